@@ -0,0 +1,130 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "buffer-pool.hpp"
+
+#include <boost/thread/mutex.hpp>
+
+namespace nfd {
+
+class BufferPool::Impl : noncopyable
+{
+public:
+  Impl(size_t bufferSize, size_t maxIdle)
+    : bufferSize(bufferSize)
+    , maxIdle(maxIdle)
+  {
+  }
+
+  ~Impl()
+  {
+    this->clear();
+  }
+
+  void
+  clear()
+  {
+    for (std::vector<ndn::Buffer*>::iterator it = idle.begin(); it != idle.end(); ++it) {
+      delete *it;
+    }
+    idle.clear();
+  }
+
+public:
+  boost::mutex mutex;
+  const size_t bufferSize;
+  size_t maxIdle;
+  std::vector<ndn::Buffer*> idle;
+};
+
+/** \brief shared_ptr deleter that returns a buffer to its pool
+ */
+class BufferPool::Recycler
+{
+public:
+  explicit
+  Recycler(const shared_ptr<Impl>& impl)
+    : m_impl(impl)
+  {
+  }
+
+  void
+  operator()(ndn::Buffer* buffer) const
+  {
+    {
+      boost::mutex::scoped_lock lock(m_impl->mutex);
+      if (m_impl->idle.size() < m_impl->maxIdle) {
+        m_impl->idle.push_back(buffer);
+        return;
+      }
+    }
+    delete buffer;
+  }
+
+private:
+  shared_ptr<Impl> m_impl;
+};
+
+BufferPool::BufferPool(size_t bufferSize, size_t maxIdle)
+  : m_impl(make_shared<Impl>(bufferSize, maxIdle))
+  , m_bufferSize(bufferSize)
+{
+  m_impl->idle.reserve(maxIdle);
+}
+
+BufferPool::~BufferPool()
+{
+  // buffers released later are deleted
+  boost::mutex::scoped_lock lock(m_impl->mutex);
+  m_impl->maxIdle = 0;
+  m_impl->clear();
+}
+
+shared_ptr<ndn::Buffer>
+BufferPool::allocate()
+{
+  ndn::Buffer* buffer = 0;
+  {
+    boost::mutex::scoped_lock lock(m_impl->mutex);
+    if (!m_impl->idle.empty()) {
+      buffer = m_impl->idle.back();
+      m_impl->idle.pop_back();
+    }
+  }
+
+  if (buffer == 0) {
+    buffer = new ndn::Buffer(m_bufferSize);
+  }
+  return shared_ptr<ndn::Buffer>(buffer, Recycler(m_impl));
+}
+
+size_t
+BufferPool::getNIdle() const
+{
+  boost::mutex::scoped_lock lock(m_impl->mutex);
+  return m_impl->idle.size();
+}
+
+} // namespace nfd
@@ -0,0 +1,81 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_CORE_BUFFER_POOL_HPP
+#define NFD_CORE_BUFFER_POOL_HPP
+
+#include "common.hpp"
+
+#include <ndn-cxx/encoding/buffer.hpp>
+
+namespace nfd {
+
+/** \brief a pool of fixed-size buffers for receiving packets
+ *
+ *  Blocks, Interests and Data decoded from a received buffer may reference it
+ *  instead of copying their octets. A buffer returns to the pool when the last
+ *  reference to it is released, which may happen in any thread,
+ *  and may happen after the pool is destroyed.
+ */
+class BufferPool : noncopyable
+{
+public:
+  /** \param bufferSize size of every buffer
+   *  \param maxIdle maximum number of released buffers kept for reuse
+   */
+  BufferPool(size_t bufferSize, size_t maxIdle);
+
+  ~BufferPool();
+
+  /** \return a buffer of getBufferSize() octets with unspecified content
+   */
+  shared_ptr<ndn::Buffer>
+  allocate();
+
+  size_t
+  getBufferSize() const;
+
+  /** \return number of released buffers kept for reuse
+   */
+  size_t
+  getNIdle() const;
+
+private:
+  class Impl;
+  class Recycler;
+
+  shared_ptr<Impl> m_impl;
+  size_t m_bufferSize;
+};
+
+inline size_t
+BufferPool::getBufferSize() const
+{
+  return m_bufferSize;
+}
+
+} // namespace nfd
+
+#endif // NFD_CORE_BUFFER_POOL_HPP
@@ -24,6 +24,8 @@
 
 #include "global-io.hpp"
 
+#include <boost/thread/tss.hpp>
+
 namespace nfd {
 
 namespace scheduler {
@@ -34,15 +36,50 @@ resetGlobalScheduler();
 
 static shared_ptr<boost::asio::io_service> g_ioService;
 
+static void
+releaseThreadIoService(boost::asio::io_service* ioService)
+{
+  // io_service is owned by the thread that installed it
+}
+
+static boost::thread_specific_ptr<boost::asio::io_service>&
+getThreadIoServicePtr()
+{
+  static boost::thread_specific_ptr<boost::asio::io_service> threadIoService(
+    &releaseThreadIoService);
+  return threadIoService;
+}
+
+// also used by scheduler.cpp
+boost::asio::io_service*
+getThreadIoService()
+{
+  return getThreadIoServicePtr().get();
+}
+
 boost::asio::io_service&
 getGlobalIoService()
 {
+  boost::asio::io_service* threadIoService = getThreadIoService();
+  if (threadIoService != 0) {
+    return *threadIoService;
+  }
+
   if (!static_cast<bool>(g_ioService)) {
     g_ioService = make_shared<boost::asio::io_service>();
   }
   return *g_ioService;
 }
 
+void
+setThreadIoService(boost::asio::io_service* ioService)
+{
+  if (getThreadIoService() != 0) {
+    scheduler::resetGlobalScheduler();
+  }
+  getThreadIoServicePtr().reset(ioService);
+}
+
 void
 resetGlobalIoService()
 {
@@ -34,6 +34,16 @@ namespace nfd {
 boost::asio::io_service&
 getGlobalIoService();
 
+/** \brief make getGlobalIoService() return ioService in the calling thread
+ *
+ *  A forwarding worker thread installs its own io_service, so that the scheduler
+ *  and other users of getGlobalIoService() on that thread run on the worker's event loop.
+ *  The calling thread's scheduler is deleted when an io_service is replaced.
+ *  \param ioService io_service owned by the caller, or 0 to restore the global instance
+ */
+void
+setThreadIoService(boost::asio::io_service* ioService);
+
 #ifdef WITH_TESTS
 /** \brief delete the global io_service instance
  *
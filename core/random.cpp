@@ -25,14 +25,41 @@
 
 #include "random.hpp"
 
+#include <boost/thread/tss.hpp>
+#include <boost/random/random_device.hpp>
+#include <boost/detail/atomic_count.hpp>
+
 namespace nfd {
 
-static boost::random::mt19937 g_rng;
+// each thread has its own generator, so that worker threads can draw numbers without locking
+static boost::thread_specific_ptr<boost::random::mt19937> g_rng;
+
+/** \return a seed for the generator of a new thread
+ *
+ *  Seeds come from the system entropy source, so that threads and NFD processes
+ *  draw different sequences. If it is unavailable, each thread gets a distinct seed.
+ */
+static boost::random::mt19937::result_type
+makeSeed()
+{
+  try {
+    boost::random::random_device entropy;
+    return entropy();
+  }
+  catch (const std::exception&) {
+    static boost::detail::atomic_count nThreads(0);
+    long threadIndex = ++nThreads;
+    return boost::random::mt19937::default_seed + threadIndex;
+  }
+}
 
 boost::random::mt19937&
 getGlobalRng()
 {
-  return g_rng;
+  if (g_rng.get() == 0) {
+    g_rng.reset(new boost::random::mt19937(makeSeed()));
+  }
+  return *g_rng;
 }
 
 } // namespace nfd
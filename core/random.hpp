@@ -39,7 +39,9 @@
 
 namespace nfd {
 
-/** \return the global random number generator instance
+/** \return the global random number generator instance of the calling thread
+ *
+ *  Each thread's generator has its own seed from the system entropy source.
  */
 boost::random::mt19937&
 getGlobalRng();
@@ -25,14 +25,32 @@
 #include "scheduler.hpp"
 #include "global-io.hpp"
 
+#include <boost/thread/tss.hpp>
+
 namespace nfd {
+
+// defined in global-io.cpp
+boost::asio::io_service*
+getThreadIoService();
+
 namespace scheduler {
 
 static shared_ptr<Scheduler> g_scheduler;
 
+/// schedulers of threads that have their own io_service
+static boost::thread_specific_ptr<Scheduler> g_threadScheduler;
+
 inline Scheduler&
 getGlobalScheduler()
 {
+  boost::asio::io_service* threadIoService = getThreadIoService();
+  if (threadIoService != 0) {
+    if (g_threadScheduler.get() == 0) {
+      g_threadScheduler.reset(new Scheduler(*threadIoService));
+    }
+    return *g_threadScheduler;
+  }
+
   if (!static_cast<bool>(g_scheduler)) {
     g_scheduler = make_shared<Scheduler>(ref(getGlobalIoService()));
   }
@@ -54,6 +72,11 @@ cancel(const EventId& eventId)
 void
 resetGlobalScheduler()
 {
+  if (getThreadIoService() != 0) {
+    g_threadScheduler.reset();
+    return;
+  }
+
   g_scheduler.reset();
 }
 
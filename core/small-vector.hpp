@@ -0,0 +1,251 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_CORE_SMALL_VECTOR_HPP
+#define NFD_CORE_SMALL_VECTOR_HPP
+
+#include "common.hpp"
+
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+
+#include <new>
+
+namespace nfd {
+
+/** \brief a sequence container that stores up to N elements inline
+ *
+ *  Elements are kept in contiguous storage. The first N elements are stored within
+ *  the container itself, so that no heap allocation happens unless size exceeds N.
+ *  As with std::vector, push_back and erase invalidate iterators.
+ */
+template<typename T, size_t N>
+class SmallVector
+{
+public:
+  typedef T value_type;
+  typedef T& reference;
+  typedef const T& const_reference;
+  typedef T* iterator;
+  typedef const T* const_iterator;
+  typedef size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+
+  SmallVector()
+    : m_begin(getInlineStorage())
+    , m_size(0)
+    , m_capacity(N)
+  {
+  }
+
+  SmallVector(const SmallVector& other)
+    : m_begin(getInlineStorage())
+    , m_size(0)
+    , m_capacity(N)
+  {
+    this->assign(other.begin(), other.end());
+  }
+
+  SmallVector&
+  operator=(const SmallVector& other)
+  {
+    if (this != &other)
+      this->assign(other.begin(), other.end());
+    return *this;
+  }
+
+  ~SmallVector()
+  {
+    this->clear();
+    this->releaseHeapStorage();
+  }
+
+  iterator
+  begin()
+  {
+    return m_begin;
+  }
+
+  const_iterator
+  begin() const
+  {
+    return m_begin;
+  }
+
+  iterator
+  end()
+  {
+    return m_begin + m_size;
+  }
+
+  const_iterator
+  end() const
+  {
+    return m_begin + m_size;
+  }
+
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+
+  bool
+  empty() const
+  {
+    return m_size == 0;
+  }
+
+  /** \return whether elements are stored outside of the container
+   */
+  bool
+  isOnHeap() const
+  {
+    return m_begin != getInlineStorage();
+  }
+
+  T&
+  operator[](size_t i)
+  {
+    BOOST_ASSERT(i < m_size);
+    return m_begin[i];
+  }
+
+  const T&
+  operator[](size_t i) const
+  {
+    BOOST_ASSERT(i < m_size);
+    return m_begin[i];
+  }
+
+  T&
+  front()
+  {
+    BOOST_ASSERT(m_size > 0);
+    return m_begin[0];
+  }
+
+  T&
+  back()
+  {
+    BOOST_ASSERT(m_size > 0);
+    return m_begin[m_size - 1];
+  }
+
+  void
+  push_back(const T& value)
+  {
+    if (m_size == m_capacity)
+      {
+        // value may refer to an element of this container
+        T copy(value);
+        this->grow(m_capacity * 2);
+        new (m_begin + m_size) T(copy);
+      }
+    else
+      {
+        new (m_begin + m_size) T(value);
+      }
+    ++m_size;
+  }
+
+  /** \brief erases one element, shifting the following elements forward
+   *  \return an iterator to the element that followed the erased element
+   */
+  iterator
+  erase(iterator pos)
+  {
+    BOOST_ASSERT(pos >= this->begin() && pos < this->end());
+    for (iterator it = pos + 1; it != this->end(); ++it)
+      *(it - 1) = *it;
+    this->back().~T();
+    --m_size;
+    return pos;
+  }
+
+  /** \brief erases all elements; storage is kept
+   */
+  void
+  clear()
+  {
+    for (iterator it = this->begin(); it != this->end(); ++it)
+      it->~T();
+    m_size = 0;
+  }
+
+private:
+  template<typename InputIterator>
+  void
+  assign(InputIterator first, InputIterator last)
+  {
+    this->clear();
+    for (; first != last; ++first)
+      this->push_back(*first);
+  }
+
+  T*
+  getInlineStorage()
+  {
+    return static_cast<T*>(m_inline.address());
+  }
+
+  const T*
+  getInlineStorage() const
+  {
+    return static_cast<const T*>(m_inline.address());
+  }
+
+  void
+  grow(size_t capacity)
+  {
+    T* storage = static_cast<T*>(::operator new(capacity * sizeof(T)));
+    for (size_t i = 0; i < m_size; ++i)
+      {
+        new (storage + i) T(m_begin[i]);
+        m_begin[i].~T();
+      }
+
+    this->releaseHeapStorage();
+    m_begin = storage;
+    m_capacity = capacity;
+  }
+
+  void
+  releaseHeapStorage()
+  {
+    if (this->isOnHeap())
+      ::operator delete(m_begin);
+  }
+
+private:
+  boost::aligned_storage<sizeof(T) * N, boost::alignment_of<T>::value> m_inline;
+  T* m_begin;
+  size_t m_size;
+  size_t m_capacity;
+};
+
+} // namespace nfd
+
+#endif // NFD_CORE_SMALL_VECTOR_HPP
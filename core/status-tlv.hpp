@@ -0,0 +1,49 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_CORE_STATUS_TLV_HPP
+#define NFD_CORE_STATUS_TLV_HPP
+
+namespace nfd {
+
+/** \brief TLV-TYPE codes of NFD-specific elements in the general status dataset
+ *
+ *  These elements are appended after the ForwarderStatus elements
+ *  in the Content of /localhost/nfd/status.
+ *  A decoder that only understands ForwarderStatus ignores them.
+ */
+namespace status_tlv {
+
+enum {
+  /// current number of bytes used by Content Store entries
+  NCsBytes   = 0xa0,
+  /// maximum number of bytes of Content Store; omitted if unlimited
+  CsMaxBytes = 0xa1
+};
+
+} // namespace status_tlv
+} // namespace nfd
+
+#endif // NFD_CORE_STATUS_TLV_HPP
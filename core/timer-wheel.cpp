@@ -0,0 +1,202 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "timer-wheel.hpp"
+
+namespace nfd {
+
+Timer::Timer()
+  : m_wheel(0)
+  , m_expiry(0)
+{
+}
+
+Timer::~Timer()
+{
+  this->cancel();
+}
+
+void
+Timer::cancel()
+{
+  if (!this->isScheduled())
+    return;
+
+  this->unlink();
+  --m_wheel->m_nTimers;
+  m_wheel = 0;
+
+  // the callback may own this timer, so it is released last
+  function<void()> callback;
+  callback.swap(m_callback);
+}
+
+const int TimerWheel::N_LEVELS;
+const int TimerWheel::SLOT_BITS;
+const size_t TimerWheel::N_SLOTS;
+
+TimerWheel::TimerWheel(const time::nanoseconds& tick)
+  : m_tick(tick)
+  , m_origin(time::steady_clock::now())
+  , m_now(0)
+  , m_nTimers(0)
+{
+  BOOST_ASSERT(m_tick > time::nanoseconds::zero());
+}
+
+TimerWheel::~TimerWheel()
+{
+  scheduler::cancel(m_tickEvent);
+
+  for (int level = 0; level < N_LEVELS; ++level)
+    {
+      for (size_t i = 0; i < N_SLOTS; ++i)
+        {
+          Slot& slot = m_slots[level][i];
+          while (!slot.empty())
+            slot.front().cancel();
+        }
+    }
+}
+
+uint64_t
+TimerWheel::getCurrentTick() const
+{
+  return (time::steady_clock::now() - m_origin) / m_tick;
+}
+
+void
+TimerWheel::schedule(Timer& timer, const time::nanoseconds& after,
+                     const function<void()>& callback)
+{
+  timer.cancel();
+
+  if (m_nTimers == 0)
+    {
+      // nothing to fire in skipped ticks
+      m_now = std::max(m_now, this->getCurrentTick());
+    }
+
+  // round up to the next tick boundary, so that the timer does not fire early
+  time::nanoseconds expiry = time::steady_clock::now() - m_origin + after;
+  uint64_t expiryTick = 0;
+  if (expiry > time::nanoseconds::zero())
+    expiryTick = (expiry + m_tick - time::nanoseconds(1)) / m_tick;
+
+  timer.m_wheel = this;
+  timer.m_expiry = std::max(expiryTick, m_now + 1);
+  timer.m_callback = callback;
+  this->insert(timer);
+  ++m_nTimers;
+
+  if (m_nTimers == 1)
+    this->scheduleTick();
+}
+
+void
+TimerWheel::insert(Timer& timer)
+{
+  BOOST_ASSERT(timer.m_expiry >= m_now);
+  uint64_t delta = timer.m_expiry - m_now;
+
+  for (int level = 0; level < N_LEVELS; ++level)
+    {
+      int shift = level * SLOT_BITS;
+      if (delta < (static_cast<uint64_t>(N_SLOTS) << shift) || level == N_LEVELS - 1)
+        {
+          // beyond the range of the last level, the timer is re-placed when cascaded
+          uint64_t position = std::min(timer.m_expiry,
+                                       m_now + (static_cast<uint64_t>(N_SLOTS) << shift) - 1);
+          m_slots[level][(position >> shift) & (N_SLOTS - 1)].push_back(timer);
+          return;
+        }
+    }
+}
+
+void
+TimerWheel::cascade(Slot& slot)
+{
+  Slot timers;
+  timers.swap(slot);
+  while (!timers.empty())
+    {
+      Timer& timer = timers.front();
+      timers.pop_front();
+      this->insert(timer);
+    }
+}
+
+void
+TimerWheel::advance()
+{
+  ++m_now;
+
+  for (int level = 1; level < N_LEVELS; ++level)
+    {
+      int shift = level * SLOT_BITS;
+      if ((m_now & ((static_cast<uint64_t>(1) << shift) - 1)) != 0)
+        break;
+      this->cascade(m_slots[level][(m_now >> shift) & (N_SLOTS - 1)]);
+    }
+
+  Slot& slot = m_slots[0][m_now & (N_SLOTS - 1)];
+  while (!slot.empty())
+    {
+      Timer& timer = slot.front();
+      BOOST_ASSERT(timer.m_expiry == m_now);
+      slot.pop_front();
+      --m_nTimers;
+      timer.m_wheel = 0;
+
+      // the callback may reschedule or destruct the timer
+      function<void()> callback;
+      callback.swap(timer.m_callback);
+      callback();
+    }
+}
+
+void
+TimerWheel::onTick()
+{
+  uint64_t currentTick = this->getCurrentTick();
+  while (m_now < currentTick && m_nTimers > 0)
+    this->advance();
+
+  if (m_nTimers > 0)
+    this->scheduleTick();
+}
+
+void
+TimerWheel::scheduleTick()
+{
+  time::nanoseconds nextTick = m_tick * static_cast<int64_t>(m_now + 1);
+  time::nanoseconds after = nextTick - (time::steady_clock::now() - m_origin);
+
+  scheduler::cancel(m_tickEvent);
+  m_tickEvent = scheduler::schedule(std::max(after, time::nanoseconds::zero()),
+                                    bind(&TimerWheel::onTick, this));
+}
+
+} // namespace nfd
@@ -0,0 +1,178 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_CORE_TIMER_WHEEL_HPP
+#define NFD_CORE_TIMER_WHEEL_HPP
+
+#include "common.hpp"
+#include "scheduler.hpp"
+
+#include <boost/intrusive/list.hpp>
+
+namespace nfd {
+
+class TimerWheel;
+
+/** \brief a timer that can be scheduled on a TimerWheel
+ *
+ *  The Timer is owned by the caller, typically as a member of the object it refers to,
+ *  so that scheduling does not allocate memory.
+ *  A Timer that is destructed while scheduled is cancelled.
+ */
+class Timer : public boost::intrusive::list_base_hook<
+                       boost::intrusive::link_mode<boost::intrusive::auto_unlink> >,
+              noncopyable
+{
+public:
+  Timer();
+
+  ~Timer();
+
+  /** \return whether the timer is scheduled and has not fired
+   */
+  bool
+  isScheduled() const;
+
+  /** \brief cancels the timer if it is scheduled
+   */
+  void
+  cancel();
+
+private:
+  /// the TimerWheel on which the timer is scheduled
+  TimerWheel* m_wheel;
+  /// expiry in ticks of the TimerWheel
+  uint64_t m_expiry;
+  function<void()> m_callback;
+
+  friend class TimerWheel;
+};
+
+/** \brief a hierarchical timing wheel
+ *
+ *  Time is divided into ticks. Timers expiring within 256 ticks are placed in a slot of
+ *  the first level; later timers are placed in coarser levels, and are moved to finer
+ *  levels as time advances. Scheduling and cancelling take constant time, regardless
+ *  of how many timers are scheduled.
+ *
+ *  A timer fires at the first tick boundary after its expiry; it never fires early.
+ *  The wheel is driven by one global scheduler event per tick, which exists only while
+ *  any timer is scheduled.
+ */
+class TimerWheel : noncopyable
+{
+public:
+  explicit
+  TimerWheel(const time::nanoseconds& tick = time::milliseconds(1));
+
+  /** \brief cancels all scheduled timers
+   */
+  ~TimerWheel();
+
+  const time::nanoseconds&
+  getTick() const;
+
+  /** \return number of scheduled timers
+   */
+  size_t
+  size() const;
+
+  /** \brief schedules \p timer to invoke \p callback after \p after
+   *
+   *  If \p timer is already scheduled, it is rescheduled.
+   *  The callback is released before it is invoked, or when the timer is cancelled.
+   */
+  void
+  schedule(Timer& timer, const time::nanoseconds& after, const function<void()>& callback);
+
+private:
+  typedef boost::intrusive::list<Timer, boost::intrusive::constant_time_size<false> > Slot;
+
+  uint64_t
+  getCurrentTick() const;
+
+  /** \brief places timer in the slot for its expiry, relative to m_now
+   *
+   *  A timer that expires at m_now is placed in the current slot of the first level,
+   *  which happens when a coarser slot is cascaded at the expiry tick.
+   */
+  void
+  insert(Timer& timer);
+
+  /** \brief moves all timers in a slot to finer levels
+   */
+  void
+  cascade(Slot& slot);
+
+  /** \brief advances m_now by one tick, and fires timers that expire at the new m_now
+   */
+  void
+  advance();
+
+  /** \brief advances m_now to current time
+   */
+  void
+  onTick();
+
+  void
+  scheduleTick();
+
+private:
+  static const int N_LEVELS = 4;
+  static const int SLOT_BITS = 8;
+  static const size_t N_SLOTS = 1 << SLOT_BITS;
+
+  time::nanoseconds m_tick;
+  time::steady_clock::TimePoint m_origin;
+  /// ticks up to m_now have been processed
+  uint64_t m_now;
+  Slot m_slots[N_LEVELS][N_SLOTS];
+  size_t m_nTimers;
+  EventId m_tickEvent;
+
+  friend class Timer;
+};
+
+inline bool
+Timer::isScheduled() const
+{
+  return this->is_linked();
+}
+
+inline const time::nanoseconds&
+TimerWheel::getTick() const
+{
+  return m_tick;
+}
+
+inline size_t
+TimerWheel::size() const
+{
+  return m_nTimers;
+}
+
+} // namespace nfd
+
+#endif // NFD_CORE_TIMER_WHEEL_HPP
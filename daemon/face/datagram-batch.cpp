@@ -0,0 +1,224 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "datagram-batch.hpp"
+#include "face.hpp"
+
+#if defined(HAVE_RECVMMSG) && defined(HAVE_SENDMMSG)
+#define NFD_HAVE_DATAGRAM_BATCH 1
+#include <sys/socket.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace nfd {
+
+#ifdef NFD_HAVE_DATAGRAM_BATCH
+
+class DatagramBatch::Impl
+{
+public:
+  explicit
+  Impl(size_t batchSize)
+    : receiveMessages(batchSize)
+    , receiveIovecs(batchSize)
+    , receiveSources(batchSize)
+    , sendMessages(batchSize)
+    , sendIovecs(batchSize)
+  {
+  }
+
+public:
+  std::vector<mmsghdr> receiveMessages;
+  std::vector<iovec> receiveIovecs;
+  std::vector<sockaddr_storage> receiveSources;
+  std::vector<mmsghdr> sendMessages;
+  std::vector<iovec> sendIovecs;
+};
+
+static boost::system::error_code
+makeErrorCode(int errorNumber)
+{
+  if (errorNumber == EAGAIN || errorNumber == EWOULDBLOCK)
+    return boost::asio::error::would_block;
+  return boost::system::error_code(errorNumber, boost::system::system_category());
+}
+
+#else
+
+class DatagramBatch::Impl
+{
+public:
+  explicit
+  Impl(size_t batchSize)
+  {
+  }
+};
+
+#endif // NFD_HAVE_DATAGRAM_BATCH
+
+DatagramBatch::DatagramBatch(size_t batchSize)
+  : m_impl(new Impl(batchSize))
+{
+  BOOST_ASSERT(batchSize > 0);
+
+  m_buffers.reserve(batchSize);
+  for (size_t i = 0; i < batchSize; ++i)
+    m_buffers.push_back(Face::getReceiveBufferPool().allocate());
+}
+
+DatagramBatch::~DatagramBatch()
+{
+}
+
+bool
+DatagramBatch::isSupported()
+{
+#ifdef NFD_HAVE_DATAGRAM_BATCH
+  return true;
+#else
+  return false;
+#endif // NFD_HAVE_DATAGRAM_BATCH
+}
+
+#ifdef NFD_HAVE_DATAGRAM_BATCH
+
+size_t
+DatagramBatch::receive(int fd, boost::system::error_code& error)
+{
+  BufferPool& pool = Face::getReceiveBufferPool();
+  for (size_t i = 0; i < m_buffers.size(); ++i)
+    {
+      // packets decoded from the previous batch may still reference its buffers
+      if (!m_buffers[i].unique())
+        m_buffers[i] = pool.allocate();
+
+      iovec& iov = m_impl->receiveIovecs[i];
+      iov.iov_base = &m_buffers[i]->front();
+      iov.iov_len = m_buffers[i]->size();
+
+      mmsghdr& message = m_impl->receiveMessages[i];
+      std::memset(&message, 0, sizeof(message));
+      message.msg_hdr.msg_name = &m_impl->receiveSources[i];
+      message.msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+      message.msg_hdr.msg_iov = &iov;
+      message.msg_hdr.msg_iovlen = 1;
+    }
+
+  int nReceived = ::recvmmsg(fd, &m_impl->receiveMessages.front(), m_buffers.size(),
+                             MSG_DONTWAIT, 0);
+  if (nReceived < 0)
+    {
+      error = makeErrorCode(errno);
+      return 0;
+    }
+
+  error.clear();
+  return static_cast<size_t>(nReceived);
+}
+
+size_t
+DatagramBatch::getSize(size_t i) const
+{
+  return m_impl->receiveMessages[i].msg_len;
+}
+
+size_t
+DatagramBatch::getSourceAddress(size_t i, void* address, size_t addressCapacity) const
+{
+  size_t length = std::min<size_t>(m_impl->receiveMessages[i].msg_hdr.msg_namelen,
+                                   addressCapacity);
+  std::memcpy(address, &m_impl->receiveSources[i], length);
+  return length;
+}
+
+size_t
+DatagramBatch::send(int fd, const std::deque<Block>& queue,
+                    const void* destination, size_t destinationLength,
+                    boost::system::error_code& error, size_t& nOctetsSent)
+{
+  size_t nMessages = std::min(queue.size(), m_impl->sendMessages.size());
+  for (size_t i = 0; i < nMessages; ++i)
+    {
+      iovec& iov = m_impl->sendIovecs[i];
+      iov.iov_base = const_cast<uint8_t*>(queue[i].wire());
+      iov.iov_len = queue[i].size();
+
+      mmsghdr& message = m_impl->sendMessages[i];
+      std::memset(&message, 0, sizeof(message));
+      message.msg_hdr.msg_name = const_cast<void*>(destination);
+      message.msg_hdr.msg_namelen = destinationLength;
+      message.msg_hdr.msg_iov = &iov;
+      message.msg_hdr.msg_iovlen = 1;
+    }
+
+  nOctetsSent = 0;
+  int nSent = ::sendmmsg(fd, &m_impl->sendMessages.front(), nMessages, MSG_DONTWAIT);
+  if (nSent < 0)
+    {
+      error = makeErrorCode(errno);
+      return 0;
+    }
+
+  for (int i = 0; i < nSent; ++i)
+    nOctetsSent += m_impl->sendMessages[i].msg_len;
+  error.clear();
+  return static_cast<size_t>(nSent);
+}
+
+#else
+
+size_t
+DatagramBatch::receive(int fd, boost::system::error_code& error)
+{
+  error = boost::asio::error::operation_not_supported;
+  return 0;
+}
+
+size_t
+DatagramBatch::getSize(size_t i) const
+{
+  return 0;
+}
+
+size_t
+DatagramBatch::getSourceAddress(size_t i, void* address, size_t addressCapacity) const
+{
+  return 0;
+}
+
+size_t
+DatagramBatch::send(int fd, const std::deque<Block>& queue,
+                    const void* destination, size_t destinationLength,
+                    boost::system::error_code& error, size_t& nOctetsSent)
+{
+  error = boost::asio::error::operation_not_supported;
+  nOctetsSent = 0;
+  return 0;
+}
+
+#endif // NFD_HAVE_DATAGRAM_BATCH
+
+} // namespace nfd
@@ -0,0 +1,119 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FACE_DATAGRAM_BATCH_HPP
+#define NFD_DAEMON_FACE_DATAGRAM_BATCH_HPP
+
+#include "common.hpp"
+
+#include <ndn-cxx/encoding/buffer.hpp>
+
+#include <deque>
+
+namespace nfd {
+
+/** \brief receives and sends datagrams in batches with recvmmsg and sendmmsg
+ *
+ *  Datagrams are received into a ring of buffers from Face::getReceiveBufferPool().
+ *  Buffers still referenced by decoded packets are replaced before the next receive.
+ */
+class DatagramBatch : noncopyable
+{
+public:
+  /** \param batchSize maximum number of datagrams received or sent in one syscall
+   */
+  explicit
+  DatagramBatch(size_t batchSize);
+
+  ~DatagramBatch();
+
+  /** \return whether batched datagram I/O is available on this platform
+   */
+  static bool
+  isSupported();
+
+  size_t
+  getBatchSize() const;
+
+  /** \brief receive datagrams without blocking
+   *  \param fd a datagram socket
+   *  \param[out] error reason of failure, or would_block if no datagram is pending
+   *  \return number of received datagrams
+   */
+  size_t
+  receive(int fd, boost::system::error_code& error);
+
+  /** \return buffer of the i-th received datagram
+   */
+  const shared_ptr<ndn::Buffer>&
+  getBuffer(size_t i) const;
+
+  /** \return size of the i-th received datagram
+   */
+  size_t
+  getSize(size_t i) const;
+
+  /** \brief copy the source address of the i-th received datagram
+   *  \param[out] address where the source address is copied
+   *  \param addressCapacity size of address
+   *  \return length of the source address
+   */
+  size_t
+  getSourceAddress(size_t i, void* address, size_t addressCapacity) const;
+
+  /** \brief send Blocks from the front of queue without blocking
+   *  \param fd a datagram socket
+   *  \param destination destination address, or 0 if fd is connected
+   *  \param destinationLength size of destination
+   *  \param[out] error reason of failure, or would_block if the socket is not writable
+   *  \param[out] nOctetsSent total size of sent Blocks
+   *  \return number of sent Blocks, each as one datagram
+   */
+  size_t
+  send(int fd, const std::deque<Block>& queue,
+       const void* destination, size_t destinationLength,
+       boost::system::error_code& error, size_t& nOctetsSent);
+
+private:
+  class Impl;
+  scoped_ptr<Impl> m_impl;
+  std::vector<shared_ptr<ndn::Buffer> > m_buffers;
+};
+
+inline size_t
+DatagramBatch::getBatchSize() const
+{
+  return m_buffers.size();
+}
+
+inline const shared_ptr<ndn::Buffer>&
+DatagramBatch::getBuffer(size_t i) const
+{
+  return m_buffers[i];
+}
+
+} // namespace nfd
+
+#endif // NFD_DAEMON_FACE_DATAGRAM_BATCH_HPP
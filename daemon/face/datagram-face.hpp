@@ -27,6 +27,7 @@
 #define NFD_DAEMON_FACE_DATAGRAM_FACE_HPP
 
 #include "face.hpp"
+#include "datagram-batch.hpp"
 #include "core/logger.hpp"
 
 namespace nfd {
@@ -50,6 +51,17 @@ public:
                const shared_ptr<typename protocol::socket>& socket,
                bool isOnDemand);
 
+  /** \brief Construct datagram face on a socket shared with other faces
+   *
+   * The face does not receive from sharedSocket; the owner of the socket
+   * passes datagrams from remoteEndpoint to receiveDatagram.
+   * Packets are sent to remoteEndpoint, and closing the face leaves the socket open.
+   */
+  DatagramFace(const FaceUri& remoteUri, const FaceUri& localUri,
+               const shared_ptr<typename protocol::socket>& sharedSocket,
+               const typename protocol::endpoint& remoteEndpoint,
+               bool isOnDemand);
+
   virtual
   ~DatagramFace();
 
@@ -63,8 +75,11 @@ public:
   virtual void
   close();
 
+  /** \brief process a received datagram
+   *  \param buffer receive buffer, which decoded packets may reference
+   */
   void
-  receiveDatagram(const uint8_t* buffer,
+  receiveDatagram(const ndn::ConstBufferPtr& buffer,
                   size_t nBytesReceived,
                   const boost::system::error_code& error);
 
@@ -80,7 +95,46 @@ public:
   void
   setOnDemand(bool isOnDemand);
 
+  /** \brief receive and send up to batchSize datagrams per syscall
+   *
+   *  Datagrams received together are dispatched as one batch.
+   *  Packets sent while handling one event are sent together.
+   *  Batched I/O requires DatagramBatch::isSupported(); batchSize 0 or 1 disables it.
+   *  The receive mode changes after the pending receive completes.
+   */
+  void
+  setIoBatchSize(size_t batchSize);
+
+  size_t
+  getIoBatchSize() const;
+
 protected:
+  /** \brief send a packet, or queue it when batched I/O is enabled
+   */
+  void
+  sendBlock(const Block& block);
+
+  /** \brief send through sendSocket to destination, instead of the connected socket
+   */
+  void
+  setSendDestination(const shared_ptr<typename protocol::socket>& sendSocket,
+                     const typename protocol::endpoint& destination);
+
+  /** \brief dispatch the element decoded from one datagram
+   *
+   *  A subclass may override this to handle link layer packets such as NDNLP fragments.
+   *  \return false if the element is not recognized
+   */
+  virtual bool
+  dispatchDatagram(const Block& element);
+
+  /** \return source of the datagram being dispatched
+   *
+   *  This is known only when the face receives from its own socket.
+   */
+  const typename protocol::endpoint&
+  getReceiveSource() const;
+
   void
   handleSend(const boost::system::error_code& error,
              size_t nBytesSent,
@@ -90,17 +144,50 @@ protected:
   handleReceive(const boost::system::error_code& error,
                 size_t nBytesReceived);
 
+  void
+  startReceive();
+
+  void
+  handleReceiveBatch(const boost::system::error_code& error);
+
+  void
+  sendQueued(const shared_ptr<Face>& face);
+
+  void
+  handleSendReady(const boost::system::error_code& error,
+                  const shared_ptr<Face>& face);
+
   void
   keepFaceAliveUntilAllHandlersExecuted(const shared_ptr<Face>& face);
 
+  /** \return whether the face has not been closed
+   */
+  bool
+  isOpen() const;
+
   void
   closeSocket();
 
 protected:
   shared_ptr<typename protocol::socket> m_socket;
-  uint8_t m_inputBuffer[MAX_NDN_PACKET_SIZE];
+  shared_ptr<ndn::Buffer> m_inputBuffer;
+  typename protocol::endpoint m_receiveSource;
   bool m_hasBeenUsedRecently;
 
+  shared_ptr<typename protocol::socket> m_sendSocket;
+  typename protocol::endpoint m_sendDestination;
+  bool m_hasSendDestination;
+
+  /// batched I/O, or null if disabled
+  scoped_ptr<DatagramBatch> m_batch;
+  /// packets waiting for a batched send
+  std::deque<Block> m_sendQueue;
+  bool m_isSendPending;
+
+  /// m_socket is shared with other faces, and is not closed by this face
+  bool m_isSocketShared;
+  bool m_isClosed;
+
   NFD_LOG_INCLASS_DECLARE();
 };
 
@@ -112,11 +199,34 @@ DatagramFace<T, U>::DatagramFace(const FaceUri& remoteUri, const FaceUri& localU
                                  bool isOnDemand)
   : Face(remoteUri, localUri)
   , m_socket(socket)
+  , m_inputBuffer(getReceiveBufferPool().allocate())
+  , m_sendSocket(socket)
+  , m_hasSendDestination(false)
+  , m_isSendPending(false)
+  , m_isSocketShared(false)
+  , m_isClosed(false)
 {
   setOnDemand(isOnDemand);
 
-  m_socket->async_receive(boost::asio::buffer(m_inputBuffer, MAX_NDN_PACKET_SIZE), 0,
-                          bind(&DatagramFace<T, U>::handleReceive, this, _1, _2));
+  this->startReceive();
+}
+
+template<class T, class U>
+inline
+DatagramFace<T, U>::DatagramFace(const FaceUri& remoteUri, const FaceUri& localUri,
+                                 const shared_ptr<typename DatagramFace::protocol::socket>& sharedSocket,
+                                 const typename DatagramFace::protocol::endpoint& remoteEndpoint,
+                                 bool isOnDemand)
+  : Face(remoteUri, localUri)
+  , m_socket(sharedSocket)
+  , m_sendSocket(sharedSocket)
+  , m_sendDestination(remoteEndpoint)
+  , m_hasSendDestination(true)
+  , m_isSendPending(false)
+  , m_isSocketShared(true)
+  , m_isClosed(false)
+{
+  setOnDemand(isOnDemand);
 }
 
 template<class T, class U>
@@ -130,11 +240,7 @@ inline void
 DatagramFace<T, U>::sendInterest(const Interest& interest)
 {
   this->onSendInterest(interest);
-  const Block& payload = interest.wireEncode();
-  m_socket->async_send(boost::asio::buffer(payload.wire(), payload.size()),
-                       bind(&DatagramFace<T, U>::handleSend, this, _1, _2, payload));
-
-  // anything else should be done here?
+  this->sendBlock(interest.wireEncode());
 }
 
 template<class T, class U>
@@ -142,11 +248,129 @@ inline void
 DatagramFace<T, U>::sendData(const Data& data)
 {
   this->onSendData(data);
-  const Block& payload = data.wireEncode();
-  m_socket->async_send(boost::asio::buffer(payload.wire(), payload.size()),
-                       bind(&DatagramFace<T, U>::handleSend, this, _1, _2, payload));
+  this->sendBlock(data.wireEncode());
+}
 
-  // anything else should be done here?
+template<class T, class U>
+inline void
+DatagramFace<T, U>::setIoBatchSize(size_t batchSize)
+{
+  if (batchSize > 1 && DatagramBatch::isSupported())
+    m_batch.reset(new DatagramBatch(batchSize));
+  else
+    m_batch.reset();
+}
+
+template<class T, class U>
+inline size_t
+DatagramFace<T, U>::getIoBatchSize() const
+{
+  return static_cast<bool>(m_batch) ? m_batch->getBatchSize() : 1;
+}
+
+template<class T, class U>
+inline void
+DatagramFace<T, U>::setSendDestination(const shared_ptr<typename protocol::socket>& sendSocket,
+                                       const typename protocol::endpoint& destination)
+{
+  m_sendSocket = sendSocket;
+  m_sendDestination = destination;
+  m_hasSendDestination = true;
+}
+
+template<class T, class U>
+inline void
+DatagramFace<T, U>::sendBlock(const Block& block)
+{
+  if (m_isClosed)
+    return;
+
+  if (static_cast<bool>(m_batch) || m_isSendPending)
+    {
+      m_sendQueue.push_back(block);
+      if (!m_isSendPending)
+        {
+          // gather the packets sent while handling the current event
+          m_isSendPending = true;
+          m_socket->get_io_service().post(bind(&DatagramFace<T, U>::sendQueued,
+                                               this, this->shared_from_this()));
+        }
+      return;
+    }
+
+  if (m_hasSendDestination)
+    m_sendSocket->async_send_to(boost::asio::buffer(block.wire(), block.size()),
+                                m_sendDestination,
+                                bind(&DatagramFace<T, U>::handleSend, this, _1, _2, block));
+  else
+    m_sendSocket->async_send(boost::asio::buffer(block.wire(), block.size()),
+                             bind(&DatagramFace<T, U>::handleSend, this, _1, _2, block));
+}
+
+template<class T, class U>
+inline void
+DatagramFace<T, U>::sendQueued(const shared_ptr<Face>& face)
+{
+  m_isSendPending = false;
+
+  while (!m_sendQueue.empty())
+    {
+      if (!this->isOpen() || !m_sendSocket->is_open())
+        {
+          m_sendQueue.clear();
+          return;
+        }
+
+      if (!static_cast<bool>(m_batch))
+        {
+          // batched I/O has been disabled
+          std::deque<Block> queue;
+          queue.swap(m_sendQueue);
+          for (std::deque<Block>::const_iterator it = queue.begin(); it != queue.end(); ++it)
+            this->sendBlock(*it);
+          return;
+        }
+
+      boost::system::error_code error;
+      size_t nOctetsSent = 0;
+      size_t nSent = m_batch->send(m_sendSocket->native_handle(), m_sendQueue,
+                                   m_hasSendDestination ? m_sendDestination.data() : 0,
+                                   m_hasSendDestination ? m_sendDestination.size() : 0,
+                                   error, nOctetsSent);
+      if (error == boost::asio::error::would_block)
+        {
+          m_isSendPending = true;
+          m_sendSocket->async_send(boost::asio::null_buffers(),
+                                   bind(&DatagramFace<T, U>::handleSendReady,
+                                        this, _1, this->shared_from_this()));
+          return;
+        }
+      if (error)
+        {
+          m_sendQueue.clear();
+          this->handleSend(error, 0, Block());
+          return;
+        }
+
+      m_sendQueue.erase(m_sendQueue.begin(), m_sendQueue.begin() + nSent);
+      this->handleSend(error, nOctetsSent, Block());
+    }
+}
+
+template<class T, class U>
+inline void
+DatagramFace<T, U>::handleSendReady(const boost::system::error_code& error,
+                                    const shared_ptr<Face>& face)
+{
+  if (error)
+    {
+      m_isSendPending = false;
+      m_sendQueue.clear();
+      this->handleSend(error, 0, Block());
+      return;
+    }
+
+  this->sendQueued(face);
 }
 
 template<class T, class U>
@@ -160,7 +384,7 @@ DatagramFace<T, U>::handleSend(const boost::system::error_code& error,
     if (error == boost::system::errc::operation_canceled) // when socket is closed by someone
       return;
 
-    if (!m_socket->is_open()) {
+    if (!this->isOpen()) {
       fail("Tunnel closed");
       return;
     }
@@ -192,7 +416,7 @@ template<class T, class U>
 inline void
 DatagramFace<T, U>::close()
 {
-  if (!m_socket->is_open())
+  if (!this->isOpen())
     return;
 
   NFD_LOG_INFO("[id:" << this->getId()
@@ -203,6 +427,21 @@ DatagramFace<T, U>::close()
   fail("Close tunnel");
 }
 
+template<class T, class U>
+inline void
+DatagramFace<T, U>::startReceive()
+{
+  if (static_cast<bool>(m_batch))
+    // wait until readable, then receive a batch with recvmmsg
+    m_socket->async_receive(boost::asio::null_buffers(),
+                            bind(&DatagramFace<T, U>::handleReceiveBatch, this, _1));
+  else
+    m_socket->async_receive_from(boost::asio::buffer(&m_inputBuffer->front(),
+                                                     MAX_NDN_PACKET_SIZE),
+                                 m_receiveSource, 0,
+                                 bind(&DatagramFace<T, U>::handleReceive, this, _1, _2));
+}
+
 template<class T, class U>
 inline void
 DatagramFace<T, U>::handleReceive(const boost::system::error_code& error,
@@ -210,14 +449,45 @@ DatagramFace<T, U>::handleReceive(const boost::system::error_code& error,
 {
   NFD_LOG_DEBUG("handleReceive: " << nBytesReceived);
   receiveDatagram(m_inputBuffer, nBytesReceived, error);
-  if (m_socket->is_open())
-    m_socket->async_receive(boost::asio::buffer(m_inputBuffer, MAX_NDN_PACKET_SIZE), 0,
-                            bind(&DatagramFace<T, U>::handleReceive, this, _1, _2));
+  if (!m_inputBuffer.unique())
+    m_inputBuffer = getReceiveBufferPool().allocate();
+
+  if (this->isOpen())
+    this->startReceive();
 }
 
 template<class T, class U>
 inline void
-DatagramFace<T, U>::receiveDatagram(const uint8_t* buffer,
+DatagramFace<T, U>::handleReceiveBatch(const boost::system::error_code& error)
+{
+  if (error)
+    return receiveDatagram(ndn::ConstBufferPtr(), 0, error);
+
+  if (static_cast<bool>(m_batch))
+    {
+      boost::system::error_code receiveError;
+      size_t nReceived = m_batch->receive(m_socket->native_handle(), receiveError);
+      if (receiveError && receiveError != boost::asio::error::would_block)
+        return receiveDatagram(ndn::ConstBufferPtr(), 0, receiveError);
+
+      NFD_LOG_DEBUG("handleReceiveBatch: " << nReceived);
+      this->beginReceiveBatch();
+      for (size_t i = 0; i < nReceived && this->isOpen(); ++i)
+        {
+          m_receiveSource.resize(m_batch->getSourceAddress(i, m_receiveSource.data(),
+                                                           m_receiveSource.capacity()));
+          receiveDatagram(m_batch->getBuffer(i), m_batch->getSize(i), receiveError);
+        }
+      this->endReceiveBatch();
+    }
+
+  if (this->isOpen())
+    this->startReceive();
+}
+
+template<class T, class U>
+inline void
+DatagramFace<T, U>::receiveDatagram(const ndn::ConstBufferPtr& buffer,
                                     size_t nBytesReceived,
                                     const boost::system::error_code& error)
 {
@@ -226,7 +496,7 @@ DatagramFace<T, U>::receiveDatagram(const uint8_t* buffer,
       return;
 
     // this should be unnecessary, but just in case
-    if (!m_socket->is_open()) {
+    if (!this->isOpen()) {
       fail("Tunnel closed");
       return;
     }
@@ -254,7 +524,7 @@ DatagramFace<T, U>::receiveDatagram(const uint8_t* buffer,
   this->getMutableCounters().getNInBytes() += nBytesReceived;
 
   Block element;
-  bool isOk = Block::fromBuffer(buffer, nBytesReceived, element);
+  bool isOk = parseReceivedElement(buffer, 0, nBytesReceived, element);
   if (!isOk)
     {
       NFD_LOG_WARN("[id:" << this->getId()
@@ -274,7 +544,7 @@ DatagramFace<T, U>::receiveDatagram(const uint8_t* buffer,
       return;
     }
 
-  if (!this->decodeAndDispatchInput(element))
+  if (!this->dispatchDatagram(element))
     {
       NFD_LOG_WARN("[id:" << this->getId()
                    << ",uri:" << this->getRemoteUri()
@@ -288,12 +558,33 @@ DatagramFace<T, U>::receiveDatagram(const uint8_t* buffer,
 }
 
 
+template<class T, class U>
+inline bool
+DatagramFace<T, U>::dispatchDatagram(const Block& element)
+{
+  return this->decodeAndDispatchInput(element);
+}
+
+template<class T, class U>
+inline const typename DatagramFace<T, U>::protocol::endpoint&
+DatagramFace<T, U>::getReceiveSource() const
+{
+  return m_receiveSource;
+}
+
 template<class T, class U>
 inline void
 DatagramFace<T, U>::keepFaceAliveUntilAllHandlersExecuted(const shared_ptr<Face>& face)
 {
 }
 
+template<class T, class U>
+inline bool
+DatagramFace<T, U>::isOpen() const
+{
+  return m_isSocketShared ? !m_isClosed : m_socket->is_open();
+}
+
 template<class T, class U>
 inline void
 DatagramFace<T, U>::closeSocket()
@@ -303,6 +594,15 @@ DatagramFace<T, U>::closeSocket()
                 << "] closeSocket");
 
   boost::asio::io_service& io = m_socket->get_io_service();
+  m_isClosed = true;
+
+  if (m_isSocketShared)
+    {
+      // other faces still use the socket
+      io.post(bind(&DatagramFace<T, U>::keepFaceAliveUntilAllHandlersExecuted,
+                   this, this->shared_from_this()));
+      return;
+    }
 
   // use the non-throwing variants and ignore errors, if any
   boost::system::error_code error;
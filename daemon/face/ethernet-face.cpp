@@ -26,6 +26,11 @@
 #include "ethernet-face.hpp"
 #include "core/logger.hpp"
 #include "core/network-interface.hpp"
+#include "core/scheduler.hpp"
+
+#ifdef HAVE_PACKET_MMAP
+#include "ethernet-packet-ring.hpp"
+#endif
 
 #include <pcap/pcap.h>
 
@@ -49,24 +54,43 @@ namespace nfd {
 
 NFD_LOG_INIT("EthernetFace");
 
+/// reassembly state of a sender is dropped after it has sent no fragment for this long
+static const time::seconds REASSEMBLER_LIFETIME(60);
+
 EthernetFace::EthernetFace(const shared_ptr<boost::asio::posix::stream_descriptor>& socket,
                            const shared_ptr<NetworkInterfaceInfo>& interface,
-                           const ethernet::Address& address)
+                           const ethernet::Address& address,
+                           Backend backend)
   : Face(FaceUri(address), FaceUri::fromDev(interface->name))
   , m_socket(socket)
   , m_interfaceName(interface->name)
   , m_srcAddress(interface->etherAddress)
   , m_destAddress(address)
+  , m_pcap(0)
+  , m_backend(backend)
+  , m_isFlushPending(false)
 {
   NFD_LOG_INFO("Creating ethernet face on " << m_interfaceName << ": "
                << m_srcAddress << " <--> " << m_destAddress);
-  pcapInit();
 
-  int fd = pcap_get_selectable_fd(m_pcap);
-  if (fd < 0)
-    throw Error("pcap_get_selectable_fd() failed");
+  int fd = -1;
+  if (m_backend == BACKEND_PACKET_MMAP)
+    {
+      ringInit();
+#ifdef HAVE_PACKET_MMAP
+      fd = m_ring->getReceiveFd();
+#endif
+    }
+  else
+    {
+      pcapInit();
+
+      fd = pcap_get_selectable_fd(m_pcap);
+      if (fd < 0)
+        throw Error("pcap_get_selectable_fd() failed");
+    }
 
-  // need to duplicate the fd, otherwise both pcap_close()
+  // need to duplicate the fd, otherwise both pcap_close() (or the ring)
   // and stream_descriptor::close() will try to close the
   // same fd and one of them will fail
   m_socket->assign(::dup(fd));
@@ -74,6 +98,8 @@ EthernetFace::EthernetFace(const shared_ptr<boost::asio::posix::stream_descripto
   m_interfaceMtu = getInterfaceMtu();
   NFD_LOG_DEBUG("[id:" << getId() << ",endpoint:" << m_interfaceName
                 << "] Interface MTU is: " << m_interfaceMtu);
+  m_slicer.reset(new ndnlp::Slicer(m_interfaceMtu));
+  m_frameBuffer.reserve(ethernet::HDR_LEN + std::max(m_interfaceMtu, ethernet::MIN_DATA_LEN));
 
   char filter[100];
   ::snprintf(filter, sizeof(filter),
@@ -93,6 +119,9 @@ EthernetFace::~EthernetFace()
 {
   onFail.clear(); // no reason to call onFail anymore
   close();
+
+  for (ReassemblerMap::iterator i = m_reassemblers.begin(); i != m_reassemblers.end(); ++i)
+    scheduler::cancel(i->second.expireEvent);
 }
 
 void
@@ -121,6 +150,40 @@ EthernetFace::close()
 
       fail("Face closed");
     }
+#ifdef HAVE_PACKET_MMAP
+  else if (m_ring)
+    {
+      boost::system::error_code error;
+      m_socket->close(error); // ignore errors
+      try
+        {
+          m_ring->flush();
+        }
+      catch (const EthernetPacketRing::Error&)
+        {
+          // ignore errors, frames still in the ring are lost
+        }
+      m_ring.reset();
+
+      fail("Face closed");
+    }
+#endif
+}
+
+bool
+EthernetFace::isPacketMmapSupported()
+{
+#ifdef HAVE_PACKET_MMAP
+  return true;
+#else
+  return false;
+#endif
+}
+
+bool
+EthernetFace::isOpen() const
+{
+  return m_pcap != 0 || static_cast<bool>(m_ring);
 }
 
 void
@@ -155,9 +218,46 @@ EthernetFace::pcapInit()
     NFD_LOG_WARN("pcap_setdirection(): " << pcap_geterr(m_pcap));
 }
 
+void
+EthernetFace::ringInit()
+{
+#ifdef HAVE_PACKET_MMAP
+  try
+    {
+      m_ring = make_shared<EthernetPacketRing>(m_interfaceName, ETHERTYPE_NDN);
+
+      // unlike the pcap backend, join the group instead of relying on promisc mode
+      if (!m_destAddress.isBroadcast())
+        m_ring->joinMulticastGroup(m_destAddress);
+    }
+  catch (const EthernetPacketRing::Error& e)
+    {
+      m_ring.reset();
+      throw Error(e.what());
+    }
+#else
+  throw Error("PACKET_MMAP backend is not available on this platform");
+#endif
+}
+
 void
 EthernetFace::setPacketFilter(const char* filterString)
 {
+#ifdef HAVE_PACKET_MMAP
+  if (m_ring)
+    {
+      try
+        {
+          m_ring->setPacketFilter(filterString);
+        }
+      catch (const EthernetPacketRing::Error& e)
+        {
+          throw Error(e.what());
+        }
+      return;
+    }
+#endif
+
   bpf_program filter;
   if (pcap_compile(m_pcap, &filter, filterString, 1, PCAP_NETMASK_UNKNOWN) < 0)
     throw Error("pcap_compile(): " + std::string(pcap_geterr(m_pcap)));
@@ -171,7 +271,7 @@ EthernetFace::setPacketFilter(const char* filterString)
 void
 EthernetFace::sendPacket(const ndn::Block& block)
 {
-  if (!m_pcap)
+  if (!isOpen())
     {
       NFD_LOG_WARN("[id:" << getId() << ",endpoint:" << m_interfaceName
                    << "] Trying to send on closed face");
@@ -179,99 +279,161 @@ EthernetFace::sendPacket(const ndn::Block& block)
       return;
     }
 
-  /// \todo Fragmentation
-  if (block.size() > m_interfaceMtu)
-    {
-      NFD_LOG_ERROR("[id:" << getId() << ",endpoint:" << m_interfaceName
-                    << "] Fragmentation not implemented: dropping packet larger than MTU");
-      return;
-    }
+  if (block.size() <= m_interfaceMtu)
+    return sendFrame(0, 0, block.wire(), block.size());
 
-  /// \todo Right now there is no reserve when packet is received, but
-  ///       we should reserve some space at the beginning and at the end
-  ndn::EncodingBuffer buffer(block);
-
-  // pad with zeroes if the payload is too short
-  if (block.size() < ethernet::MIN_DATA_LEN)
+  // fragment payloads are sent straight from the packet's wire encoding
+  const std::vector<ndnlp::Fragment>& fragments = m_slicer->sliceInPlace(block);
+  NFD_LOG_TRACE("[id:" << getId() << ",endpoint:" << m_interfaceName
+                << "] Sending " << block.size() << " bytes in "
+                << fragments.size() << " fragments");
+  for (std::vector<ndnlp::Fragment>::const_iterator i = fragments.begin();
+       i != fragments.end(); ++i)
     {
-      static const uint8_t padding[ethernet::MIN_DATA_LEN] = {0};
-      buffer.appendByteArray(padding, ethernet::MIN_DATA_LEN - block.size());
+      ++m_fragmentationCounters.getNOutFragments();
+      sendFrame(i->header, i->headerSize, i->payload, i->payloadSize);
     }
+}
 
-  // construct and prepend the ethernet header
-  static uint16_t ethertype = htons(ETHERTYPE_NDN);
-  buffer.prependByteArray(reinterpret_cast<const uint8_t*>(&ethertype), ethernet::TYPE_LEN);
-  buffer.prependByteArray(m_srcAddress.data(), m_srcAddress.size());
-  buffer.prependByteArray(m_destAddress.data(), m_destAddress.size());
+void
+EthernetFace::sendFrame(const uint8_t* header, size_t headerSize,
+                        const uint8_t* payload, size_t payloadSize)
+{
+  if (m_ring)
+    return sendFrameToRing(header, headerSize, payload, payloadSize);
+
+  // the frame is assembled in a buffer reused across packets,
+  // which stops growing once it fits the interface MTU
+  size_t length = headerSize + payloadSize;
+  m_frameBuffer.resize(ethernet::HDR_LEN + std::max(length, ethernet::MIN_DATA_LEN));
+  uint8_t* frame = &m_frameBuffer.front();
+  uint8_t* p = buildFrame(frame, header, headerSize, payload, payloadSize);
+  BOOST_ASSERT(static_cast<size_t>(p - frame) == m_frameBuffer.size());
 
   // send the packet
-  int sent = pcap_inject(m_pcap, buffer.buf(), buffer.size());
+  int sent = pcap_inject(m_pcap, frame, p - frame);
   if (sent < 0)
     {
       throw Error("pcap_inject(): " + std::string(pcap_geterr(m_pcap)));
     }
-  else if (static_cast<size_t>(sent) < buffer.size())
+  else if (sent < p - frame)
     {
       throw Error("Failed to send packet");
     }
 
   NFD_LOG_TRACE("[id:" << getId() << ",endpoint:" << m_interfaceName
-                << "] Successfully sent: " << block.size() << " bytes");
-  this->getMutableCounters().getNOutBytes() += block.size();
+                << "] Successfully sent: " << length << " bytes");
+  this->getMutableCounters().getNOutBytes() += length;
+}
+
+uint8_t*
+EthernetFace::buildFrame(uint8_t* frame, const uint8_t* header, size_t headerSize,
+                         const uint8_t* payload, size_t payloadSize) const
+{
+  static uint16_t ethertype = htons(ETHERTYPE_NDN);
+  uint8_t* p = std::copy(m_destAddress.begin(), m_destAddress.end(), frame);
+  p = std::copy(m_srcAddress.begin(), m_srcAddress.end(), p);
+  p = std::copy(reinterpret_cast<const uint8_t*>(&ethertype),
+                reinterpret_cast<const uint8_t*>(&ethertype) + ethernet::TYPE_LEN, p);
+  p = std::copy(header, header + headerSize, p);
+  p = std::copy(payload, payload + payloadSize, p);
+
+  // pad with zeroes if the payload is too short
+  if (headerSize + payloadSize < ethernet::MIN_DATA_LEN)
+    p = std::fill_n(p, ethernet::MIN_DATA_LEN - headerSize - payloadSize, 0);
+
+  return p;
 }
 
 void
-EthernetFace::handleRead(const boost::system::error_code& error, size_t)
+EthernetFace::sendFrameToRing(const uint8_t* header, size_t headerSize,
+                              const uint8_t* payload, size_t payloadSize)
 {
-  if (error)
-    return processErrorCode(error);
+#ifdef HAVE_PACKET_MMAP
+  // the frame is built in the transmit ring, saving the copy into a buffer
+  uint8_t* frame = m_ring->getTransmitSlot();
+  if (frame == 0)
+    {
+      NFD_LOG_WARN("[id:" << getId() << ",endpoint:" << m_interfaceName
+                   << "] Transmit ring is full: dropping packet");
+      return;
+    }
 
-  pcap_pkthdr* pktHeader;
-  const uint8_t* packet;
-  int ret = pcap_next_ex(m_pcap, &pktHeader, &packet);
-  if (ret < 0)
+  uint8_t* p = buildFrame(frame, header, headerSize, payload, payloadSize);
+  m_ring->commitTransmitSlot(p - frame);
+
+  // frames sent while handling the current event are flushed together
+  if (!m_isFlushPending)
+    {
+      m_isFlushPending = true;
+      m_socket->get_io_service().post(bind(&EthernetFace::flushRing, this,
+                                           this->shared_from_this()));
+    }
+
+  NFD_LOG_TRACE("[id:" << getId() << ",endpoint:" << m_interfaceName
+                << "] Queued: " << headerSize + payloadSize << " bytes");
+  this->getMutableCounters().getNOutBytes() += headerSize + payloadSize;
+#endif
+}
+
+void
+EthernetFace::flushRing(const shared_ptr<Face>& face)
+{
+#ifdef HAVE_PACKET_MMAP
+  m_isFlushPending = false;
+  if (!m_ring)
+    return;
+
+  try
     {
-      throw Error("pcap_next_ex(): " + std::string(pcap_geterr(m_pcap)));
+      size_t nFlushed = m_ring->flush();
+      NFD_LOG_TRACE("[id:" << getId() << ",endpoint:" << m_interfaceName
+                    << "] Flushed " << nFlushed << " frames");
     }
-  else if (ret == 0)
+  catch (const EthernetPacketRing::Error& e)
     {
       NFD_LOG_WARN("[id:" << getId() << ",endpoint:" << m_interfaceName
-                   << "] pcap_next_ex() timed out");
+                   << "] Send operation failed, closing face: " << e.what());
+      close();
+    }
+#endif
+}
+
+void
+EthernetFace::handleRead(const boost::system::error_code& error, size_t)
+{
+  if (error)
+    return processErrorCode(error);
+
+#ifdef HAVE_PACKET_MMAP
+  if (m_ring)
+    {
+      // every frame of the ready blocks is one batch
+      beginReceiveBatch();
+      const uint8_t* frame = 0;
+      size_t length = 0;
+      while (m_ring && m_ring->nextFrame(frame, length))
+        processFrame(frame, length);
+      endReceiveBatch();
     }
   else
+#endif
     {
-      size_t length = pktHeader->caplen;
-      if (length < ethernet::HDR_LEN + ethernet::MIN_DATA_LEN)
-        throw Error("Received packet is too short");
-
-      const ether_header* eh = reinterpret_cast<const ether_header*>(packet);
-      if (ntohs(eh->ether_type) != ETHERTYPE_NDN)
-        throw Error("Unrecognized ethertype");
-
-      packet += ethernet::HDR_LEN;
-      length -= ethernet::HDR_LEN;
-
-      /// \todo Reserve space in front and at the back
-      ///       of the underlying buffer
-      Block element;
-      bool isOk = Block::fromBuffer(packet, length, element);
-      if (isOk)
+      pcap_pkthdr* pktHeader;
+      const uint8_t* packet;
+      int ret = pcap_next_ex(m_pcap, &pktHeader, &packet);
+      if (ret < 0)
         {
-          NFD_LOG_TRACE("[id:" << getId() << ",endpoint:" << m_interfaceName
-                        << "] Received: " << element.size() << " bytes");
-          this->getMutableCounters().getNInBytes() += element.size();
-
-          if (!decodeAndDispatchInput(element))
-            {
-              NFD_LOG_WARN("[id:" << getId() << ",endpoint:" << m_interfaceName
-                           << "] Received unrecognized block of type " << element.type());
-              // ignore unknown packet
-            }
+          throw Error("pcap_next_ex(): " + std::string(pcap_geterr(m_pcap)));
         }
-      else
+      else if (ret == 0)
         {
           NFD_LOG_WARN("[id:" << getId() << ",endpoint:" << m_interfaceName
-                       << "] Received block is invalid or too large to process");
+                       << "] pcap_next_ex() timed out");
+        }
+      else
+        {
+          processFrame(packet, pktHeader->caplen);
         }
     }
 
@@ -281,6 +443,102 @@ EthernetFace::handleRead(const boost::system::error_code& error, size_t)
                                  boost::asio::placeholders::bytes_transferred));
 }
 
+void
+EthernetFace::processFrame(const uint8_t* packet, size_t length)
+{
+  if (length < ethernet::HDR_LEN + ethernet::MIN_DATA_LEN)
+    throw Error("Received packet is too short");
+
+  const ether_header* eh = reinterpret_cast<const ether_header*>(packet);
+  if (ntohs(eh->ether_type) != ETHERTYPE_NDN)
+    throw Error("Unrecognized ethertype");
+
+  packet += ethernet::HDR_LEN;
+  length -= ethernet::HDR_LEN;
+
+  /// \todo Reserve space in front and at the back
+  ///       of the underlying buffer
+  Block element;
+  bool isOk = Block::fromBuffer(packet, length, element);
+  if (isOk)
+    {
+      NFD_LOG_TRACE("[id:" << getId() << ",endpoint:" << m_interfaceName
+                    << "] Received: " << element.size() << " bytes");
+      this->getMutableCounters().getNInBytes() += element.size();
+
+      if (element.type() == tlv::NdnlpData)
+        {
+          ++m_fragmentationCounters.getNInFragments();
+          receiveFragment(ethernet::Address(eh->ether_shost), element);
+        }
+      else if (!decodeAndDispatchInput(element))
+        {
+          NFD_LOG_WARN("[id:" << getId() << ",endpoint:" << m_interfaceName
+                       << "] Received unrecognized block of type " << element.type());
+          // ignore unknown packet
+        }
+    }
+  else
+    {
+      NFD_LOG_WARN("[id:" << getId() << ",endpoint:" << m_interfaceName
+                   << "] Received block is invalid or too large to process");
+    }
+}
+
+void
+EthernetFace::receiveFragment(const ethernet::Address& source, const Block& fragment)
+{
+  // message identifiers are only unique per sender
+  Reassembler& reassembler = m_reassemblers[source];
+  if (!reassembler.pms)
+    {
+      reassembler.pms = make_shared<ndnlp::PartialMessageStore>();
+      reassembler.pms->onReceive += bind(&EthernetFace::receiveReassembled, this, _1);
+      reassembler.pms->onReassemblyTimeout += bind(&EthernetFace::countReassemblyTimeout, this);
+    }
+
+  scheduler::cancel(reassembler.expireEvent);
+  reassembler.expireEvent = scheduler::schedule(REASSEMBLER_LIFETIME,
+                              bind(&EthernetFace::removeReassembler, this, source));
+
+  try
+    {
+      reassembler.pms->receiveNdnlpData(fragment);
+    }
+  catch (const ndnlp::ParseError& e)
+    {
+      NFD_LOG_WARN("[id:" << getId() << ",endpoint:" << m_interfaceName
+                   << "] Received invalid NDNLP fragment from " << source << ": " << e.what());
+    }
+  catch (const ndn::Block::Error& e)
+    {
+      NFD_LOG_WARN("[id:" << getId() << ",endpoint:" << m_interfaceName
+                   << "] Reassembled packet from " << source << " is invalid: " << e.what());
+    }
+}
+
+void
+EthernetFace::receiveReassembled(const Block& packet)
+{
+  if (!decodeAndDispatchInput(packet))
+    {
+      NFD_LOG_WARN("[id:" << getId() << ",endpoint:" << m_interfaceName
+                   << "] Reassembled unrecognized block of type " << packet.type());
+    }
+}
+
+void
+EthernetFace::countReassemblyTimeout()
+{
+  ++m_fragmentationCounters.getNReassemblyTimeouts();
+}
+
+void
+EthernetFace::removeReassembler(const ethernet::Address& source)
+{
+  m_reassemblers.erase(source);
+}
+
 void
 EthernetFace::processErrorCode(const boost::system::error_code& error)
 {
@@ -288,7 +546,7 @@ EthernetFace::processErrorCode(const boost::system::error_code& error)
     // when socket is closed by someone
     return;
 
-  if (!m_pcap)
+  if (!isOpen())
     {
       fail("Face closed");
       return;
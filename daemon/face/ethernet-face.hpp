@@ -29,6 +29,8 @@
 #include "config.hpp"
 #include "ethernet.hpp"
 #include "face.hpp"
+#include "ndnlp-slicer.hpp"
+#include "ndnlp-partial-message-store.hpp"
 
 #ifndef HAVE_LIBPCAP
 #error "Cannot include this file when libpcap is not available"
@@ -41,6 +43,7 @@ typedef pcap pcap_t;
 namespace nfd {
 
 class NetworkInterfaceInfo;
+class EthernetPacketRing;
 
 /**
  * \brief Implementation of Face abstraction that uses raw
@@ -57,9 +60,21 @@ public:
     Error(const std::string& what) : Face::Error(what) {}
   };
 
+  /**
+   * \brief How frames are exchanged with the kernel
+   */
+  enum Backend {
+    /// libpcap, one frame per read and one pcap_inject() per sent frame
+    BACKEND_PCAP,
+    /// AF_PACKET socket with memory-mapped rings (Linux only, see EthernetPacketRing);
+    /// frames are received block by block and sent with one send() per batch
+    BACKEND_PACKET_MMAP
+  };
+
   EthernetFace(const shared_ptr<boost::asio::posix::stream_descriptor>& socket,
                const shared_ptr<NetworkInterfaceInfo>& interface,
-               const ethernet::Address& address);
+               const ethernet::Address& address,
+               Backend backend = BACKEND_PCAP);
 
   virtual
   ~EthernetFace();
@@ -81,20 +96,78 @@ public:
   virtual void
   close();
 
+  Backend
+  getBackend() const;
+
+  const FragmentationCounters&
+  getFragmentationCounters() const;
+
+  /**
+   * \return whether BACKEND_PACKET_MMAP is available on this platform
+   */
+  static bool
+  isPacketMmapSupported();
+
 private:
+  bool
+  isOpen() const;
+
   void
   pcapInit();
 
+  void
+  ringInit();
+
   void
   setPacketFilter(const char* filterString);
 
+  /**
+   * \brief send a packet, in NDNLP fragments if it is larger than the interface MTU
+   */
   void
   sendPacket(const ndn::Block& block);
 
+  /**
+   * \brief send one Ethernet frame whose payload is header followed by payload
+   */
+  void
+  sendFrame(const uint8_t* header, size_t headerSize,
+            const uint8_t* payload, size_t payloadSize);
+
+  void
+  sendFrameToRing(const uint8_t* header, size_t headerSize,
+                  const uint8_t* payload, size_t payloadSize);
+
+  /**
+   * \brief write Ethernet header, header, payload and padding into frame
+   * \return end of the frame
+   */
+  uint8_t*
+  buildFrame(uint8_t* frame, const uint8_t* header, size_t headerSize,
+             const uint8_t* payload, size_t payloadSize) const;
+
+  void
+  flushRing(const shared_ptr<Face>& face);
+
   void
   handleRead(const boost::system::error_code& error,
              size_t nBytesRead);
 
+  void
+  processFrame(const uint8_t* packet, size_t length);
+
+  void
+  receiveFragment(const ethernet::Address& source, const Block& fragment);
+
+  void
+  receiveReassembled(const Block& packet);
+
+  void
+  countReassemblyTimeout();
+
+  void
+  removeReassembler(const ethernet::Address& source);
+
   void
   processErrorCode(const boost::system::error_code& error);
 
@@ -102,14 +175,44 @@ private:
   getInterfaceMtu() const;
 
 private:
+  /**
+   * \brief reassembly state of one sender
+   */
+  struct Reassembler
+  {
+    shared_ptr<ndnlp::PartialMessageStore> pms;
+    EventId expireEvent;
+  };
+
+  typedef std::map<ethernet::Address, Reassembler> ReassemblerMap;
+
   shared_ptr<boost::asio::posix::stream_descriptor> m_socket;
   std::string m_interfaceName;
   ethernet::Address m_srcAddress;
   ethernet::Address m_destAddress;
   size_t m_interfaceMtu;
   pcap_t* m_pcap;
+  Backend m_backend;
+  shared_ptr<EthernetPacketRing> m_ring;
+  bool m_isFlushPending;
+  std::vector<uint8_t> m_frameBuffer;
+  scoped_ptr<ndnlp::Slicer> m_slicer;
+  ReassemblerMap m_reassemblers;
+  FragmentationCounters m_fragmentationCounters;
 };
 
+inline EthernetFace::Backend
+EthernetFace::getBackend() const
+{
+  return m_backend;
+}
+
+inline const FragmentationCounters&
+EthernetFace::getFragmentationCounters() const
+{
+  return m_fragmentationCounters;
+}
+
 } // namespace nfd
 
 #endif // NFD_DAEMON_FACE_ETHERNET_FACE_HPP
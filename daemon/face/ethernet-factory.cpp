@@ -35,6 +35,11 @@ namespace nfd {
 
 NFD_LOG_INIT("EthernetFactory");
 
+EthernetFactory::EthernetFactory()
+  : m_backend(EthernetFace::BACKEND_PCAP)
+{
+}
+
 shared_ptr<EthernetFace>
 EthernetFactory::createMulticastFace(const shared_ptr<NetworkInterfaceInfo> &interface,
                                      const ethernet::Address &address)
@@ -45,12 +50,19 @@ EthernetFactory::createMulticastFace(const shared_ptr<NetworkInterfaceInfo> &int
   const std::string& name = interface->name;
   shared_ptr<EthernetFace> face = findMulticastFace(name, address);
   if (face)
-    return face;
+    {
+      if (face->getBackend() == m_backend)
+        return face;
+
+      // the backend has been reconfigured, replace the face
+      face->close();
+      m_multicastFaces.erase(std::make_pair(name, address));
+    }
 
   shared_ptr<boost::asio::posix::stream_descriptor> socket =
     make_shared<boost::asio::posix::stream_descriptor>(ref(getGlobalIoService()));
 
-  face = make_shared<EthernetFace>(socket, interface, address);
+  face = make_shared<EthernetFace>(socket, interface, address, m_backend);
   face->onFail += bind(&EthernetFactory::afterFaceFailed,
                        this, name, address);
   m_multicastFaces[std::make_pair(name, address)] = face;
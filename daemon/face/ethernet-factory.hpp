@@ -52,6 +52,19 @@ public:
   typedef std::map< std::pair<std::string, ethernet::Address>,
                     shared_ptr<EthernetFace> > MulticastFaceMap;
 
+  EthernetFactory();
+
+  /**
+   * \brief Set the backend of faces created afterwards
+   *
+   * createMulticastFace() replaces an existing face that uses another backend.
+   */
+  void
+  setBackend(EthernetFace::Backend backend);
+
+  EthernetFace::Backend
+  getBackend() const;
+
   // from ProtocolFactory
   virtual void
   createFace(const FaceUri& uri,
@@ -105,8 +118,20 @@ private:
 
 private:
   MulticastFaceMap m_multicastFaces;
+  EthernetFace::Backend m_backend;
 };
 
+inline void
+EthernetFactory::setBackend(EthernetFace::Backend backend)
+{
+  m_backend = backend;
+}
+
+inline EthernetFace::Backend
+EthernetFactory::getBackend() const
+{
+  return m_backend;
+}
 
 inline const EthernetFactory::MulticastFaceMap&
 EthernetFactory::getMulticastFaces() const
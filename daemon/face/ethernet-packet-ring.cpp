@@ -0,0 +1,333 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ethernet-packet-ring.hpp"
+
+#include <pcap/pcap.h>
+
+#include <boost/static_assert.hpp>
+
+#include <cerrno>
+#include <cstring>              // for std::memcpy() and std::strerror()
+#include <arpa/inet.h>          // for htons()
+#include <linux/filter.h>       // for struct sock_fprog
+#include <linux/if_packet.h>    // for TPACKET_V2, TPACKET_V3 and struct packet_mreq
+#include <net/if.h>             // for if_nametoindex()
+#include <sys/mman.h>           // for mmap()
+#include <sys/socket.h>
+#include <unistd.h>             // for close()
+
+#if !defined(PCAP_NETMASK_UNKNOWN)
+#define PCAP_NETMASK_UNKNOWN    0xffffffff
+#endif
+
+namespace nfd {
+
+// Each receive block holds many frames; the kernel hands a block over when it is full
+// or when it has been open for RX_BLOCK_TIMEOUT milliseconds, which bounds the latency
+// added at low packet rates.
+static const unsigned int RX_BLOCK_SIZE = 1 << 18;
+static const unsigned int RX_N_BLOCKS = 16;
+static const unsigned int RX_FRAME_SIZE = 1 << 11;
+static const unsigned int RX_BLOCK_TIMEOUT = 1;
+
+// A transmit slot holds the tpacket2_hdr followed by a full-sized frame.
+static const unsigned int TX_FRAME_SIZE = 1 << 11;
+static const unsigned int TX_BLOCK_SIZE = 1 << 16;
+static const unsigned int TX_N_BLOCKS = 8;
+static const size_t TX_DATA_OFFSET = TPACKET_ALIGN(sizeof(tpacket2_hdr));
+
+static std::string
+makeErrorMessage(const std::string& function)
+{
+  return function + "(): " + std::strerror(errno);
+}
+
+static void
+setPacketOption(int fd, int option, int value)
+{
+  if (::setsockopt(fd, SOL_PACKET, option, &value, sizeof(value)) < 0)
+    throw EthernetPacketRing::Error(makeErrorMessage("setsockopt"));
+}
+
+static uint8_t*
+mapRing(int fd, size_t size)
+{
+  void* ring = ::mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (ring == MAP_FAILED)
+    throw EthernetPacketRing::Error(makeErrorMessage("mmap"));
+  return static_cast<uint8_t*>(ring);
+}
+
+static void
+bindToInterface(int fd, int ifIndex, uint16_t protocol)
+{
+  sockaddr_ll addr;
+  std::memset(&addr, 0, sizeof(addr));
+  addr.sll_family = AF_PACKET;
+  addr.sll_protocol = htons(protocol);
+  addr.sll_ifindex = ifIndex;
+
+  if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0)
+    throw EthernetPacketRing::Error(makeErrorMessage("bind"));
+}
+
+EthernetPacketRing::EthernetPacketRing(const std::string& interfaceName, uint16_t ethertype)
+  : m_rxFd(-1)
+  , m_txFd(-1)
+  , m_ifIndex(0)
+  , m_rxRing(0)
+  , m_rxRingSize(RX_BLOCK_SIZE * RX_N_BLOCKS)
+  , m_rxBlockSize(RX_BLOCK_SIZE)
+  , m_nRxBlocks(RX_N_BLOCKS)
+  , m_rxBlock(0)
+  , m_isRxBlockHeld(false)
+  , m_rxFrame(0)
+  , m_nRxFramesLeft(0)
+  , m_txRing(0)
+  , m_txRingSize(TX_BLOCK_SIZE * TX_N_BLOCKS)
+  , m_txFrameSize(TX_FRAME_SIZE)
+  , m_nTxFrames(TX_BLOCK_SIZE * TX_N_BLOCKS / TX_FRAME_SIZE)
+  , m_txFrame(0)
+  , m_nTxQueued(0)
+{
+  BOOST_STATIC_ASSERT(TX_DATA_OFFSET + ethernet::HDR_LEN + ethernet::MAX_DATA_LEN <=
+                      TX_FRAME_SIZE);
+
+  try
+    {
+      m_ifIndex = ::if_nametoindex(interfaceName.c_str());
+      if (m_ifIndex == 0)
+        throw Error(makeErrorMessage("if_nametoindex"));
+
+      // the receive ring is set up before bind(),
+      // so that no frame is queued on the socket's regular receive queue
+      m_rxFd = ::socket(AF_PACKET, SOCK_RAW, 0);
+      if (m_rxFd < 0)
+        throw Error(makeErrorMessage("socket"));
+
+      setPacketOption(m_rxFd, PACKET_VERSION, TPACKET_V3);
+
+      tpacket_req3 rxReq;
+      std::memset(&rxReq, 0, sizeof(rxReq));
+      rxReq.tp_block_size = RX_BLOCK_SIZE;
+      rxReq.tp_block_nr = RX_N_BLOCKS;
+      rxReq.tp_frame_size = RX_FRAME_SIZE;
+      rxReq.tp_frame_nr = RX_BLOCK_SIZE * RX_N_BLOCKS / RX_FRAME_SIZE;
+      rxReq.tp_retire_blk_tov = RX_BLOCK_TIMEOUT;
+      if (::setsockopt(m_rxFd, SOL_PACKET, PACKET_RX_RING, &rxReq, sizeof(rxReq)) < 0)
+        throw Error(makeErrorMessage("setsockopt"));
+
+      m_rxRing = mapRing(m_rxFd, m_rxRingSize);
+      bindToInterface(m_rxFd, m_ifIndex, ethertype);
+
+      // the transmit socket is bound to protocol 0, so that it receives nothing
+      m_txFd = ::socket(AF_PACKET, SOCK_RAW, 0);
+      if (m_txFd < 0)
+        throw Error(makeErrorMessage("socket"));
+
+      setPacketOption(m_txFd, PACKET_VERSION, TPACKET_V2);
+      // discard malformed frames instead of stopping the ring
+      setPacketOption(m_txFd, PACKET_LOSS, 1);
+
+      tpacket_req txReq;
+      std::memset(&txReq, 0, sizeof(txReq));
+      txReq.tp_block_size = TX_BLOCK_SIZE;
+      txReq.tp_block_nr = TX_N_BLOCKS;
+      txReq.tp_frame_size = TX_FRAME_SIZE;
+      txReq.tp_frame_nr = m_nTxFrames;
+      if (::setsockopt(m_txFd, SOL_PACKET, PACKET_TX_RING, &txReq, sizeof(txReq)) < 0)
+        throw Error(makeErrorMessage("setsockopt"));
+
+      m_txRing = mapRing(m_txFd, m_txRingSize);
+      bindToInterface(m_txFd, m_ifIndex, 0);
+    }
+  catch (const Error&)
+    {
+      close();
+      throw;
+    }
+}
+
+EthernetPacketRing::~EthernetPacketRing()
+{
+  close();
+}
+
+void
+EthernetPacketRing::close()
+{
+  if (m_rxRing != 0)
+    ::munmap(m_rxRing, m_rxRingSize);
+  if (m_txRing != 0)
+    ::munmap(m_txRing, m_txRingSize);
+  if (m_rxFd >= 0)
+    ::close(m_rxFd);
+  if (m_txFd >= 0)
+    ::close(m_txFd);
+
+  m_rxRing = m_txRing = 0;
+  m_rxFd = m_txFd = -1;
+}
+
+void
+EthernetPacketRing::joinMulticastGroup(const ethernet::Address& group)
+{
+  packet_mreq mreq;
+  std::memset(&mreq, 0, sizeof(mreq));
+  mreq.mr_ifindex = m_ifIndex;
+  mreq.mr_type = PACKET_MR_MULTICAST;
+  mreq.mr_alen = group.size();
+  std::memcpy(mreq.mr_address, group.data(), group.size());
+
+  if (::setsockopt(m_rxFd, SOL_PACKET, PACKET_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) < 0)
+    throw Error(makeErrorMessage("setsockopt"));
+}
+
+void
+EthernetPacketRing::setPacketFilter(const char* filterString)
+{
+  pcap_t* pcap = pcap_open_dead(DLT_EN10MB, RX_FRAME_SIZE);
+  if (pcap == 0)
+    throw Error("pcap_open_dead() failed");
+
+  bpf_program program;
+  if (pcap_compile(pcap, &program, filterString, 1, PCAP_NETMASK_UNKNOWN) < 0)
+    {
+      std::string msg = "pcap_compile(): " + std::string(pcap_geterr(pcap));
+      pcap_close(pcap);
+      throw Error(msg);
+    }
+  pcap_close(pcap);
+
+  // bpf_insn from libpcap has the same layout as the kernel's sock_filter
+  sock_fprog fprog;
+  fprog.len = program.bf_len;
+  fprog.filter = reinterpret_cast<sock_filter*>(program.bf_insns);
+
+  int ret = ::setsockopt(m_rxFd, SOL_SOCKET, SO_ATTACH_FILTER, &fprog, sizeof(fprog));
+  pcap_freecode(&program);
+  if (ret < 0)
+    throw Error(makeErrorMessage("setsockopt"));
+}
+
+bool
+EthernetPacketRing::nextFrame(const uint8_t*& frame, size_t& length)
+{
+  while (m_nRxFramesLeft == 0)
+    {
+      if (m_isRxBlockHeld)
+        releaseReceiveBlock();
+
+      tpacket_block_desc* block =
+        reinterpret_cast<tpacket_block_desc*>(m_rxRing + m_rxBlock * m_rxBlockSize);
+      const volatile uint32_t& status = block->hdr.bh1.block_status;
+      if ((status & TP_STATUS_USER) == 0)
+        return false;
+      __sync_synchronize(); // read the block only after its status
+
+      m_isRxBlockHeld = true;
+      m_nRxFramesLeft = block->hdr.bh1.num_pkts;
+      m_rxFrame = reinterpret_cast<uint8_t*>(block) + block->hdr.bh1.offset_to_first_pkt;
+    }
+
+  const tpacket3_hdr* header = reinterpret_cast<const tpacket3_hdr*>(m_rxFrame);
+  frame = m_rxFrame + header->tp_mac;
+  length = header->tp_snaplen;
+
+  m_rxFrame += header->tp_next_offset;
+  --m_nRxFramesLeft;
+  return true;
+}
+
+void
+EthernetPacketRing::releaseReceiveBlock()
+{
+  tpacket_block_desc* block =
+    reinterpret_cast<tpacket_block_desc*>(m_rxRing + m_rxBlock * m_rxBlockSize);
+  __sync_synchronize(); // finish reading the block before returning it
+  block->hdr.bh1.block_status = TP_STATUS_KERNEL;
+
+  m_isRxBlockHeld = false;
+  m_rxBlock = (m_rxBlock + 1) % m_nRxBlocks;
+}
+
+uint8_t*
+EthernetPacketRing::getTransmitSlot()
+{
+  tpacket2_hdr* header = reinterpret_cast<tpacket2_hdr*>(m_txRing + m_txFrame * m_txFrameSize);
+  const volatile uint32_t& status = header->tp_status;
+  if (status != TP_STATUS_AVAILABLE)
+    {
+      flush();
+      if (status != TP_STATUS_AVAILABLE)
+        return 0;
+    }
+  __sync_synchronize();
+
+  return reinterpret_cast<uint8_t*>(header) + TX_DATA_OFFSET;
+}
+
+size_t
+EthernetPacketRing::getTransmitSlotSize() const
+{
+  return m_txFrameSize - TX_DATA_OFFSET;
+}
+
+void
+EthernetPacketRing::commitTransmitSlot(size_t length)
+{
+  BOOST_ASSERT(length <= getTransmitSlotSize());
+
+  tpacket2_hdr* header = reinterpret_cast<tpacket2_hdr*>(m_txRing + m_txFrame * m_txFrameSize);
+  header->tp_len = length;
+  __sync_synchronize(); // publish the frame before its status
+  header->tp_status = TP_STATUS_SEND_REQUEST;
+
+  m_txFrame = (m_txFrame + 1) % m_nTxFrames;
+  ++m_nTxQueued;
+}
+
+size_t
+EthernetPacketRing::flush()
+{
+  if (m_nTxQueued == 0)
+    return 0;
+
+  if (::send(m_txFd, 0, 0, MSG_DONTWAIT) < 0)
+    {
+      if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS)
+        // frames stay queued in the ring until the next flush
+        return 0;
+
+      throw Error(makeErrorMessage("send"));
+    }
+
+  size_t nFlushed = m_nTxQueued;
+  m_nTxQueued = 0;
+  return nFlushed;
+}
+
+} // namespace nfd
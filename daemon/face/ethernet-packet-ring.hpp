@@ -0,0 +1,163 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FACE_ETHERNET_PACKET_RING_HPP
+#define NFD_DAEMON_FACE_ETHERNET_PACKET_RING_HPP
+
+#include "common.hpp"
+#include "core/ethernet.hpp"
+
+#ifndef HAVE_PACKET_MMAP
+#error "Cannot include this file when PACKET_MMAP is not available"
+#endif
+
+namespace nfd {
+
+/** \brief a raw AF_PACKET socket pair with memory-mapped receive and transmit rings
+ *
+ *  Frames are received from a TPACKET_V3 ring, in which the kernel fills whole blocks
+ *  of frames and hands them over at once, so that one wakeup yields many frames.
+ *  Frames are sent by writing them into a TPACKET_V2 ring and then flushing
+ *  every queued frame with one send() call.
+ *  The rings live on two sockets, because a socket has one PACKET_VERSION
+ *  and TPACKET_V3 transmit rings are not available on older kernels.
+ */
+class EthernetPacketRing : noncopyable
+{
+public:
+  struct Error : public std::runtime_error
+  {
+    Error(const std::string& what) : std::runtime_error(what) {}
+  };
+
+  /** \brief open the sockets and map the rings
+   *  \param interfaceName local network interface
+   *  \param ethertype frames of other Ethertypes are not received
+   *  \throw Error
+   */
+  EthernetPacketRing(const std::string& interfaceName, uint16_t ethertype);
+
+  ~EthernetPacketRing();
+
+  /** \return the receive socket, which becomes readable when a block of frames is ready
+   */
+  int
+  getReceiveFd() const;
+
+  /** \brief receive frames addressed to a multicast group, without promiscuous mode
+   *  \throw Error
+   */
+  void
+  joinMulticastGroup(const ethernet::Address& group);
+
+  /** \brief attach a classic BPF program to the receive socket
+   *  \param filterString a filter in pcap-filter(7) syntax
+   *  \throw Error
+   */
+  void
+  setPacketFilter(const char* filterString);
+
+  /** \brief get the next received frame
+   *  \param[out] frame the frame, including the Ethernet header; valid until the next call
+   *  \param[out] length length of frame
+   *  \return false if no more frames are ready; the last block is returned to the kernel
+   */
+  bool
+  nextFrame(const uint8_t*& frame, size_t& length);
+
+  /** \return the free space of the next transmit slot, or 0 if the ring is full
+   *
+   *  A full ring is flushed once before giving up.
+   */
+  uint8_t*
+  getTransmitSlot();
+
+  /** \return capacity of a transmit slot, which is at least
+   *          ethernet::HDR_LEN + ethernet::MAX_DATA_LEN
+   */
+  size_t
+  getTransmitSlotSize() const;
+
+  /** \brief queue the frame written into the slot returned by getTransmitSlot()
+   */
+  void
+  commitTransmitSlot(size_t length);
+
+  /** \brief hand every queued frame to the kernel with one send() call
+   *  \return number of frames queued before the call
+   *  \throw Error if send() fails for a reason other than congestion
+   */
+  size_t
+  flush();
+
+  /** \return number of queued frames not yet flushed
+   */
+  size_t
+  getNQueued() const;
+
+private:
+  void
+  close();
+
+  void
+  releaseReceiveBlock();
+
+private:
+  int m_rxFd;
+  int m_txFd;
+  int m_ifIndex;
+
+  uint8_t* m_rxRing;
+  size_t m_rxRingSize;
+  size_t m_rxBlockSize;
+  size_t m_nRxBlocks;
+  size_t m_rxBlock;     ///< index of the block being read or waited for
+  bool m_isRxBlockHeld; ///< whether m_rxBlock belongs to user space
+  uint8_t* m_rxFrame;   ///< next frame in m_rxBlock
+  size_t m_nRxFramesLeft;
+
+  uint8_t* m_txRing;
+  size_t m_txRingSize;
+  size_t m_txFrameSize;
+  size_t m_nTxFrames;
+  size_t m_txFrame;     ///< index of the next transmit slot
+  size_t m_nTxQueued;
+};
+
+inline int
+EthernetPacketRing::getReceiveFd() const
+{
+  return m_rxFd;
+}
+
+inline size_t
+EthernetPacketRing::getNQueued() const
+{
+  return m_nTxQueued;
+}
+
+} // namespace nfd
+
+#endif // NFD_DAEMON_FACE_ETHERNET_PACKET_RING_HPP
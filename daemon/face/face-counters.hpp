@@ -246,6 +246,58 @@ public:
   }
 };
 
+/** \brief contains NDNLP counters of a face that fragments packets larger than its MTU
+ *
+ *  These counters are not part of FaceStatus.
+ */
+class FragmentationCounters : noncopyable
+{
+public:
+  /// sent NDNLP fragments
+  const PacketCounter&
+  getNOutFragments() const
+  {
+    return m_nOutFragments;
+  }
+
+  PacketCounter&
+  getNOutFragments()
+  {
+    return m_nOutFragments;
+  }
+
+  /// received NDNLP fragments
+  const PacketCounter&
+  getNInFragments() const
+  {
+    return m_nInFragments;
+  }
+
+  PacketCounter&
+  getNInFragments()
+  {
+    return m_nInFragments;
+  }
+
+  /// partially received packets dropped because their other fragments did not arrive in time
+  const PacketCounter&
+  getNReassemblyTimeouts() const
+  {
+    return m_nReassemblyTimeouts;
+  }
+
+  PacketCounter&
+  getNReassemblyTimeouts()
+  {
+    return m_nReassemblyTimeouts;
+  }
+
+private:
+  PacketCounter m_nOutFragments;
+  PacketCounter m_nInFragments;
+  PacketCounter m_nReassemblyTimeouts;
+};
+
 } // namespace nfd
 
 #endif // NFD_DAEMON_FACE_FACE_COUNTERS_HPP
@@ -36,6 +36,7 @@ Face::Face(const FaceUri& remoteUri, const FaceUri& localUri, bool isLocal)
   , m_localUri(localUri)
   , m_isOnDemand(false)
   , m_isFailed(false)
+  , m_isReceivingBatch(false)
 {
   onReceiveInterest += bind(&PacketCounter::operator++, &m_counters.getNInInterests());
   onReceiveData     += bind(&PacketCounter::operator++, &m_counters.getNInDatas());
@@ -112,6 +113,39 @@ Face::decodeAndDispatchInput(const Block& element)
   }
 }
 
+BufferPool&
+Face::getReceiveBufferPool()
+{
+  static BufferPool pool(MAX_NDN_PACKET_SIZE, 256);
+  return pool;
+}
+
+bool
+Face::parseReceivedElement(const ndn::ConstBufferPtr& buffer, size_t offset, size_t size,
+                           Block& element)
+{
+  BOOST_ASSERT(offset <= size && size <= buffer->size());
+
+  ndn::Buffer::const_iterator begin = buffer->begin() + offset;
+  ndn::Buffer::const_iterator end = buffer->begin() + size;
+  ndn::Buffer::const_iterator pos = begin;
+
+  uint64_t type = 0;
+  uint64_t length = 0;
+  if (!tlv::readVarNumber(pos, end, type) ||
+      !tlv::readVarNumber(pos, end, length) ||
+      length > static_cast<uint64_t>(end - pos))
+    return false;
+
+  element = Block(buffer, begin, pos + length, false);
+
+  // an Interest leaves the PIT soon, but a Data may stay in the ContentStore
+  if (type != tlv::Interest && element.size() * 4 < buffer->size())
+    element = Block(element.wire(), element.size());
+
+  return true;
+}
+
 void
 Face::fail(const std::string& reason)
 {
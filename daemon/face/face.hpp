@@ -29,6 +29,7 @@
 #include "common.hpp"
 #include "core/event-emitter.hpp"
 #include "core/face-uri.hpp"
+#include "core/buffer-pool.hpp"
 #include "face-counters.hpp"
 
 #include <ndn-cxx/management/nfd-face-status.hpp>
@@ -56,6 +57,12 @@ const FaceId FACEID_RESERVED_MAX = 255;
 /// pratical limit of packet size in octets
 const size_t MAX_NDN_PACKET_SIZE = 8800;
 
+/// Interests received together, processed by Forwarder::onInterestBatch
+typedef std::vector<shared_ptr<Interest> > InterestBatch;
+
+/// Data received together, processed by Forwarder::onDataBatch
+typedef std::vector<shared_ptr<Data> > DataBatch;
+
 
 /** \brief represents a face
  */
@@ -95,6 +102,15 @@ public:
   /// fires when face disconnects or fails to perform properly
   EventEmitter<std::string/*reason*/> onFail;
 
+  /** \brief fires after the packets of one receive batch have been received
+   *
+   *  Between beginReceiveBatch() and endReceiveBatch(), onReceiveInterest and
+   *  onReceiveData still fire for every packet, and isReceivingBatch() is true;
+   *  a subscriber may collect those packets and process them together
+   *  when this event fires.
+   */
+  EventEmitter<> afterReceiveBatch;
+
   /// send an Interest
   virtual void
   sendInterest(const Interest& interest) = 0;
@@ -150,6 +166,11 @@ public: // attributes
   bool
   isOnDemand() const;
 
+  /** \brief Get whether packets are being received as a batch
+   */
+  bool
+  isReceivingBatch() const;
+
   const FaceCounters&
   getCounters() const;
 
@@ -168,6 +189,11 @@ public: // attributes
   virtual ndn::nfd::FaceStatus
   getFaceStatus() const;
 
+  /** \return the pool of MAX_NDN_PACKET_SIZE buffers that faces receive into
+   */
+  static BufferPool&
+  getReceiveBufferPool();
+
 protected:
   // this is a non-virtual method
   bool
@@ -179,11 +205,36 @@ protected:
   void
   setOnDemand(bool isOnDemand);
 
+  /** \brief mark the start of a batch, typically before decoding the packets of one read
+   */
+  void
+  beginReceiveBatch();
+
+  /** \brief mark the end of a batch, and raise afterReceiveBatch event
+   */
+  void
+  endReceiveBatch();
+
   /** \brief fail the face and raise onFail event if it's UP; otherwise do nothing
    */
   void
   fail(const std::string& reason);
 
+  /** \brief parse a TLV element from a receive buffer without copying it
+   *  \param buffer receive buffer
+   *  \param offset position of the element in buffer
+   *  \param size number of valid octets in buffer
+   *  \param[out] element the parsed element, which references buffer
+   *  \return true if a complete element is found
+   *
+   *  Packets decoded from element share the receive buffer.
+   *  A Data or other element that is small relative to the buffer is copied instead,
+   *  so that long-lived entries such as cached Data do not hold a whole receive buffer.
+   */
+  static bool
+  parseReceivedElement(const ndn::ConstBufferPtr& buffer, size_t offset, size_t size,
+                       Block& element);
+
 private:
   void
   setId(FaceId faceId);
@@ -197,6 +248,7 @@ private:
   FaceUri m_localUri;
   bool m_isOnDemand;
   bool m_isFailed;
+  bool m_isReceivingBatch;
 
   // allow setting FaceId
   friend class FaceTable;
@@ -245,6 +297,25 @@ Face::isOnDemand() const
   return m_isOnDemand;
 }
 
+inline bool
+Face::isReceivingBatch() const
+{
+  return m_isReceivingBatch;
+}
+
+inline void
+Face::beginReceiveBatch()
+{
+  m_isReceivingBatch = true;
+}
+
+inline void
+Face::endReceiveBatch()
+{
+  m_isReceivingBatch = false;
+  this->afterReceiveBatch();
+}
+
 } // namespace nfd
 
 #endif // NFD_DAEMON_FACE_FACE_HPP
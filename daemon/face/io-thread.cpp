@@ -0,0 +1,90 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "io-thread.hpp"
+
+#include <sys/socket.h>
+#include <cerrno>
+
+namespace nfd {
+
+IoThread::IoThread()
+{
+}
+
+IoThread::~IoThread()
+{
+  this->stop();
+}
+
+void
+IoThread::start()
+{
+  m_work.reset(new boost::asio::io_service::work(m_ioService));
+  m_thread = boost::thread(bind(&IoThread::run, this));
+}
+
+void
+IoThread::stop()
+{
+  if (!m_thread.joinable())
+    return;
+
+  m_work.reset();
+  m_ioService.stop();
+  m_thread.join();
+}
+
+void
+IoThread::run()
+{
+  m_ioService.run();
+}
+
+bool
+isReusePortSupported()
+{
+#ifdef SO_REUSEPORT
+  return true;
+#else
+  return false;
+#endif // SO_REUSEPORT
+}
+
+void
+setReusePort(int nativeHandle)
+{
+#ifdef SO_REUSEPORT
+  const int value = 1;
+  if (::setsockopt(nativeHandle, SOL_SOCKET, SO_REUSEPORT, &value, sizeof(value)) < 0)
+    throw boost::system::system_error(errno, boost::system::system_category(),
+                                      "cannot set SO_REUSEPORT");
+#else
+  throw boost::system::system_error(boost::asio::error::operation_not_supported,
+                                    "SO_REUSEPORT is not supported");
+#endif // SO_REUSEPORT
+}
+
+} // namespace nfd
@@ -0,0 +1,91 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FACE_IO_THREAD_HPP
+#define NFD_DAEMON_FACE_IO_THREAD_HPP
+
+#include "common.hpp"
+
+#include <boost/thread/thread.hpp>
+
+namespace nfd {
+
+/** \brief a thread running its own io_service, which services the sockets of
+ *         one listen queue of a channel
+ *
+ *  Handlers running in this thread must not touch faces or forwarding tables;
+ *  they post their results to the main io_service instead.
+ */
+class IoThread : noncopyable
+{
+public:
+  IoThread();
+
+  /** \brief stop and join the thread
+   */
+  ~IoThread();
+
+  boost::asio::io_service&
+  getIoService();
+
+  void
+  start();
+
+  /** \brief stop and join the thread; pending handlers are not invoked
+   */
+  void
+  stop();
+
+private:
+  void
+  run();
+
+private:
+  boost::asio::io_service m_ioService;
+  scoped_ptr<boost::asio::io_service::work> m_work;
+  boost::thread m_thread;
+};
+
+inline boost::asio::io_service&
+IoThread::getIoService()
+{
+  return m_ioService;
+}
+
+/** \return whether SO_REUSEPORT is available, so that several sockets
+ *          can bind the same endpoint and the kernel spreads flows across them
+ */
+bool
+isReusePortSupported();
+
+/** \brief set SO_REUSEPORT on socket, before it is bound
+ *  \throw boost::system::system_error on failure, or if SO_REUSEPORT is unavailable
+ */
+void
+setReusePort(int nativeHandle);
+
+} // namespace nfd
+
+#endif // NFD_DAEMON_FACE_IO_THREAD_HPP
@@ -24,6 +24,7 @@
  */
 
 #include "multicast-udp-face.hpp"
+#include "core/scheduler.hpp"
 
 namespace nfd {
 
@@ -31,6 +32,9 @@ NFD_LOG_INCLASS_2TEMPLATE_SPECIALIZATION_DEFINE(DatagramFace,
                                                 MulticastUdpFace::protocol, Multicast,
                                                 "MulticastUdpFace");
 
+/// reassembly state of a sender is dropped after it has sent no fragment for this long
+static const time::seconds REASSEMBLER_LIFETIME(60);
+
 MulticastUdpFace::MulticastUdpFace(const shared_ptr<MulticastUdpFace::protocol::socket>& recvSocket,
                                    const shared_ptr<MulticastUdpFace::protocol::socket>& sendSocket,
                                    const MulticastUdpFace::protocol::endpoint& localEndpoint,
@@ -39,9 +43,18 @@ MulticastUdpFace::MulticastUdpFace(const shared_ptr<MulticastUdpFace::protocol::
                                       FaceUri(localEndpoint),
                                       recvSocket, false)
   , m_multicastGroup(multicastEndpoint)
-  , m_sendSocket(sendSocket)
 {
+  this->setSendDestination(sendSocket, multicastEndpoint);
   NFD_LOG_INFO("Creating multicast UDP face for group " << m_multicastGroup);
+
+  // Ethernet MTU less IPv4 or IPv6 header and UDP header
+  this->setMtu(multicastEndpoint.address().is_v4() ? 1472 : 1452);
+}
+
+MulticastUdpFace::~MulticastUdpFace()
+{
+  for (ReassemblerMap::iterator i = m_reassemblers.begin(); i != m_reassemblers.end(); ++i)
+    scheduler::cancel(i->second.expireEvent);
 }
 
 const MulticastUdpFace::protocol::endpoint&
@@ -51,11 +64,10 @@ MulticastUdpFace::getMulticastGroup() const
 }
 
 void
-MulticastUdpFace::sendBlock(const Block& block)
+MulticastUdpFace::setMtu(size_t mtu)
 {
-  m_sendSocket->async_send_to(boost::asio::buffer(block.wire(), block.size()),
-                              m_multicastGroup,
-                              bind(&MulticastUdpFace::handleSend, this, _1, _2, block));
+  m_mtu = mtu;
+  m_slicer.reset(new ndnlp::Slicer(mtu));
 }
 
 void
@@ -64,7 +76,7 @@ MulticastUdpFace::sendInterest(const Interest& interest)
   onSendInterest(interest);
 
   NFD_LOG_DEBUG("Sending interest");
-  sendBlock(interest.wireEncode());
+  sendPacket(interest.wireEncode());
 }
 
 void
@@ -75,7 +87,7 @@ MulticastUdpFace::sendData(const Data& data)
   onSendData(data);
 
   NFD_LOG_DEBUG("Sending data");
-  sendBlock(data.wireEncode());
+  sendPacket(data.wireEncode());
 }
 
 bool
@@ -84,4 +96,81 @@ MulticastUdpFace::isMultiAccess() const
   return true;
 }
 
+void
+MulticastUdpFace::sendPacket(const Block& block)
+{
+  if (block.size() <= m_mtu)
+    return sendBlock(block);
+
+  ndnlp::PacketArray fragments = m_slicer->slice(block);
+  NFD_LOG_TRACE("Sending " << block.size() << " bytes in " << fragments->size() << " fragments");
+  for (std::vector<Block>::const_iterator i = fragments->begin(); i != fragments->end(); ++i)
+    {
+      ++m_fragmentationCounters.getNOutFragments();
+      sendBlock(*i);
+    }
+}
+
+bool
+MulticastUdpFace::dispatchDatagram(const Block& element)
+{
+  if (element.type() != tlv::NdnlpData)
+    return this->decodeAndDispatchInput(element);
+
+  ++m_fragmentationCounters.getNInFragments();
+
+  // message identifiers are only unique per sender
+  const protocol::endpoint& source = this->getReceiveSource();
+  Reassembler& reassembler = m_reassemblers[source];
+  if (!reassembler.pms)
+    {
+      reassembler.pms = make_shared<ndnlp::PartialMessageStore>();
+      reassembler.pms->onReceive += bind(&MulticastUdpFace::receiveReassembled, this, _1);
+      reassembler.pms->onReassemblyTimeout += bind(&MulticastUdpFace::countReassemblyTimeout,
+                                                   this);
+    }
+
+  scheduler::cancel(reassembler.expireEvent);
+  reassembler.expireEvent = scheduler::schedule(REASSEMBLER_LIFETIME,
+                              bind(&MulticastUdpFace::removeReassembler, this, source));
+
+  try
+    {
+      reassembler.pms->receiveNdnlpData(element);
+    }
+  catch (const ndnlp::ParseError& e)
+    {
+      NFD_LOG_WARN("[id:" << this->getId() << ",uri:" << this->getRemoteUri()
+                   << "] Received invalid NDNLP fragment from " << source << ": " << e.what());
+    }
+  catch (const ndn::Block::Error& e)
+    {
+      NFD_LOG_WARN("[id:" << this->getId() << ",uri:" << this->getRemoteUri()
+                   << "] Reassembled packet from " << source << " is invalid: " << e.what());
+    }
+  return true;
+}
+
+void
+MulticastUdpFace::receiveReassembled(const Block& packet)
+{
+  if (!this->decodeAndDispatchInput(packet))
+    {
+      NFD_LOG_WARN("[id:" << this->getId() << ",uri:" << this->getRemoteUri()
+                   << "] Reassembled unrecognized block of type " << packet.type());
+    }
+}
+
+void
+MulticastUdpFace::countReassemblyTimeout()
+{
+  ++m_fragmentationCounters.getNReassemblyTimeouts();
+}
+
+void
+MulticastUdpFace::removeReassembler(const protocol::endpoint& source)
+{
+  m_reassemblers.erase(source);
+}
+
 } // namespace nfd
@@ -27,6 +27,8 @@
 #define NFD_DAEMON_FACE_MULTICAST_UDP_FACE_HPP
 
 #include "datagram-face.hpp"
+#include "ndnlp-slicer.hpp"
+#include "ndnlp-partial-message-store.hpp"
 
 namespace nfd {
 
@@ -45,9 +47,27 @@ public:
                    const protocol::endpoint& localEndpoint,
                    const protocol::endpoint& multicastEndpoint);
 
+  virtual
+  ~MulticastUdpFace();
+
   const protocol::endpoint&
   getMulticastGroup() const;
 
+  /**
+   * \brief Set the largest datagram sent unfragmented
+   *
+   * Larger packets are sent in NDNLP fragments. The default is an Ethernet MTU
+   * less the IP and UDP headers, so that IP does not fragment datagrams.
+   */
+  void
+  setMtu(size_t mtu);
+
+  size_t
+  getMtu() const;
+
+  const FragmentationCounters&
+  getFragmentationCounters() const;
+
   // from Face
   virtual void
   sendInterest(const Interest& interest);
@@ -58,15 +78,55 @@ public:
   virtual bool
   isMultiAccess() const;
 
+protected:
+  // from DatagramFace
+  virtual bool
+  dispatchDatagram(const Block& element);
+
 private:
   void
-  sendBlock(const Block& block);
+  sendPacket(const Block& block);
+
+  void
+  receiveReassembled(const Block& packet);
+
+  void
+  countReassemblyTimeout();
+
+  void
+  removeReassembler(const protocol::endpoint& source);
 
 private:
+  /**
+   * \brief reassembly state of one sender
+   */
+  struct Reassembler
+  {
+    shared_ptr<ndnlp::PartialMessageStore> pms;
+    EventId expireEvent;
+  };
+
+  typedef std::map<protocol::endpoint, Reassembler> ReassemblerMap;
+
   protocol::endpoint m_multicastGroup;
-  shared_ptr<protocol::socket> m_sendSocket;
+  size_t m_mtu;
+  scoped_ptr<ndnlp::Slicer> m_slicer;
+  ReassemblerMap m_reassemblers;
+  FragmentationCounters m_fragmentationCounters;
 };
 
+inline size_t
+MulticastUdpFace::getMtu() const
+{
+  return m_mtu;
+}
+
+inline const FragmentationCounters&
+MulticastUdpFace::getFragmentationCounters() const
+{
+  return m_fragmentationCounters;
+}
+
 } // namespace nfd
 
 #endif // NFD_DAEMON_FACE_MULTICAST_UDP_FACE_HPP
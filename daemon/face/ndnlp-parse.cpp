@@ -88,5 +88,107 @@ NdnlpData::wireDecode(const Block& wire)
   }
 }
 
+static void
+readVarNumber(const uint8_t*& pos, const uint8_t* end, uint64_t& number)
+{
+  if (pos == end) {
+    throw ParseError("truncated TLV");
+  }
+
+  uint8_t first = *pos++;
+  size_t size = first < 253 ? 0 : first == 253 ? 2 : first == 254 ? 4 : 8;
+  if (static_cast<size_t>(end - pos) < size) {
+    throw ParseError("truncated TLV");
+  }
+
+  number = size == 0 ? first : 0;
+  for (size_t i = 0; i < size; ++i) {
+    number = (number << 8) | *pos++;
+  }
+}
+
+/** \brief read the TLV-TYPE and TLV-LENGTH of the next element
+ *  \return TLV-VALUE of the element, which pos is moved past
+ */
+static const uint8_t*
+readElement(const uint8_t*& pos, const uint8_t* end, uint64_t expectedType, size_t& length)
+{
+  uint64_t type = 0;
+  uint64_t tlvLength = 0;
+  readVarNumber(pos, end, type);
+  readVarNumber(pos, end, tlvLength);
+  if (type != expectedType) {
+    throw ParseError("unexpected element in NdnlpData");
+  }
+  if (tlvLength > static_cast<uint64_t>(end - pos)) {
+    throw ParseError("truncated TLV");
+  }
+
+  const uint8_t* value = pos;
+  length = static_cast<size_t>(tlvLength);
+  pos += length;
+  return value;
+}
+
+static uint16_t
+readFragField(const uint8_t* value, size_t length)
+{
+  if (length != 1 && length != 2 && length != 4 && length != 8) {
+    throw ParseError("NonNegativeInteger has incorrect length");
+  }
+
+  uint64_t number = 0;
+  for (size_t i = 0; i < length; ++i) {
+    number = (number << 8) | value[i];
+  }
+  if (number > std::numeric_limits<uint16_t>::max()) {
+    throw ParseError("NdnlpFragIndex or NdnlpFragCount is too large");
+  }
+  return static_cast<uint16_t>(number);
+}
+
+void
+NdnlpDataHeader::wireDecode(const Block& wire)
+{
+  if (wire.type() != tlv::NdnlpData) {
+    throw ParseError("top element is not NdnlpData");
+  }
+
+  const uint8_t* begin = wire.wire();
+  const uint8_t* pos = &*wire.value_begin();
+  const uint8_t* end = pos + wire.value_size();
+
+  size_t length = 0;
+  const uint8_t* value = readElement(pos, end, tlv::NdnlpSequence, length);
+  if (length != sizeof(uint64_t)) {
+    throw ParseError("NdnlpSequence element has incorrect length");
+  }
+  m_seq = 0;
+  for (size_t i = 0; i < sizeof(uint64_t); ++i) {
+    m_seq = (m_seq << 8) | value[i];
+  }
+
+  if (pos != end && *pos == tlv::NdnlpFragIndex) {
+    value = readElement(pos, end, tlv::NdnlpFragIndex, length);
+    m_fragIndex = readFragField(value, length);
+    value = readElement(pos, end, tlv::NdnlpFragCount, length);
+    m_fragCount = readFragField(value, length);
+    if (m_fragIndex >= m_fragCount) {
+      throw ParseError("NdnlpFragIndex must be less than NdnlpFragCount");
+    }
+  }
+  else { // single wire packet
+    m_fragIndex = 0;
+    m_fragCount = 1;
+  }
+
+  value = readElement(pos, end, tlv::NdnlpPayload, length);
+  if (pos != end) {
+    throw ParseError("NdnlpData element has incorrect number of children");
+  }
+  m_payloadOffset = value - begin;
+  m_payloadSize = length;
+}
+
 } // namespace ndnlp
 } // namespace nfd
@@ -64,6 +64,30 @@ public:
   Block m_payload;
 };
 
+/** \brief represents the header fields of a NdnlpData packet and the position of its payload
+ *
+ *  Unlike NdnlpData, decoding walks the wire encoding directly instead of parsing
+ *  the packet into sub-elements, so that it does not allocate.
+ */
+class NdnlpDataHeader
+{
+public:
+  /** \brief decode a NdnlpData packet
+   *
+   *  \exception ParseError packet is malformated
+   */
+  void
+  wireDecode(const Block& wire);
+
+public:
+  uint64_t m_seq;
+  uint16_t m_fragIndex;
+  uint16_t m_fragCount;
+  /// offset of NdnlpPayload TLV-VALUE from the beginning of the NdnlpData wire encoding
+  size_t m_payloadOffset;
+  size_t m_payloadSize;
+};
+
 } // namespace ndnlp
 } // namespace nfd
 
@@ -27,110 +27,226 @@
 namespace nfd {
 namespace ndnlp {
 
-PartialMessage::PartialMessage()
-  : m_fragCount(0)
-  , m_received(0)
-  , m_totalLength(0)
-{
-}
+const size_t PartialMessageStore::MAX_FRAGMENTS;
 
-bool
-PartialMessage::add(uint16_t fragIndex, uint16_t fragCount, const Block& payload)
-{
-  if (m_received == 0) { // first packet
-    m_fragCount = fragCount;
-    m_payloads.resize(fragCount);
-  }
+/// marks an unused position in the hash table
+static const size_t EMPTY_POSITION = std::numeric_limits<size_t>::max();
 
-  if (m_fragCount != fragCount || fragIndex >= m_fragCount) {
-    return false;
+PartialMessageStore::PartialMessageStore(const time::nanoseconds& idleDuration, size_t nSlots)
+  : m_idleDuration(idleDuration)
+  , m_slots(std::max<size_t>(nSlots, 1))
+  , m_tableBits(1)
+  , m_isSweepScheduled(false)
+{
+  m_freeSlots.reserve(m_slots.size());
+  for (size_t i = m_slots.size(); i > 0; --i) {
+    m_slots[i - 1].isUsed = false;
+    m_freeSlots.push_back(i - 1);
   }
 
-  if (!m_payloads[fragIndex].empty()) { // duplicate
-    return false;
+  while ((static_cast<size_t>(1) << m_tableBits) < m_slots.size() * 2) {
+    ++m_tableBits;
   }
-
-  m_payloads[fragIndex] = payload;
-  ++m_received;
-  m_totalLength += payload.value_size();
-  return true;
+  m_table.resize(static_cast<size_t>(1) << m_tableBits, EMPTY_POSITION);
 }
 
-bool
-PartialMessage::isComplete() const
+PartialMessageStore::~PartialMessageStore()
 {
-  return m_received == m_fragCount;
+  // sweep event refers to this store
+  if (m_isSweepScheduled) {
+    scheduler::cancel(m_sweepEvent);
+  }
 }
 
-Block
-PartialMessage::reassemble()
+void
+PartialMessageStore::receiveNdnlpData(const Block& pkt)
 {
-  BOOST_ASSERT(this->isComplete());
+  NdnlpDataHeader parsed;
+  parsed.wireDecode(pkt);
+  if (parsed.m_fragCount == 1) { // single fragment
+    NdnlpData single;
+    single.wireDecode(pkt);
+    this->onReceive(single.m_payload.blockFromValue());
+    return;
+  }
+  if (parsed.m_fragCount > MAX_FRAGMENTS) {
+    throw ParseError("NdnlpFragCount exceeds reassembly capacity");
+  }
+
+  uint64_t messageIdentifier = parsed.m_seq - parsed.m_fragIndex;
+  size_t slotIndex = this->findOrAllocate(messageIdentifier);
+  Slot& slot = m_slots[slotIndex];
+  slot.lastActivity = time::steady_clock::now();
+  this->scheduleSweep(m_idleDuration);
 
-  ndn::BufferPtr buffer = make_shared<ndn::Buffer>(m_totalLength);
+  if (slot.nReceived == 0) { // first packet
+    slot.fragCount = parsed.m_fragCount;
+  }
+  if (slot.fragCount != parsed.m_fragCount ||
+      !slot.fragments[parsed.m_fragIndex].empty()) { // mismatch or duplicate
+    return;
+  }
+
+  slot.fragments[parsed.m_fragIndex] = pkt;
+  slot.payloadOffsets[parsed.m_fragIndex] = parsed.m_payloadOffset;
+  slot.payloadSizes[parsed.m_fragIndex] = parsed.m_payloadSize;
+  slot.totalLength += parsed.m_payloadSize;
+  if (++slot.nReceived < slot.fragCount) {
+    return;
+  }
+
+  // reassemble network layer packet
+  ndn::BufferPtr buffer = make_shared<ndn::Buffer>(slot.totalLength);
   uint8_t* buf = buffer->get();
-  for (std::vector<Block>::const_iterator it = m_payloads.begin();
-       it != m_payloads.end(); ++it) {
-    const Block& payload = *it;
-    memcpy(buf, payload.value(), payload.value_size());
-    buf += payload.value_size();
+  for (uint16_t fragIndex = 0; fragIndex < slot.fragCount; ++fragIndex) {
+    memcpy(buf, slot.fragments[fragIndex].wire() + slot.payloadOffsets[fragIndex],
+           slot.payloadSizes[fragIndex]);
+    buf += slot.payloadSizes[fragIndex];
   }
+  this->release(slotIndex);
 
-  return Block(buffer);
+  this->onReceive(Block(buffer));
 }
 
-PartialMessageStore::PartialMessageStore(const time::nanoseconds& idleDuration)
-  : m_idleDuration(idleDuration)
+size_t
+PartialMessageStore::findOrAllocate(uint64_t messageIdentifier)
 {
+  size_t position = this->findPosition(messageIdentifier);
+  if (position != m_table.size()) {
+    return m_table[position];
+  }
+
+  if (m_freeSlots.empty()) {
+    this->evictOldest();
+  }
+  size_t slotIndex = m_freeSlots.back();
+  m_freeSlots.pop_back();
+
+  Slot& slot = m_slots[slotIndex];
+  slot.isUsed = true;
+  slot.messageIdentifier = messageIdentifier;
+  slot.fragCount = 0;
+  slot.nReceived = 0;
+  slot.totalLength = 0;
+
+  size_t mask = m_table.size() - 1;
+  for (position = this->getHomePosition(messageIdentifier);
+       m_table[position] != EMPTY_POSITION; position = (position + 1) & mask) {
+  }
+  m_table[position] = slotIndex;
+  return slotIndex;
 }
 
-PartialMessageStore::~PartialMessageStore()
+void
+PartialMessageStore::release(size_t slotIndex)
 {
+  Slot& slot = m_slots[slotIndex];
+  BOOST_ASSERT(slot.isUsed);
+
+  this->erasePosition(this->findPosition(slot.messageIdentifier));
+  for (uint16_t fragIndex = 0; fragIndex < slot.fragCount; ++fragIndex) {
+    slot.fragments[fragIndex] = Block();
+  }
+  slot.isUsed = false;
+  m_freeSlots.push_back(slotIndex);
 }
 
 void
-PartialMessageStore::receiveNdnlpData(const Block& pkt)
+PartialMessageStore::evictOldest()
 {
-  NdnlpData parsed;
-  parsed.wireDecode(pkt);
-  if (parsed.m_fragCount == 1) { // single fragment
-    this->onReceive(parsed.m_payload.blockFromValue());
-    return;
+  size_t oldest = m_slots.size();
+  for (size_t i = 0; i < m_slots.size(); ++i) {
+    if (m_slots[i].isUsed &&
+        (oldest == m_slots.size() || m_slots[i].lastActivity < m_slots[oldest].lastActivity)) {
+      oldest = i;
+    }
   }
+  BOOST_ASSERT(oldest != m_slots.size());
 
-  uint64_t messageIdentifier = parsed.m_seq - parsed.m_fragIndex;
-  shared_ptr<PartialMessage> pm = m_partialMessages[messageIdentifier];
-  if (!static_cast<bool>(pm)) {
-    m_partialMessages[messageIdentifier] = pm = make_shared<PartialMessage>();
-  }
-  this->scheduleCleanup(messageIdentifier, pm);
+  this->release(oldest);
+  this->onReassemblyTimeout();
+}
 
-  pm->add(parsed.m_fragIndex, parsed.m_fragCount, parsed.m_payload);
-  if (pm->isComplete()) {
-    this->onReceive(pm->reassemble());
-    this->cleanup(messageIdentifier);
+size_t
+PartialMessageStore::getHomePosition(uint64_t messageIdentifier) const
+{
+  // Fibonacci hashing: sequence numbers are consecutive, so spread them with a multiplication
+  return static_cast<size_t>((messageIdentifier * 0x9E3779B97F4A7C15ULL) >> (64 - m_tableBits));
+}
+
+size_t
+PartialMessageStore::findPosition(uint64_t messageIdentifier) const
+{
+  size_t mask = m_table.size() - 1;
+  for (size_t position = this->getHomePosition(messageIdentifier);
+       m_table[position] != EMPTY_POSITION; position = (position + 1) & mask) {
+    if (m_slots[m_table[position]].messageIdentifier == messageIdentifier) {
+      return position;
+    }
   }
+  return m_table.size();
 }
 
 void
-PartialMessageStore::scheduleCleanup(uint64_t messageIdentifier,
-                                     shared_ptr<PartialMessage> partialMessage)
+PartialMessageStore::erasePosition(size_t position)
 {
-  partialMessage->m_expiry = scheduler::schedule(m_idleDuration,
-    bind(&PartialMessageStore::cleanup, this, messageIdentifier));
+  BOOST_ASSERT(position < m_table.size());
+  size_t mask = m_table.size() - 1;
+
+  // backward shift deletion keeps probe sequences unbroken without tombstones
+  size_t hole = position;
+  for (size_t next = (hole + 1) & mask; m_table[next] != EMPTY_POSITION;
+       next = (next + 1) & mask) {
+    size_t home = this->getHomePosition(m_slots[m_table[next]].messageIdentifier);
+    // entry at next stays if its home is cyclically within (hole, next]
+    bool canStay = hole <= next ? (hole < home && home <= next) : (hole < home || home <= next);
+    if (!canStay) {
+      m_table[hole] = m_table[next];
+      hole = next;
+    }
+  }
+  m_table[hole] = EMPTY_POSITION;
 }
 
 void
-PartialMessageStore::cleanup(uint64_t messageIdentifier)
+PartialMessageStore::scheduleSweep(const time::nanoseconds& delay)
 {
-  std::map<uint64_t, shared_ptr<PartialMessage> >::iterator it =
-    m_partialMessages.find(messageIdentifier);
-  if (it == m_partialMessages.end()) {
+  if (m_isSweepScheduled) {
     return;
   }
+  m_sweepEvent = scheduler::schedule(delay, bind(&PartialMessageStore::sweep, this));
+  m_isSweepScheduled = true;
+}
 
-  scheduler::cancel(it->second->m_expiry);
-  m_partialMessages.erase(it);
+void
+PartialMessageStore::sweep()
+{
+  m_isSweepScheduled = false;
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+
+  size_t nExpired = 0;
+  time::steady_clock::TimePoint nextDeadline = time::steady_clock::TimePoint::max();
+  for (size_t i = 0; i < m_slots.size(); ++i) {
+    if (!m_slots[i].isUsed) {
+      continue;
+    }
+    time::steady_clock::TimePoint deadline = m_slots[i].lastActivity + m_idleDuration;
+    if (deadline <= now) {
+      this->release(i);
+      ++nExpired;
+    }
+    else {
+      nextDeadline = std::min(nextDeadline, deadline);
+    }
+  }
+
+  if (nextDeadline != time::steady_clock::TimePoint::max()) {
+    this->scheduleSweep(nextDeadline - now);
+  }
+
+  for (size_t i = 0; i < nExpired; ++i) {
+    this->onReassemblyTimeout();
+  }
 }
 
 } // namespace ndnlp
@@ -26,80 +26,133 @@
 #define NFD_DAEMON_FACE_NDNLP_PARTIAL_MESSAGE_STORE_HPP
 
 #include "ndnlp-parse.hpp"
+#include "ndnlp-slicer.hpp"
 #include "core/event-emitter.hpp"
 #include "core/scheduler.hpp"
 
 namespace nfd {
 namespace ndnlp {
 
-/** \brief represents a partially received message
- */
-class PartialMessage : noncopyable
-{
-public:
-  PartialMessage();
-
-  bool
-  add(uint16_t fragIndex, uint16_t fragCount, const Block& payload);
-
-  bool
-  isComplete() const;
-
-  /** \brief reassemble network layer packet
-   *
-   *  isComplete() must be true before calling this method
-   *
-   *  \exception ndn::Block::Error packet is malformated
-   *  \return network layer packet
-   */
-  Block
-  reassemble();
-
-public:
-  EventId m_expiry;
-
-private:
-  size_t m_fragCount;
-  size_t m_received;
-  std::vector<Block> m_payloads;
-  size_t m_totalLength;
-};
-
 /** \brief provides reassembly feature at receiver
+ *
+ *  Partial messages are kept in a fixed number of preallocated slots, which are found
+ *  through an open-addressed hash table keyed by message identifier.
+ *  A slot refers to received fragments instead of copying their payloads,
+ *  so that a message is copied only once, when it is reassembled.
+ *  A single scheduler event expires all messages idle for idleDuration;
+ *  when every slot is in use, the message idle for the longest time is dropped.
  */
 class PartialMessageStore : noncopyable
 {
 public:
   explicit
-  PartialMessageStore(const time::nanoseconds& idleDuration = time::milliseconds(100));
+  PartialMessageStore(const time::nanoseconds& idleDuration = time::milliseconds(100),
+                      size_t nSlots = 16);
 
   virtual
   ~PartialMessageStore();
 
   /** \brief receive a NdnlpData packet
    *
-   *  \exception ParseError NDNLP packet is malformated
+   *  \exception ParseError NDNLP packet is malformated,
+   *                        or has more than MAX_FRAGMENTS fragments
    *  \exception ndn::Block::Error network layer packet is malformated
    */
   void
   receiveNdnlpData(const Block& pkt);
 
+  /// \return number of partially received messages
+  size_t
+  size() const;
+
   /// fires when network layer packet is received
   EventEmitter<Block> onReceive;
 
+  /** \brief fires when a partially received packet is dropped
+   *
+   *  This happens after idleDuration, or when its slot is taken by a new message.
+   */
+  EventEmitter<> onReassemblyTimeout;
+
+  /// maximum number of fragments in a message, as many as Slicer may send
+  static const size_t MAX_FRAGMENTS = Slicer::MAX_FRAGMENTS;
+
 private:
+  /** \brief a partially received message
+   */
+  struct Slot
+  {
+    bool isUsed;
+    uint64_t messageIdentifier;
+    uint16_t fragCount;
+    uint16_t nReceived;
+    size_t totalLength;
+    time::steady_clock::TimePoint lastActivity;
+
+    /// received NdnlpData packets; empty Block if not received yet
+    Block fragments[MAX_FRAGMENTS];
+    size_t payloadOffsets[MAX_FRAGMENTS];
+    size_t payloadSizes[MAX_FRAGMENTS];
+  };
+
+  /** \return index of the slot used by messageIdentifier,
+   *          or a newly allocated slot if there is none
+   */
+  size_t
+  findOrAllocate(uint64_t messageIdentifier);
+
   void
-  scheduleCleanup(uint64_t messageIdentifier, shared_ptr<PartialMessage> partialMessage);
+  release(size_t slotIndex);
 
+  /// drop the message idle for the longest time
   void
-  cleanup(uint64_t messageIdentifier);
+  evictOldest();
 
-private:
-  std::map<uint64_t, shared_ptr<PartialMessage> > m_partialMessages;
+  size_t
+  getHomePosition(uint64_t messageIdentifier) const;
 
+  /** \return position of messageIdentifier in m_table, or m_table.size() if not found
+   */
+  size_t
+  findPosition(uint64_t messageIdentifier) const;
+
+  void
+  erasePosition(size_t position);
+
+  /** \brief schedule sweep if it is not already scheduled
+   */
+  void
+  scheduleSweep(const time::nanoseconds& delay);
+
+  /** \brief drop messages that have been idle for idleDuration
+   */
+  void
+  sweep();
+
+private:
   time::nanoseconds m_idleDuration;
+
+  std::vector<Slot> m_slots;
+  std::vector<size_t> m_freeSlots;
+
+  /** \brief open-addressed hash table from message identifier to slot index
+   *
+   *  Its size is a power of two at least twice the number of slots;
+   *  collisions are resolved by linear probing.
+   */
+  std::vector<size_t> m_table;
+  int m_tableBits;
+
+  EventId m_sweepEvent;
+  bool m_isSweepScheduled;
 };
 
+inline size_t
+PartialMessageStore::size() const
+{
+  return m_slots.size() - m_freeSlots.size();
+}
+
 } // namespace ndnlp
 } // namespace nfd
 
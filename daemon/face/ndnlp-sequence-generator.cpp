@@ -23,6 +23,9 @@
  **/
 
 #include "ndnlp-sequence-generator.hpp"
+#include "core/random.hpp"
+
+#include <boost/random/uniform_int_distribution.hpp>
 
 namespace nfd {
 namespace ndnlp {
@@ -34,8 +37,9 @@ SequenceBlock::SequenceBlock(uint64_t start, size_t count)
 }
 
 SequenceGenerator::SequenceGenerator()
-  : m_next(0)
 {
+  static boost::random::uniform_int_distribution<uint64_t> dist;
+  m_next = dist(getGlobalRng());
 }
 
 SequenceBlock
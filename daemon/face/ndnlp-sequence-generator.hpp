@@ -70,6 +70,11 @@ SequenceBlock::count() const
 class SequenceGenerator : noncopyable
 {
 public:
+  /** \brief start from a random sequence number
+   *
+   *  A sender that restarts is thus unlikely to reuse the message identifiers
+   *  of fragments that receivers still hold.
+   */
   SequenceGenerator();
 
   /** \brief generates a block of consecutive sequence numbers
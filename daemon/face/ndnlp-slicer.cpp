@@ -23,12 +23,19 @@
  **/
 
 #include "ndnlp-slicer.hpp"
+#include "core/logger.hpp"
 
 #include <ndn-cxx/encoding/encoding-buffer.hpp>
 
 namespace nfd {
 namespace ndnlp {
 
+NFD_LOG_INIT("NdnlpSlicer");
+
+const size_t Slicer::MAX_HEADER_SIZE;
+const size_t Slicer::MIN_MTU;
+const size_t Slicer::MAX_FRAGMENTS;
+
 Slicer::Slicer(size_t mtu)
   : m_mtu(mtu)
 {
@@ -106,6 +113,12 @@ Slicer::slice(const Block& block)
                          (networkPacketSize % m_maxPayload == 0 ? 0 : 1)
                        );
   PacketArray pa = make_shared<std::vector<Block> >();
+  if (fragCount > MAX_FRAGMENTS) {
+    NFD_LOG_WARN("Dropping " << networkPacketSize << "-octet packet: needs " << fragCount
+                 << " fragments with MTU " << m_mtu << ", at most " << MAX_FRAGMENTS
+                 << " can be reassembled");
+    return pa;
+  }
   pa->reserve(fragCount);
   SequenceBlock seqBlock = m_seqgen.nextBlock(fragCount);
 
@@ -126,5 +139,134 @@ Slicer::slice(const Block& block)
   return pa;
 }
 
+static inline size_t
+Slicer_sizeOfVarNumber(uint64_t number)
+{
+  return number < 253 ? 1 : number <= 0xFFFF ? 3 : 5;
+}
+
+static inline uint8_t*
+Slicer_writeVarNumber(uint8_t* pos, uint64_t number)
+{
+  if (number < 253) {
+    *pos++ = static_cast<uint8_t>(number);
+  }
+  else if (number <= 0xFFFF) {
+    *pos++ = 253;
+    *pos++ = static_cast<uint8_t>(number >> 8);
+    *pos++ = static_cast<uint8_t>(number);
+  }
+  else {
+    *pos++ = 254;
+    for (int shift = 24; shift >= 0; shift -= 8) {
+      *pos++ = static_cast<uint8_t>(number >> shift);
+    }
+  }
+  return pos;
+}
+
+/// size of NonNegativeInteger encoding of a 16-bit value
+static inline size_t
+Slicer_sizeOfFragField(uint16_t value)
+{
+  return value <= 0xFF ? 1 : 2;
+}
+
+static inline uint8_t*
+Slicer_writeFragField(uint8_t* pos, uint32_t type, uint16_t value)
+{
+  *pos++ = static_cast<uint8_t>(type);
+  if (value <= 0xFF) {
+    *pos++ = 1;
+  }
+  else {
+    *pos++ = 2;
+    *pos++ = static_cast<uint8_t>(value >> 8);
+  }
+  *pos++ = static_cast<uint8_t>(value);
+  return pos;
+}
+
+/** \brief write the NDNLP header of a fragment
+ *
+ *  The result is identical to the octets Slicer_encodeFragment places before the payload.
+ *  \return header size
+ */
+static size_t
+Slicer_writeHeader(uint8_t* header,
+                   uint64_t seq, uint16_t fragIndex, uint16_t fragCount, size_t payloadSize)
+{
+  bool needFragIndexAndCount = fragCount > 1;
+  size_t valueLength = 2 + sizeof(uint64_t) +
+                       1 + Slicer_sizeOfVarNumber(payloadSize) + payloadSize;
+  if (needFragIndexAndCount) {
+    valueLength += 2 + Slicer_sizeOfFragField(fragIndex) +
+                   2 + Slicer_sizeOfFragField(fragCount);
+  }
+
+  uint8_t* pos = header;
+  // NdnlpData
+  pos = Slicer_writeVarNumber(pos, tlv::NdnlpData);
+  pos = Slicer_writeVarNumber(pos, valueLength);
+
+  // NdnlpSequence
+  *pos++ = tlv::NdnlpSequence;
+  *pos++ = sizeof(uint64_t);
+  for (int shift = 56; shift >= 0; shift -= 8) {
+    *pos++ = static_cast<uint8_t>(seq >> shift);
+  }
+
+  if (needFragIndexAndCount) {
+    pos = Slicer_writeFragField(pos, tlv::NdnlpFragIndex, fragIndex);
+    pos = Slicer_writeFragField(pos, tlv::NdnlpFragCount, fragCount);
+  }
+
+  // NdnlpPayload, up to TLV-VALUE
+  *pos++ = tlv::NdnlpPayload;
+  pos = Slicer_writeVarNumber(pos, payloadSize);
+
+  BOOST_ASSERT(static_cast<size_t>(pos - header) <= Slicer::MAX_HEADER_SIZE);
+  return pos - header;
+}
+
+const std::vector<Fragment>&
+Slicer::sliceInPlace(const Block& block)
+{
+  BOOST_ASSERT(block.hasWire());
+  const uint8_t* networkPacket = block.wire();
+  size_t networkPacketSize = block.size();
+
+  uint16_t fragCount = static_cast<uint16_t>(
+                         (networkPacketSize / m_maxPayload) +
+                         (networkPacketSize % m_maxPayload == 0 ? 0 : 1)
+                       );
+  if (fragCount > MAX_FRAGMENTS) {
+    NFD_LOG_WARN("Dropping " << networkPacketSize << "-octet packet: needs " << fragCount
+                 << " fragments with MTU " << m_mtu << ", at most " << MAX_FRAGMENTS
+                 << " can be reassembled");
+    m_fragments.clear();
+    return m_fragments;
+  }
+  // resize never shrinks capacity, so steady state sending does not allocate
+  m_headers.resize(fragCount * MAX_HEADER_SIZE);
+  m_fragments.resize(fragCount);
+  SequenceBlock seqBlock = m_seqgen.nextBlock(fragCount);
+
+  for (uint16_t fragIndex = 0; fragIndex < fragCount; ++fragIndex) {
+    size_t payloadOffset = fragIndex * m_maxPayload;
+    Fragment& fragment = m_fragments[fragIndex];
+    fragment.payload = networkPacket + payloadOffset;
+    fragment.payloadSize = std::min(m_maxPayload, networkPacketSize - payloadOffset);
+    fragment.header = &m_headers[fragIndex * MAX_HEADER_SIZE];
+    fragment.headerSize = Slicer_writeHeader(&m_headers[fragIndex * MAX_HEADER_SIZE],
+                                             seqBlock[fragIndex], fragIndex, fragCount,
+                                             fragment.payloadSize);
+
+    BOOST_ASSERT(fragment.headerSize + fragment.payloadSize <= m_mtu);
+  }
+
+  return m_fragments;
+}
+
 } // namespace ndnlp
 } // namespace nfd
@@ -33,6 +33,18 @@ namespace ndnlp {
 
 typedef shared_ptr<std::vector<Block> > PacketArray;
 
+/** \brief a NDNLP fragment whose payload refers into the network layer packet
+ *
+ *  The fragment on the wire is the header followed by the payload.
+ */
+struct Fragment
+{
+  const uint8_t* header;
+  size_t headerSize;
+  const uint8_t* payload;
+  size_t payloadSize;
+};
+
 /** \brief provides fragmentation feature at sender
  */
 class Slicer : noncopyable
@@ -44,9 +56,37 @@ public:
   virtual
   ~Slicer();
 
+  /** \return fragments, or none if block needs more than MAX_FRAGMENTS fragments
+   */
   PacketArray
   slice(const Block& block);
 
+  /** \brief slice a network layer packet without copying its payload
+   *
+   *  Only the NDNLP headers are encoded, into storage owned by this Slicer;
+   *  payloads point into the wire encoding of block.
+   *  Once the Slicer has seen a packet of the largest size, this does not allocate.
+   *
+   *  \return fragments, valid until the next call and as long as block's buffer lives;
+   *          none if block needs more than MAX_FRAGMENTS fragments
+   */
+  const std::vector<Fragment>&
+  sliceInPlace(const Block& block);
+
+  /// maximum size of a NDNLP header written by sliceInPlace
+  static const size_t MAX_HEADER_SIZE = 32;
+
+  /// smallest MTU with which any network layer packet fits in MAX_FRAGMENTS fragments
+  static const size_t MIN_MTU = 576;
+
+  /** \brief maximum number of fragments in a message
+   *
+   *  Receivers must be able to reassemble this many fragments;
+   *  a packet that needs more is dropped by the sender.
+   */
+  static const size_t MAX_FRAGMENTS = (ndn::MAX_NDN_PACKET_SIZE + MIN_MTU - MAX_HEADER_SIZE - 1) /
+                                      (MIN_MTU - MAX_HEADER_SIZE);
+
 private:
   /// estimate the size of NDNLP header and maximum payload size per packet
   void
@@ -60,6 +100,12 @@ private:
 
   /// maximum payload size
   size_t m_maxPayload;
+
+  /// headers encoded by sliceInPlace, MAX_HEADER_SIZE octets per fragment
+  std::vector<uint8_t> m_headers;
+
+  /// fragments returned by sliceInPlace
+  std::vector<Fragment> m_fragments;
 };
 
 } // namespace ndnlp
@@ -35,6 +35,9 @@ namespace nfd {
 // forward declaration
 template<class T, class U, class V> struct StreamFaceSenderImpl;
 
+/// default limit of octets gathered into one write on a stream face
+const size_t DEFAULT_STREAM_MAX_WRITE_SIZE = 65536;
+
 template<class Protocol, class FaceBase = Face>
 class StreamFace : public FaceBase
 {
@@ -61,6 +64,17 @@ public:
   virtual void
   close();
 
+  /** \brief set the limit of octets gathered into one write
+   *
+   *  Queued packets are sent together in one gathered write, as long as their total
+   *  size is within this limit. A packet larger than the limit is written alone.
+   */
+  void
+  setMaxWriteSize(size_t maxWriteSize);
+
+  size_t
+  getMaxWriteSize() const;
+
 protected:
   void
   processErrorCode(const boost::system::error_code& error);
@@ -86,9 +100,13 @@ protected:
   shared_ptr<typename protocol::socket> m_socket;
 
 private:
-  uint8_t m_inputBuffer[MAX_NDN_PACKET_SIZE];
+  /// received octets, shared with the packets decoded from them
+  shared_ptr<ndn::Buffer> m_inputBuffer;
   size_t m_inputBufferSize;
-  std::queue<Block> m_sendQueue;
+  /// packets to send; the first m_nBlocksInWrite are being written
+  std::deque<Block> m_sendQueue;
+  size_t m_nBlocksInWrite;
+  size_t m_maxWriteSize;
 
   friend struct StreamFaceSenderImpl<Protocol, FaceBase, Interest>;
   friend struct StreamFaceSenderImpl<Protocol, FaceBase, Data>;
@@ -124,11 +142,14 @@ StreamFace<T, FaceBase>::StreamFace(const FaceUri& remoteUri, const FaceUri& loc
                 bool isOnDemand)
   : FaceBase(remoteUri, localUri)
   , m_socket(socket)
+  , m_inputBuffer(Face::getReceiveBufferPool().allocate())
   , m_inputBufferSize(0)
+  , m_nBlocksInWrite(0)
+  , m_maxWriteSize(DEFAULT_STREAM_MAX_WRITE_SIZE)
 {
   FaceBase::setOnDemand(isOnDemand);
   StreamFaceValidator<T, FaceBase>::validateSocket(*socket);
-  m_socket->async_receive(boost::asio::buffer(m_inputBuffer, MAX_NDN_PACKET_SIZE), 0,
+  m_socket->async_receive(boost::asio::buffer(&m_inputBuffer->front(), MAX_NDN_PACKET_SIZE), 0,
                           bind(&StreamFace<T, FaceBase>::handleReceive, this, _1, _2));
 }
 
@@ -145,7 +166,7 @@ struct StreamFaceSenderImpl
   send(StreamFace<Protocol, FaceBase>& face, const Packet& packet)
   {
     bool wasQueueEmpty = face.m_sendQueue.empty();
-    face.m_sendQueue.push(packet.wireEncode());
+    face.m_sendQueue.push_back(packet.wireEncode());
 
     if (wasQueueEmpty)
       face.sendFromQueue();
@@ -163,9 +184,9 @@ struct StreamFaceSenderImpl<Protocol, LocalFace, Packet>
 
     if (!face.isEmptyFilteredLocalControlHeader(packet.getLocalControlHeader()))
       {
-        face.m_sendQueue.push(face.filterAndEncodeLocalControlHeader(packet));
+        face.m_sendQueue.push_back(face.filterAndEncodeLocalControlHeader(packet));
       }
-    face.m_sendQueue.push(packet.wireEncode());
+    face.m_sendQueue.push_back(packet.wireEncode());
 
     if (wasQueueEmpty)
       face.sendFromQueue();
@@ -189,12 +210,41 @@ StreamFace<T, U>::sendData(const Data& data)
   StreamFaceSenderImpl<T, U, Data>::send(*this, data);
 }
 
+template<class T, class U>
+inline void
+StreamFace<T, U>::setMaxWriteSize(size_t maxWriteSize)
+{
+  m_maxWriteSize = maxWriteSize;
+}
+
+template<class T, class U>
+inline size_t
+StreamFace<T, U>::getMaxWriteSize() const
+{
+  return m_maxWriteSize;
+}
+
 template<class T, class U>
 inline void
 StreamFace<T, U>::sendFromQueue()
 {
-  const Block& block = this->m_sendQueue.front();
-  boost::asio::async_write(*this->m_socket, boost::asio::buffer(block),
+  BOOST_ASSERT(m_nBlocksInWrite == 0 && !m_sendQueue.empty());
+
+  // gather queued packets into one write
+  std::vector<boost::asio::const_buffer> buffers;
+  size_t writeSize = 0;
+  for (std::deque<Block>::const_iterator it = m_sendQueue.begin();
+       it != m_sendQueue.end(); ++it)
+    {
+      if (!buffers.empty() && writeSize + it->size() > m_maxWriteSize)
+        break;
+
+      buffers.push_back(boost::asio::buffer(*it));
+      writeSize += it->size();
+    }
+  m_nBlocksInWrite = buffers.size();
+
+  boost::asio::async_write(*this->m_socket, buffers,
                            bind(&StreamFace<T, U>::handleSend, this, _1, _2));
 }
 
@@ -262,14 +312,15 @@ StreamFace<T, U>::handleSend(const boost::system::error_code& error,
   if (error)
     return processErrorCode(error);
 
-  BOOST_ASSERT(!m_sendQueue.empty());
+  BOOST_ASSERT(m_nBlocksInWrite > 0 && m_nBlocksInWrite <= m_sendQueue.size());
 
   NFD_LOG_TRACE("[id:" << this->getId()
                 << ",uri:" << this->getRemoteUri()
                 << "] Successfully sent: " << nBytesSent << " bytes");
   this->getMutableCounters().getNOutBytes() += nBytesSent;
 
-  m_sendQueue.pop();
+  m_sendQueue.erase(m_sendQueue.begin(), m_sendQueue.begin() + m_nBlocksInWrite);
+  m_nBlocksInWrite = 0;
   if (!m_sendQueue.empty())
     sendFromQueue();
 }
@@ -293,9 +344,11 @@ StreamFace<T, U>::handleReceive(const boost::system::error_code& error,
 
   bool isOk = true;
   Block element;
+  // packets decoded from one read are forwarded as a batch
+  this->beginReceiveBatch();
   while (m_inputBufferSize - offset > 0)
     {
-      isOk = Block::fromBuffer(m_inputBuffer + offset, m_inputBufferSize - offset, element);
+      isOk = Face::parseReceivedElement(m_inputBuffer, offset, m_inputBufferSize, element);
       if (!isOk)
         break;
 
@@ -312,6 +365,8 @@ StreamFace<T, U>::handleReceive(const boost::system::error_code& error,
           // ignore unknown packet and proceed
         }
     }
+  this->endReceiveBatch();
+
   if (!isOk && m_inputBufferSize == MAX_NDN_PACKET_SIZE && offset == 0)
     {
       NFD_LOG_WARN("[id:" << this->getId()
@@ -327,19 +382,25 @@ StreamFace<T, U>::handleReceive(const boost::system::error_code& error,
 
   if (offset > 0)
     {
-      if (offset != m_inputBufferSize)
+      element = Block();
+      if (m_inputBuffer.unique())
         {
-          std::copy(m_inputBuffer + offset, m_inputBuffer + m_inputBufferSize,
-                    m_inputBuffer);
-          m_inputBufferSize -= offset;
+          std::copy(m_inputBuffer->begin() + offset, m_inputBuffer->begin() + m_inputBufferSize,
+                    m_inputBuffer->begin());
         }
       else
         {
-          m_inputBufferSize = 0;
+          // decoded packets still reference the current buffer,
+          // so continue in a fresh one with only the incomplete tail
+          shared_ptr<ndn::Buffer> buffer = Face::getReceiveBufferPool().allocate();
+          std::copy(m_inputBuffer->begin() + offset, m_inputBuffer->begin() + m_inputBufferSize,
+                    buffer->begin());
+          m_inputBuffer = buffer;
         }
+      m_inputBufferSize -= offset;
     }
 
-  m_socket->async_receive(boost::asio::buffer(m_inputBuffer + m_inputBufferSize,
+  m_socket->async_receive(boost::asio::buffer(&m_inputBuffer->front() + m_inputBufferSize,
                                               MAX_NDN_PACKET_SIZE - m_inputBufferSize), 0,
                           bind(&StreamFace<T, U>::handleReceive, this, _1, _2));
 }
@@ -368,8 +429,9 @@ StreamFace<T, U>::closeSocket()
                this, this->shared_from_this()));
 
   // clear send queue
-  std::queue<Block> emptyQueue;
+  std::deque<Block> emptyQueue;
   std::swap(emptyQueue, m_sendQueue);
+  m_nBlocksInWrite = 0;
 }
 
 } // namespace nfd
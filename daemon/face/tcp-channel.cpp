@@ -23,6 +23,7 @@
  **/
 
 #include "tcp-channel.hpp"
+#include "io-thread.hpp"
 #include "core/global-io.hpp"
 #include "core/face-uri.hpp"
 
@@ -32,15 +33,109 @@ NFD_LOG_INIT("TcpChannel");
 
 using namespace boost::asio;
 
+/** \brief an acceptor in the SO_REUSEPORT group of the channel, serviced by its own thread
+ *
+ *  Connections are accepted into sockets of the main io_service,
+ *  and their faces are created in the main thread.
+ */
+class TcpChannel::ListenQueue : noncopyable
+{
+public:
+  ListenQueue(TcpChannel& channel, io_service& mainIo,
+              const FaceCreatedCallback& onFaceCreated,
+              const ConnectFailedCallback& onAcceptFailed, int backlog)
+    : m_channel(channel)
+    , m_mainIo(mainIo)
+    , m_onFaceCreated(onFaceCreated)
+    , m_onAcceptFailed(onAcceptFailed)
+    , m_acceptor(m_thread.getIoService())
+  {
+    const tcp::Endpoint& localEndpoint = m_channel.m_localEndpoint;
+    m_acceptor.open(localEndpoint.protocol());
+    m_acceptor.set_option(ip::tcp::acceptor::reuse_address(true));
+    if (localEndpoint.address().is_v6())
+      {
+        m_acceptor.set_option(ip::v6_only(true));
+      }
+    setReusePort(m_acceptor.native_handle());
+    m_acceptor.bind(localEndpoint);
+    m_acceptor.listen(backlog);
+  }
+
+  ~ListenQueue()
+  {
+    // no handler may run while the acceptor is destroyed
+    m_thread.stop();
+  }
+
+  void
+  start()
+  {
+    this->startAccept();
+    m_thread.start();
+  }
+
+private:
+  void
+  startAccept()
+  {
+    shared_ptr<ip::tcp::socket> clientSocket = make_shared<ip::tcp::socket>(ref(m_mainIo));
+    m_acceptor.async_accept(*clientSocket,
+                            bind(&ListenQueue::handleAccept, this, _1, clientSocket));
+  }
+
+  void
+  handleAccept(const boost::system::error_code& error,
+               const shared_ptr<ip::tcp::socket>& socket)
+  {
+    if (error == boost::system::errc::operation_canceled) // when socket is closed by someone
+      return;
+
+    if (error) {
+      // like the main thread acceptor, this queue stops accepting
+      if (static_cast<bool>(m_onAcceptFailed))
+        m_mainIo.post(bind(m_onAcceptFailed, "Connect to remote endpoint failed: " +
+                           error.category().message(error.value())));
+      return;
+    }
+
+    m_mainIo.post(bind(&TcpChannel::createFace, &m_channel, socket, m_onFaceCreated, true));
+    this->startAccept();
+  }
+
+private:
+  TcpChannel& m_channel;
+  io_service& m_mainIo;
+  FaceCreatedCallback m_onFaceCreated;
+  ConnectFailedCallback m_onAcceptFailed;
+  // declared before m_acceptor, so that the acceptor is destroyed first
+  IoThread m_thread;
+  ip::tcp::acceptor m_acceptor;
+};
+
 TcpChannel::TcpChannel(const tcp::Endpoint& localEndpoint)
   : m_localEndpoint(localEndpoint)
   , m_isListening(false)
+  , m_maxWriteSize(DEFAULT_STREAM_MAX_WRITE_SIZE)
+  , m_nListenQueues(1)
 {
   this->setUri(FaceUri(localEndpoint));
 }
 
 TcpChannel::~TcpChannel()
 {
+  // stop I/O threads before the acceptors they use are destroyed
+  m_listenQueues.clear();
+}
+
+void
+TcpChannel::setNListenQueues(size_t nQueues)
+{
+  BOOST_ASSERT(!m_isListening);
+  if (nQueues > 1 && !isReusePortSupported())
+    throw Error("Multiple listen queues need SO_REUSEPORT, which is not supported");
+
+  m_nListenQueues = std::max<size_t>(nQueues, 1);
 }
 
 void
@@ -48,6 +143,19 @@ TcpChannel::listen(const FaceCreatedCallback& onFaceCreated,
                    const ConnectFailedCallback& onAcceptFailed,
                    int backlog/* = tcp::acceptor::max_connections*/)
 {
+  if (m_nListenQueues > 1)
+    {
+      for (size_t i = 0; i < m_nListenQueues; ++i)
+        m_listenQueues.push_back(make_shared<ListenQueue>(ref(*this), ref(getGlobalIoService()),
+                                                          onFaceCreated, onAcceptFailed,
+                                                          backlog));
+      for (size_t i = 0; i < m_nListenQueues; ++i)
+        m_listenQueues[i]->start();
+
+      m_isListening = true;
+      return;
+    }
+
   m_acceptor = make_shared<ip::tcp::acceptor>(ref(getGlobalIoService()));
   m_acceptor->open(m_localEndpoint.protocol());
   m_acceptor->set_option(ip::tcp::acceptor::reuse_address(true));
@@ -136,9 +244,17 @@ TcpChannel::createFace(const shared_ptr<ip::tcp::socket>& socket,
   if (faceMapPos == m_channelFaces.end())
     {
       if (socket->local_endpoint().address().is_loopback())
-        face = make_shared<TcpLocalFace>(socket, isOnDemand);
+        {
+          shared_ptr<TcpLocalFace> localFace = make_shared<TcpLocalFace>(socket, isOnDemand);
+          localFace->setMaxWriteSize(m_maxWriteSize);
+          face = localFace;
+        }
       else
-        face = make_shared<TcpFace>(socket, isOnDemand);
+        {
+          shared_ptr<TcpFace> tcpFace = make_shared<TcpFace>(socket, isOnDemand);
+          tcpFace->setMaxWriteSize(m_maxWriteSize);
+          face = tcpFace;
+        }
 
       face->onFail += bind(&TcpChannel::afterFaceFailed, this, remoteEndpoint);
 
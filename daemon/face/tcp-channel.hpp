@@ -45,6 +45,14 @@ typedef boost::asio::ip::tcp::endpoint Endpoint;
 class TcpChannel : public Channel
 {
 public:
+  /**
+   * \brief Exception of TcpChannel
+   */
+  struct Error : public std::runtime_error
+  {
+    Error(const std::string& what) : runtime_error(what) {}
+  };
+
   /**
    * \brief Create TCP channel for the local endpoint
    *
@@ -106,6 +114,31 @@ public:
   bool
   isListening() const;
 
+  /**
+   * \brief Set the limit of octets gathered into one write on faces
+   *        created by this channel afterwards
+   */
+  void
+  setMaxWriteSize(size_t maxWriteSize);
+
+  /**
+   * \brief Accept on nQueues sockets bound to the local endpoint with SO_REUSEPORT,
+   *        each serviced by its own I/O thread
+   *
+   * The kernel spreads incoming connections across the sockets.
+   * Accepted connections are passed to the main thread, where their faces run.
+   * With nQueues 1 (the default), the channel accepts in the main thread.
+   *
+   * Must be called before listen.
+   *
+   * \throw TcpChannel::Error if SO_REUSEPORT is unavailable
+   */
+  void
+  setNListenQueues(size_t nQueues);
+
+  size_t
+  getNListenQueues() const;
+
 private:
   void
   createFace(const shared_ptr<boost::asio::ip::tcp::socket>& socket,
@@ -149,6 +182,12 @@ private:
 
   bool m_isListening;
   shared_ptr<boost::asio::ip::tcp::acceptor> m_acceptor;
+  size_t m_maxWriteSize;
+
+  class ListenQueue;
+  size_t m_nListenQueues;
+  /// acceptors with their own I/O threads, used instead of m_acceptor when m_nListenQueues > 1
+  std::vector<shared_ptr<ListenQueue> > m_listenQueues;
 };
 
 inline bool
@@ -157,6 +196,18 @@ TcpChannel::isListening() const
   return m_isListening;
 }
 
+inline void
+TcpChannel::setMaxWriteSize(size_t maxWriteSize)
+{
+  m_maxWriteSize = maxWriteSize;
+}
+
+inline size_t
+TcpChannel::getNListenQueues() const
+{
+  return m_nListenQueues;
+}
+
 } // namespace nfd
 
 #endif // NFD_DAEMON_FACE_TCP_CHANNEL_HPP
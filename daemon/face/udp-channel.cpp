@@ -24,6 +24,7 @@
  */
 
 #include "udp-channel.hpp"
+#include "io-thread.hpp"
 #include "core/global-io.hpp"
 #include "core/face-uri.hpp"
 
@@ -33,35 +34,178 @@ NFD_LOG_INIT("UdpChannel");
 
 using namespace boost::asio;
 
+/** \brief a socket in the SO_REUSEPORT group of the channel, serviced by its own thread
+ *
+ *  Received datagrams are posted to the main thread, where UdpChannel::dispatchToPeer
+ *  passes them to faces.
+ */
+class UdpChannel::ListenQueue : noncopyable
+{
+public:
+  ListenQueue(UdpChannel& channel, size_t batchSize)
+    : m_channel(channel)
+    , m_mainIo(channel.m_socket->get_io_service())
+    , m_socket(m_thread.getIoService())
+  {
+    m_channel.openSocket(m_socket, true);
+    if (batchSize > 1 && DatagramBatch::isSupported())
+      m_batch.reset(new DatagramBatch(batchSize));
+  }
+
+  ~ListenQueue()
+  {
+    // no handler may run while the socket is destroyed
+    m_thread.stop();
+  }
+
+  void
+  start()
+  {
+    this->startReceive();
+    m_thread.start();
+  }
+
+private:
+  void
+  startReceive()
+  {
+    if (static_cast<bool>(m_batch))
+      m_socket.async_receive(boost::asio::null_buffers(),
+                             bind(&ListenQueue::handleReceiveBatch, this, _1));
+    else
+      {
+        m_inputBuffer = Face::getReceiveBufferPool().allocate();
+        m_socket.async_receive_from(boost::asio::buffer(&m_inputBuffer->front(),
+                                                        MAX_NDN_PACKET_SIZE),
+                                    m_remoteEndpoint,
+                                    bind(&ListenQueue::handleReceive, this, _1, _2));
+      }
+  }
+
+  void
+  handleReceive(const boost::system::error_code& error, size_t nBytesReceived)
+  {
+    if (error == boost::asio::error::operation_aborted) // when socket is closed by someone
+      return;
+
+    if (!error)
+      m_mainIo.post(bind(&UdpChannel::dispatchToPeer, &m_channel, m_remoteEndpoint,
+                         ndn::ConstBufferPtr(m_inputBuffer), nBytesReceived, error));
+    this->startReceive();
+  }
+
+  void
+  handleReceiveBatch(const boost::system::error_code& error)
+  {
+    if (error == boost::asio::error::operation_aborted) // when socket is closed by someone
+      return;
+
+    if (!error)
+      {
+        boost::system::error_code receiveError;
+        size_t nReceived = m_batch->receive(m_socket.native_handle(), receiveError);
+
+        udp::Endpoint remoteEndpoint;
+        for (size_t i = 0; i < nReceived; ++i)
+          {
+            remoteEndpoint.resize(m_batch->getSourceAddress(i, remoteEndpoint.data(),
+                                                            remoteEndpoint.capacity()));
+            m_mainIo.post(bind(&UdpChannel::dispatchToPeer, &m_channel, remoteEndpoint,
+                               ndn::ConstBufferPtr(m_batch->getBuffer(i)),
+                               m_batch->getSize(i), boost::system::error_code()));
+          }
+      }
+    this->startReceive();
+  }
+
+private:
+  UdpChannel& m_channel;
+  io_service& m_mainIo;
+  // declared before m_socket, so that the socket is destroyed first
+  IoThread m_thread;
+  ip::udp::socket m_socket;
+  shared_ptr<ndn::Buffer> m_inputBuffer;
+  udp::Endpoint m_remoteEndpoint;
+  scoped_ptr<DatagramBatch> m_batch;
+};
+
 UdpChannel::UdpChannel(const udp::Endpoint& localEndpoint,
                        const time::seconds& timeout)
   : m_localEndpoint(localEndpoint)
+  , m_ioBatchSize(1)
   , m_isListening(false)
+  , m_isSocketShared(false)
+  , m_isReceiving(false)
+  , m_nListenQueues(1)
   , m_idleFaceTimeout(timeout)
+{
+  m_socket = make_shared<ip::udp::socket>(ref(getGlobalIoService()));
+
+  try {
+    this->openSocket(*m_socket, false);
+  }
+  catch (boost::system::system_error& e) {
+    //The bind failed, so the socket is useless now
+    m_socket->close();
+    throw Error("Failed to properly configure the socket. "
+                "UdpChannel creation aborted, check the address (" + std::string(e.what()) + ")");
+  }
+
+  this->setUri(FaceUri(localEndpoint));
+}
+
+UdpChannel::~UdpChannel()
+{
+  // stop I/O threads before the sockets they use are destroyed
+  m_listenQueues.clear();
+}
+
+void
+UdpChannel::openSocket(ip::udp::socket& socket, bool needReusePort)
 {
   /// \todo the reuse_address works as we want in Linux, but in other system could be different.
   ///       We need to check this
   ///       (SO_REUSEADDR doesn't behave uniformly in different OS)
 
-  m_socket = make_shared<ip::udp::socket>(ref(getGlobalIoService()));
-  m_socket->open(m_localEndpoint.protocol());
-  m_socket->set_option(boost::asio::ip::udp::socket::reuse_address(true));
+  socket.open(m_localEndpoint.protocol());
+  socket.set_option(boost::asio::ip::udp::socket::reuse_address(true));
   if (m_localEndpoint.address().is_v6())
     {
-      m_socket->set_option(ip::v6_only(true));
+      socket.set_option(ip::v6_only(true));
+    }
+  if (needReusePort)
+    {
+      setReusePort(socket.native_handle());
     }
 
+  socket.bind(m_localEndpoint);
+}
+
+void
+UdpChannel::setNListenQueues(size_t nQueues)
+{
+  BOOST_ASSERT(!m_isReceiving && m_channelFaces.empty());
+  if (nQueues == m_nListenQueues || nQueues == 0)
+    return;
+
+  if (nQueues > 1 && !isReusePortSupported())
+    throw Error("Multiple listen queues need SO_REUSEPORT, which is not supported");
+
   try {
-    m_socket->bind(m_localEndpoint);
+    // the channel socket must join the SO_REUSEPORT group before it is bound
+    m_socket->close();
+    this->openSocket(*m_socket, nQueues > 1);
+
+    m_listenQueues.clear();
+    for (size_t i = 1; i < nQueues; ++i)
+      m_listenQueues.push_back(make_shared<ListenQueue>(ref(*this), m_ioBatchSize));
   }
   catch (boost::system::system_error& e) {
-    //The bind failed, so the socket is useless now
-    m_socket->close();
-    throw Error("Failed to properly configure the socket. "
-                "UdpChannel creation aborted, check the address (" + std::string(e.what()) + ")");
+    m_listenQueues.clear();
+    throw Error("Failed to bind listen queue sockets (" + std::string(e.what()) + ")");
   }
 
-  this->setUri(FaceUri(localEndpoint));
+  m_nListenQueues = nQueues;
 }
 
 void
@@ -76,11 +220,8 @@ UdpChannel::listen(const FaceCreatedCallback& onFaceCreated,
   onFaceCreatedNewPeerCallback = onFaceCreated;
   onConnectFailedNewPeerCallback = onListenFailed;
 
-  m_socket->async_receive_from(boost::asio::buffer(m_inputBuffer, MAX_NDN_PACKET_SIZE),
-                               m_newRemoteEndpoint,
-                               bind(&UdpChannel::newPeer, this,
-                                    boost::asio::placeholders::error,
-                                    boost::asio::placeholders::bytes_transferred));
+  if (!m_isReceiving)
+    this->startReceive();
 }
 
 
@@ -96,6 +237,14 @@ UdpChannel::connect(const udp::Endpoint& remoteEndpoint,
     return;
   }
 
+  if (m_isSocketShared) {
+    if (!m_isReceiving)
+      this->startReceive();
+
+    createFace(m_socket, remoteEndpoint, onFaceCreated, false);
+    return;
+  }
+
   //creating a new socket for the face that will be created soon
   shared_ptr<ip::udp::socket> clientSocket =
     make_shared<ip::udp::socket>(ref(getGlobalIoService()));
@@ -115,7 +264,7 @@ UdpChannel::connect(const udp::Endpoint& remoteEndpoint,
     onConnectFailed("Failed to configure socket (" + std::string(e.what()) + ")");
     return;
   }
-  createFace(clientSocket, onFaceCreated, false);
+  createFace(clientSocket, remoteEndpoint, onFaceCreated, false);
 }
 
 void
@@ -164,20 +313,67 @@ UdpChannel::size() const
   return m_channelFaces.size();
 }
 
+void
+UdpChannel::setIoBatchSize(size_t batchSize)
+{
+  m_ioBatchSize = batchSize;
+
+  if (batchSize > 1 && DatagramBatch::isSupported())
+    m_batch.reset(new DatagramBatch(batchSize));
+  else
+    m_batch.reset();
+}
+
+void
+UdpChannel::setSharedSocket(bool isSocketShared)
+{
+  BOOST_ASSERT(!m_isReceiving && m_channelFaces.empty());
+  m_isSocketShared = isSocketShared;
+}
+
+void
+UdpChannel::startReceive()
+{
+  if (!m_isReceiving)
+    {
+      for (size_t i = 0; i < m_listenQueues.size(); ++i)
+        m_listenQueues[i]->start();
+    }
+
+  m_isReceiving = true;
+  if (!static_cast<bool>(m_inputBuffer))
+    m_inputBuffer = Face::getReceiveBufferPool().allocate();
+
+  if (static_cast<bool>(m_batch))
+    m_socket->async_receive(boost::asio::null_buffers(),
+                            bind(&UdpChannel::newPeerBatch, this,
+                                 boost::asio::placeholders::error));
+  else
+    m_socket->async_receive_from(boost::asio::buffer(&m_inputBuffer->front(),
+                                                     MAX_NDN_PACKET_SIZE),
+                                 m_newRemoteEndpoint,
+                                 bind(&UdpChannel::newPeer, this,
+                                      boost::asio::placeholders::error,
+                                      boost::asio::placeholders::bytes_transferred));
+}
+
 
 shared_ptr<UdpFace>
 UdpChannel::createFace(const shared_ptr<ip::udp::socket>& socket,
+                       const udp::Endpoint& remoteEndpoint,
                        const FaceCreatedCallback& onFaceCreated,
                        bool isOnDemand)
 {
-  udp::Endpoint remoteEndpoint = socket->remote_endpoint();
-
   shared_ptr<UdpFace> face;
 
   ChannelFaceMap::iterator faceMapPos = m_channelFaces.find(remoteEndpoint);
   if (faceMapPos == m_channelFaces.end())
     {
-      face = make_shared<UdpFace>(socket, isOnDemand, m_idleFaceTimeout);
+      if (m_isSocketShared)
+        face = make_shared<UdpFace>(socket, remoteEndpoint, isOnDemand, m_idleFaceTimeout);
+      else
+        face = make_shared<UdpFace>(socket, isOnDemand, m_idleFaceTimeout);
+      face->setIoBatchSize(m_ioBatchSize);
       face->onFail += bind(&UdpChannel::afterFaceFailed, this, remoteEndpoint);
 
       m_channelFaces[remoteEndpoint] = face;
@@ -187,9 +383,12 @@ UdpChannel::createFace(const shared_ptr<ip::udp::socket>& socket,
       // we've already created a a face for this endpoint, just reuse it
       face = faceMapPos->second;
 
-      boost::system::error_code error;
-      socket->shutdown(ip::udp::socket::shutdown_both, error);
-      socket->close(error);
+      if (socket != m_socket)
+        {
+          boost::system::error_code error;
+          socket->shutdown(ip::udp::socket::shutdown_both, error);
+          socket->close(error);
+        }
     }
 
   // Need to invoke the callback regardless of whether or not we have already created
@@ -203,12 +402,76 @@ void
 UdpChannel::newPeer(const boost::system::error_code& error,
                     size_t nBytesReceived)
 {
-  NFD_LOG_DEBUG("UdpChannel::newPeer from " << m_newRemoteEndpoint);
+  if (m_isSocketShared && error)
+    {
+      // the error belongs to the channel socket, not to the face of m_newRemoteEndpoint
+      if (error == boost::asio::error::operation_aborted) // when socket is closed by someone
+        return;
+
+      NFD_LOG_WARN("Receive on shared socket failed: " << error.message());
+      this->startReceive();
+      return;
+    }
+
+  this->dispatchToPeer(m_newRemoteEndpoint, m_inputBuffer, nBytesReceived, error);
+  if (!m_inputBuffer.unique())
+    m_inputBuffer = Face::getReceiveBufferPool().allocate();
+
+  this->startReceive();
+}
+
+void
+UdpChannel::newPeerBatch(const boost::system::error_code& error)
+{
+  if (error == boost::asio::error::operation_aborted) // when socket is closed by someone
+    return;
+
+  if (error == 0 && static_cast<bool>(m_batch))
+    {
+      boost::system::error_code receiveError;
+      size_t nReceived = m_batch->receive(m_socket->native_handle(), receiveError);
+      if (receiveError && receiveError != boost::asio::error::would_block)
+        NFD_LOG_WARN("Batched receive failed: " << receiveError.message());
+
+      udp::Endpoint remoteEndpoint;
+      for (size_t i = 0; i < nReceived; ++i)
+        {
+          remoteEndpoint.resize(m_batch->getSourceAddress(i, remoteEndpoint.data(),
+                                                          remoteEndpoint.capacity()));
+          this->dispatchToPeer(remoteEndpoint, m_batch->getBuffer(i), m_batch->getSize(i),
+                               receiveError);
+        }
+    }
+
+  this->startReceive();
+}
 
+void
+UdpChannel::dispatchToPeer(const udp::Endpoint& remoteEndpoint,
+                           const ndn::ConstBufferPtr& buffer, size_t nBytesReceived,
+                           const boost::system::error_code& error)
+{
   shared_ptr<UdpFace> face;
 
-  ChannelFaceMap::iterator i = m_channelFaces.find(m_newRemoteEndpoint);
-  if (i != m_channelFaces.end()) {
+  ChannelFaceMap::iterator i = m_channelFaces.find(remoteEndpoint);
+  if (m_isSocketShared) {
+    // every datagram of every peer arrives here
+    if (i != m_channelFaces.end()) {
+      i->second->receiveDatagram(buffer, nBytesReceived, error);
+      return;
+    }
+
+    if (!m_isListening) {
+      NFD_LOG_DEBUG("Dropping datagram from unknown peer " << remoteEndpoint);
+      return;
+    }
+
+    NFD_LOG_DEBUG("UdpChannel::newPeer from " << remoteEndpoint);
+    face = createFace(m_socket, remoteEndpoint, onFaceCreatedNewPeerCallback, true);
+  }
+  else if (i != m_channelFaces.end()) {
+    NFD_LOG_DEBUG("UdpChannel::newPeer from " << remoteEndpoint);
+
     //The face already exists.
     //Usually this shouldn't happen, because the channel creates a Udpface
     //as soon as it receives a pkt from a new endpoint and then the
@@ -219,32 +482,28 @@ UdpChannel::newPeer(const boost::system::error_code& error,
     //ready. In this case, the channel has to pass the pkt to the face
 
     NFD_LOG_DEBUG("The creation of the face for the remote endpoint "
-                  << m_newRemoteEndpoint
+                  << remoteEndpoint
                   << " is in progress");
 
     face = i->second;
   }
   else {
+    NFD_LOG_DEBUG("UdpChannel::newPeer from " << remoteEndpoint);
+
     shared_ptr<ip::udp::socket> clientSocket =
       make_shared<ip::udp::socket>(ref(getGlobalIoService()));
     clientSocket->open(m_localEndpoint.protocol());
     clientSocket->set_option(ip::udp::socket::reuse_address(true));
     clientSocket->bind(m_localEndpoint);
-    clientSocket->connect(m_newRemoteEndpoint);
+    clientSocket->connect(remoteEndpoint);
 
-    face = createFace(clientSocket,
+    face = createFace(clientSocket, remoteEndpoint,
                       onFaceCreatedNewPeerCallback,
                       true);
   }
 
   // dispatch the datagram to the face for processing
-  face->receiveDatagram(m_inputBuffer, nBytesReceived, error);
-
-  m_socket->async_receive_from(boost::asio::buffer(m_inputBuffer, MAX_NDN_PACKET_SIZE),
-                               m_newRemoteEndpoint,
-                               bind(&UdpChannel::newPeer, this,
-                                    boost::asio::placeholders::error,
-                                    boost::asio::placeholders::bytes_transferred));
+  face->receiveDatagram(buffer, nBytesReceived, error);
 }
 
 
@@ -65,6 +65,9 @@ public:
   UdpChannel(const udp::Endpoint& localEndpoint,
              const time::seconds& timeout);
 
+  virtual
+  ~UdpChannel();
+
   /**
    * \brief Enable listening on the local endpoint, accept connections,
    *        and create faces when remote host makes a connection
@@ -112,9 +115,59 @@ public:
   size_t
   size() const;
 
+  /**
+   * \brief Set the number of datagrams received or sent per syscall
+   *        by this channel and by faces it creates afterwards
+   *
+   * \sa DatagramFace::setIoBatchSize
+   */
+  void
+  setIoBatchSize(size_t batchSize);
+
+  /**
+   * \brief Let faces of this channel share the channel socket
+   *
+   * Instead of one connected socket per remote endpoint, the channel receives
+   * from all peers on its own unconnected socket, and passes each datagram
+   * to the face of its source endpoint. Faces send through the same socket.
+   *
+   * Must be called before listen or connect.
+   */
+  void
+  setSharedSocket(bool isSocketShared);
+
+  bool
+  isSocketShared() const;
+
+  /**
+   * \brief Receive on nQueues sockets bound to the local endpoint with SO_REUSEPORT
+   *
+   * The kernel spreads remote endpoints across the sockets.
+   * The channel socket is the first queue and is serviced by the main thread;
+   * each other queue has its own I/O thread, which receives datagrams and passes them
+   * to the main thread, where faces and forwarding run.
+   * With nQueues 1 (the default), only the channel socket receives.
+   *
+   * Must be called before listen or connect.
+   *
+   * \throw UdpChannel::Error if SO_REUSEPORT is unavailable or the sockets cannot be bound
+   */
+  void
+  setNListenQueues(size_t nQueues);
+
+  size_t
+  getNListenQueues() const;
+
 private:
+  /**
+   * \brief Open socket and bind it to the local endpoint
+   */
+  void
+  openSocket(boost::asio::ip::udp::socket& socket, bool needReusePort);
+
   shared_ptr<UdpFace>
   createFace(const shared_ptr<boost::asio::ip::udp::socket>& socket,
+             const udp::Endpoint& remoteEndpoint,
              const FaceCreatedCallback& onFaceCreated,
              bool isOnDemand);
   void
@@ -127,6 +180,21 @@ private:
   void
   newPeer(const boost::system::error_code& error, size_t nBytesReceived);
 
+  /**
+   * \brief The listening socket is readable, and datagrams are received
+   *        in a batch with recvmmsg
+   */
+  void
+  newPeerBatch(const boost::system::error_code& error);
+
+  void
+  dispatchToPeer(const udp::Endpoint& remoteEndpoint,
+                 const ndn::ConstBufferPtr& buffer, size_t nBytesReceived,
+                 const boost::system::error_code& error);
+
+  void
+  startReceive();
+
   void
   handleEndpointResolution(const boost::system::error_code& error,
                            boost::asio::ip::udp::resolver::iterator remoteEndpoint,
@@ -157,7 +225,12 @@ private:
    **/
   shared_ptr<boost::asio::ip::udp::socket> m_socket;
 
-  uint8_t m_inputBuffer[MAX_NDN_PACKET_SIZE];
+  shared_ptr<ndn::Buffer> m_inputBuffer;
+
+  size_t m_ioBatchSize;
+
+  /// batched receive on the listening socket, or null if disabled
+  scoped_ptr<DatagramBatch> m_batch;
 
   typedef std::map< udp::Endpoint, shared_ptr<UdpFace> > ChannelFaceMap;
   ChannelFaceMap m_channelFaces;
@@ -167,6 +240,21 @@ private:
    */
   bool m_isListening;
 
+  /**
+   * \brief If true, faces use m_socket instead of their own connected sockets
+   */
+  bool m_isSocketShared;
+
+  /**
+   * \brief If true, a receive on m_socket is pending
+   */
+  bool m_isReceiving;
+
+  class ListenQueue;
+  size_t m_nListenQueues;
+  /// listen queues other than m_socket, each with its own I/O thread
+  std::vector<shared_ptr<ListenQueue> > m_listenQueues;
+
   /**
    * \brief every time m_idleFaceTimeout expires all the idle (and on-demand)
    *        faces will be removed
@@ -174,6 +262,18 @@ private:
   time::seconds m_idleFaceTimeout;
 };
 
+inline bool
+UdpChannel::isSocketShared() const
+{
+  return m_isSocketShared;
+}
+
+inline size_t
+UdpChannel::getNListenQueues() const
+{
+  return m_nListenQueues;
+}
+
 } // namespace nfd
 
 #endif // NFD_DAEMON_FACE_UDP_CHANNEL_HPP
@@ -42,6 +42,25 @@ UdpFace::UdpFace(const shared_ptr<UdpFace::protocol::socket>& socket,
                            socket, isOnDemand)
   , m_idleTimeout(idleTimeout)
   , m_lastIdleCheck(time::steady_clock::now())
+{
+  this->initialize(*socket, isOnDemand);
+}
+
+UdpFace::UdpFace(const shared_ptr<UdpFace::protocol::socket>& sharedSocket,
+                 const UdpFace::protocol::endpoint& remoteEndpoint,
+                 bool isOnDemand,
+                 const time::seconds& idleTimeout)
+  : DatagramFace<protocol>(FaceUri(remoteEndpoint),
+                           FaceUri(sharedSocket->local_endpoint()),
+                           sharedSocket, remoteEndpoint, isOnDemand)
+  , m_idleTimeout(idleTimeout)
+  , m_lastIdleCheck(time::steady_clock::now())
+{
+  this->initialize(*sharedSocket, isOnDemand);
+}
+
+void
+UdpFace::initialize(protocol::socket& socket, bool isOnDemand)
 {
 #ifdef __linux__
   //
@@ -57,7 +76,7 @@ UdpFace::UdpFace(const shared_ptr<UdpFace::protocol::socket>& socket,
   // routers along the path to perform fragmentation as needed.
   //
   const int value = IP_PMTUDISC_DONT;
-  if (::setsockopt(socket->native_handle(), IPPROTO_IP,
+  if (::setsockopt(socket.native_handle(), IPPROTO_IP,
                    IP_MTU_DISCOVER, &value, sizeof(value)) < 0)
     {
       NFD_LOG_WARN("[id:" << this->getId()
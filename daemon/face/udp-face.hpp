@@ -41,6 +41,16 @@ public:
           bool isOnDemand,
           const time::seconds& idleTimeout);
 
+  /**
+   * \brief Create a face for remoteEndpoint on an unconnected socket shared with other faces
+   *
+   * Datagrams from remoteEndpoint must be passed to receiveDatagram by the owner of the socket.
+   */
+  UdpFace(const shared_ptr<protocol::socket>& sharedSocket,
+          const protocol::endpoint& remoteEndpoint,
+          bool isOnDemand,
+          const time::seconds& idleTimeout);
+
   virtual
   ~UdpFace();
 
@@ -48,6 +58,9 @@ public:
   getFaceStatus() const;
 
 private:
+  void
+  initialize(protocol::socket& socket, bool isOnDemand);
+
   void
   closeIfIdle();
 
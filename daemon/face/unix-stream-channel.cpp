@@ -37,6 +37,7 @@ using namespace boost::asio::local;
 UnixStreamChannel::UnixStreamChannel(const unix_stream::Endpoint& endpoint)
   : m_endpoint(endpoint)
   , m_isListening(false)
+  , m_maxWriteSize(DEFAULT_STREAM_MAX_WRITE_SIZE)
 {
   setUri(FaceUri(endpoint));
 }
@@ -143,6 +144,7 @@ UnixStreamChannel::handleSuccessfulAccept(const boost::system::error_code& error
                                 onFaceCreated, onAcceptFailed));
 
   shared_ptr<UnixStreamFace> face = make_shared<UnixStreamFace>(socket);
+  face->setMaxWriteSize(m_maxWriteSize);
   onFaceCreated(face);
 }
 
@@ -77,6 +77,13 @@ public:
          const ConnectFailedCallback& onAcceptFailed,
          int backlog = boost::asio::local::stream_protocol::acceptor::max_connections);
 
+  /**
+   * \brief Set the limit of octets gathered into one write on faces
+   *        created by this channel afterwards
+   */
+  void
+  setMaxWriteSize(size_t maxWriteSize);
+
 private:
   void
   handleSuccessfulAccept(const boost::system::error_code& error,
@@ -88,8 +95,15 @@ private:
   unix_stream::Endpoint m_endpoint;
   shared_ptr<boost::asio::local::stream_protocol::acceptor> m_acceptor;
   bool m_isListening;
+  size_t m_maxWriteSize;
 };
 
+inline void
+UnixStreamChannel::setMaxWriteSize(size_t maxWriteSize)
+{
+  m_maxWriteSize = maxWriteSize;
+}
+
 } // namespace nfd
 
 #endif // NFD_DAEMON_FACE_UNIX_STREAM_CHANNEL_HPP
@@ -64,6 +64,19 @@ FaceTable::addReserved(shared_ptr<Face> face, FaceId faceId)
   this->addImpl(face, faceId);
 }
 
+void
+FaceTable::addMirror(shared_ptr<Face> face, FaceId faceId)
+{
+  BOOST_ASSERT(face->getId() == INVALID_FACEID);
+  BOOST_ASSERT(faceId != INVALID_FACEID);
+  if (m_faces.count(faceId) > 0) {
+    NFD_LOG_WARN("Trying to add existing face id=" << faceId << " to the face table");
+    return;
+  }
+
+  this->addImpl(face, faceId);
+}
+
 void
 FaceTable::addImpl(shared_ptr<Face> face, FaceId faceId)
 {
@@ -76,6 +89,8 @@ FaceTable::addImpl(shared_ptr<Face> face, FaceId faceId)
                                   &m_forwarder, ref(*face), _1);
   face->onReceiveData     += bind(&Forwarder::onData,
                                   &m_forwarder, ref(*face), _1);
+  face->afterReceiveBatch += bind(&Forwarder::onReceiveBatchEnd,
+                                  &m_forwarder, ref(*face));
   face->onFail            += bind(&FaceTable::remove,
                                   this, face);
 
@@ -87,6 +102,10 @@ FaceTable::remove(shared_ptr<Face> face)
 {
   this->onRemove(face);
 
+  // packets collected before the face failed must not be processed
+  // after the face is gone
+  m_forwarder.dropReceiveBatch(*face);
+
   FaceId faceId = face->getId();
   m_faces.erase(faceId);
   face->setId(INVALID_FACEID);
@@ -97,11 +116,13 @@ FaceTable::remove(shared_ptr<Face> face)
   //     does not support only removing Forwarder's subscription
   face->onReceiveInterest.clear();
   face->onReceiveData    .clear();
+  face->afterReceiveBatch.clear();
   face->onSendInterest   .clear();
   face->onSendData       .clear();
   // don't clear onFail because other functions may need to execute
 
   m_forwarder.getFib().removeNextHopFromAllEntries(face);
+  m_forwarder.getPit().deleteInOutRecords(face);
 }
 
 
@@ -52,6 +52,13 @@ public:
   VIRTUAL_WITH_TESTS void
   addReserved(shared_ptr<Face> face, FaceId faceId);
 
+  /** \brief add a Face that stands for a Face in another FaceTable, under the same FaceId
+   *
+   *  This is used by ShardedForwarder to mirror the main FaceTable into worker Forwarders.
+   */
+  VIRTUAL_WITH_TESTS void
+  addMirror(shared_ptr<Face> face, FaceId faceId);
+
   VIRTUAL_WITH_TESTS shared_ptr<Face>
   get(FaceId id) const;
 
@@ -24,6 +24,7 @@
  */
 
 #include "forwarder.hpp"
+#include "sharded-forwarder.hpp"
 #include "core/logger.hpp"
 #include "core/random.hpp"
 #include "available-strategies.hpp"
@@ -43,6 +44,8 @@ Forwarder::Forwarder()
   , m_pit(m_nameTree)
   , m_measurements(m_nameTree)
   , m_strategyChoice(m_nameTree, fw::makeDefaultStrategy(*this))
+  , m_dispatcher(0)
+  , m_batchFace(0)
 {
   fw::installStrategies(*this);
 }
@@ -52,8 +55,155 @@ Forwarder::~Forwarder()
 
 }
 
+void
+Forwarder::onInterest(Face& face, const Interest& interest)
+{
+  if (m_dispatcher != 0 && m_dispatcher->dispatchInterest(*this, face, interest)) {
+    return;
+  }
+
+  if (face.isReceivingBatch()) {
+    if (&face != m_batchFace || !m_dataBatch.empty()) {
+      this->flushReceiveBatch();
+    }
+    m_batchFace = &face;
+    m_interestBatch.push_back(const_pointer_cast<Interest>(interest.shared_from_this()));
+    return;
+  }
+
+  this->onIncomingInterest(face, interest);
+}
+
+void
+Forwarder::onData(Face& face, const Data& data)
+{
+  if (m_dispatcher != 0 && m_dispatcher->dispatchData(*this, face, data)) {
+    return;
+  }
+
+  if (face.isReceivingBatch()) {
+    if (&face != m_batchFace || !m_interestBatch.empty()) {
+      this->flushReceiveBatch();
+    }
+    m_batchFace = &face;
+    m_dataBatch.push_back(const_pointer_cast<Data>(data.shared_from_this()));
+    return;
+  }
+
+  this->onIncomingData(face, data);
+}
+
+void
+Forwarder::onInterestBatch(Face& face, const InterestBatch& interests)
+{
+  if (m_dispatcher != 0) {
+    // each Interest may go to a different worker
+    for (InterestBatch::const_iterator it = interests.begin(); it != interests.end(); ++it) {
+      this->onInterest(face, **it);
+    }
+    return;
+  }
+
+  this->onIncomingInterestBatch(face, interests);
+}
+
+void
+Forwarder::onDataBatch(Face& face, const DataBatch& datas)
+{
+  if (m_dispatcher != 0) {
+    // each Data may go to a different worker
+    for (DataBatch::const_iterator it = datas.begin(); it != datas.end(); ++it) {
+      this->onData(face, **it);
+    }
+    return;
+  }
+
+  this->onIncomingDataBatch(face, datas);
+}
+
+void
+Forwarder::onReceiveBatchEnd(Face& face)
+{
+  if (&face == m_batchFace) {
+    this->flushReceiveBatch();
+  }
+}
+
+void
+Forwarder::dropReceiveBatch(Face& face)
+{
+  if (&face != m_batchFace) {
+    return;
+  }
+
+  NFD_LOG_DEBUG("dropReceiveBatch face=" << face.getId() <<
+                " interests=" << m_interestBatch.size() << " datas=" << m_dataBatch.size());
+  m_interestBatch.clear();
+  m_dataBatch.clear();
+  m_batchFace = 0;
+}
+
+void
+Forwarder::flushReceiveBatch()
+{
+  if (m_batchFace == 0) {
+    return;
+  }
+
+  // Pipelines do not receive on faces in batch mode, so the collections are
+  // not modified while they are processed.
+  Face& face = *m_batchFace;
+  if (!m_interestBatch.empty()) {
+    this->onIncomingInterestBatch(face, m_interestBatch);
+    m_interestBatch.clear();
+  }
+  if (!m_dataBatch.empty()) {
+    this->onIncomingDataBatch(face, m_dataBatch);
+    m_dataBatch.clear();
+  }
+  m_batchFace = 0;
+}
+
 void
 Forwarder::onIncomingInterest(Face& inFace, const Interest& interest)
+{
+  if (!this->receiveInterest(inFace, interest)) {
+    return;
+  }
+
+  // hash the Name once for all table lookups of this Interest
+  name_tree::LookupContext lookupContext(interest.getName());
+
+  this->processInterest(inFace, interest, lookupContext);
+}
+
+void
+Forwarder::onIncomingInterestBatch(Face& inFace, const InterestBatch& interests)
+{
+  NFD_LOG_DEBUG("onIncomingInterestBatch face=" << inFace.getId() <<
+                " size=" << interests.size());
+
+  // receive all Interests, and hash their Names
+  std::vector<const Interest*> accepted;
+  std::vector<name_tree::LookupContext> lookupContexts;
+  accepted.reserve(interests.size());
+  lookupContexts.reserve(interests.size());
+  for (InterestBatch::const_iterator it = interests.begin(); it != interests.end(); ++it) {
+    if (this->receiveInterest(inFace, **it)) {
+      accepted.push_back(it->get());
+      lookupContexts.push_back(name_tree::LookupContext((*it)->getName()));
+      m_nameTree.prefetch(lookupContexts.back());
+    }
+  }
+
+  // table stages find the NameTree buckets of every Interest in cache
+  for (size_t i = 0; i < accepted.size(); ++i) {
+    this->processInterest(inFace, *accepted[i], lookupContexts[i]);
+  }
+}
+
+bool
+Forwarder::receiveInterest(Face& inFace, const Interest& interest)
 {
   // receive Interest
   NFD_LOG_DEBUG("onIncomingInterest face=" << inFace.getId() <<
@@ -68,11 +218,18 @@ Forwarder::onIncomingInterest(Face& inFace, const Interest& interest)
     NFD_LOG_DEBUG("onIncomingInterest face=" << inFace.getId() <<
                   " interest=" << interest.getName() << " violates /localhost");
     // (drop)
-    return;
+    return false;
   }
 
+  return true;
+}
+
+void
+Forwarder::processInterest(Face& inFace, const Interest& interest,
+                           const name_tree::LookupContext& lookupContext)
+{
   // PIT insert
-  shared_ptr<pit::Entry> pitEntry = m_pit.insert(interest).first;
+  shared_ptr<pit::Entry> pitEntry = m_pit.insert(interest, lookupContext).first;
 
   // detect loop and record Nonce
   bool isLoop = ! pitEntry->addNonce(interest.getNonce());
@@ -227,6 +384,44 @@ Forwarder::onInterestUnsatisfied(shared_ptr<pit::Entry> pitEntry)
 
 void
 Forwarder::onIncomingData(Face& inFace, const Data& data)
+{
+  if (!this->receiveData(inFace, data)) {
+    return;
+  }
+
+  // hash the Name once for all table lookups of this Data
+  name_tree::LookupContext lookupContext(data.getName());
+
+  this->processData(inFace, data, lookupContext);
+}
+
+void
+Forwarder::onIncomingDataBatch(Face& inFace, const DataBatch& datas)
+{
+  NFD_LOG_DEBUG("onIncomingDataBatch face=" << inFace.getId() <<
+                " size=" << datas.size());
+
+  // receive all Data, and hash their Names
+  std::vector<const Data*> accepted;
+  std::vector<name_tree::LookupContext> lookupContexts;
+  accepted.reserve(datas.size());
+  lookupContexts.reserve(datas.size());
+  for (DataBatch::const_iterator it = datas.begin(); it != datas.end(); ++it) {
+    if (this->receiveData(inFace, **it)) {
+      accepted.push_back(it->get());
+      lookupContexts.push_back(name_tree::LookupContext((*it)->getName()));
+      m_nameTree.prefetch(lookupContexts.back());
+    }
+  }
+
+  // table stages find the NameTree buckets of every Data in cache
+  for (size_t i = 0; i < accepted.size(); ++i) {
+    this->processData(inFace, *accepted[i], lookupContexts[i]);
+  }
+}
+
+bool
+Forwarder::receiveData(Face& inFace, const Data& data)
 {
   // receive Data
   NFD_LOG_DEBUG("onIncomingData face=" << inFace.getId() << " data=" << data.getName());
@@ -240,11 +435,18 @@ Forwarder::onIncomingData(Face& inFace, const Data& data)
     NFD_LOG_DEBUG("onIncomingData face=" << inFace.getId() <<
                   " data=" << data.getName() << " violates /localhost");
     // (drop)
-    return;
+    return false;
   }
 
+  return true;
+}
+
+void
+Forwarder::processData(Face& inFace, const Data& data,
+                       const name_tree::LookupContext& lookupContext)
+{
   // PIT match
-  shared_ptr<pit::DataMatchResult> pitMatches = m_pit.findAllDataMatches(data);
+  shared_ptr<pit::DataMatchResult> pitMatches = m_pit.findAllDataMatches(data, lookupContext);
   if (pitMatches->begin() == pitMatches->end()) {
     // goto Data unsolicited pipeline
     this->onDataUnsolicited(inFace, data);
@@ -300,6 +502,11 @@ Forwarder::onIncomingData(Face& inFace, const Data& data)
 void
 Forwarder::onDataUnsolicited(Face& inFace, const Data& data)
 {
+  // Interests under shorter prefixes may be pending in another shard
+  if (m_dispatcher != 0 && m_dispatcher->dispatchUnsolicitedData(*this, inFace, data)) {
+    return;
+  }
+
   // accept to cache?
   bool acceptToCache = inFace.isLocal();
   if (acceptToCache) {
@@ -358,8 +565,7 @@ Forwarder::setUnsatisfyTimer(shared_ptr<pit::Entry> pitEntry)
     // TODO all InRecords are already expired; will this happen?
   }
 
-  scheduler::cancel(pitEntry->m_unsatisfyTimer);
-  pitEntry->m_unsatisfyTimer = scheduler::schedule(lastExpiryFromNow,
+  m_pitTimers.schedule(pitEntry->m_unsatisfyTimer, lastExpiryFromNow,
     bind(&Forwarder::onInterestUnsatisfied, this, pitEntry));
 }
 
@@ -368,16 +574,15 @@ Forwarder::setStragglerTimer(shared_ptr<pit::Entry> pitEntry)
 {
   time::nanoseconds stragglerTime = time::milliseconds(100);
 
-  scheduler::cancel(pitEntry->m_stragglerTimer);
-  pitEntry->m_stragglerTimer = scheduler::schedule(stragglerTime,
+  m_pitTimers.schedule(pitEntry->m_stragglerTimer, stragglerTime,
     bind(&Pit::erase, &m_pit, pitEntry));
 }
 
 void
 Forwarder::cancelUnsatisfyAndStragglerTimer(shared_ptr<pit::Entry> pitEntry)
 {
-  scheduler::cancel(pitEntry->m_unsatisfyTimer);
-  scheduler::cancel(pitEntry->m_stragglerTimer);
+  pitEntry->m_unsatisfyTimer.cancel();
+  pitEntry->m_stragglerTimer.cancel();
 }
 
 } // namespace nfd
@@ -26,7 +26,7 @@
 #define NFD_DAEMON_FW_FORWARDER_HPP
 
 #include "common.hpp"
-#include "core/scheduler.hpp"
+#include "core/timer-wheel.hpp"
 #include "forwarder-counters.hpp"
 #include "face-table.hpp"
 #include "table/fib.hpp"
@@ -41,6 +41,8 @@ namespace fw {
 class Strategy;
 } // namespace fw
 
+class ShardedForwarder;
+
 /** \brief main class of NFD
  *
  *  Forwarder owns all faces and tables, and implements forwarding pipelines.
@@ -81,6 +83,31 @@ public: // forwarding entrypoints and tables
   void
   onData(Face& face, const Data& data);
 
+  /** \brief process Interests received together on a face
+   */
+  void
+  onInterestBatch(Face& face, const InterestBatch& interests);
+
+  /** \brief process Data received together on a face
+   */
+  void
+  onDataBatch(Face& face, const DataBatch& datas);
+
+  /** \brief process packets collected while face was receiving a batch
+   *
+   *  While face.isReceivingBatch(), onInterest and onData collect packets
+   *  instead of processing them; this is invoked by face.afterReceiveBatch.
+   */
+  void
+  onReceiveBatchEnd(Face& face);
+
+  /** \brief discard packets collected from face
+   *
+   *  This is invoked when face is removed before its batch ends.
+   */
+  void
+  dropReceiveBatch(Face& face);
+
   NameTree&
   getNameTree();
 
@@ -105,6 +132,14 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE: // pipelines
   VIRTUAL_WITH_TESTS void
   onIncomingInterest(Face& inFace, const Interest& interest);
 
+  /** \brief incoming Interest pipeline for Interests received together on a face
+   *
+   *  The Names of all Interests are hashed and their NameTree buckets are prefetched
+   *  before PIT, CS and FIB stages run on each Interest.
+   */
+  VIRTUAL_WITH_TESTS void
+  onIncomingInterestBatch(Face& inFace, const InterestBatch& interests);
+
   /** \brief Interest loop pipeline
    */
   VIRTUAL_WITH_TESTS void
@@ -132,6 +167,14 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE: // pipelines
   VIRTUAL_WITH_TESTS void
   onIncomingData(Face& inFace, const Data& data);
 
+  /** \brief incoming Data pipeline for Data received together on a face
+   *
+   *  The Names of all Data are hashed and their NameTree buckets are prefetched
+   *  before PIT match and CS insert run on each Data.
+   */
+  VIRTUAL_WITH_TESTS void
+  onIncomingDataBatch(Face& inFace, const DataBatch& datas);
+
   /** \brief Data unsolicited pipeline
    */
   VIRTUAL_WITH_TESTS void
@@ -162,6 +205,35 @@ PROTECTED_WITH_TESTS_ELSE_PRIVATE:
   dispatchToStrategy(shared_ptr<pit::Entry> pitEntry, Function trigger);
 #endif
 
+private:
+  /** \brief receive stage of incoming Interest pipeline
+   *  \return whether the Interest passes /localhost scope control
+   */
+  bool
+  receiveInterest(Face& inFace, const Interest& interest);
+
+  /** \brief PIT, CS and FIB stages of incoming Interest pipeline
+   */
+  void
+  processInterest(Face& inFace, const Interest& interest,
+                  const name_tree::LookupContext& lookupContext);
+
+  /** \brief receive stage of incoming Data pipeline
+   *  \return whether the Data passes /localhost scope control
+   */
+  bool
+  receiveData(Face& inFace, const Data& data);
+
+  /** \brief PIT match and CS insert stages of incoming Data pipeline
+   */
+  void
+  processData(Face& inFace, const Data& data,
+              const name_tree::LookupContext& lookupContext);
+
+  /// process collected Interests or Data of m_batchFace
+  void
+  flushReceiveBatch();
+
 private:
   ForwarderCounters m_counters;
 
@@ -175,10 +247,25 @@ private:
   Measurements   m_measurements;
   StrategyChoice m_strategyChoice;
 
+  /// unsatisfy and straggler timers of PIT entries
+  TimerWheel     m_pitTimers;
+
+  /// hands packets to worker threads, or null if forwarding is single-threaded
+  ShardedForwarder* m_dispatcher;
+
+  /// face whose packets are being collected, or null
+  Face* m_batchFace;
+  /// Interests collected from m_batchFace
+  InterestBatch m_interestBatch;
+  /// Data collected from m_batchFace
+  DataBatch m_dataBatch;
+
   static const Name LOCALHOST_NAME;
 
   // allow Strategy (base class) to enter pipelines
   friend class fw::Strategy;
+  // allow ShardedForwarder to attach itself as dispatcher
+  friend class ShardedForwarder;
 };
 
 inline const ForwarderCounters&
@@ -205,18 +292,6 @@ Forwarder::addFace(shared_ptr<Face> face)
   m_faceTable.add(face);
 }
 
-inline void
-Forwarder::onInterest(Face& face, const Interest& interest)
-{
-  this->onIncomingInterest(face, interest);
-}
-
-inline void
-Forwarder::onData(Face& face, const Data& data)
-{
-  this->onIncomingData(face, data);
-}
-
 inline NameTree&
 Forwarder::getNameTree()
 {
@@ -0,0 +1,677 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "sharded-forwarder.hpp"
+#include "core/logger.hpp"
+#include "core/global-io.hpp"
+#include "table/cs-policy.hpp"
+
+#include <boost/thread/thread.hpp>
+#include <boost/thread/tss.hpp>
+
+namespace nfd {
+
+NFD_LOG_INIT("ShardedForwarder");
+
+const size_t ShardedForwarder::DEFAULT_N_WORKERS = 0;
+const size_t ShardedForwarder::DEFAULT_N_DISPATCH_COMPONENTS = 2;
+
+typedef std::vector<std::pair<FaceId, uint64_t> > NextHopSpecs;
+
+/** \brief a Face in a worker Forwarder that stands for a face of the main Forwarder
+ *
+ *  Packets sent on this face are passed to the main thread,
+ *  and are sent on the face with the same FaceId in the main FaceTable.
+ */
+class ShardedForwarder::ShardFace : public Face
+{
+public:
+  ShardFace(ShardedForwarder& owner, const FaceUri& remoteUri, const FaceUri& localUri,
+            bool isLocal, bool isMultiAccess)
+    : Face(remoteUri, localUri, isLocal)
+    , m_owner(owner)
+    , m_isMultiAccess(isMultiAccess)
+  {
+  }
+
+  virtual void
+  sendInterest(const Interest& interest)
+  {
+    m_owner.m_mainIo.post(bind(&ShardedForwarder::sendInterest, &m_owner,
+                               this->getId(), make_shared<Interest>(interest)));
+  }
+
+  virtual void
+  sendData(const Data& data)
+  {
+    m_owner.m_mainIo.post(bind(&ShardedForwarder::sendData, &m_owner,
+                               this->getId(), make_shared<Data>(data)));
+  }
+
+  virtual void
+  close()
+  {
+    this->fail("Face closed");
+  }
+
+  virtual bool
+  isMultiAccess() const
+  {
+    return m_isMultiAccess;
+  }
+
+private:
+  ShardedForwarder& m_owner;
+  bool m_isMultiAccess;
+};
+
+/** \brief a worker thread with its own io_service and Forwarder
+ *
+ *  Methods other than start, stop and post are handlers that run in the worker thread.
+ */
+class ShardedForwarder::Worker : noncopyable
+{
+public:
+  struct CsSettings
+  {
+    size_t nMaxPackets;
+    size_t nMaxBytes;
+    Cs::IndexType indexType;
+    std::string policyName;
+  };
+
+  Worker(ShardedForwarder& owner, size_t index)
+    : m_owner(owner)
+    , m_index(index)
+    , m_forwarder(0)
+    , m_isDataSolicited(false)
+    , m_isDataSolicitedElsewhere(false)
+  {
+  }
+
+  ~Worker()
+  {
+    this->stop();
+  }
+
+  void
+  start(const CsSettings& csSettings)
+  {
+    m_work.reset(new boost::asio::io_service::work(m_ioService));
+    m_thread = boost::thread(bind(&Worker::run, this, csSettings));
+  }
+
+  void
+  stop()
+  {
+    if (!m_thread.joinable()) {
+      return;
+    }
+
+    m_work.reset();
+    m_ioService.stop();
+    m_thread.join();
+  }
+
+  template<class Handler>
+  void
+  post(Handler handler)
+  {
+    m_ioService.post(handler);
+  }
+
+  size_t
+  getIndex() const
+  {
+    return m_index;
+  }
+
+  /** \return the Worker whose thread is calling, or null in other threads
+   */
+  static Worker*
+  getCurrent()
+  {
+    return getCurrentPtr().get();
+  }
+
+public: // handlers
+  void
+  addFace(FaceId faceId, const FaceUri& remoteUri, const FaceUri& localUri,
+          bool isLocal, bool isMultiAccess)
+  {
+    shared_ptr<Face> face = make_shared<ShardFace>(ref(m_owner), remoteUri, localUri,
+                                                   isLocal, isMultiAccess);
+    m_forwarder->getFaceTable().addMirror(face, faceId);
+  }
+
+  void
+  removeFace(FaceId faceId)
+  {
+    shared_ptr<Face> face = m_forwarder->getFace(faceId);
+    if (static_cast<bool>(face)) {
+      face->close();
+    }
+  }
+
+  void
+  receiveInterest(FaceId faceId, shared_ptr<Interest> interest)
+  {
+    shared_ptr<Face> face = m_forwarder->getFace(faceId);
+    if (!static_cast<bool>(face)) {
+      return;
+    }
+
+    m_forwarder->onInterest(*face, *interest);
+  }
+
+  /** \brief process a Data dispatched by the main thread, then pass it on to the
+   *         workers of shorter prefixes
+   */
+  void
+  receiveData(FaceId faceId, shared_ptr<Data> data)
+  {
+    shared_ptr<Face> face = m_forwarder->getFace(faceId);
+    if (!static_cast<bool>(face)) {
+      return;
+    }
+
+    m_isDataSolicited = true;
+    m_isDataSolicitedElsewhere = false;
+    m_forwarder->onData(*face, *data);
+
+    m_owner.fanOutData(m_index, faceId, *data, m_isDataSolicited);
+  }
+
+  /** \brief process a Data passed on by the worker of a longer prefix
+   *  \param isSolicited whether that worker had a PIT match
+   */
+  void
+  receiveFanOutData(FaceId faceId, shared_ptr<Data> data, bool isSolicited)
+  {
+    shared_ptr<Face> face = m_forwarder->getFace(faceId);
+    if (!static_cast<bool>(face)) {
+      return;
+    }
+
+    m_isDataSolicited = true;
+    m_isDataSolicitedElsewhere = isSolicited;
+    m_forwarder->onData(*face, *data);
+  }
+
+  void
+  setFibEntry(const Name& prefix, const NextHopSpecs& nextHops)
+  {
+    Fib& fib = m_forwarder->getFib();
+    shared_ptr<fib::Entry> entry = fib.insert(prefix).first;
+
+    fib::NextHopList oldNextHops = entry->getNextHops();
+    for (fib::NextHopList::const_iterator it = oldNextHops.begin();
+         it != oldNextHops.end(); ++it) {
+      entry->removeNextHop(it->getFace());
+    }
+
+    for (NextHopSpecs::const_iterator it = nextHops.begin(); it != nextHops.end(); ++it) {
+      shared_ptr<Face> face = m_forwarder->getFace(it->first);
+      if (static_cast<bool>(face)) {
+        entry->addNextHop(face, it->second);
+      }
+    }
+
+    if (!entry->hasNextHops()) {
+      fib.erase(*entry);
+    }
+  }
+
+  void
+  setStrategy(const Name& prefix, shared_ptr<Name> strategyName)
+  {
+    if (static_cast<bool>(strategyName)) {
+      m_forwarder->getStrategyChoice().insert(prefix, *strategyName);
+    }
+    else {
+      m_forwarder->getStrategyChoice().erase(prefix);
+    }
+  }
+
+  /** \brief record that the Data being processed has no PIT match in this worker
+   *  \return whether another worker found it solicited
+   */
+  bool
+  markDataUnsolicited()
+  {
+    m_isDataSolicited = false;
+    return m_isDataSolicitedElsewhere;
+  }
+
+private:
+  static void
+  releaseCurrent(Worker* worker)
+  {
+    // Worker is owned by ShardedForwarder
+  }
+
+  static boost::thread_specific_ptr<Worker>&
+  getCurrentPtr()
+  {
+    static boost::thread_specific_ptr<Worker> current(&releaseCurrent);
+    return current;
+  }
+
+  /// thread body: tables are created, used and destroyed in the worker thread
+  void
+  run(const CsSettings& csSettings)
+  {
+    getCurrentPtr().reset(this);
+    setThreadIoService(&m_ioService);
+
+    {
+      Forwarder forwarder;
+      forwarder.m_dispatcher = &m_owner;
+
+      Cs& cs = forwarder.getCs();
+      cs.setIndexType(csSettings.indexType);
+      cs.setPolicy(cs::makePolicy(csSettings.policyName));
+      cs.setLimit(csSettings.nMaxPackets);
+      cs.setByteLimit(csSettings.nMaxBytes);
+
+      m_forwarder = &forwarder;
+      try {
+        m_ioService.run();
+      }
+      catch (const std::exception& e) {
+        NFD_LOG_FATAL("worker " << m_index << ": " << e.what());
+        m_owner.m_mainIo.stop();
+      }
+      m_forwarder = 0;
+    }
+
+    setThreadIoService(0);
+    getCurrentPtr().reset();
+  }
+
+private:
+  ShardedForwarder& m_owner;
+  size_t m_index;
+  boost::asio::io_service m_ioService;
+  scoped_ptr<boost::asio::io_service::work> m_work;
+  boost::thread m_thread;
+
+  /// worker Forwarder, valid in the worker thread while running
+  Forwarder* m_forwarder;
+  /// whether the Data being processed has a PIT match in this worker
+  bool m_isDataSolicited;
+  /// whether the Data being processed has a PIT match in the worker that passed it on
+  bool m_isDataSolicitedElsewhere;
+};
+
+ShardedForwarder::ShardedForwarder(Forwarder& mainForwarder)
+  : m_mainForwarder(mainForwarder)
+  , m_mainIo(getGlobalIoService())
+  , m_nWorkers(DEFAULT_N_WORKERS)
+  , m_nDispatchComponents(DEFAULT_N_DISPATCH_COMPONENTS)
+{
+  m_mainForwarder.getFaceTable().onAdd += bind(&ShardedForwarder::onFaceAdded, this, _1);
+  m_mainForwarder.getFaceTable().onRemove += bind(&ShardedForwarder::onFaceRemoved, this, _1);
+}
+
+ShardedForwarder::~ShardedForwarder()
+{
+  this->stop();
+}
+
+void
+ShardedForwarder::setConfigFile(ConfigFile& configFile)
+{
+  configFile.addSectionHandler("forwarder",
+                               bind(&ShardedForwarder::onConfig, this, _1, _2, _3));
+}
+
+void
+ShardedForwarder::setNWorkers(size_t nWorkers)
+{
+  BOOST_ASSERT(!this->isRunning());
+  m_nWorkers = nWorkers;
+}
+
+void
+ShardedForwarder::setNDispatchComponents(size_t nComponents)
+{
+  BOOST_ASSERT(!this->isRunning());
+  BOOST_ASSERT(nComponents > 0);
+  m_nDispatchComponents = nComponents;
+}
+
+void
+ShardedForwarder::onConfig(const ConfigSection& configSection,
+                           bool isDryRun,
+                           const std::string& filename)
+{
+  // forwarder
+  // {
+  //    workers 4
+  //    dispatch_components 2
+  // }
+
+  size_t nWorkers = DEFAULT_N_WORKERS;
+  size_t nDispatchComponents = DEFAULT_N_DISPATCH_COMPONENTS;
+
+  boost::optional<const ConfigSection&> workersNode =
+    configSection.get_child_optional("workers");
+
+  if (workersNode)
+    {
+      boost::optional<size_t> valWorkers =
+        configSection.get_optional<size_t>("workers");
+
+      if (!valWorkers)
+        {
+          throw ConfigFile::Error("Invalid value for option \"workers\""
+                                  " in \"forwarder\" section");
+        }
+
+      nWorkers = *valWorkers;
+    }
+
+  boost::optional<const ConfigSection&> dispatchComponentsNode =
+    configSection.get_child_optional("dispatch_components");
+
+  if (dispatchComponentsNode)
+    {
+      boost::optional<size_t> valDispatchComponents =
+        configSection.get_optional<size_t>("dispatch_components");
+
+      if (!valDispatchComponents || *valDispatchComponents == 0)
+        {
+          throw ConfigFile::Error("Invalid value for option \"dispatch_components\""
+                                  " in \"forwarder\" section");
+        }
+
+      nDispatchComponents = *valDispatchComponents;
+    }
+
+  if (isDryRun)
+    {
+      return;
+    }
+
+  if (this->isRunning())
+    {
+      if (nWorkers != m_nWorkers || nDispatchComponents != m_nDispatchComponents)
+        {
+          NFD_LOG_WARN("Forwarder worker settings cannot be changed while running, "
+                       "restart NFD to apply them");
+        }
+      return;
+    }
+
+  NFD_LOG_INFO("Setting forwarder workers to " << nWorkers <<
+               ", dispatch components to " << nDispatchComponents);
+  this->setNWorkers(nWorkers);
+  this->setNDispatchComponents(nDispatchComponents);
+}
+
+void
+ShardedForwarder::start()
+{
+  if (this->isRunning() || m_nWorkers == 0)
+    {
+      return;
+    }
+
+  const Cs& mainCs = m_mainForwarder.getCs();
+  Worker::CsSettings csSettings;
+  csSettings.nMaxPackets = std::max<size_t>(mainCs.getLimit() / m_nWorkers, 1);
+  csSettings.nMaxBytes = mainCs.getByteLimit() == std::numeric_limits<size_t>::max() ?
+                         mainCs.getByteLimit() :
+                         std::max<size_t>(mainCs.getByteLimit() / m_nWorkers, 1);
+  csSettings.indexType = mainCs.getIndexType();
+  csSettings.policyName = mainCs.getPolicy().getName();
+
+  NFD_LOG_INFO("Starting " << m_nWorkers << " forwarding workers");
+
+  for (size_t i = 0; i < m_nWorkers; ++i)
+    {
+      shared_ptr<Worker> worker = make_shared<Worker>(ref(*this), i);
+      worker->start(csSettings);
+      m_workers.push_back(worker);
+    }
+
+  // replicate existing faces, FIB and StrategyChoice
+  FaceTable& faceTable = m_mainForwarder.getFaceTable();
+  for (FaceTable::const_iterator it = faceTable.begin(); it != faceTable.end(); ++it)
+    {
+      this->onFaceAdded(*it);
+    }
+
+  Fib& fib = m_mainForwarder.getFib();
+  for (Fib::const_iterator it = fib.begin(); it != fib.end(); ++it)
+    {
+      this->syncFibEntry(it->getPrefix());
+    }
+
+  StrategyChoice& strategyChoice = m_mainForwarder.getStrategyChoice();
+  for (StrategyChoice::const_iterator it = strategyChoice.begin();
+       it != strategyChoice.end(); ++it)
+    {
+      this->syncStrategyChoice(it->getPrefix());
+    }
+
+  m_mainForwarder.m_dispatcher = this;
+}
+
+void
+ShardedForwarder::stop()
+{
+  if (!this->isRunning())
+    {
+      return;
+    }
+
+  NFD_LOG_INFO("Stopping forwarding workers");
+
+  m_mainForwarder.m_dispatcher = 0;
+
+  for (size_t i = 0; i < m_workers.size(); ++i)
+    {
+      m_workers[i]->stop();
+    }
+  m_workers.clear();
+}
+
+size_t
+ShardedForwarder::getShard(const Name& name, size_t prefixLength) const
+{
+  BOOST_ASSERT(m_nWorkers > 0);
+  return name_tree::computeHash(name, prefixLength) % m_nWorkers;
+}
+
+void
+ShardedForwarder::syncFibEntry(const Name& prefix)
+{
+  if (!this->isRunning())
+    {
+      return;
+    }
+
+  NextHopSpecs nextHops;
+  shared_ptr<fib::Entry> entry = m_mainForwarder.getFib().findExactMatch(prefix);
+  if (static_cast<bool>(entry))
+    {
+      const fib::NextHopList& entryNextHops = entry->getNextHops();
+      for (fib::NextHopList::const_iterator it = entryNextHops.begin();
+           it != entryNextHops.end(); ++it)
+        {
+          nextHops.push_back(std::make_pair(it->getFace()->getId(), it->getCost()));
+        }
+    }
+
+  for (size_t i = 0; i < m_workers.size(); ++i)
+    {
+      // each worker gets its own copy of the Name, because Name caches its encoding
+      m_workers[i]->post(bind(&Worker::setFibEntry, m_workers[i].get(),
+                              Name(prefix.wireEncode()), nextHops));
+    }
+}
+
+void
+ShardedForwarder::syncStrategyChoice(const Name& prefix)
+{
+  if (!this->isRunning())
+    {
+      return;
+    }
+
+  shared_ptr<const Name> strategyName = m_mainForwarder.getStrategyChoice().get(prefix);
+
+  for (size_t i = 0; i < m_workers.size(); ++i)
+    {
+      shared_ptr<Name> strategyNameCopy;
+      if (static_cast<bool>(strategyName))
+        {
+          strategyNameCopy = make_shared<Name>(strategyName->wireEncode());
+        }
+      m_workers[i]->post(bind(&Worker::setStrategy, m_workers[i].get(),
+                              Name(prefix.wireEncode()), strategyNameCopy));
+    }
+}
+
+bool
+ShardedForwarder::dispatchInterest(Forwarder& forwarder, Face& inFace,
+                                   const Interest& interest)
+{
+  if (&forwarder != &m_mainForwarder ||
+      Forwarder::LOCALHOST_NAME.isPrefixOf(interest.getName()))
+    {
+      return false;
+    }
+
+  Worker& worker = *m_workers[this->getShard(interest.getName(), m_nDispatchComponents)];
+  worker.post(bind(&Worker::receiveInterest, &worker,
+                   inFace.getId(), make_shared<Interest>(interest)));
+  return true;
+}
+
+bool
+ShardedForwarder::dispatchData(Forwarder& forwarder, Face& inFace, const Data& data)
+{
+  if (&forwarder != &m_mainForwarder ||
+      Forwarder::LOCALHOST_NAME.isPrefixOf(data.getName()))
+    {
+      return false;
+    }
+
+  size_t prefixLength = std::min(m_nDispatchComponents, data.getName().size());
+  Worker& worker = *m_workers[this->getShard(data.getName(), prefixLength)];
+  worker.post(bind(&Worker::receiveData, &worker,
+                   inFace.getId(), make_shared<Data>(data)));
+  return true;
+}
+
+void
+ShardedForwarder::fanOutData(size_t worker, FaceId faceId, const Data& data,
+                             bool isSolicited)
+{
+  size_t prefixLength = std::min(m_nDispatchComponents, data.getName().size());
+
+  std::vector<bool> isVisited(m_workers.size(), false);
+  isVisited[worker] = true;
+  while (prefixLength > 0)
+    {
+      --prefixLength;
+      size_t shard = this->getShard(data.getName(), prefixLength);
+      if (isVisited[shard])
+        {
+          continue;
+        }
+      isVisited[shard] = true;
+
+      // each worker gets its own copy of the Data, because Data caches its encoding
+      m_workers[shard]->post(bind(&Worker::receiveFanOutData, m_workers[shard].get(),
+                                  faceId, make_shared<Data>(data), isSolicited));
+    }
+}
+
+bool
+ShardedForwarder::dispatchUnsolicitedData(Forwarder& forwarder, Face& inFace,
+                                          const Data& data)
+{
+  Worker* current = Worker::getCurrent();
+  if (current == 0)
+    {
+      return false;
+    }
+
+  // Data solicited in the worker of a longer prefix is cached here too,
+  // so that Interests with fewer components dispatched here can find it
+  if (!current->markDataUnsolicited())
+    {
+      return false;
+    }
+
+  forwarder.getCs().insert(data);
+  return true;
+}
+
+void
+ShardedForwarder::onFaceAdded(shared_ptr<Face> face)
+{
+  for (size_t i = 0; i < m_workers.size(); ++i)
+    {
+      m_workers[i]->post(bind(&Worker::addFace, m_workers[i].get(), face->getId(),
+                              face->getRemoteUri(), face->getLocalUri(),
+                              face->isLocal(), face->isMultiAccess()));
+    }
+}
+
+void
+ShardedForwarder::onFaceRemoved(shared_ptr<Face> face)
+{
+  for (size_t i = 0; i < m_workers.size(); ++i)
+    {
+      m_workers[i]->post(bind(&Worker::removeFace, m_workers[i].get(), face->getId()));
+    }
+}
+
+void
+ShardedForwarder::sendInterest(FaceId faceId, shared_ptr<Interest> interest)
+{
+  shared_ptr<Face> face = m_mainForwarder.getFace(faceId);
+  if (static_cast<bool>(face))
+    {
+      face->sendInterest(*interest);
+    }
+}
+
+void
+ShardedForwarder::sendData(FaceId faceId, shared_ptr<Data> data)
+{
+  shared_ptr<Face> face = m_mainForwarder.getFace(faceId);
+  if (static_cast<bool>(face))
+    {
+      face->sendData(*data);
+    }
+}
+
+} // namespace nfd
@@ -0,0 +1,204 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_SHARDED_FORWARDER_HPP
+#define NFD_DAEMON_FW_SHARDED_FORWARDER_HPP
+
+#include "forwarder.hpp"
+#include "core/config-file.hpp"
+
+namespace nfd {
+
+/** \brief runs the forwarding pipelines on worker threads, each owning a shard of the tables
+ *
+ *  Every worker thread has its own io_service and a complete Forwarder,
+ *  whose NameTree, FIB, PIT, ContentStore, Measurements and StrategyChoice
+ *  only see the names that hash to this worker, so that pipelines run without locks.
+ *
+ *  An Interest is dispatched to the worker selected by the hash of
+ *  its first dispatch_components name components.
+ *  A Data is dispatched the same way. After that worker has processed it, the Data
+ *  is passed on to every other worker that owns a shorter prefix of its Name,
+ *  so that it satisfies Interests with fewer components wherever they are pending.
+ *  Those workers cache the Data if the first worker found it solicited, so that
+ *  later Interests with fewer components find it in their own ContentStore.
+ *
+ *  Faces, management, and the authoritative FIB and StrategyChoice stay in the main thread.
+ *  Every worker Forwarder has a mirror of each face under the same FaceId,
+ *  which hands outgoing packets back to the main thread.
+ *  FIB and StrategyChoice changes are replicated to all workers via syncFibEntry
+ *  and syncStrategyChoice. Names under /localhost are never dispatched.
+ *
+ *  \note With zero workers (the default) nothing is dispatched,
+ *        and all packets are forwarded by the main Forwarder.
+ *  \note Known limitations: worker counters are not included in the main Forwarder's counters;
+ *        the ContentStore disk tier is not enabled in workers.
+ */
+class ShardedForwarder : noncopyable
+{
+public:
+  explicit
+  ShardedForwarder(Forwarder& mainForwarder);
+
+  ~ShardedForwarder();
+
+  /** \brief register handler for "forwarder" config section
+   */
+  void
+  setConfigFile(ConfigFile& configFile);
+
+  /** \brief set number of worker threads
+   *  \pre !isRunning()
+   */
+  void
+  setNWorkers(size_t nWorkers);
+
+  size_t
+  getNWorkers() const;
+
+  /** \brief set number of name components that select the worker of a packet
+   *  \pre !isRunning()
+   *  \pre nComponents > 0
+   */
+  void
+  setNDispatchComponents(size_t nComponents);
+
+  size_t
+  getNDispatchComponents() const;
+
+  /** \brief start worker threads, and replicate faces, FIB and StrategyChoice to them
+   *
+   *  This does nothing if the number of workers is zero.
+   *  Each worker's ContentStore gets an equal share of the main ContentStore limits.
+   */
+  void
+  start();
+
+  /** \brief stop and join worker threads
+   */
+  void
+  stop();
+
+  bool
+  isRunning() const;
+
+  /** \return index of the worker owning the prefix made of the first prefixLength
+   *          components of name
+   *  \pre getNWorkers() > 0
+   */
+  size_t
+  getShard(const Name& name, size_t prefixLength) const;
+
+public: // replication
+  /** \brief copy the FIB entry at prefix from the main Forwarder to all workers
+   */
+  void
+  syncFibEntry(const Name& prefix);
+
+  /** \brief copy the strategy choice at prefix from the main Forwarder to all workers
+   */
+  void
+  syncStrategyChoice(const Name& prefix);
+
+private: // dispatch, called by Forwarder
+  /** \return true if the Interest has been handed to a worker
+   */
+  bool
+  dispatchInterest(Forwarder& forwarder, Face& inFace, const Interest& interest);
+
+  /** \return true if the Data has been handed to a worker
+   */
+  bool
+  dispatchData(Forwarder& forwarder, Face& inFace, const Data& data);
+
+  /** \brief handle a Data that has no PIT match in a worker
+   *  \return true if the Data has been cached, because another worker found it solicited
+   */
+  bool
+  dispatchUnsolicitedData(Forwarder& forwarder, Face& inFace, const Data& data);
+
+  /** \brief pass a Data processed by worker to the other workers owning shorter prefixes
+   *         of its Name; called in worker thread
+   */
+  void
+  fanOutData(size_t worker, FaceId faceId, const Data& data, bool isSolicited);
+
+private:
+  void
+  onConfig(const ConfigSection& configSection, bool isDryRun,
+           const std::string& filename);
+
+  void
+  onFaceAdded(shared_ptr<Face> face);
+
+  void
+  onFaceRemoved(shared_ptr<Face> face);
+
+  /// send Interest on a main face; called in main thread
+  void
+  sendInterest(FaceId faceId, shared_ptr<Interest> interest);
+
+  /// send Data on a main face; called in main thread
+  void
+  sendData(FaceId faceId, shared_ptr<Data> data);
+
+private:
+  class Worker;
+  class ShardFace;
+
+  Forwarder& m_mainForwarder;
+  boost::asio::io_service& m_mainIo;
+  size_t m_nWorkers;
+  size_t m_nDispatchComponents;
+  std::vector<shared_ptr<Worker> > m_workers;
+
+  static const size_t DEFAULT_N_WORKERS;
+  static const size_t DEFAULT_N_DISPATCH_COMPONENTS;
+
+  // allow Forwarder to dispatch packets
+  friend class Forwarder;
+};
+
+inline size_t
+ShardedForwarder::getNWorkers() const
+{
+  return m_nWorkers;
+}
+
+inline size_t
+ShardedForwarder::getNDispatchComponents() const
+{
+  return m_nDispatchComponents;
+}
+
+inline bool
+ShardedForwarder::isRunning() const
+{
+  return !m_workers.empty();
+}
+
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_SHARDED_FORWARDER_HPP
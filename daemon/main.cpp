@@ -31,6 +31,7 @@
 #include "core/global-io.hpp"
 #include "core/privilege-helper.hpp"
 #include "fw/forwarder.hpp"
+#include "fw/sharded-forwarder.hpp"
 #include "face/null-face.hpp"
 #include "mgmt/internal-face.hpp"
 #include "mgmt/fib-manager.hpp"
@@ -76,6 +77,7 @@ public:
     initializeLogging();
 
     m_forwarder = make_shared<Forwarder>();
+    m_shardedForwarder = make_shared<ShardedForwarder>(ref(*m_forwarder));
 
     initializeManagement();
 
@@ -83,6 +85,9 @@ public:
     m_forwarder->getFaceTable().addReserved(
       make_shared<NullFace>(FaceUri("contentstore://")), FACEID_CONTENT_STORE);
 
+    // start worker threads after tables are configured and reserved faces are added
+    m_shardedForwarder->start();
+
     PrivilegeHelper::drop();
   }
 
@@ -141,6 +146,11 @@ public:
                                          m_internalFace,
                                          ndn::ref(m_keyChain));
 
+    m_fibManager->afterUpdate +=
+      bind(&ShardedForwarder::syncFibEntry, m_shardedForwarder.get(), _1);
+    m_strategyChoiceManager->afterUpdate +=
+      bind(&ShardedForwarder::syncStrategyChoice, m_shardedForwarder.get(), _1);
+
     m_statusServer = make_shared<StatusServer>(m_internalFace,
                                                ref(*m_forwarder),
                                                ndn::ref(m_keyChain));
@@ -155,6 +165,8 @@ public:
                                      m_forwarder->getMeasurements());
     tablesConfig.setConfigFile(config);
 
+    m_shardedForwarder->setConfigFile(config);
+
     m_internalFace->getValidator().setConfigFile(config);
 
     m_forwarder->getFaceTable().addReserved(m_internalFace, FACEID_INTERNAL_FACE);
@@ -299,6 +311,8 @@ public:
 
     tablesConfig.setConfigFile(config);
 
+    m_shardedForwarder->setConfigFile(config);
+
     m_internalFace->getValidator().setConfigFile(config);
     m_faceManager->setConfigFile(config);
 
@@ -313,6 +327,7 @@ private:
   std::string m_configFile;
 
   shared_ptr<Forwarder> m_forwarder;
+  shared_ptr<ShardedForwarder> m_shardedForwarder;
 
   shared_ptr<InternalFace>          m_internalFace;
   shared_ptr<FibManager>            m_fibManager;
@@ -32,6 +32,7 @@
 #include "face/face-flags.hpp"
 #include "face/tcp-factory.hpp"
 #include "face/udp-factory.hpp"
+#include "face/io-thread.hpp"
 #include "core/config-file.hpp"
 
 #ifdef HAVE_UNIX_SOCKETS
@@ -220,12 +221,14 @@ FaceManager::processSectionUnix(const ConfigSection& configSection, bool isDryRu
   // {
   //   listen yes ; set to 'no' to disable UNIX stream listener, default 'yes'
   //   path /var/run/nfd.sock ; UNIX stream listener path
+  //   max_write_size 65536 ; octets gathered into one write, 0 to write packets one by one
   // }
 
 #if defined(HAVE_UNIX_SOCKETS)
 
   bool needToListen = true;
   std::string path = "/var/run/nfd.sock";
+  size_t maxWriteSize = DEFAULT_STREAM_MAX_WRITE_SIZE;
 
   for (ConfigSection::const_iterator i = configSection.begin();
        i != configSection.end();
@@ -239,6 +242,18 @@ FaceManager::processSectionUnix(const ConfigSection& configSection, bool isDryRu
         {
           needToListen = parseYesNo(i, i->first, "unix");
         }
+      else if (i->first == "max_write_size")
+        {
+          try
+            {
+              maxWriteSize = i->second.get_value<size_t>();
+            }
+          catch (const std::exception& e)
+            {
+              throw ConfigFile::Error("Invalid value for option \"" +
+                                      i->first + "\" in \"unix\" section");
+            }
+        }
       else
         {
           throw ConfigFile::Error("Unrecognized option \"" + i->first + "\" in \"unix\" section");
@@ -262,6 +277,7 @@ FaceManager::processSectionUnix(const ConfigSection& configSection, bool isDryRu
 
       shared_ptr<UnixStreamFactory> factory = make_shared<UnixStreamFactory>();
       shared_ptr<UnixStreamChannel> unixChannel = factory->createChannel(path);
+      unixChannel->setMaxWriteSize(maxWriteSize);
 
       if (needToListen)
         {
@@ -287,12 +303,16 @@ FaceManager::processSectionTcp(const ConfigSection& configSection, bool isDryRun
   // {
   //   listen yes ; set to 'no' to disable TCP listener, default 'yes'
   //   port 6363 ; TCP listener port number
+  //   max_write_size 65536 ; octets gathered into one write, 0 to write packets one by one
+  //   listen_queues 1 ; SO_REUSEPORT acceptors, each with its own I/O thread
   // }
 
   std::string port = "6363";
   bool needToListen = true;
   bool enableV4 = true;
   bool enableV6 = true;
+  size_t maxWriteSize = DEFAULT_STREAM_MAX_WRITE_SIZE;
+  size_t nListenQueues = 1;
 
   for (ConfigSection::const_iterator i = configSection.begin();
        i != configSection.end();
@@ -324,6 +344,35 @@ FaceManager::processSectionTcp(const ConfigSection& configSection, bool isDryRun
         {
           enableV6 = parseYesNo(i, i->first, "tcp");
         }
+      else if (i->first == "max_write_size")
+        {
+          try
+            {
+              maxWriteSize = i->second.get_value<size_t>();
+            }
+          catch (const std::exception& e)
+            {
+              throw ConfigFile::Error("Invalid value for option \"" +
+                                      i->first + "\" in \"tcp\" section");
+            }
+        }
+      else if (i->first == "listen_queues")
+        {
+          try
+            {
+              nListenQueues = i->second.get_value<size_t>();
+            }
+          catch (const std::exception& e)
+            {
+              throw ConfigFile::Error("Invalid value for option \"" +
+                                      i->first + "\" in \"tcp\" section");
+            }
+          if (nListenQueues == 0 || (nListenQueues > 1 && !isReusePortSupported()))
+            {
+              throw ConfigFile::Error("Invalid value for option \"" +
+                                      i->first + "\" in \"tcp\" section");
+            }
+        }
       else
         {
           throw ConfigFile::Error("Unrecognized option \"" + i->first + "\" in \"tcp\" section");
@@ -350,6 +399,8 @@ FaceManager::processSectionTcp(const ConfigSection& configSection, bool isDryRun
       if (enableV4)
         {
           shared_ptr<TcpChannel> ipv4Channel = factory->createChannel("0.0.0.0", port);
+          ipv4Channel->setMaxWriteSize(maxWriteSize);
+          ipv4Channel->setNListenQueues(nListenQueues);
           if (needToListen)
             {
               // Should acceptFailed callback be used somehow?
@@ -363,6 +414,8 @@ FaceManager::processSectionTcp(const ConfigSection& configSection, bool isDryRun
       if (enableV6)
         {
           shared_ptr<TcpChannel> ipv6Channel = factory->createChannel("::", port);
+          ipv6Channel->setMaxWriteSize(maxWriteSize);
+          ipv6Channel->setNListenQueues(nListenQueues);
           if (needToListen)
             {
               // Should acceptFailed callback be used somehow?
@@ -386,6 +439,9 @@ FaceManager::processSectionUdp(const ConfigSection& configSection,
   //   port 6363 ; UDP unicast port number
   //   idle_timeout 30 ; idle time (seconds) before closing a UDP unicast face
   //   keep_alive_interval 25; interval (seconds) between keep-alive refreshes
+  //   io_batch_size 1 ; datagrams received or sent per syscall, 1 to disable recvmmsg/sendmmsg
+  //   shared_socket no ; set to 'yes' to serve all unicast peers from one socket per channel
+  //   listen_queues 1 ; SO_REUSEPORT sockets; all but the first have their own I/O thread
 
   //   ; NFD creates one UDP multicast face per NIC
   //   mcast yes ; set to 'no' to disable UDP multicast, default 'yes'
@@ -398,6 +454,9 @@ FaceManager::processSectionUdp(const ConfigSection& configSection,
   bool enableV6 = true;
   size_t timeout = 30;
   size_t keepAliveInterval = 25;
+  size_t ioBatchSize = 1;
+  bool isSocketShared = false;
+  size_t nListenQueues = 1;
   bool useMcast = true;
   std::string mcastGroup = "224.0.23.170";
   std::string mcastPort = "56363";
@@ -456,6 +515,39 @@ FaceManager::processSectionUdp(const ConfigSection& configSection,
                                       i->first + "\" in \"udp\" section");
             }
         }
+      else if (i->first == "io_batch_size")
+        {
+          try
+            {
+              ioBatchSize = i->second.get_value<size_t>();
+            }
+          catch (const std::exception& e)
+            {
+              throw ConfigFile::Error("Invalid value for option \"" +
+                                      i->first + "\" in \"udp\" section");
+            }
+        }
+      else if (i->first == "shared_socket")
+        {
+          isSocketShared = parseYesNo(i, i->first, "udp");
+        }
+      else if (i->first == "listen_queues")
+        {
+          try
+            {
+              nListenQueues = i->second.get_value<size_t>();
+            }
+          catch (const std::exception& e)
+            {
+              throw ConfigFile::Error("Invalid value for option \"" +
+                                      i->first + "\" in \"udp\" section");
+            }
+          if (nListenQueues == 0 || (nListenQueues > 1 && !isReusePortSupported()))
+            {
+              throw ConfigFile::Error("Invalid value for option \"" +
+                                      i->first + "\" in \"udp\" section");
+            }
+        }
       else if (i->first == "mcast")
         {
           useMcast = parseYesNo(i, i->first, "udp");
@@ -530,6 +622,9 @@ FaceManager::processSectionUdp(const ConfigSection& configSection,
         {
           shared_ptr<UdpChannel> v4Channel =
             factory->createChannel("0.0.0.0", port, time::seconds(timeout));
+          v4Channel->setIoBatchSize(ioBatchSize);
+          v4Channel->setSharedSocket(isSocketShared);
+          v4Channel->setNListenQueues(nListenQueues);
 
           v4Channel->listen(bind(&FaceTable::add, &m_faceTable, _1),
                             UdpChannel::ConnectFailedCallback());
@@ -541,6 +636,9 @@ FaceManager::processSectionUdp(const ConfigSection& configSection,
         {
           shared_ptr<UdpChannel> v6Channel =
             factory->createChannel("::", port, time::seconds(timeout));
+          v6Channel->setIoBatchSize(ioBatchSize);
+          v6Channel->setSharedSocket(isSocketShared);
+          v6Channel->setNListenQueues(nListenQueues);
 
           v6Channel->listen(bind(&FaceTable::add, &m_faceTable, _1),
                             UdpChannel::ConnectFailedCallback());
@@ -592,6 +690,7 @@ FaceManager::processSectionUdp(const ConfigSection& configSection,
                                                      mcastGroup,
                                                      mcastPort,
                                                      isNicNameNecessary ? nic->name : "");
+              newFace->setIoBatchSize(ioBatchSize);
 
               addCreatedFaceToForwarder(newFace);
               multicastFacesToRemove.remove(newFace);
@@ -638,6 +737,7 @@ FaceManager::processSectionEther(const ConfigSection& configSection,
   //   ; NFD creates one Ethernet multicast face per NIC
   //   mcast yes ; set to 'no' to disable Ethernet multicast, default 'yes'
   //   mcast_group 01:00:5E:00:17:AA ; Ethernet multicast group
+  //   backend pcap ; 'pcap' or 'packet_mmap' (Linux AF_PACKET rings), default 'pcap'
   // }
 
 #if defined(HAVE_LIBPCAP)
@@ -646,6 +746,7 @@ FaceManager::processSectionEther(const ConfigSection& configSection,
 
   bool useMcast = true;
   Address mcastGroup(ethernet::getDefaultMulticastAddress());
+  EthernetFace::Backend backend = EthernetFace::BACKEND_PCAP;
 
   for (ConfigSection::const_iterator i = configSection.begin();
        i != configSection.end();
@@ -665,6 +766,23 @@ FaceManager::processSectionEther(const ConfigSection& configSection,
                                       i->first + "\" in \"ether\" section");
             }
         }
+      else if (i->first == "backend")
+        {
+          const std::string value = i->second.get_value<std::string>();
+          if (value == "pcap")
+            {
+              backend = EthernetFace::BACKEND_PCAP;
+            }
+          else if (value == "packet_mmap" && EthernetFace::isPacketMmapSupported())
+            {
+              backend = EthernetFace::BACKEND_PACKET_MMAP;
+            }
+          else
+            {
+              throw ConfigFile::Error("Invalid value for option \"" +
+                                      i->first + "\" in \"ether\" section");
+            }
+        }
       else
         {
           throw ConfigFile::Error("Unrecognized option \"" + i->first + "\" in \"ether\" section");
@@ -681,6 +799,7 @@ FaceManager::processSectionEther(const ConfigSection& configSection,
         factory = ndn::make_shared<EthernetFactory>();
         m_factories.insert(std::make_pair("ether", factory));
       }
+      factory->setBackend(backend);
 
       if (useMcast)
         {
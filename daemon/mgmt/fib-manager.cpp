@@ -201,6 +201,7 @@ FibManager::addNextHop(ControlParameters& parameters,
                     << " cost: " << cost);
 
       setResponse(response, 200, "Success", parameters.wireEncode());
+      this->afterUpdate(prefix);
     }
   else
     {
@@ -238,6 +239,7 @@ FibManager::removeNextHop(ControlParameters& parameters,
             {
               m_managedFib.erase(*entry);
             }
+          this->afterUpdate(parameters.getName());
         }
       else
         {
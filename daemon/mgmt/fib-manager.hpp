@@ -28,6 +28,7 @@
 
 #include "common.hpp"
 #include "mgmt/manager-base.hpp"
+#include "core/event-emitter.hpp"
 #include "mgmt/fib-enumeration-publisher.hpp"
 
 namespace nfd {
@@ -53,6 +54,10 @@ public:
   void
   onFibRequest(const Interest& request);
 
+  /** \brief fires after a command changes the nexthops of the FIB entry at a prefix
+   */
+  EventEmitter<Name> afterUpdate;
+
 private:
 
   void
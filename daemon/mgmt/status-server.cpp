@@ -26,6 +26,7 @@
 #include "status-server.hpp"
 #include "fw/forwarder.hpp"
 #include "version.hpp"
+#include "core/status-tlv.hpp"
 
 namespace nfd {
 
@@ -52,7 +53,9 @@ StatusServer::onInterest(const Interest& interest) const
   data->setFreshnessPeriod(RESPONSE_FRESHNESS);
 
   shared_ptr<ndn::nfd::ForwarderStatus> status = this->collectStatus();
-  data->setContent(status->wireEncode());
+  Block content = status->wireEncode();
+  this->appendNfdStatus(content);
+  data->setContent(content);
 
   m_keyChain.sign(*data);
   m_face->put(*data);
@@ -78,4 +81,19 @@ StatusServer::collectStatus() const
   return status;
 }
 
+void
+StatusServer::appendNfdStatus(Block& content) const
+{
+  const Cs& cs = m_forwarder.getCs();
+
+  content.parse();
+  content.push_back(ndn::nonNegativeIntegerBlock(status_tlv::NCsBytes, cs.getNBytes()));
+  if (cs.getByteLimit() != std::numeric_limits<size_t>::max())
+    {
+      content.push_back(ndn::nonNegativeIntegerBlock(status_tlv::CsMaxBytes,
+                                                     cs.getByteLimit()));
+    }
+  content.encode();
+}
+
 } // namespace nfd
@@ -45,6 +45,12 @@ private:
   shared_ptr<ndn::nfd::ForwarderStatus>
   collectStatus() const;
 
+  /** \brief appends NFD-specific elements (see core/status-tlv.hpp)
+   *         after the ForwarderStatus elements in \p content
+   */
+  void
+  appendNfdStatus(Block& content) const;
+
 private:
   static const Name DATASET_PREFIX;
   static const time::milliseconds RESPONSE_FRESHNESS;
@@ -163,6 +163,7 @@ StrategyChoiceManager::setStrategy(ControlParameters& parameters,
     {
       NFD_LOG_DEBUG("strategy-choice result: SUCCESS");
       setResponse(response, 200, "Success", parameters.wireEncode());
+      this->afterUpdate(prefix);
     }
   else
     {
@@ -197,6 +198,7 @@ StrategyChoiceManager::unsetStrategy(ControlParameters& parameters,
 
   NFD_LOG_DEBUG("strategy-choice result: SUCCESS");
   setResponse(response, 200, "Success", parameters.wireEncode());
+  this->afterUpdate(parameters.getName());
 }
 
 
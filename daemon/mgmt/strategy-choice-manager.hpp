@@ -27,6 +27,7 @@
 #define NFD_DAEMON_MGMT_STRATEGY_CHOICE_MANAGER_HPP
 
 #include "mgmt/manager-base.hpp"
+#include "core/event-emitter.hpp"
 #include "mgmt/strategy-choice-publisher.hpp"
 
 #include <ndn-cxx/management/nfd-control-parameters.hpp>
@@ -50,6 +51,10 @@ public:
   void
   onStrategyChoiceRequest(const Interest& request);
 
+  /** \brief fires after a command sets or unsets the strategy of a prefix
+   */
+  EventEmitter<Name> afterUpdate;
+
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
 
   void
@@ -34,6 +34,10 @@ namespace nfd {
 NFD_LOG_INIT("TablesConfigSection");
 
 const size_t TablesConfigSection::DEFAULT_CS_MAX_PACKETS = 65536;
+const size_t TablesConfigSection::DEFAULT_CS_MAX_BYTES = std::numeric_limits<size_t>::max();
+const Cs::IndexType TablesConfigSection::DEFAULT_CS_INDEX = Cs::INDEX_SKIP_LIST;
+const std::string TablesConfigSection::DEFAULT_CS_POLICY = "fifo";
+const uint64_t TablesConfigSection::DEFAULT_CS_DISK_MAX_BYTES = 1073741824;
 
 TablesConfigSection::TablesConfigSection(Cs& cs,
                                          Pit& pit,
@@ -68,6 +72,7 @@ TablesConfigSection::ensureTablesAreConfigured()
 
   NFD_LOG_INFO("Setting CS max packets to " << DEFAULT_CS_MAX_PACKETS);
   m_cs.setLimit(DEFAULT_CS_MAX_PACKETS);
+  m_cs.setByteLimit(DEFAULT_CS_MAX_BYTES);
 
   m_areTablesConfigured = true;
 }
@@ -80,9 +85,19 @@ TablesConfigSection::onConfig(const ConfigSection& configSection,
   // tables
   // {
   //    cs_max_packets 65536
+  //    cs_max_bytes 536870912
+  //    cs_index skiplist
+  //    cs_policy fifo
+  //    cs_disk_path /var/cache/ndn/nfd-cs
+  //    cs_disk_max_bytes 1073741824
   // }
 
   size_t nCsMaxPackets = DEFAULT_CS_MAX_PACKETS;
+  size_t nCsMaxBytes = DEFAULT_CS_MAX_BYTES;
+  Cs::IndexType csIndexType = DEFAULT_CS_INDEX;
+  std::string csPolicyName = DEFAULT_CS_POLICY;
+  std::string csDiskPath;
+  uint64_t csDiskMaxBytes = DEFAULT_CS_DISK_MAX_BYTES;
 
   boost::optional<const ConfigSection&> csMaxPacketsNode =
     configSection.get_child_optional("cs_max_packets");
@@ -101,13 +116,164 @@ TablesConfigSection::onConfig(const ConfigSection& configSection,
       nCsMaxPackets = *valCsMaxPackets;
     }
 
+  boost::optional<const ConfigSection&> csMaxBytesNode =
+    configSection.get_child_optional("cs_max_bytes");
+
+  if (csMaxBytesNode)
+    {
+      boost::optional<size_t> valCsMaxBytes =
+        configSection.get_optional<size_t>("cs_max_bytes");
+
+      if (!valCsMaxBytes || *valCsMaxBytes == 0)
+        {
+          throw ConfigFile::Error("Invalid value for option \"cs_max_bytes\""
+                                  " in \"tables\" section");
+        }
+
+      nCsMaxBytes = *valCsMaxBytes;
+    }
+
+  boost::optional<std::string> valCsIndex =
+    configSection.get_optional<std::string>("cs_index");
+
+  if (valCsIndex)
+    {
+      if (*valCsIndex == "skiplist")
+        {
+          csIndexType = Cs::INDEX_SKIP_LIST;
+        }
+      else if (*valCsIndex == "btree")
+        {
+          csIndexType = Cs::INDEX_BTREE;
+        }
+      else
+        {
+          throw ConfigFile::Error("Invalid value for option \"cs_index\""
+                                  " in \"tables\" section");
+        }
+    }
+
+  boost::optional<std::string> valCsPolicy =
+    configSection.get_optional<std::string>("cs_policy");
+
+  if (valCsPolicy)
+    {
+      csPolicyName = *valCsPolicy;
+    }
+
+  shared_ptr<cs::Policy> csPolicy = cs::makePolicy(csPolicyName);
+  if (!static_cast<bool>(csPolicy))
+    {
+      throw ConfigFile::Error("Invalid value for option \"cs_policy\""
+                              " in \"tables\" section");
+    }
+
+  boost::optional<std::string> valCsDiskPath =
+    configSection.get_optional<std::string>("cs_disk_path");
+
+  if (valCsDiskPath)
+    {
+      if (valCsDiskPath->empty())
+        {
+          throw ConfigFile::Error("Invalid value for option \"cs_disk_path\""
+                                  " in \"tables\" section");
+        }
+
+      csDiskPath = *valCsDiskPath;
+    }
+
+  boost::optional<const ConfigSection&> csDiskMaxBytesNode =
+    configSection.get_child_optional("cs_disk_max_bytes");
+
+  if (csDiskMaxBytesNode)
+    {
+      boost::optional<uint64_t> valCsDiskMaxBytes =
+        configSection.get_optional<uint64_t>("cs_disk_max_bytes");
+
+      if (!valCsDiskMaxBytes || *valCsDiskMaxBytes == 0)
+        {
+          throw ConfigFile::Error("Invalid value for option \"cs_disk_max_bytes\""
+                                  " in \"tables\" section");
+        }
+
+      csDiskMaxBytes = *valCsDiskMaxBytes;
+    }
+
+  if (!csDiskPath.empty())
+    {
+      try
+        {
+          cs::DiskTier::checkSettings(csDiskPath, csDiskMaxBytes);
+        }
+      catch (cs::DiskTier::Error& e)
+        {
+          throw ConfigFile::Error("Cannot use \"cs_disk_path\" in \"tables\" section: " +
+                                  std::string(e.what()));
+        }
+    }
+
   if (!isDryRun)
     {
       NFD_LOG_INFO("Setting CS max packets to " << nCsMaxPackets);
 
       m_cs.setLimit(nCsMaxPackets);
+
+      if (nCsMaxBytes == DEFAULT_CS_MAX_BYTES)
+        {
+          NFD_LOG_INFO("Setting CS max bytes to unlimited");
+        }
+      else
+        {
+          NFD_LOG_INFO("Setting CS max bytes to " << nCsMaxBytes);
+        }
+      m_cs.setByteLimit(nCsMaxBytes);
+
+      NFD_LOG_INFO("Setting CS index to " << (csIndexType == Cs::INDEX_BTREE ?
+                                              "btree" : "skiplist"));
+      m_cs.setIndexType(csIndexType);
+
+      if (m_cs.getPolicy().getName() != csPolicy->getName())
+        {
+          NFD_LOG_INFO("Setting CS replacement policy to " << csPolicy->getName());
+          m_cs.setPolicy(csPolicy);
+        }
+
+      applyCsDiskTier(csDiskPath, csDiskMaxBytes);
+
       m_areTablesConfigured = true;
     }
 }
 
+void
+TablesConfigSection::applyCsDiskTier(const std::string& path, uint64_t capacity)
+{
+  const cs::DiskTier* diskTier = m_cs.getDiskTier();
+
+  if (path.empty())
+    {
+      if (diskTier != 0)
+        {
+          NFD_LOG_INFO("Disabling CS disk tier");
+          m_cs.disableDiskTier();
+        }
+      return;
+    }
+
+  if (diskTier != 0 && diskTier->getPath() == path && diskTier->getCapacity() == capacity)
+    {
+      return;
+    }
+
+  NFD_LOG_INFO("Setting CS disk tier to " << path << ", max bytes " << capacity);
+  try
+    {
+      m_cs.enableDiskTier(path, capacity);
+    }
+  catch (cs::DiskTier::Error& e)
+    {
+      throw ConfigFile::Error("Cannot use \"cs_disk_path\" in \"tables\" section: " +
+                              std::string(e.what()));
+    }
+}
+
 } // namespace nfd
@@ -58,6 +58,11 @@ private:
            bool isDryRun,
            const std::string& filename);
 
+  /** \brief enables, disables, or reopens the CS disk tier if its settings changed
+   */
+  void
+  applyCsDiskTier(const std::string& path, uint64_t capacity);
+
 private:
   Cs& m_cs;
   // Pit& m_pit;
@@ -70,6 +75,10 @@ private:
 private:
 
   static const size_t DEFAULT_CS_MAX_PACKETS;
+  static const size_t DEFAULT_CS_MAX_BYTES;
+  static const Cs::IndexType DEFAULT_CS_INDEX;
+  static const std::string DEFAULT_CS_POLICY;
+  static const uint64_t DEFAULT_CS_DISK_MAX_BYTES;
 };
 
 } // namespace nfd
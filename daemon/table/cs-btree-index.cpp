@@ -0,0 +1,278 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cs-btree-index.hpp"
+
+namespace nfd {
+namespace cs {
+
+const size_t BTreeIndex::MAX_LEAF_SIZE = 128;
+
+static inline uint64_t
+computeKeyHead(const uint8_t* buffer, size_t length)
+{
+  uint64_t head = 0;
+  for (size_t i = 0; i < sizeof(head); ++i) {
+    head <<= 8;
+    if (i < length) {
+      head |= buffer[i];
+    }
+  }
+  return head;
+}
+
+BTreeIndex::Key::Key(const Name& name)
+{
+  const Block& block = name.wireEncode();
+  buffer = block.value();
+  length = block.value_size();
+  head = computeKeyHead(buffer, length);
+}
+
+BTreeIndex::BTreeIndex()
+  : m_nEntries(0)
+{
+}
+
+BTreeIndex::~BTreeIndex()
+{
+  this->clear();
+}
+
+int
+BTreeIndex::compare(const Slot& slot, const Key& key)
+{
+  if (slot.keyHead != key.head) {
+    return slot.keyHead < key.head ? -1 : 1;
+  }
+
+  const Block& block = slot.entry->getFullName().wireEncode();
+  size_t length = std::min(block.value_size(), key.length);
+  int result = std::memcmp(block.value(), key.buffer, length);
+  if (result != 0) {
+    return result;
+  }
+  if (block.value_size() == key.length) {
+    return 0;
+  }
+  return block.value_size() < key.length ? -1 : 1;
+}
+
+size_t
+BTreeIndex::findLeaf(const Key& key) const
+{
+  BOOST_ASSERT(!m_leaves.empty());
+
+  // last leaf whose first key is not greater than key
+  size_t low = 0;
+  size_t high = m_separators.size();
+  while (high - low > 1) {
+    size_t middle = low + (high - low) / 2;
+    if (compare(m_separators[middle], key) <= 0) {
+      low = middle;
+    }
+    else {
+      high = middle;
+    }
+  }
+  return low;
+}
+
+size_t
+BTreeIndex::findSlot(const Leaf& leaf, const Key& key)
+{
+  size_t low = 0;
+  size_t high = leaf.size();
+  while (low < high) {
+    size_t middle = low + (high - low) / 2;
+    if (compare(leaf[middle], key) < 0) {
+      low = middle + 1;
+    }
+    else {
+      high = middle;
+    }
+  }
+  return low;
+}
+
+BTreeIndex::const_iterator
+BTreeIndex::lowerBound(const Name& name) const
+{
+  if (m_leaves.empty()) {
+    return this->end();
+  }
+
+  Key key(name);
+  size_t leafIndex = this->findLeaf(key);
+  size_t slotIndex = findSlot(*m_leaves[leafIndex], key);
+  if (slotIndex == m_leaves[leafIndex]->size()) {
+    // key is greater than every entry in this leaf; next leaf starts with a greater key
+    return const_iterator(this, leafIndex + 1, 0);
+  }
+  return const_iterator(this, leafIndex, slotIndex);
+}
+
+BTreeIndex::const_iterator
+BTreeIndex::find(const Name& fullName) const
+{
+  const_iterator it = this->lowerBound(fullName);
+  if (it != this->end() && (*it)->getFullName() == fullName) {
+    return it;
+  }
+  return this->end();
+}
+
+std::pair<Entry*, bool>
+BTreeIndex::insert(Entry* entry)
+{
+  Key key(entry->getFullName());
+  Slot slot = { key.head, entry };
+
+  if (m_leaves.empty()) {
+    m_leaves.push_back(new Leaf());
+    m_leaves.back()->reserve(MAX_LEAF_SIZE + 1);
+    m_leaves.back()->push_back(slot);
+    m_separators.push_back(slot);
+    ++m_nEntries;
+    return std::make_pair(entry, true);
+  }
+
+  size_t leafIndex = this->findLeaf(key);
+  Leaf& leaf = *m_leaves[leafIndex];
+  size_t slotIndex = findSlot(leaf, key);
+
+  if (slotIndex < leaf.size() && compare(leaf[slotIndex], key) == 0) {
+    return std::make_pair(leaf[slotIndex].entry, false);
+  }
+
+  leaf.insert(leaf.begin() + slotIndex, slot);
+  if (slotIndex == 0) {
+    m_separators[leafIndex] = slot;
+  }
+  ++m_nEntries;
+
+  if (leaf.size() > MAX_LEAF_SIZE) {
+    this->splitLeaf(leafIndex);
+  }
+  return std::make_pair(entry, true);
+}
+
+bool
+BTreeIndex::erase(Entry* entry)
+{
+  if (m_leaves.empty()) {
+    return false;
+  }
+
+  Key key(entry->getFullName());
+  size_t leafIndex = this->findLeaf(key);
+  Leaf& leaf = *m_leaves[leafIndex];
+  size_t slotIndex = findSlot(leaf, key);
+
+  if (slotIndex == leaf.size() || leaf[slotIndex].entry != entry) {
+    return false;
+  }
+
+  leaf.erase(leaf.begin() + slotIndex);
+  --m_nEntries;
+
+  if (leaf.empty()) {
+    delete m_leaves[leafIndex];
+    m_leaves.erase(m_leaves.begin() + leafIndex);
+    m_separators.erase(m_separators.begin() + leafIndex);
+    return true;
+  }
+
+  if (slotIndex == 0) {
+    m_separators[leafIndex] = leaf.front();
+  }
+
+  if (leaf.size() < MAX_LEAF_SIZE / 4) {
+    this->mergeLeaf(leafIndex);
+  }
+  return true;
+}
+
+void
+BTreeIndex::clear()
+{
+  for (std::vector<Leaf*>::iterator it = m_leaves.begin(); it != m_leaves.end(); ++it) {
+    delete *it;
+  }
+  m_leaves.clear();
+  m_separators.clear();
+  m_nEntries = 0;
+}
+
+void
+BTreeIndex::splitLeaf(size_t leafIndex)
+{
+  Leaf& leaf = *m_leaves[leafIndex];
+  Leaf::iterator middle = leaf.begin() + leaf.size() / 2;
+
+  Leaf* newLeaf = new Leaf();
+  newLeaf->reserve(MAX_LEAF_SIZE + 1);
+  newLeaf->assign(middle, leaf.end());
+  leaf.erase(middle, leaf.end());
+
+  m_leaves.insert(m_leaves.begin() + leafIndex + 1, newLeaf);
+  m_separators.insert(m_separators.begin() + leafIndex + 1, newLeaf->front());
+}
+
+void
+BTreeIndex::mergeLeaf(size_t leafIndex)
+{
+  // merge with the smaller neighbor, if both fit in one leaf
+  size_t left = 0;
+  if (leafIndex == 0) {
+    if (m_leaves.size() == 1) {
+      return;
+    }
+    left = 0;
+  }
+  else if (leafIndex + 1 == m_leaves.size()) {
+    left = leafIndex - 1;
+  }
+  else if (m_leaves[leafIndex + 1]->size() < m_leaves[leafIndex - 1]->size()) {
+    left = leafIndex;
+  }
+  else {
+    left = leafIndex - 1;
+  }
+
+  Leaf& leftLeaf = *m_leaves[left];
+  Leaf& rightLeaf = *m_leaves[left + 1];
+  if (leftLeaf.size() + rightLeaf.size() > MAX_LEAF_SIZE) {
+    return;
+  }
+
+  leftLeaf.insert(leftLeaf.end(), rightLeaf.begin(), rightLeaf.end());
+  delete m_leaves[left + 1];
+  m_leaves.erase(m_leaves.begin() + left + 1);
+  m_separators.erase(m_separators.begin() + left + 1);
+}
+
+} // namespace cs
+} // namespace nfd
@@ -0,0 +1,269 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_CS_BTREE_INDEX_HPP
+#define NFD_DAEMON_TABLE_CS_BTREE_INDEX_HPP
+
+#include "cs-entry.hpp"
+
+namespace nfd {
+namespace cs {
+
+/** \brief an ordered index of CS entries stored in contiguous nodes
+ *
+ *  This is a B+-tree of height two: a sorted array of leaf nodes, each holding
+ *  up to MAX_LEAF_SIZE entries in a contiguous array, and an array of separator
+ *  keys (the first key of each leaf) used to pick a leaf by binary search.
+ *
+ *  Entries are ordered by the TLV-VALUE of their full Name's wire encoding.
+ *  When all components have the same TLV-TYPE, comparing these octets lexicographically
+ *  gives the same order as NDN canonical Name ordering: component TLV-LENGTH is
+ *  compared before TLV-VALUE, and a Name is less than any Name it is a proper prefix of.
+ *  Each slot caches the first eight octets of its key, so most comparisons
+ *  do not dereference the entry.
+ */
+class BTreeIndex : noncopyable
+{
+public:
+  class const_iterator;
+
+  BTreeIndex();
+
+  ~BTreeIndex();
+
+  size_t
+  size() const;
+
+  bool
+  empty() const;
+
+  const_iterator
+  begin() const;
+
+  const_iterator
+  end() const;
+
+  /** \return the first entry whose full Name is not less than name
+   */
+  const_iterator
+  lowerBound(const Name& name) const;
+
+  /** \return the entry whose full Name equals fullName, or end()
+   */
+  const_iterator
+  find(const Name& fullName) const;
+
+  /** \brief inserts entry
+   *  \return{ the inserted entry and true; or, if an entry with the same full Name exists,
+   *           that entry and false }
+   *  \note Existing iterators are invalidated.
+   */
+  std::pair<Entry*, bool>
+  insert(Entry* entry);
+
+  /** \brief removes entry
+   *  \return whether entry was found and removed
+   *  \note Existing iterators are invalidated.
+   */
+  bool
+  erase(Entry* entry);
+
+  /** \brief removes all entries
+   */
+  void
+  clear();
+
+public:
+  /// maximum number of entries in a leaf node; a leaf is split in half when it overflows
+  static const size_t MAX_LEAF_SIZE;
+
+private:
+  struct Slot
+  {
+    uint64_t keyHead; // first 8 octets of the key, big endian, zero padded
+    Entry* entry;
+  };
+
+  typedef std::vector<Slot> Leaf;
+
+  struct Key
+  {
+    explicit
+    Key(const Name& name);
+
+    const uint8_t* buffer;
+    size_t length;
+    uint64_t head;
+  };
+
+  /** \brief compares slot's key with key
+   *  \return negative, zero, or positive, if slot's key is less than,
+   *          equal to, or greater than key
+   */
+  static int
+  compare(const Slot& slot, const Key& key);
+
+  /** \return index of the leaf that should contain key
+   *  \pre !m_leaves.empty()
+   */
+  size_t
+  findLeaf(const Key& key) const;
+
+  /** \return position of the first slot in leaf whose key is not less than key
+   */
+  static size_t
+  findSlot(const Leaf& leaf, const Key& key);
+
+  void
+  splitLeaf(size_t leafIndex);
+
+  void
+  mergeLeaf(size_t leafIndex);
+
+private:
+  std::vector<Leaf*> m_leaves;
+  std::vector<Slot> m_separators; // first slot of each leaf
+  size_t m_nEntries;
+
+  friend class const_iterator;
+};
+
+/** \brief a bidirectional iterator over the entries of BTreeIndex in Name order
+ *
+ *  Dereferencing yields cs::Entry*.
+ */
+class BTreeIndex::const_iterator
+  : public std::iterator<std::bidirectional_iterator_tag, Entry* const>
+{
+public:
+  const_iterator();
+
+  const_iterator(const BTreeIndex* index, size_t leafIndex, size_t slotIndex);
+
+  Entry* const&
+  operator*() const;
+
+  const_iterator&
+  operator++();
+
+  const_iterator&
+  operator--();
+
+  bool
+  operator==(const const_iterator& other) const;
+
+  bool
+  operator!=(const const_iterator& other) const;
+
+private:
+  const BTreeIndex* m_index;
+  size_t m_leafIndex;
+  size_t m_slotIndex;
+};
+
+inline size_t
+BTreeIndex::size() const
+{
+  return m_nEntries;
+}
+
+inline bool
+BTreeIndex::empty() const
+{
+  return m_nEntries == 0;
+}
+
+inline BTreeIndex::const_iterator
+BTreeIndex::begin() const
+{
+  return const_iterator(this, 0, 0);
+}
+
+inline BTreeIndex::const_iterator
+BTreeIndex::end() const
+{
+  return const_iterator(this, m_leaves.size(), 0);
+}
+
+inline
+BTreeIndex::const_iterator::const_iterator()
+  : m_index(0)
+  , m_leafIndex(0)
+  , m_slotIndex(0)
+{
+}
+
+inline
+BTreeIndex::const_iterator::const_iterator(const BTreeIndex* index,
+                                           size_t leafIndex, size_t slotIndex)
+  : m_index(index)
+  , m_leafIndex(leafIndex)
+  , m_slotIndex(slotIndex)
+{
+}
+
+inline Entry* const&
+BTreeIndex::const_iterator::operator*() const
+{
+  return (*m_index->m_leaves[m_leafIndex])[m_slotIndex].entry;
+}
+
+inline BTreeIndex::const_iterator&
+BTreeIndex::const_iterator::operator++()
+{
+  if (++m_slotIndex == m_index->m_leaves[m_leafIndex]->size()) {
+    ++m_leafIndex;
+    m_slotIndex = 0;
+  }
+  return *this;
+}
+
+inline BTreeIndex::const_iterator&
+BTreeIndex::const_iterator::operator--()
+{
+  if (m_slotIndex == 0) {
+    --m_leafIndex;
+    m_slotIndex = m_index->m_leaves[m_leafIndex]->size();
+  }
+  --m_slotIndex;
+  return *this;
+}
+
+inline bool
+BTreeIndex::const_iterator::operator==(const const_iterator& other) const
+{
+  return m_leafIndex == other.m_leafIndex && m_slotIndex == other.m_slotIndex;
+}
+
+inline bool
+BTreeIndex::const_iterator::operator!=(const const_iterator& other) const
+{
+  return !(*this == other);
+}
+
+} // namespace cs
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_CS_BTREE_INDEX_HPP
@@ -0,0 +1,408 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cs-disk-tier.hpp"
+#include "name-tree.hpp"
+#include "core/logger.hpp"
+
+#include <ndn-cxx/util/crypto.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+NFD_LOG_INIT("CsDiskTier");
+
+namespace nfd {
+namespace cs {
+
+static const uint64_t FILE_MAGIC = 0x4e46444353445431ULL; // "NFDCSDT1"
+static const uint32_t FILE_VERSION = 1;
+/// the record area starts at the second page
+static const size_t FILE_HEADER_SIZE = 4096;
+static const uint32_t RECORD_MAGIC = 0x4e444352; // "NDCR"
+static const uint32_t PADDING_MAGIC = 0x4e444350; // "NDCP"
+static const uint32_t RECORD_FLAG_ERASED = 1;
+static const uint64_t RECORD_ALIGNMENT = 8;
+
+struct DiskTier::FileHeader
+{
+  uint64_t magic;
+  uint32_t version;
+  uint32_t hashSize; // sizeof(size_t) of the name_tree::computeHash that indexed the file
+  uint64_t capacity;
+  uint64_t head; // logical offset where the next record is written
+  uint64_t tail; // logical offset of the oldest record
+};
+
+struct DiskTier::RecordHeader
+{
+  uint32_t magic;
+  uint32_t flags;
+  uint32_t dataSize;
+  uint32_t recordSize; // including this header and padding
+  uint64_t nameHash;
+  int64_t staleAt; // milliseconds since Unix epoch
+  uint8_t digest[ndn::crypto::SHA256_DIGEST_SIZE];
+};
+
+static std::string
+describeErrno(const std::string& what, const std::string& path)
+{
+  return what + " " + path + ": " + std::strerror(errno);
+}
+
+DiskTier::DiskTier(const std::string& path, uint64_t capacity)
+  : m_path(path)
+  , m_capacity(capacity)
+  , m_fd(-1)
+  , m_map(0)
+  , m_mapSize(FILE_HEADER_SIZE + m_capacity)
+{
+  checkSettings(path, m_capacity);
+
+  m_fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+  if (m_fd < 0)
+    throw Error(describeErrno("Cannot open", path));
+
+  struct stat st;
+  if (::fstat(m_fd, &st) != 0)
+    {
+      ::close(m_fd);
+      throw Error(describeErrno("Cannot stat", path));
+    }
+
+  bool isSizeMatched = static_cast<uint64_t>(st.st_size) == m_mapSize;
+  if (!isSizeMatched && ::ftruncate(m_fd, m_mapSize) != 0)
+    {
+      ::close(m_fd);
+      throw Error(describeErrno("Cannot resize", path));
+    }
+
+  void* map = ::mmap(0, m_mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+  if (map == MAP_FAILED)
+    {
+      ::close(m_fd);
+      throw Error(describeErrno("Cannot map", path));
+    }
+  m_map = static_cast<uint8_t*>(map);
+
+  const FileHeader& header = getFileHeader();
+  if (isSizeMatched &&
+      header.magic == FILE_MAGIC &&
+      header.version == FILE_VERSION &&
+      header.hashSize == sizeof(size_t) &&
+      header.capacity == m_capacity &&
+      header.tail <= header.head &&
+      header.head - header.tail <= m_capacity)
+    {
+      rebuildIndex();
+    }
+  else
+    {
+      initializeFile();
+    }
+}
+
+void
+DiskTier::checkSettings(const std::string& path, uint64_t capacity)
+{
+  if (capacity < sizeof(RecordHeader))
+    throw Error("Capacity of " + path + " is too small");
+
+  std::string directory = boost::filesystem::absolute(path).parent_path().string();
+  if (::access(directory.c_str(), W_OK | X_OK) != 0)
+    throw Error(describeErrno("Cannot access", directory));
+
+  if (::access(path.c_str(), F_OK) == 0 && ::access(path.c_str(), R_OK | W_OK) != 0)
+    throw Error(describeErrno("Cannot access", path));
+}
+
+DiskTier::~DiskTier()
+{
+  sync();
+  ::munmap(m_map, m_mapSize);
+  ::close(m_fd);
+}
+
+void
+DiskTier::sync()
+{
+  if (::msync(m_map, m_mapSize, MS_SYNC) != 0)
+    NFD_LOG_WARN(describeErrno("Cannot sync", m_path));
+}
+
+DiskTier::FileHeader&
+DiskTier::getFileHeader() const
+{
+  return *reinterpret_cast<FileHeader*>(m_map);
+}
+
+DiskTier::RecordHeader*
+DiskTier::getRecordHeader(uint64_t offset) const
+{
+  uint64_t position = offset % m_capacity;
+  if (m_capacity - position < sizeof(RecordHeader))
+    return 0;
+
+  return reinterpret_cast<RecordHeader*>(m_map + FILE_HEADER_SIZE + position);
+}
+
+uint64_t
+DiskTier::getNBytes() const
+{
+  const FileHeader& header = getFileHeader();
+  return header.head - header.tail;
+}
+
+void
+DiskTier::initializeFile()
+{
+  NFD_LOG_INFO("Initializing " << m_path << " capacity=" << m_capacity);
+
+  FileHeader& header = getFileHeader();
+  header.magic = FILE_MAGIC;
+  header.version = FILE_VERSION;
+  header.hashSize = sizeof(size_t);
+  header.capacity = m_capacity;
+  header.head = 0;
+  header.tail = 0;
+  m_index.clear();
+}
+
+void
+DiskTier::rebuildIndex()
+{
+  FileHeader& header = getFileHeader();
+  m_index.clear();
+
+  uint64_t offset = header.tail;
+  while (offset < header.head)
+    {
+      const RecordHeader* record = getRecordHeader(offset);
+      if (record == 0 || record->magic == PADDING_MAGIC)
+        {
+          offset += m_capacity - offset % m_capacity;
+          continue;
+        }
+
+      if (record->magic != RECORD_MAGIC ||
+          record->recordSize < sizeof(RecordHeader) + record->dataSize ||
+          record->recordSize % RECORD_ALIGNMENT != 0 ||
+          offset % m_capacity + record->recordSize > m_capacity)
+        {
+          NFD_LOG_WARN("Invalid record in " << m_path << " at " << offset
+                       << ", discarding later records");
+          header.head = offset;
+          break;
+        }
+
+      if ((record->flags & RECORD_FLAG_ERASED) == 0)
+        m_index.insert(std::make_pair(record->nameHash, offset));
+
+      offset += record->recordSize;
+    }
+
+  NFD_LOG_INFO("Indexed " << m_index.size() << " Data in " << m_path);
+}
+
+DiskTier::Index::iterator
+DiskTier::findIndexElement(uint64_t nameHash, uint64_t offset)
+{
+  std::pair<Index::iterator, Index::iterator> range = m_index.equal_range(nameHash);
+  for (Index::iterator it = range.first; it != range.second; ++it)
+    {
+      if (it->second == offset)
+        return it;
+    }
+  return m_index.end();
+}
+
+DiskTier::Index::iterator
+DiskTier::findIndexElement(uint64_t nameHash, const name::Component& digest)
+{
+  // the implicit digest covers the whole Data packet, so the Name need not be compared
+  std::pair<Index::iterator, Index::iterator> range = m_index.equal_range(nameHash);
+  for (Index::iterator it = range.first; it != range.second; ++it)
+    {
+      const RecordHeader* record = getRecordHeader(it->second);
+      if (std::memcmp(record->digest, digest.value(), sizeof(record->digest)) == 0)
+        return it;
+    }
+  return m_index.end();
+}
+
+void
+DiskTier::evictOldest()
+{
+  FileHeader& header = getFileHeader();
+  BOOST_ASSERT(header.tail < header.head);
+
+  const RecordHeader* record = getRecordHeader(header.tail);
+  if (record == 0 || record->magic == PADDING_MAGIC)
+    {
+      header.tail += m_capacity - header.tail % m_capacity;
+      return;
+    }
+
+  Index::iterator it = findIndexElement(record->nameHash, header.tail);
+  if (it != m_index.end())
+    m_index.erase(it);
+
+  header.tail += record->recordSize;
+}
+
+bool
+DiskTier::insert(const Data& data, const time::system_clock::TimePoint& staleAt)
+{
+  const Name& fullName = data.getFullName();
+  const name::Component& digest = fullName.get(-1);
+  BOOST_ASSERT(digest.value_size() == ndn::crypto::SHA256_DIGEST_SIZE);
+
+  uint64_t nameHash = name_tree::computeHash(data.getName());
+  if (findIndexElement(nameHash, digest) != m_index.end())
+    return false;
+
+  const Block& wire = data.wireEncode();
+  uint64_t recordSize = sizeof(RecordHeader) + wire.size();
+  recordSize += (RECORD_ALIGNMENT - recordSize % RECORD_ALIGNMENT) % RECORD_ALIGNMENT;
+  if (recordSize > m_capacity)
+    return false;
+
+  FileHeader& header = getFileHeader();
+  uint64_t position = header.head % m_capacity;
+  uint64_t padding = (position + recordSize > m_capacity) ? m_capacity - position : 0;
+
+  while (header.head + padding + recordSize - header.tail > m_capacity)
+    evictOldest();
+
+  if (padding > 0)
+    {
+      RecordHeader* paddingRecord = getRecordHeader(header.head);
+      if (paddingRecord != 0)
+        paddingRecord->magic = PADDING_MAGIC;
+      header.head += padding;
+    }
+
+  RecordHeader* record = getRecordHeader(header.head);
+  BOOST_ASSERT(record != 0);
+  record->magic = RECORD_MAGIC;
+  record->flags = 0;
+  record->dataSize = wire.size();
+  record->recordSize = recordSize;
+  record->nameHash = nameHash;
+  record->staleAt = time::toUnixTimestamp(staleAt).count();
+  std::memcpy(record->digest, digest.value(), sizeof(record->digest));
+  std::memcpy(reinterpret_cast<uint8_t*>(record) + sizeof(RecordHeader), wire.wire(), wire.size());
+
+  m_index.insert(std::make_pair(record->nameHash, header.head));
+  header.head += recordSize;
+  return true;
+}
+
+shared_ptr<Data>
+DiskTier::find(const Name& name, bool mustBeFresh, time::system_clock::TimePoint& staleAt) const
+{
+  shared_ptr<Data> match = findRecord(name, 0, mustBeFresh, staleAt);
+  if (static_cast<bool>(match) || name.empty())
+    return match;
+
+  const name::Component& lastComponent = name.get(-1);
+  if (lastComponent.value_size() != ndn::crypto::SHA256_DIGEST_SIZE)
+    return match;
+
+  return findRecord(name.getPrefix(-1), &lastComponent, mustBeFresh, staleAt);
+}
+
+shared_ptr<Data>
+DiskTier::findRecord(const Name& dataName, const name::Component* digest, bool mustBeFresh,
+                     time::system_clock::TimePoint& staleAt) const
+{
+  int64_t now = time::toUnixTimestamp(time::system_clock::now()).count();
+
+  // examine candidates from the newest record
+  std::vector<uint64_t> offsets;
+  std::pair<Index::const_iterator, Index::const_iterator> range =
+    m_index.equal_range(name_tree::computeHash(dataName));
+  for (Index::const_iterator it = range.first; it != range.second; ++it)
+    offsets.push_back(it->second);
+  std::sort(offsets.begin(), offsets.end(), std::greater<uint64_t>());
+
+  for (std::vector<uint64_t>::const_iterator it = offsets.begin(); it != offsets.end(); ++it)
+    {
+      const RecordHeader* record = getRecordHeader(*it);
+      BOOST_ASSERT(record != 0 && record->magic == RECORD_MAGIC);
+
+      if (digest != 0 && std::memcmp(record->digest, digest->value(), sizeof(record->digest)) != 0)
+        continue;
+
+      if (mustBeFresh && record->staleAt < now)
+        continue;
+
+      shared_ptr<Data> data;
+      try {
+        data = make_shared<Data>(Block(reinterpret_cast<const uint8_t*>(record) +
+                                       sizeof(RecordHeader), record->dataSize));
+      }
+      catch (tlv::Error& e) {
+        NFD_LOG_WARN("Cannot decode record in " << m_path << " at " << *it << ": " << e.what());
+        continue;
+      }
+
+      if (data->getName() != dataName)
+        continue; // hash collision
+
+      staleAt = time::fromUnixTimestamp(time::milliseconds(record->staleAt));
+      return data;
+    }
+
+  return shared_ptr<Data>();
+}
+
+void
+DiskTier::erase(const Name& fullName)
+{
+  if (fullName.empty())
+    return;
+
+  const name::Component& digest = fullName.get(-1);
+  if (digest.value_size() != ndn::crypto::SHA256_DIGEST_SIZE)
+    return;
+
+  Index::iterator it = findIndexElement(name_tree::computeHash(fullName.getPrefix(-1)), digest);
+  if (it == m_index.end())
+    return;
+
+  getRecordHeader(it->second)->flags |= RECORD_FLAG_ERASED;
+  m_index.erase(it);
+}
+
+} // namespace cs
+} // namespace nfd
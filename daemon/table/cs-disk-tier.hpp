@@ -0,0 +1,195 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_CS_DISK_TIER_HPP
+#define NFD_DAEMON_TABLE_CS_DISK_TIER_HPP
+
+#include "common.hpp"
+
+#include <boost/unordered_map.hpp>
+
+namespace nfd {
+namespace cs {
+
+/** \brief represents the on-disk second tier of Content Store
+ *
+ *  Data packets are appended to a ring of records in a memory-mapped file.
+ *  When the ring is full, the oldest records are overwritten.
+ *  The index maps the hash of Data Name to record offsets; each record header keeps
+ *  the Name hash and the implicit digest, so that the index is rebuilt at startup
+ *  by scanning record headers only.
+ *
+ *  File layout: a FileHeader in the first page, followed by \p capacity bytes of records.
+ *  A record is a RecordHeader followed by the Data wire encoding, padded to 8 octets.
+ */
+class DiskTier : noncopyable
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    explicit
+    Error(const std::string& what)
+      : std::runtime_error(what)
+    {
+    }
+  };
+
+  /** \brief opens or creates the file at \p path
+   *
+   *  Records in an existing file are indexed. A file with another capacity or format
+   *  is reinitialized and its records are discarded.
+   *  \throw Error the file cannot be opened or mapped
+   */
+  DiskTier(const std::string& path, uint64_t capacity);
+
+  /** \brief checks that a DiskTier could be opened with these settings,
+   *         without creating or opening the file
+   *  \throw Error capacity is too small, or the file or its directory is not accessible
+   */
+  static void
+  checkSettings(const std::string& path, uint64_t capacity);
+
+  ~DiskTier();
+
+  const std::string&
+  getPath() const;
+
+  /** \return size of the record area in bytes
+   */
+  uint64_t
+  getCapacity() const;
+
+  /** \return number of indexed Data packets
+   */
+  size_t
+  size() const;
+
+  /** \return number of bytes used by records, including overwritten padding
+   */
+  uint64_t
+  getNBytes() const;
+
+  /** \brief writes a Data packet, overwriting the oldest records to make room
+   *  \param staleAt absolute time when Data becomes expired
+   *  \return{ whether the Data is written; false if it is already stored or too large }
+   */
+  bool
+  insert(const Data& data, const time::system_clock::TimePoint& staleAt);
+
+  /** \brief finds a Data packet whose Name or full Name equals \p name
+   *
+   *  Among several Data with the same Name, the most recently written is returned.
+   *  \param[out] staleAt absolute time when the returned Data becomes expired
+   *  \return{ the Data, or an empty pointer if none matches }
+   */
+  shared_ptr<Data>
+  find(const Name& name, bool mustBeFresh, time::system_clock::TimePoint& staleAt) const;
+
+  /** \brief removes the Data packet with full Name \p fullName
+   *
+   *  The record is marked erased, so it is not indexed again after restart.
+   */
+  void
+  erase(const Name& fullName);
+
+  /** \brief writes modified pages back to the file
+   */
+  void
+  sync();
+
+private:
+  struct FileHeader;
+  struct RecordHeader;
+  typedef boost::unordered_multimap<uint64_t, uint64_t> Index; // Name hash => record offset
+
+  FileHeader&
+  getFileHeader() const;
+
+  /** \return the record header at logical \p offset,
+   *          or 0 if \p offset is in the padding before the end of the ring
+   */
+  RecordHeader*
+  getRecordHeader(uint64_t offset) const;
+
+  /** \return the Index element that refers to the record at \p offset
+   */
+  Index::iterator
+  findIndexElement(uint64_t nameHash, uint64_t offset);
+
+  /** \return the Index element that refers to the record with \p digest
+   */
+  Index::iterator
+  findIndexElement(uint64_t nameHash, const name::Component& digest);
+
+  /** \brief finds the newest record of a Data with \p dataName,
+   *         and with \p digest if it is not null
+   */
+  shared_ptr<Data>
+  findRecord(const Name& dataName, const name::Component* digest, bool mustBeFresh,
+             time::system_clock::TimePoint& staleAt) const;
+
+  void
+  initializeFile();
+
+  void
+  rebuildIndex();
+
+  /** \brief drops the oldest record or padding from the ring
+   */
+  void
+  evictOldest();
+
+private:
+  std::string m_path;
+  uint64_t m_capacity;
+  int m_fd;
+  uint8_t* m_map;
+  size_t m_mapSize;
+  Index m_index;
+};
+
+inline const std::string&
+DiskTier::getPath() const
+{
+  return m_path;
+}
+
+inline uint64_t
+DiskTier::getCapacity() const
+{
+  return m_capacity;
+}
+
+inline size_t
+DiskTier::size() const
+{
+  return m_index.size();
+}
+
+} // namespace cs
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_CS_DISK_TIER_HPP
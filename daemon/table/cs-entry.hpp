@@ -93,6 +93,12 @@ public:
   void
   updateStaleTime();
 
+  /** \brief sets the absolute time when Data becomes expired,
+   *  for Data that has been stored elsewhere since its arrival
+   */
+  void
+  setStaleTime(const time::steady_clock::TimePoint& staleAt);
+
   /** \brief saves the iterator pointing to the CS entry on a specific layer of skip list
    */
   void
@@ -158,6 +164,12 @@ Entry::getStaleTime() const
   return m_staleAt;
 }
 
+inline void
+Entry::setStaleTime(const time::steady_clock::TimePoint& staleAt)
+{
+  m_staleAt = staleAt;
+}
+
 inline const Entry::LayerIterators&
 Entry::getIterators() const
 {
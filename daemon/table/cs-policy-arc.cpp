@@ -0,0 +1,144 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cs-policy-arc.hpp"
+
+namespace nfd {
+namespace cs {
+
+const std::string ArcPolicy::POLICY_NAME = "arc";
+
+ArcPolicy::ArcPolicy()
+  : Policy(POLICY_NAME)
+  , m_target(0)
+{
+}
+
+void
+ArcPolicy::afterInsert(Entry* entry)
+{
+  const Name& fullName = entry->getFullName();
+
+  GhostList::nth_index<1>::type::iterator ghost = m_b1.get<1>().find(fullName);
+  if (ghost != m_b1.get<1>().end())
+    {
+      // recently evicted from T1: T1 deserves more room
+      size_t delta = std::max<size_t>(m_b2.size() / m_b1.size(), 1);
+      m_target = std::min(m_target + delta, getLimit());
+      m_b1.get<1>().erase(ghost);
+      m_t2.push_back(entry);
+      this->trimGhosts();
+      return;
+    }
+
+  ghost = m_b2.get<1>().find(fullName);
+  if (ghost != m_b2.get<1>().end())
+    {
+      // recently evicted from T2: T2 deserves more room
+      size_t delta = std::max<size_t>(m_b1.size() / m_b2.size(), 1);
+      m_target = m_target > delta ? m_target - delta : 0;
+      m_b2.get<1>().erase(ghost);
+      m_t2.push_back(entry);
+      this->trimGhosts();
+      return;
+    }
+
+  m_t1.push_back(entry);
+  this->trimGhosts();
+}
+
+void
+ArcPolicy::afterRefresh(Entry* entry)
+{
+  this->recordUse(entry);
+}
+
+void
+ArcPolicy::beforeUse(Entry* entry)
+{
+  this->recordUse(entry);
+}
+
+void
+ArcPolicy::beforeErase(Entry* entry)
+{
+  if (m_t1.get<1>().erase(entry) == 0)
+    m_t2.get<1>().erase(entry);
+}
+
+Entry*
+ArcPolicy::evictEntry()
+{
+  if (!m_t1.empty() && (m_t1.size() > m_target || m_t2.empty()))
+    {
+      Entry* entry = m_t1.front();
+      m_t1.pop_front();
+      m_b1.push_back(entry->getFullName());
+      return entry;
+    }
+
+  if (!m_t2.empty())
+    {
+      Entry* entry = m_t2.front();
+      m_t2.pop_front();
+      m_b2.push_back(entry->getFullName());
+      return entry;
+    }
+
+  return 0;
+}
+
+void
+ArcPolicy::recordUse(Entry* entry)
+{
+  UseQueue::nth_index<1>::type::iterator it = m_t1.get<1>().find(entry);
+  if (it != m_t1.get<1>().end())
+    {
+      m_t1.get<1>().erase(it);
+      m_t2.push_back(entry);
+      return;
+    }
+
+  it = m_t2.get<1>().find(entry);
+  if (it != m_t2.get<1>().end())
+    {
+      m_t2.relocate(m_t2.end(), m_t2.project<0>(it));
+    }
+}
+
+void
+ArcPolicy::trimGhosts()
+{
+  size_t limit = getLimit();
+
+  while (!m_b1.empty() && m_t1.size() + m_b1.size() > limit)
+    m_b1.pop_front();
+
+  while (!m_b2.empty() && m_t1.size() + m_t2.size() + m_b1.size() + m_b2.size() > 2 * limit)
+    m_b2.pop_front();
+}
+
+} // namespace cs
+} // namespace nfd
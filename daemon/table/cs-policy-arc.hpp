@@ -0,0 +1,115 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_CS_POLICY_ARC_HPP
+#define NFD_DAEMON_TABLE_CS_POLICY_ARC_HPP
+
+#include "cs-policy.hpp"
+#include "cs-policy-lru.hpp"
+
+#include <boost/multi_index/ordered_index.hpp>
+
+namespace nfd {
+namespace cs {
+
+/** \brief Adaptive Replacement Cache policy
+ *
+ *  Reference: "ARC: A Self-Tuning, Low Overhead Replacement Cache" by N.Megiddo and D.Modha
+ *
+ *  Entries used once are kept in T1, entries used more than once in T2.
+ *  B1 and B2 remember the full Names of entries recently evicted from T1 and T2;
+ *  a new Data whose Name is found there adapts the target size of T1.
+ *
+ *  Cs asks for a victim before the incoming Data is inserted, so the replacement rule
+ *  cannot consider whether the incoming Name is in B2: T1 is evicted when it is larger
+ *  than its target size or T2 is empty.
+ */
+class ArcPolicy : public Policy
+{
+public:
+  ArcPolicy();
+
+  virtual void
+  afterInsert(Entry* entry);
+
+  virtual void
+  afterRefresh(Entry* entry);
+
+  virtual void
+  beforeUse(Entry* entry);
+
+  virtual void
+  beforeErase(Entry* entry);
+
+  virtual Entry*
+  evictEntry();
+
+  /** \return target size of T1
+   */
+  size_t
+  getTarget() const;
+
+public:
+  static const std::string POLICY_NAME;
+
+private:
+  /** \brief Names of evicted entries: least recently evicted in the front
+   */
+  typedef boost::multi_index_container<
+    Name,
+    boost::multi_index::indexed_by<
+      boost::multi_index::sequenced<>,
+      boost::multi_index::ordered_unique<boost::multi_index::identity<Name> >
+    >
+  > GhostList;
+
+  /** \brief moves an entry in T1 or T2 to the back of T2
+   */
+  void
+  recordUse(Entry* entry);
+
+  /** \brief pops ghosts so that |T1|+|B1| <= c and |T1|+|T2|+|B1|+|B2| <= 2c
+   */
+  void
+  trimGhosts();
+
+private:
+  UseQueue m_t1;
+  UseQueue m_t2;
+  GhostList m_b1;
+  GhostList m_b2;
+  size_t m_target; // target size of T1, "p" in the paper
+};
+
+inline size_t
+ArcPolicy::getTarget() const
+{
+  return m_target;
+}
+
+} // namespace cs
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_CS_POLICY_ARC_HPP
@@ -0,0 +1,88 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cs-policy-lfu.hpp"
+
+namespace nfd {
+namespace cs {
+
+const std::string LfuPolicy::POLICY_NAME = "lfu";
+
+LfuPolicy::LfuPolicy()
+  : Policy(POLICY_NAME)
+  , m_clock(0)
+{
+}
+
+void
+LfuPolicy::afterInsert(Entry* entry)
+{
+  Record record;
+  record.entry = entry;
+  record.frequency = 1;
+  record.lastUse = ++m_clock;
+  m_queue.insert(record);
+}
+
+void
+LfuPolicy::afterRefresh(Entry* entry)
+{
+  this->recordUse(entry);
+}
+
+void
+LfuPolicy::beforeUse(Entry* entry)
+{
+  this->recordUse(entry);
+}
+
+void
+LfuPolicy::beforeErase(Entry* entry)
+{
+  m_queue.get<1>().erase(entry);
+}
+
+Entry*
+LfuPolicy::evictEntry()
+{
+  if (m_queue.empty())
+    return 0;
+
+  Entry* entry = m_queue.begin()->entry;
+  m_queue.erase(m_queue.begin());
+  return entry;
+}
+
+void
+LfuPolicy::recordUse(Entry* entry)
+{
+  Queue::nth_index<1>::type& entryIndex = m_queue.get<1>();
+  Queue::nth_index<1>::type::iterator it = entryIndex.find(entry);
+  if (it != entryIndex.end())
+    entryIndex.modify(it, IncrementFrequency(++m_clock));
+}
+
+} // namespace cs
+} // namespace nfd
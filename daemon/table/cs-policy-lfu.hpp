@@ -0,0 +1,136 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_CS_POLICY_LFU_HPP
+#define NFD_DAEMON_TABLE_CS_POLICY_LFU_HPP
+
+#include "cs-policy.hpp"
+
+#include <boost/multi_index_container.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/identity.hpp>
+
+namespace nfd {
+namespace cs {
+
+/** \brief Least Frequently Used replacement policy
+ *
+ *  Each entry counts its insertions, refreshes and cache hits;
+ *  the entry with the smallest count is evicted,
+ *  and among equal counts the one used least recently.
+ */
+class LfuPolicy : public Policy
+{
+public:
+  LfuPolicy();
+
+  virtual void
+  afterInsert(Entry* entry);
+
+  virtual void
+  afterRefresh(Entry* entry);
+
+  virtual void
+  beforeUse(Entry* entry);
+
+  virtual void
+  beforeErase(Entry* entry);
+
+  virtual Entry*
+  evictEntry();
+
+public:
+  static const std::string POLICY_NAME;
+
+private:
+  void
+  recordUse(Entry* entry);
+
+private:
+  struct Record
+  {
+    Entry* entry;
+    uint64_t frequency;
+    uint64_t lastUse;
+  };
+
+  struct FrequencyComparator
+  {
+    bool
+    operator()(const Record& record1, const Record& record2) const
+    {
+      if (record1.frequency != record2.frequency)
+        return record1.frequency < record2.frequency;
+      return record1.lastUse < record2.lastUse;
+    }
+  };
+
+  struct IncrementFrequency
+  {
+    explicit
+    IncrementFrequency(uint64_t now)
+      : m_now(now)
+    {
+    }
+
+    void
+    operator()(Record& record) const
+    {
+      ++record.frequency;
+      record.lastUse = m_now;
+    }
+
+  private:
+    uint64_t m_now;
+  };
+
+  typedef boost::multi_index_container<
+    Record,
+    boost::multi_index::indexed_by<
+
+      // least frequently used in the front
+      boost::multi_index::ordered_non_unique<
+        boost::multi_index::identity<Record>,
+        FrequencyComparator
+      >,
+
+      // lookup by entry
+      boost::multi_index::hashed_unique<
+        boost::multi_index::member<Record, Entry*, &Record::entry>
+      >
+
+    >
+  > Queue;
+
+  Queue m_queue;
+  uint64_t m_clock; // logical time of the last use
+};
+
+} // namespace cs
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_CS_POLICY_LFU_HPP
@@ -0,0 +1,84 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cs-policy-lru.hpp"
+
+namespace nfd {
+namespace cs {
+
+const std::string LruPolicy::POLICY_NAME = "lru";
+
+LruPolicy::LruPolicy()
+  : Policy(POLICY_NAME)
+{
+}
+
+void
+LruPolicy::afterInsert(Entry* entry)
+{
+  m_queue.push_back(entry);
+}
+
+void
+LruPolicy::afterRefresh(Entry* entry)
+{
+  this->moveToBack(entry);
+}
+
+void
+LruPolicy::beforeUse(Entry* entry)
+{
+  this->moveToBack(entry);
+}
+
+void
+LruPolicy::beforeErase(Entry* entry)
+{
+  m_queue.get<1>().erase(entry);
+}
+
+Entry*
+LruPolicy::evictEntry()
+{
+  if (m_queue.empty())
+    return 0;
+
+  Entry* entry = m_queue.front();
+  m_queue.pop_front();
+  return entry;
+}
+
+void
+LruPolicy::moveToBack(Entry* entry)
+{
+  UseQueue::nth_index<1>::type::iterator it = m_queue.get<1>().find(entry);
+  if (it == m_queue.get<1>().end())
+    return;
+
+  m_queue.relocate(m_queue.end(), m_queue.project<0>(it));
+}
+
+} // namespace cs
+} // namespace nfd
@@ -0,0 +1,100 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cs-policy-priority-fifo.hpp"
+
+namespace nfd {
+namespace cs {
+
+const std::string PriorityFifoPolicy::POLICY_NAME = "fifo";
+
+PriorityFifoPolicy::PriorityFifoPolicy()
+  : Policy(POLICY_NAME)
+{
+}
+
+void
+PriorityFifoPolicy::afterInsert(Entry* entry)
+{
+  Record record;
+  record.entry = entry;
+  record.staleAt = entry->getStaleTime();
+  record.isUnsolicited = entry->isUnsolicited();
+  m_queue.push_back(record);
+}
+
+void
+PriorityFifoPolicy::afterRefresh(Entry* entry)
+{
+  Queue::index<byEntry>::type& entryIndex = m_queue.get<byEntry>();
+  Queue::index<byEntry>::type::iterator it = entryIndex.find(entry);
+  if (it != entryIndex.end())
+    entryIndex.modify(it, UpdateRecord());
+}
+
+void
+PriorityFifoPolicy::beforeUse(Entry* entry)
+{
+}
+
+void
+PriorityFifoPolicy::beforeErase(Entry* entry)
+{
+  m_queue.get<byEntry>().erase(entry);
+}
+
+Entry*
+PriorityFifoPolicy::evictEntry()
+{
+  Queue::index<byUnsolicited>::type& unsolicitedIndex = m_queue.get<byUnsolicited>();
+  if (!unsolicitedIndex.empty() && unsolicitedIndex.begin()->isUnsolicited)
+    {
+      Entry* entry = unsolicitedIndex.begin()->entry;
+      unsolicitedIndex.erase(unsolicitedIndex.begin());
+      return entry;
+    }
+
+  Queue::index<byStaleness>::type& stalenessIndex = m_queue.get<byStaleness>();
+  if (!stalenessIndex.empty() &&
+      stalenessIndex.begin()->staleAt < time::steady_clock::now())
+    {
+      Entry* entry = stalenessIndex.begin()->entry;
+      stalenessIndex.erase(stalenessIndex.begin());
+      return entry;
+    }
+
+  Queue::index<byArrival>::type& arrivalIndex = m_queue.get<byArrival>();
+  if (!arrivalIndex.empty())
+    {
+      Entry* entry = arrivalIndex.begin()->entry;
+      arrivalIndex.erase(arrivalIndex.begin());
+      return entry;
+    }
+
+  return 0;
+}
+
+} // namespace cs
+} // namespace nfd
@@ -0,0 +1,135 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_CS_POLICY_PRIORITY_FIFO_HPP
+#define NFD_DAEMON_TABLE_CS_POLICY_PRIORITY_FIFO_HPP
+
+#include "cs-policy.hpp"
+
+#include <boost/multi_index_container.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+
+#include <functional>
+
+namespace nfd {
+namespace cs {
+
+/** \brief Priority FIFO replacement policy
+ *
+ *  Evicts unsolicited Data first, then the Data which became stale earliest,
+ *  and otherwise the Data that arrived earliest.
+ *  Cache hits do not change the eviction order.
+ */
+class PriorityFifoPolicy : public Policy
+{
+public:
+  PriorityFifoPolicy();
+
+  virtual void
+  afterInsert(Entry* entry);
+
+  virtual void
+  afterRefresh(Entry* entry);
+
+  virtual void
+  beforeUse(Entry* entry);
+
+  virtual void
+  beforeErase(Entry* entry);
+
+  virtual Entry*
+  evictEntry();
+
+public:
+  static const std::string POLICY_NAME;
+
+private:
+  /** \brief copy of the entry fields the indexes are keyed on,
+   *         so that refreshing an entry cannot corrupt the ordered indexes
+   */
+  struct Record
+  {
+    Entry* entry;
+    time::steady_clock::TimePoint staleAt;
+    bool isUnsolicited;
+  };
+
+  struct UpdateRecord
+  {
+    void
+    operator()(Record& record) const
+    {
+      record.staleAt = record.entry->getStaleTime();
+      record.isUnsolicited = record.entry->isUnsolicited();
+    }
+  };
+
+  // tags
+  class byArrival;
+  class byStaleness;
+  class byUnsolicited;
+  class byEntry;
+
+  typedef boost::multi_index_container<
+    Record,
+    boost::multi_index::indexed_by<
+
+      // by arrival (FIFO)
+      boost::multi_index::sequenced<
+        boost::multi_index::tag<byArrival>
+      >,
+
+      // index by staleness time
+      boost::multi_index::ordered_non_unique<
+        boost::multi_index::tag<byStaleness>,
+        boost::multi_index::member<Record, time::steady_clock::TimePoint, &Record::staleAt>
+      >,
+
+      // unsolicited Data is in the front
+      boost::multi_index::ordered_non_unique<
+        boost::multi_index::tag<byUnsolicited>,
+        boost::multi_index::member<Record, bool, &Record::isUnsolicited>,
+        std::greater<bool>
+      >,
+
+      // lookup by entry
+      boost::multi_index::hashed_unique<
+        boost::multi_index::tag<byEntry>,
+        boost::multi_index::member<Record, Entry*, &Record::entry>
+      >
+
+    >
+  > Queue;
+
+  Queue m_queue;
+};
+
+} // namespace cs
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_CS_POLICY_PRIORITY_FIFO_HPP
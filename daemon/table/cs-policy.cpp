@@ -0,0 +1,64 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cs-policy.hpp"
+#include "cs-policy-priority-fifo.hpp"
+#include "cs-policy-lru.hpp"
+#include "cs-policy-lfu.hpp"
+#include "cs-policy-arc.hpp"
+
+namespace nfd {
+namespace cs {
+
+Policy::Policy(const std::string& name)
+  : m_name(name)
+  , m_nMaxEntries(0)
+{
+}
+
+Policy::~Policy()
+{
+}
+
+shared_ptr<Policy>
+makePolicy(const std::string& name)
+{
+  if (name == PriorityFifoPolicy::POLICY_NAME)
+    return make_shared<PriorityFifoPolicy>();
+
+  if (name == LruPolicy::POLICY_NAME)
+    return make_shared<LruPolicy>();
+
+  if (name == LfuPolicy::POLICY_NAME)
+    return make_shared<LfuPolicy>();
+
+  if (name == ArcPolicy::POLICY_NAME)
+    return make_shared<ArcPolicy>();
+
+  return shared_ptr<Policy>();
+}
+
+} // namespace cs
+} // namespace nfd
@@ -0,0 +1,127 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_CS_POLICY_HPP
+#define NFD_DAEMON_TABLE_CS_POLICY_HPP
+
+#include "cs-entry.hpp"
+
+namespace nfd {
+namespace cs {
+
+/** \brief represents a Content Store replacement policy
+ *
+ *  Cs notifies the policy about insertions, refreshes, cache hits and erasures,
+ *  and asks the policy for a victim when an entry must be evicted.
+ *  The policy only keeps pointers to entries; the entries are owned by Cs.
+ */
+class Policy : noncopyable
+{
+public:
+  explicit
+  Policy(const std::string& name);
+
+  virtual
+  ~Policy();
+
+  /** \return the name of this policy, as used in the "tables" config section
+   */
+  const std::string&
+  getName() const;
+
+  /** \brief sets the capacity of Content Store in packets
+   *
+   *  Policies that keep history of evicted entries bound it with this value.
+   */
+  void
+  setLimit(size_t nMaxEntries);
+
+  size_t
+  getLimit() const;
+
+public: // triggers
+  /** \brief invoked after a new entry is inserted
+   */
+  virtual void
+  afterInsert(Entry* entry) = 0;
+
+  /** \brief invoked after an existing entry is refreshed with a duplicate Data packet
+   */
+  virtual void
+  afterRefresh(Entry* entry) = 0;
+
+  /** \brief invoked when an entry is returned as the match of an Interest
+   */
+  virtual void
+  beforeUse(Entry* entry) = 0;
+
+  /** \brief invoked before an entry is erased by exact name
+   *
+   *  The policy must stop tracking the entry.
+   */
+  virtual void
+  beforeErase(Entry* entry) = 0;
+
+  /** \brief selects an entry to evict, and stops tracking it
+   *  \return the victim, or 0 if the policy tracks no entry
+   */
+  virtual Entry*
+  evictEntry() = 0;
+
+private:
+  std::string m_name;
+  size_t m_nMaxEntries;
+};
+
+inline const std::string&
+Policy::getName() const
+{
+  return m_name;
+}
+
+inline void
+Policy::setLimit(size_t nMaxEntries)
+{
+  m_nMaxEntries = nMaxEntries;
+}
+
+inline size_t
+Policy::getLimit() const
+{
+  return m_nMaxEntries;
+}
+
+/** \brief creates a replacement policy by name
+ *
+ *  Known names are "fifo", "lru", "lfu" and "arc".
+ *  \return the policy, or an empty pointer if \p name is unknown
+ */
+shared_ptr<Policy>
+makePolicy(const std::string& name);
+
+} // namespace cs
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_CS_POLICY_HPP
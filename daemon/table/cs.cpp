@@ -28,6 +28,7 @@
  */
 
 #include "cs.hpp"
+#include "cs-policy-priority-fifo.hpp"
 #include "core/logger.hpp"
 #include "core/random.hpp"
 
@@ -40,15 +41,23 @@
 static const size_t SKIPLIST_MAX_LAYERS = 32;
 /// probability for an entry in layer N to appear also in layer N+1
 static const double SKIPLIST_PROBABILITY = 0.25;
+/// approximate memory used by a CS entry besides the Data wire encoding
+static const size_t ENTRY_OVERHEAD = sizeof(nfd::cs::Entry) + sizeof(ndn::Data);
 
 NFD_LOG_INIT("ContentStore");
 
 namespace nfd {
 
-Cs::Cs(size_t nMaxPackets)
-  : m_nMaxPackets(nMaxPackets)
+Cs::Cs(size_t nMaxPackets, IndexType indexType)
+  : m_indexType(indexType)
+  , m_policy(make_shared<cs::PriorityFifoPolicy>())
+  , m_nMaxPackets(nMaxPackets)
   , m_nPackets(0)
+  , m_nMaxBytes(std::numeric_limits<size_t>::max())
+  , m_nBytes(0)
 {
+  m_policy->setLimit(m_nMaxPackets);
+
   SkipListLayer* zeroLayer = new SkipListLayer();
   m_skipList.push_back(zeroLayer);
 
@@ -61,6 +70,7 @@ Cs::~Cs()
   // evict all items from CS
   while (evictItem())
     ;
+  flushDiskWriteQueue();
 
   BOOST_ASSERT(m_freeCsEntries.size() == m_nMaxPackets);
 
@@ -82,6 +92,7 @@ Cs::setLimit(size_t nMaxPackets)
 {
   size_t oldNMaxPackets = m_nMaxPackets;
   m_nMaxPackets = nMaxPackets;
+  m_policy->setLimit(m_nMaxPackets);
 
   while (size() > m_nMaxPackets) {
     evictItem();
@@ -106,6 +117,110 @@ Cs::getLimit() const
   return m_nMaxPackets;
 }
 
+void
+Cs::setByteLimit(size_t nMaxBytes)
+{
+  m_nMaxBytes = nMaxBytes;
+
+  while (m_nBytes > m_nMaxBytes && evictItem())
+    ;
+}
+
+size_t
+Cs::getEntrySize(const Data& data)
+{
+  return data.wireEncode().size() + ENTRY_OVERHEAD;
+}
+
+void
+Cs::setIndexType(IndexType indexType)
+{
+  if (indexType == m_indexType)
+    return;
+
+  NFD_LOG_DEBUG("setIndexType() " << indexType << ", moving " << size() << " entries");
+
+  // the same Entry objects are relinked into the new index, so the replacement policy
+  // keeps its state (recency, access counts, ghost lists) and staleness is preserved
+  std::vector<cs::Entry*> entries = listEntries();
+
+  if (m_indexType == INDEX_BTREE)
+    {
+      m_bTreeIndex.clear();
+    }
+  else
+    {
+      clearSkipList();
+    }
+
+  m_indexType = indexType;
+
+  for (size_t i = 0; i < entries.size(); ++i)
+    {
+      if (m_indexType == INDEX_BTREE)
+        m_bTreeIndex.insert(entries[i]);
+      else
+        linkToSkipList(entries[i]);
+    }
+}
+
+void
+Cs::clearSkipList()
+{
+  int layer = 0;
+  for (SkipList::iterator it = m_skipList.begin(); it != m_skipList.end(); ++it, ++layer)
+    {
+      for (SkipListLayer::iterator i = (*it)->begin(); i != (*it)->end(); ++i)
+        (*i)->removeIterator(layer);
+
+      if (layer != 0)
+        delete *it;
+    }
+
+  SkipListLayer* zeroLayer = m_skipList.front();
+  zeroLayer->clear();
+  m_skipList.clear();
+  m_skipList.push_back(zeroLayer);
+}
+
+void
+Cs::setPolicy(shared_ptr<cs::Policy> policy)
+{
+  BOOST_ASSERT(static_cast<bool>(policy));
+
+  NFD_LOG_DEBUG("setPolicy() " << policy->getName() << ", tracking " << size() << " entries");
+
+  m_policy = policy;
+  m_policy->setLimit(m_nMaxPackets);
+
+  std::vector<cs::Entry*> entries = listEntries();
+  for (size_t i = 0; i < entries.size(); ++i)
+    {
+      m_policy->afterInsert(entries[i]);
+    }
+}
+
+std::vector<cs::Entry*>
+Cs::listEntries() const
+{
+  std::vector<cs::Entry*> entries;
+  entries.reserve(size());
+
+  if (m_indexType == INDEX_BTREE)
+    {
+      for (cs::BTreeIndex::const_iterator it = m_bTreeIndex.begin();
+           it != m_bTreeIndex.end(); ++it)
+        entries.push_back(*it);
+    }
+  else
+    {
+      const SkipListLayer& zeroLayer = **m_skipList.begin();
+      entries.assign(zeroLayer.begin(), zeroLayer.end());
+    }
+
+  return entries;
+}
+
 //Reference: "Skip Lists: A Probabilistic Alternative to Balanced Trees" by W.Pugh
 std::pair<cs::Entry*, bool>
 Cs::insertToSkipList(const Data& data, bool isUnsolicited)
@@ -113,15 +228,34 @@ Cs::insertToSkipList(const Data& data, bool isUnsolicited)
   NFD_LOG_TRACE("insertToSkipList() " << data.getFullName() << ", "
                 << "skipList size " << size());
 
-  BOOST_ASSERT(m_cleanupIndex.size() <= size());
   BOOST_ASSERT(m_freeCsEntries.size() > 0);
 
   // take entry for the memory pool
   cs::Entry* entry = m_freeCsEntries.front();
   m_freeCsEntries.pop();
-  m_nPackets++;
   entry->setData(data, isUnsolicited);
 
+  std::pair<cs::Entry*, bool> result = linkToSkipList(entry);
+  if (!result.second)
+    {
+      NFD_LOG_TRACE("Duplicate name (with digest)");
+
+      result.first->setData(data, isUnsolicited); //updates stale time
+
+      // new entry not needed, returning to the pool
+      entry->release();
+      m_freeCsEntries.push(entry);
+      return result;
+    }
+
+  m_nPackets++;
+  m_nBytes += getEntrySize(data);
+  return result;
+}
+
+std::pair<cs::Entry*, bool>
+Cs::linkToSkipList(cs::Entry* entry)
+{
   bool insertInFront = false;
   bool isIterated = false;
   SkipList::reverse_iterator topLayer = m_skipList.rbegin();
@@ -179,26 +313,11 @@ Cs::insertToSkipList(const Data& data, bool isUnsolicited)
   head = updateTable[0];
   ++head; // look at the next slot to check if it contains a duplicate
 
-  bool isCsEmpty = (size() == 0);
   bool isInBoundaries = (head != (*m_skipList.begin())->end());
-  bool isNameIdentical = false;
-  if (!isCsEmpty && isInBoundaries)
-    {
-      isNameIdentical = (*head)->getFullName() == entry->getFullName();
-    }
 
   //check if this is a duplicate packet
-  if (isNameIdentical)
+  if (isInBoundaries && (*head)->getFullName() == entry->getFullName())
     {
-      NFD_LOG_TRACE("Duplicate name (with digest)");
-
-      (*head)->setData(data, isUnsolicited); //updates stale time
-
-      // new entry not needed, returning to the pool
-      entry->release();
-      m_freeCsEntries.push(entry);
-      m_nPackets--;
-
       return std::make_pair(*head, false);
     }
 
@@ -247,26 +366,55 @@ Cs::insertToSkipList(const Data& data, bool isUnsolicited)
   return std::make_pair(entry, true);
 }
 
-bool
-Cs::insert(const Data& data, bool isUnsolicited)
+std::pair<cs::Entry*, bool>
+Cs::insertEntry(const Data& data, bool isUnsolicited)
 {
-  NFD_LOG_TRACE("insert() " << data.getFullName());
+  size_t entrySize = getEntrySize(data);
+  if (entrySize > m_nMaxBytes)
+    {
+      NFD_LOG_DEBUG("insert() " << data.getName() << " " << entrySize
+                    << " bytes exceeds byte limit " << m_nMaxBytes);
+      return std::make_pair(static_cast<cs::Entry*>(0), false);
+    }
 
   if (isFull())
     {
       evictItem();
     }
 
+  while (m_nBytes + entrySize > m_nMaxBytes && evictItem())
+    ;
+
   //pointer and insertion status
-  std::pair<cs::Entry*, bool> entry = insertToSkipList(data, isUnsolicited);
+  std::pair<cs::Entry*, bool> entry = (m_indexType == INDEX_BTREE) ?
+                                      insertToBTree(data, isUnsolicited) :
+                                      insertToSkipList(data, isUnsolicited);
 
   //new entry
   if (static_cast<bool>(entry.first) && (entry.second == true))
     {
-      m_cleanupIndex.push_back(entry.first);
+      m_exactNameIndex.insert(entry.first);
+    }
+
+  return entry;
+}
+
+bool
+Cs::insert(const Data& data, bool isUnsolicited)
+{
+  NFD_LOG_TRACE("insert() " << data.getFullName());
+
+  std::pair<cs::Entry*, bool> entry = insertEntry(data, isUnsolicited);
+  if (!static_cast<bool>(entry.first))
+    return false;
+
+  if (entry.second)
+    {
+      m_policy->afterInsert(entry.first);
       return true;
     }
 
+  m_policy->afterRefresh(entry.first);
   return false;
 }
 
@@ -336,6 +484,8 @@ Cs::eraseFromSkipList(cs::Entry* entry)
   //delete entry;
   if (isErased)
   {
+    m_exactNameIndex.get<byFullName>().erase(entry->getFullName());
+    m_nBytes -= getEntrySize(entry->getData());
     entry->release();
     m_freeCsEntries.push(entry);
     m_nPackets--;
@@ -344,48 +494,291 @@ Cs::eraseFromSkipList(cs::Entry* entry)
   return isErased;
 }
 
+std::pair<cs::Entry*, bool>
+Cs::insertToBTree(const Data& data, bool isUnsolicited)
+{
+  NFD_LOG_TRACE("insertToBTree() " << data.getFullName() << ", "
+                << "index size " << size());
+
+  BOOST_ASSERT(m_freeCsEntries.size() > 0);
+
+  // take entry for the memory pool
+  cs::Entry* entry = m_freeCsEntries.front();
+  m_freeCsEntries.pop();
+  entry->setData(data, isUnsolicited);
+
+  std::pair<cs::Entry*, bool> result = m_bTreeIndex.insert(entry);
+  if (!result.second)
+    {
+      NFD_LOG_TRACE("Duplicate name (with digest)");
+
+      result.first->setData(data, isUnsolicited); //updates stale time
+
+      // new entry not needed, returning to the pool
+      entry->release();
+      m_freeCsEntries.push(entry);
+      return result;
+    }
+
+  m_nPackets++;
+  m_nBytes += getEntrySize(data);
+  return result;
+}
+
+bool
+Cs::eraseFromBTree(cs::Entry* entry)
+{
+  NFD_LOG_TRACE("eraseFromBTree() "  << entry->getFullName());
+
+  if (!m_bTreeIndex.erase(entry))
+    return false;
+
+  m_exactNameIndex.get<byFullName>().erase(entry->getFullName());
+  m_nBytes -= getEntrySize(entry->getData());
+  entry->release();
+  m_freeCsEntries.push(entry);
+  m_nPackets--;
+  return true;
+}
+
+bool
+Cs::eraseFromIndex(cs::Entry* entry)
+{
+  if (m_indexType == INDEX_BTREE)
+    return eraseFromBTree(entry);
+
+  return eraseFromSkipList(entry);
+}
+
 bool
 Cs::evictItem()
 {
-  NFD_LOG_TRACE("evictItem()");
+  NFD_LOG_TRACE("evictItem() " << m_policy->getName());
 
-  if (!m_cleanupIndex.get<unsolicited>().empty() &&
-      (*m_cleanupIndex.get<unsolicited>().begin())->isUnsolicited())
-  {
-    NFD_LOG_TRACE("Evict from unsolicited queue");
+  cs::Entry* entry = m_policy->evictEntry();
+  if (entry == 0)
+    return false;
 
-    eraseFromSkipList(*m_cleanupIndex.get<unsolicited>().begin());
-    m_cleanupIndex.get<unsolicited>().erase(m_cleanupIndex.get<unsolicited>().begin());
-    return true;
-  }
+  if (static_cast<bool>(m_diskTier) && !entry->isUnsolicited())
+    {
+      // keep the remaining freshness, in wall clock time that survives restart
+      time::system_clock::TimePoint staleAt = time::system_clock::now() +
+        time::duration_cast<time::system_clock::Duration>(entry->getStaleTime() -
+                                                          time::steady_clock::now());
+      if (m_diskWriteQueue.empty())
+        {
+          scheduler::cancel(m_diskWriteEvent); // left pending if erase() emptied the queue
+          m_diskWriteEvent = scheduler::schedule(time::nanoseconds(0),
+                                                 bind(&Cs::flushDiskWriteQueue, this));
+        }
+      m_diskWriteQueue.push_back(std::make_pair(entry->getData().shared_from_this(), staleAt));
+    }
 
-  if (!m_cleanupIndex.get<byStaleness>().empty() &&
-      (*m_cleanupIndex.get<byStaleness>().begin())->getStaleTime() < time::steady_clock::now())
-  {
-    NFD_LOG_TRACE("Evict from staleness queue");
+  eraseFromIndex(entry);
+  return true;
+}
 
-    eraseFromSkipList(*m_cleanupIndex.get<byStaleness>().begin());
-    m_cleanupIndex.get<byStaleness>().erase(m_cleanupIndex.get<byStaleness>().begin());
-    return true;
-  }
+void
+Cs::enableDiskTier(const std::string& path, uint64_t capacity)
+{
+  NFD_LOG_INFO("enableDiskTier() " << path << " capacity=" << capacity);
 
-  if (!m_cleanupIndex.get<byArrival>().empty())
-  {
-    NFD_LOG_TRACE("Evict from arrival queue");
+  flushDiskWriteQueue();
+  m_diskTier.reset(); // close the file before opening it again
+  m_diskTier.reset(new cs::DiskTier(path, capacity));
+}
 
-    eraseFromSkipList(*m_cleanupIndex.get<byArrival>().begin());
-    m_cleanupIndex.get<byArrival>().erase(m_cleanupIndex.get<byArrival>().begin());
-    return true;
-  }
+void
+Cs::disableDiskTier()
+{
+  flushDiskWriteQueue();
+  m_diskTier.reset();
+}
 
-  return false;
+cs::Entry*
+Cs::findInDiskTier(const Interest& interest)
+{
+  if (!static_cast<bool>(m_diskTier) ||
+      interest.getChildSelector() > 0 ||
+      interest.getMinSuffixComponents() >= 0 ||
+      interest.getMaxSuffixComponents() >= 0 ||
+      !interest.getExclude().empty() ||
+      !interest.getPublisherPublicKeyLocator().empty())
+    return 0;
+
+  time::system_clock::TimePoint staleAt;
+  shared_ptr<const Data> data = findInDiskWriteQueue(interest.getName(),
+                                                     interest.getMustBeFresh(), staleAt);
+  if (!static_cast<bool>(data))
+    data = m_diskTier->find(interest.getName(), interest.getMustBeFresh(), staleAt);
+  if (!static_cast<bool>(data))
+    return 0;
+
+  NFD_LOG_TRACE("findInDiskTier() promoting " << data->getFullName());
+
+  std::pair<cs::Entry*, bool> entry = insertEntry(*data, false);
+  if (!static_cast<bool>(entry.first))
+    return 0;
+
+  entry.first->setStaleTime(time::steady_clock::now() +
+                            time::duration_cast<time::steady_clock::Duration>(
+                              staleAt - time::system_clock::now()));
+  if (entry.second)
+    m_policy->afterInsert(entry.first);
+  else
+    m_policy->afterRefresh(entry.first);
+
+  return entry.first;
+}
+
+shared_ptr<const Data>
+Cs::findInDiskWriteQueue(const Name& name, bool mustBeFresh,
+                         time::system_clock::TimePoint& staleAt) const
+{
+  time::system_clock::TimePoint now = time::system_clock::now();
+
+  // the most recently evicted Data is preferred, as in the disk tier
+  for (size_t i = m_diskWriteQueue.size(); i > 0; --i)
+    {
+      const shared_ptr<const Data>& data = m_diskWriteQueue[i - 1].first;
+      if (mustBeFresh && m_diskWriteQueue[i - 1].second < now)
+        continue;
+
+      if (data->getName() == name || data->getFullName() == name)
+        {
+          staleAt = m_diskWriteQueue[i - 1].second;
+          return data;
+        }
+    }
+
+  return shared_ptr<const Data>();
+}
+
+void
+Cs::flushDiskWriteQueue()
+{
+  scheduler::cancel(m_diskWriteEvent);
+
+  if (m_diskWriteQueue.empty())
+    return;
+
+  NFD_LOG_TRACE("flushDiskWriteQueue() " << m_diskWriteQueue.size() << " Data");
+
+  if (static_cast<bool>(m_diskTier))
+    {
+      for (size_t i = 0; i < m_diskWriteQueue.size(); ++i)
+        m_diskTier->insert(*m_diskWriteQueue[i].first, m_diskWriteQueue[i].second);
+    }
+  m_diskWriteQueue.clear();
 }
 
 const Data*
-Cs::find(const Interest& interest) const
+Cs::find(const Interest& interest)
 {
   NFD_LOG_TRACE("find() " << interest.getName());
 
+  cs::Entry* entry = findExactMatch(interest);
+  if (entry == 0)
+    {
+      entry = (m_indexType == INDEX_BTREE) ?
+              findInBTree(interest) :
+              findInSkipList(interest);
+    }
+
+  if (entry == 0)
+    {
+      entry = findInDiskTier(interest);
+      if (entry == 0)
+        return 0;
+    }
+
+  m_policy->beforeUse(entry);
+  return &entry->getData();
+}
+
+cs::Entry*
+Cs::findExactMatch(const Interest& interest) const
+{
+  if (interest.getChildSelector() > 0 ||
+      interest.getMinSuffixComponents() >= 0 ||
+      interest.getMaxSuffixComponents() >= 0 ||
+      !interest.getExclude().empty() ||
+      !interest.getPublisherPublicKeyLocator().empty())
+    return 0;
+
+  const Name& name = interest.getName();
+  bool mustBeFresh = interest.getMustBeFresh();
+  time::steady_clock::TimePoint now = mustBeFresh ? time::steady_clock::now() :
+                                                    time::steady_clock::TimePoint();
+
+  // Interest Name is a full Name: no other entry under it can precede the exact entry
+  const ExactNameIndex::index<byFullName>::type& fullNameIndex =
+    m_exactNameIndex.get<byFullName>();
+  ExactNameIndex::index<byFullName>::type::const_iterator fullNameIt = fullNameIndex.find(name);
+  if (fullNameIt != fullNameIndex.end() &&
+      (!mustBeFresh || (*fullNameIt)->getStaleTime() >= now))
+    {
+      NFD_LOG_TRACE("findExactMatch() full Name " << (*fullNameIt)->getFullName());
+      return *fullNameIt;
+    }
+
+  // Interest Name is a Data Name: the entry is the leftmost match
+  // only if it is the first entry under Interest Name in Name order
+  typedef ExactNameIndex::index<byName>::type::const_iterator NameIterator;
+  std::pair<NameIterator, NameIterator> range = m_exactNameIndex.get<byName>().equal_range(name);
+  for (NameIterator it = range.first; it != range.second; ++it)
+    {
+      if (isFirstUnderPrefix(name, *it))
+        {
+          if (mustBeFresh && (*it)->getStaleTime() < now)
+            return 0;
+
+          NFD_LOG_TRACE("findExactMatch() Name " << (*it)->getFullName());
+          return *it;
+        }
+    }
+
+  return 0;
+}
+
+bool
+Cs::isFirstUnderPrefix(const Name& prefix, cs::Entry* entry) const
+{
+  if (m_indexType == INDEX_BTREE)
+    {
+      cs::BTreeIndex::const_iterator it = m_bTreeIndex.find(entry->getFullName());
+      BOOST_ASSERT(it != m_bTreeIndex.end());
+      return it == m_bTreeIndex.begin() || !prefix.isPrefixOf((*--it)->getFullName());
+    }
+
+  SkipListLayer::iterator it = entry->getIterators().find(0)->second;
+  return it == (*m_skipList.begin())->begin() || !prefix.isPrefixOf((*--it)->getFullName());
+}
+
+cs::Entry*
+Cs::findInBTree(const Interest& interest) const
+{
+  // the starting point is the last entry less than Interest Name,
+  // or the first entry if it is under Interest Name (same as findInSkipList)
+  cs::BTreeIndex::const_iterator begin = m_bTreeIndex.begin();
+  cs::BTreeIndex::const_iterator end = m_bTreeIndex.end();
+  cs::BTreeIndex::const_iterator it = m_bTreeIndex.lowerBound(interest.getName());
+
+  if (it == begin)
+    {
+      if (it != end && interest.getName().isPrefixOf((*it)->getFullName()))
+        return selectChild(interest, it, begin, end);
+
+      return 0;
+    }
+
+  --it;
+  return selectChild(interest, it, begin, end);
+}
+
+cs::Entry*
+Cs::findInSkipList(const Interest& interest) const
+{
   bool isIterated = false;
   SkipList::const_reverse_iterator topLayer = m_skipList.rbegin();
   SkipListLayer::iterator head = (*topLayer)->begin();
@@ -439,7 +832,8 @@ Cs::find(const Interest& interest) const
           else //if we reached the first layer
             {
               if (isIterated)
-                return selectChild(interest, head);
+                return selectChild(interest, head,
+                                   (*m_skipList.begin())->begin(), (*m_skipList.begin())->end());
             }
 
           layer--;
@@ -449,12 +843,14 @@ Cs::find(const Interest& interest) const
   return 0;
 }
 
-const Data*
-Cs::selectChild(const Interest& interest, SkipListLayer::iterator startingPoint) const
+template<class Iterator>
+cs::Entry*
+Cs::selectChild(const Interest& interest, Iterator startingPoint,
+                Iterator begin, Iterator end) const
 {
-  BOOST_ASSERT(startingPoint != (*m_skipList.begin())->end());
+  BOOST_ASSERT(startingPoint != end);
 
-  if (startingPoint != (*m_skipList.begin())->begin())
+  if (startingPoint != begin)
     {
       BOOST_ASSERT((*startingPoint)->getFullName() < interest.getName());
     }
@@ -483,23 +879,23 @@ Cs::selectChild(const Interest& interest, SkipListLayer::iterator startingPoint)
         {
           if (doesComplyWithSelectors(interest, *startingPoint, doesInterestContainDigest))
             {
-              return &(*startingPoint)->getData();
+              return *startingPoint;
             }
         }
     }
 
   //iterate to the right
-  SkipListLayer::iterator rightmost = startingPoint;
-  if (startingPoint != (*m_skipList.begin())->end())
+  Iterator rightmost = startingPoint;
+  if (startingPoint != end)
     {
-      SkipListLayer::iterator rightmostCandidate = startingPoint;
+      Iterator rightmostCandidate = startingPoint;
       Name currentChildPrefix("");
 
       while (true)
         {
           ++rightmostCandidate;
 
-          bool isInBoundaries = (rightmostCandidate != (*m_skipList.begin())->end());
+          bool isInBoundaries = (rightmostCandidate != end);
           bool isInPrefix = false;
           bool doesInterestContainDigest = false;
           if (isInBoundaries)
@@ -524,7 +920,7 @@ Cs::selectChild(const Interest& interest, SkipListLayer::iterator startingPoint)
                 {
                   if (hasLeftmostSelector)
                     {
-                      return &(*rightmostCandidate)->getData();
+                      return *rightmostCandidate;
                     }
 
                   if (hasRightmostSelector)
@@ -566,7 +962,7 @@ Cs::selectChild(const Interest& interest, SkipListLayer::iterator startingPoint)
 
   if (rightmost != startingPoint)
     {
-      return &(*rightmost)->getData();
+      return *rightmost;
     }
 
   if (hasRightmostSelector) // if rightmost was not found, try starting point
@@ -587,7 +983,7 @@ Cs::selectChild(const Interest& interest, SkipListLayer::iterator startingPoint)
         {
           if (doesComplyWithSelectors(interest, *startingPoint, doesInterestContainDigest))
             {
-              return &(*startingPoint)->getData();
+              return *startingPoint;
             }
         }
     }
@@ -727,6 +1123,28 @@ Cs::erase(const Name& exactName)
   NFD_LOG_TRACE("insert() " << exactName << ", "
                 << "skipList size " << size());
 
+  if (static_cast<bool>(m_diskTier))
+    {
+      for (size_t i = m_diskWriteQueue.size(); i > 0; --i)
+        {
+          if (m_diskWriteQueue[i - 1].first->getFullName() == exactName)
+            m_diskWriteQueue.erase(m_diskWriteQueue.begin() + (i - 1));
+        }
+      m_diskTier->erase(exactName);
+    }
+
+  if (m_indexType == INDEX_BTREE)
+    {
+      cs::BTreeIndex::const_iterator it = m_bTreeIndex.find(exactName);
+      if (it != m_bTreeIndex.end())
+        {
+          NFD_LOG_TRACE("Found target " << (*it)->getFullName());
+          m_policy->beforeErase(*it);
+          eraseFromBTree(*it);
+        }
+      return;
+    }
+
   bool isIterated = false;
   SkipListLayer::iterator updateTable[SKIPLIST_MAX_LAYERS];
   SkipList::reverse_iterator topLayer = m_skipList.rbegin();
@@ -749,6 +1167,7 @@ Cs::erase(const Name& exactName)
               // it can happen when begin() contains the element we want to remove
               if (!isIterated && ((*head)->getFullName() == exactName))
                 {
+                  m_policy->beforeErase(*head);
                   eraseFromSkipList(*head);
                   return;
                 }
@@ -795,6 +1214,7 @@ Cs::erase(const Name& exactName)
   if (isNameIdentical)
     {
       NFD_LOG_TRACE("Found target " << (*head)->getFullName());
+      m_policy->beforeErase(*head);
       eraseFromSkipList(*head);
     }
 }
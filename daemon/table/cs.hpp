@@ -32,83 +32,85 @@
 
 #include "common.hpp"
 #include "cs-entry.hpp"
+#include "cs-btree-index.hpp"
+#include "cs-policy.hpp"
+#include "cs-disk-tier.hpp"
+#include "name-tree.hpp"
+#include "core/scheduler.hpp"
 
-#include <boost/multi_index/member.hpp>
 #include <boost/multi_index_container.hpp>
-#include <boost/multi_index/ordered_index.hpp>
-#include <boost/multi_index/sequenced_index.hpp>
-#include <boost/multi_index/identity.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/mem_fun.hpp>
 
 #include <queue>
+#include <limits>
 
 namespace nfd {
 
 typedef std::list<cs::Entry*> SkipListLayer;
 typedef std::list<SkipListLayer*> SkipList;
 
-class StalenessComparator
+class NameHash
 {
 public:
-  bool
-  operator()(const cs::Entry* entry1, const cs::Entry* entry2) const
-  {
-    return entry1->getStaleTime() < entry2->getStaleTime();
-  }
-};
-
-class UnsolicitedComparator
-{
-public:
-  bool
-  operator()(const cs::Entry* entry1, const cs::Entry* entry2) const
+  size_t
+  operator()(const Name& name) const
   {
-    return entry1->isUnsolicited();
+    return name_tree::computeHash(name);
   }
 };
 
 // tags
-class unsolicited;
-class byStaleness;
-class byArrival;
+class byName;
+class byFullName;
 
+/** \brief hash index of CS entries on Data Name and on full Name,
+ *         which answers Interests that do not need an ordered lookup
+ */
 typedef boost::multi_index_container<
   cs::Entry*,
   boost::multi_index::indexed_by<
 
-    // by arrival (FIFO)
-    boost::multi_index::sequenced<
-      boost::multi_index::tag<byArrival>
+    // by Data Name, several Data may share a Name
+    boost::multi_index::hashed_non_unique<
+      boost::multi_index::tag<byName>,
+      boost::multi_index::const_mem_fun<cs::Entry, const Name&, &cs::Entry::getName>,
+      NameHash
     >,
 
-    // index by staleness time
-    boost::multi_index::ordered_non_unique<
-      boost::multi_index::tag<byStaleness>,
-      boost::multi_index::identity<cs::Entry*>,
-      StalenessComparator
-    >,
-
-    // unsolicited Data is in the front
-    boost::multi_index::ordered_non_unique<
-      boost::multi_index::tag<unsolicited>,
-      boost::multi_index::identity<cs::Entry*>,
-      UnsolicitedComparator
+    // by full Name, including implicit digest
+    boost::multi_index::hashed_unique<
+      boost::multi_index::tag<byFullName>,
+      boost::multi_index::const_mem_fun<cs::Entry, const Name&, &cs::Entry::getFullName>,
+      NameHash
     >
 
   >
-> CleanupIndex;
+> ExactNameIndex;
 
 /** \brief represents Content Store
  */
 class Cs : noncopyable
 {
 public:
+  /** \brief ordered index implementations that back find()
+   */
+  enum IndexType {
+    /// skip list of std::list layers
+    INDEX_SKIP_LIST,
+    /// B+-tree with contiguous leaf nodes, keyed on encoded full Name
+    INDEX_BTREE
+  };
+
   explicit
-  Cs(size_t nMaxPackets = 10);
+  Cs(size_t nMaxPackets = 10, IndexType indexType = INDEX_SKIP_LIST);
 
   ~Cs();
 
   /** \brief inserts a Data packet
    *  This method does not consider the payload of the Data packet.
+   *  Entries are evicted until the Data fits in the byte limit;
+   *  a Data packet larger than the byte limit itself is not stored.
    *
    *  Packets are considered duplicate if the name matches.
    *  The new Data packet with the identical name, but a different payload
@@ -119,10 +121,14 @@ public:
   insert(const Data& data, bool isUnsolicited = false);
 
   /** \brief finds the best match Data for an Interest
+   *
+   *  When the in-memory tier has no match and the disk tier is enabled,
+   *  an Interest without selectors other than MustBeFresh and leftmost ChildSelector
+   *  is looked up in the disk tier; a match is promoted into the in-memory tier.
    *  \return{ the best match, if any; otherwise 0 }
    */
   const Data*
-  find(const Interest& interest) const;
+  find(const Interest& interest);
 
   /** \brief deletes CS entry by the exact name
    */
@@ -146,6 +152,74 @@ public:
   size_t
   size() const;
 
+  /** \brief sets maximum allowed size of Content Store (in bytes)
+   *
+   *  The size of an entry is the wire size of its Data packet plus
+   *  a fixed per-entry overhead, see getEntrySize()
+   */
+  void
+  setByteLimit(size_t nMaxBytes);
+
+  /** \brief returns maximum allowed size of Content Store (in bytes)
+   *  \return{ std::numeric_limits<size_t>::max() if the byte size is unlimited }
+   */
+  size_t
+  getByteLimit() const;
+
+  /** \brief returns current size of Content Store measured in bytes
+   */
+  size_t
+  getNBytes() const;
+
+  /** \brief returns the number of bytes a Data packet occupies when stored in Content Store
+   */
+  static size_t
+  getEntrySize(const Data& data);
+
+  /** \brief changes the ordered index implementation
+   *
+   *  Stored entries are moved to the new index as they are; their staleness and
+   *  replacement policy state are unchanged.
+   */
+  void
+  setIndexType(IndexType indexType);
+
+  IndexType
+  getIndexType() const;
+
+  /** \brief enables the on-disk second tier
+   *
+   *  Solicited Data evicted from memory are written to the disk tier,
+   *  including every entry left in memory when Cs is destroyed.
+   *  Evicted Data are queued, and written in a batch by a scheduler event,
+   *  so that file writes are not on the packet processing path.
+   *  \param path file that backs the disk tier; its records are reused if it exists
+   *  \param capacity maximum bytes of records in the file
+   *  \throw cs::DiskTier::Error the file cannot be opened or mapped
+   */
+  void
+  enableDiskTier(const std::string& path, uint64_t capacity);
+
+  void
+  disableDiskTier();
+
+  /** \return the disk tier, or 0 if it is disabled
+   */
+  const cs::DiskTier*
+  getDiskTier() const;
+
+  /** \brief changes the replacement policy
+   *
+   *  The new policy starts tracking the stored entries in Name order,
+   *  without history from the previous policy.
+   *  The default policy is "fifo" (cs::PriorityFifoPolicy).
+   */
+  void
+  setPolicy(shared_ptr<cs::Policy> policy);
+
+  const cs::Policy&
+  getPolicy() const;
+
 protected:
   /** \brief removes one Data packet from Content Store based on replacement policy
    *  \return{ whether the Data was removed }
@@ -154,6 +228,32 @@ protected:
   evictItem();
 
 private:
+  /** \brief makes room for a Data packet, and places it in the ordered and exact name indexes
+   *
+   *  The replacement policy is not notified.
+   *  \return{ a pair containing a pointer to the CS Entry (0 if Data is too large),
+   *  and a flag indicating if the entry was newly created (True) or refreshed (False) }
+   */
+  std::pair<cs::Entry*, bool>
+  insertEntry(const Data& data, bool isUnsolicited);
+
+  /** \brief looks up an Interest in the disk tier, and moves the match into memory
+   *  \return{ the promoted entry, or 0 }
+   */
+  cs::Entry*
+  findInDiskTier(const Interest& interest);
+
+  /** \brief finds Data that is queued for the disk tier, like cs::DiskTier::find
+   */
+  shared_ptr<const Data>
+  findInDiskWriteQueue(const Name& name, bool mustBeFresh,
+                       time::system_clock::TimePoint& staleAt) const;
+
+  /** \brief writes queued evicted Data to the disk tier
+   */
+  void
+  flushDiskWriteQueue();
+
   /** \brief returns True if the Content Store is at its maximum capacity
    *  \return{ True if Content Store is full; otherwise False}
    */
@@ -175,19 +275,79 @@ private:
   std::pair<cs::Entry*, bool>
   insertToSkipList(const Data& data, bool isUnsolicited = false);
 
+  /** \brief Links an existing CS Entry into all layers of a skip list
+   *  \return{ the linked entry and true; or, if an entry with the same full Name exists,
+   *           that entry and false }
+   */
+  std::pair<cs::Entry*, bool>
+  linkToSkipList(cs::Entry* entry);
+
+  /** \brief Unlinks all entries from the skip list without releasing them
+   */
+  void
+  clearSkipList();
+
   /** \brief Removes a specific CS Entry from all layers of a skip list
    *  \return{ returns True if CS Entry was succesfully removed and False if CS Entry was not found}
    */
   bool
   eraseFromSkipList(cs::Entry* entry);
 
+  /** \brief Inserts a new Content Store Entry in the B+-tree index
+   *  \return{ returns a pair containing a pointer to the CS Entry,
+   *  and a flag indicating if the entry was newly created (True) or refreshed (False) }
+   */
+  std::pair<cs::Entry*, bool>
+  insertToBTree(const Data& data, bool isUnsolicited = false);
+
+  /** \brief Removes a specific CS Entry from the B+-tree index
+   *  \return{ returns True if CS Entry was succesfully removed and False if CS Entry was not found}
+   */
+  bool
+  eraseFromBTree(cs::Entry* entry);
+
+  /** \brief Removes a specific CS Entry from the index in use
+   */
+  bool
+  eraseFromIndex(cs::Entry* entry);
+
+  /** \brief finds the leftmost match for an Interest that has no selectors
+   *         other than MustBeFresh and leftmost ChildSelector, using the exact name index
+   *
+   *  The Interest Name is looked up as a full Name, and then as a Data Name.
+   *  \return{ the match, or 0 if the ordered index must be searched }
+   */
+  cs::Entry*
+  findExactMatch(const Interest& interest) const;
+
+  /** \brief returns true if no entry under \p prefix precedes \p entry in Name order
+   */
+  bool
+  isFirstUnderPrefix(const Name& prefix, cs::Entry* entry) const;
+
+  /** \brief finds the best match entry for an Interest in the skip list
+   */
+  cs::Entry*
+  findInSkipList(const Interest& interest) const;
+
+  /** \brief finds the best match entry for an Interest in the B+-tree index
+   */
+  cs::Entry*
+  findInBTree(const Interest& interest) const;
+
+  /** \brief returns stored entries in Name order
+   */
+  std::vector<cs::Entry*>
+  listEntries() const;
+
   /** \brief Prints contents of the skip list, starting from the top layer
    */
   void
   printSkipList() const;
 
   /** \brief Implements child selector (leftmost, rightmost, undeclared).
-   *  Operates on the first layer of a skip list.
+   *  Operates on the first layer of a skip list, or on the B+-tree index;
+   *  [begin, end) is the whole ordered sequence of CS entries.
    *
    *  startingPoint must be less than Interest Name.
    *  startingPoint can be equal to Interest Name only when the item is in the begin() position.
@@ -198,8 +358,10 @@ private:
    *  other selectors. Returned CS entry is the leftmost child of the rightmost child.
    *  \return{ the best match, if any; otherwise 0 }
    */
-  const Data*
-  selectChild(const Interest& interest, SkipListLayer::iterator startingPoint) const;
+  template<class Iterator>
+  cs::Entry*
+  selectChild(const Interest& interest, Iterator startingPoint,
+              Iterator begin, Iterator end) const;
 
   /** \brief checks if Content Store entry satisfies Interest selectors (MinSuffixComponents,
    *  MaxSuffixComponents, Implicit Digest, MustBeFresh)
@@ -218,13 +380,52 @@ private:
   recognizeInterestWithDigest(const Interest& interest, cs::Entry* entry) const;
 
 private:
+  IndexType m_indexType;
   SkipList m_skipList;
-  CleanupIndex m_cleanupIndex;
+  cs::BTreeIndex m_bTreeIndex;
+  ExactNameIndex m_exactNameIndex;
+  scoped_ptr<cs::DiskTier> m_diskTier;
+  // evicted Data and the time they become stale, oldest first
+  std::vector<std::pair<shared_ptr<const Data>, time::system_clock::TimePoint> > m_diskWriteQueue;
+  EventId m_diskWriteEvent;
+  shared_ptr<cs::Policy> m_policy;
   size_t m_nMaxPackets; // user defined maximum size of the Content Store in packets
   size_t m_nPackets;    // current number of packets in Content Store
+  size_t m_nMaxBytes;   // user defined maximum size of the Content Store in bytes
+  size_t m_nBytes;      // current number of bytes used by Content Store entries
   std::queue<cs::Entry*> m_freeCsEntries; // memory pool
 };
 
+inline Cs::IndexType
+Cs::getIndexType() const
+{
+  return m_indexType;
+}
+
+inline const cs::DiskTier*
+Cs::getDiskTier() const
+{
+  return m_diskTier.get();
+}
+
+inline const cs::Policy&
+Cs::getPolicy() const
+{
+  return *m_policy;
+}
+
+inline size_t
+Cs::getByteLimit() const
+{
+  return m_nMaxBytes;
+}
+
+inline size_t
+Cs::getNBytes() const
+{
+  return m_nBytes;
+}
+
 } // namespace nfd
 
 #endif // NFD_DAEMON_TABLE_CS_HPP
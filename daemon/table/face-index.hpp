@@ -0,0 +1,131 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_FACE_INDEX_HPP
+#define NFD_DAEMON_TABLE_FACE_INDEX_HPP
+
+#include "common.hpp"
+
+namespace nfd {
+
+class Face;
+
+/** \brief an index from Face to the table entries that refer to it
+ *
+ *  Each Face has an unordered list of entries. The table records the position returned
+ *  by add in the record that refers to the Face, so that remove takes constant time.
+ *  remove fills the hole with the last entry of the list, and returns that entry
+ *  so that the table can update its recorded position.
+ *  This allows removing a Face to visit only the entries that refer to it.
+ */
+template<typename E>
+class FaceIndex : noncopyable
+{
+public:
+  typedef std::vector<E*> EntryList;
+
+  /** \brief appends entry to the list of face
+   *  \return position of entry in the list
+   */
+  size_t
+  add(const Face& face, E* entry);
+
+  /** \brief removes the entry at position from the list of face
+   *  \return the entry that is moved into position, or 0 if none is moved
+   *  \note This does nothing if the list of face has been taken.
+   */
+  E*
+  remove(const Face& face, size_t position);
+
+  /** \brief removes the list of face from the index
+   *  \param[out] entries the list of face
+   */
+  void
+  take(const Face& face, EntryList& entries);
+
+  /// \return number of entries in the list of face
+  size_t
+  size(const Face& face) const;
+
+private:
+  typedef std::map<const Face*, EntryList> ListMap;
+  ListMap m_lists;
+};
+
+template<typename E>
+inline size_t
+FaceIndex<E>::add(const Face& face, E* entry)
+{
+  EntryList& list = m_lists[&face];
+  list.push_back(entry);
+  return list.size() - 1;
+}
+
+template<typename E>
+inline E*
+FaceIndex<E>::remove(const Face& face, size_t position)
+{
+  typename ListMap::iterator it = m_lists.find(&face);
+  if (it == m_lists.end()) {
+    return 0;
+  }
+
+  // an empty list is kept, so that its capacity is reused by the next add
+  EntryList& list = it->second;
+  BOOST_ASSERT(position < list.size());
+  E* moved = 0;
+  if (position != list.size() - 1) {
+    moved = list.back();
+    list[position] = moved;
+  }
+  list.pop_back();
+  return moved;
+}
+
+template<typename E>
+inline void
+FaceIndex<E>::take(const Face& face, EntryList& entries)
+{
+  entries.clear();
+  typename ListMap::iterator it = m_lists.find(&face);
+  if (it == m_lists.end()) {
+    return;
+  }
+
+  entries.swap(it->second);
+  m_lists.erase(it);
+}
+
+template<typename E>
+inline size_t
+FaceIndex<E>::size(const Face& face) const
+{
+  typename ListMap::const_iterator it = m_lists.find(&face);
+  return it == m_lists.end() ? 0 : it->second.size();
+}
+
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_FACE_INDEX_HPP
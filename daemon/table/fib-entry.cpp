@@ -29,9 +29,15 @@ namespace fib {
 
 Entry::Entry(const Name& prefix)
   : m_prefix(prefix)
+  , m_faceIndex(0)
 {
 }
 
+Entry::~Entry()
+{
+  this->detachFromFaceIndex();
+}
+
 static inline bool
 predicate_NextHop_eq_Face(const NextHop& nexthop, shared_ptr<Face> face)
 {
@@ -54,6 +60,9 @@ Entry::addNextHop(shared_ptr<Face> face, uint64_t cost)
   if (it == m_nextHops.end()) {
     m_nextHops.push_back(fib::NextHop(face));
     it = m_nextHops.end() - 1;
+    if (m_faceIndex != 0) {
+      it->m_faceIndexPosition = m_faceIndex->add(*face, this);
+    }
   }
   // now it refers to the NextHop for face
 
@@ -71,9 +80,36 @@ Entry::removeNextHop(shared_ptr<Face> face)
     return;
   }
 
+  this->removeFromFaceIndex(it);
   m_nextHops.erase(it);
 }
 
+void
+Entry::removeFromFaceIndex(NextHopList::iterator it)
+{
+  if (m_faceIndex == 0) {
+    return;
+  }
+
+  shared_ptr<Face> face = it->getFace();
+  Entry* moved = m_faceIndex->remove(*face, it->m_faceIndexPosition);
+  if (moved != 0) {
+    NextHopList::iterator movedIt = std::find_if(moved->m_nextHops.begin(),
+      moved->m_nextHops.end(), bind(&predicate_NextHop_eq_Face, _1, face));
+    BOOST_ASSERT(movedIt != moved->m_nextHops.end());
+    movedIt->m_faceIndexPosition = it->m_faceIndexPosition;
+  }
+}
+
+void
+Entry::detachFromFaceIndex()
+{
+  for (NextHopList::iterator it = m_nextHops.begin(); it != m_nextHops.end(); ++it) {
+    this->removeFromFaceIndex(it);
+  }
+  m_faceIndex = 0;
+}
+
 static inline bool
 compare_NextHop_cost(const NextHop& a, const NextHop& b)
 {
@@ -26,10 +26,12 @@
 #define NFD_DAEMON_TABLE_FIB_ENTRY_HPP
 
 #include "fib-nexthop.hpp"
+#include "face-index.hpp"
 
 namespace nfd {
 
 class NameTree;
+class Fib;
 namespace name_tree {
 class Entry;
 }
@@ -54,6 +56,8 @@ public:
   explicit
   Entry(const Name& prefix);
 
+  ~Entry();
+
   const Name&
   getPrefix() const;
 
@@ -80,13 +84,25 @@ private:
   void
   sortNextHops();
 
+  /// removes the NextHop at it from the FaceIndex
+  void
+  removeFromFaceIndex(NextHopList::iterator it);
+
+  /// removes all NextHops from the FaceIndex, and stops indexing this entry
+  void
+  detachFromFaceIndex();
+
 private:
   Name m_prefix;
   NextHopList m_nextHops;
 
+  /// the index of the Fib this entry belongs to, or 0 if this entry is not in a Fib
+  FaceIndex<Entry>* m_faceIndex;
+
   shared_ptr<name_tree::Entry> m_nameTreeEntry;
   friend class nfd::NameTree;
   friend class nfd::name_tree::Entry;
+  friend class nfd::Fib;
 };
 
 
@@ -28,12 +28,13 @@ namespace nfd {
 namespace fib {
 
 NextHop::NextHop(shared_ptr<Face> face)
-  : m_face(face), m_cost(0)
+  : m_face(face), m_cost(0), m_faceIndexPosition(0)
 {
 }
 
 NextHop::NextHop(const NextHop& other)
   : m_face(other.m_face), m_cost(other.m_cost)
+  , m_faceIndexPosition(other.m_faceIndexPosition)
 {
 }
 
@@ -54,6 +54,11 @@ public:
 private:
   shared_ptr<Face> m_face;
   uint64_t m_cost;
+
+  /// position of the FIB entry in the FaceIndex list of m_face
+  size_t m_faceIndexPosition;
+
+  friend class Entry;
 };
 
 } // namespace fib
@@ -37,14 +37,23 @@ Fib::Fib(NameTree& nameTree)
 {
 }
 
-Fib::~Fib()
+/// selects NameTree entries that have a FIB entry
+struct predicate_NameTreeEntry_hasFibEntry
 {
-}
+  bool
+  operator()(const name_tree::Entry& entry) const
+  {
+    return static_cast<bool>(entry.getFibEntry());
+  }
+};
 
-static inline bool
-predicate_NameTreeEntry_hasFibEntry(const name_tree::Entry& entry)
+Fib::~Fib()
 {
-  return static_cast<bool>(entry.getFibEntry());
+  // entries may outlive the FIB
+  for (NameTree::const_iterator it = m_nameTree.fullEnumerate(
+       predicate_NameTreeEntry_hasFibEntry()); it != m_nameTree.end(); ++it) {
+    it->getFibEntry()->detachFromFaceIndex();
+  }
 }
 
 std::pair<shared_ptr<fib::Entry>, bool>
@@ -55,6 +64,7 @@ Fib::insert(const Name& prefix)
   if (static_cast<bool>(entry))
     return std::make_pair(entry, false);
   entry = make_shared<fib::Entry>(prefix);
+  entry->m_faceIndex = &m_faceIndex;
   nameTreeEntry->setFibEntry(entry);
   ++m_nItems;
   return std::make_pair(entry, true);
@@ -62,9 +72,15 @@ Fib::insert(const Name& prefix)
 
 shared_ptr<fib::Entry>
 Fib::findLongestPrefixMatch(const Name& prefix) const
+{
+  return findLongestPrefixMatch(name_tree::LookupContext(prefix));
+}
+
+shared_ptr<fib::Entry>
+Fib::findLongestPrefixMatch(const name_tree::LookupContext& context) const
 {
   shared_ptr<name_tree::Entry> nameTreeEntry =
-    m_nameTree.findLongestPrefixMatch(prefix, &predicate_NameTreeEntry_hasFibEntry);
+    m_nameTree.findLongestPrefixMatchByLength(context, predicate_NameTreeEntry_hasFibEntry());
   if (static_cast<bool>(nameTreeEntry)) {
     return nameTreeEntry->getFibEntry();
   }
@@ -78,7 +94,7 @@ Fib::findLongestPrefixMatch(shared_ptr<name_tree::Entry> nameTreeEntry) const
   if (static_cast<bool>(entry))
     return entry;
   nameTreeEntry = m_nameTree.findLongestPrefixMatch(nameTreeEntry,
-                                                    &predicate_NameTreeEntry_hasFibEntry);
+                                                    predicate_NameTreeEntry_hasFibEntry());
   if (static_cast<bool>(nameTreeEntry)) {
     return nameTreeEntry->getFibEntry();
   }
@@ -117,6 +133,7 @@ Fib::findExactMatch(const Name& prefix) const
 void
 Fib::erase(shared_ptr<name_tree::Entry> nameTreeEntry)
 {
+  nameTreeEntry->getFibEntry()->detachFromFaceIndex();
   nameTreeEntry->setFibEntry(shared_ptr<fib::Entry>());
   m_nameTree.eraseEntryIfEmpty(nameTreeEntry);
   --m_nItems;
@@ -143,15 +160,16 @@ Fib::erase(const fib::Entry& entry)
 void
 Fib::removeNextHopFromAllEntries(shared_ptr<Face> face)
 {
-  for (NameTree::const_iterator it = m_nameTree.fullEnumerate(
-       &predicate_NameTreeEntry_hasFibEntry); it != m_nameTree.end();) {
-    shared_ptr<fib::Entry> entry = it->getFibEntry();
-
-    ++it; // need to be advance before `erase`, otherwise the iterator can be invalidated
-
-    entry->removeNextHop(face);
-    if (!entry->hasNextHops()) {
-      this->erase(*entry);
+  // the list is taken out of the index, so that removeNextHop does not modify it
+  FaceIndex<fib::Entry>::EntryList entries;
+  m_faceIndex.take(*face, entries);
+
+  for (FaceIndex<fib::Entry>::EntryList::iterator it = entries.begin();
+       it != entries.end(); ++it) {
+    fib::Entry& entry = **it;
+    entry.removeNextHop(face);
+    if (!entry.hasNextHops()) {
+      this->erase(entry);
     }
   }
 }
@@ -159,7 +177,7 @@ Fib::removeNextHopFromAllEntries(shared_ptr<Face> face)
 Fib::const_iterator
 Fib::begin() const
 {
-  return const_iterator(m_nameTree.fullEnumerate(&predicate_NameTreeEntry_hasFibEntry));
+  return const_iterator(m_nameTree.fullEnumerate(predicate_NameTreeEntry_hasFibEntry()));
 }
 
 } // namespace nfd
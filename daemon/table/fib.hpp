@@ -62,6 +62,12 @@ public:
   shared_ptr<fib::Entry>
   findLongestPrefixMatch(const Name& prefix) const;
 
+  /** \brief performs a longest prefix match, using precomputed hash values
+   *  \sa NameTree::findLongestPrefixMatchByLength
+   */
+  shared_ptr<fib::Entry>
+  findLongestPrefixMatch(const name_tree::LookupContext& context) const;
+
   /// performs a longest prefix match
   shared_ptr<fib::Entry>
   findLongestPrefixMatch(const pit::Entry& pitEntry) const;
@@ -81,7 +87,8 @@ public:
 
   /** \brief removes the NextHop record for face in all entrites
    *  This is usually invoked when face goes away.
-   *  Removing all NextHops in a FIB entry will not remove the FIB entry.
+   *  Only the entries that have a NextHop record for face are visited.
+   *  An entry left without NextHop records is erased.
    */
   void
   removeNextHopFromAllEntries(shared_ptr<Face> face);
@@ -136,6 +143,9 @@ private:
   NameTree& m_nameTree;
   size_t m_nItems;
 
+  /// FIB entries by nexthop face
+  FaceIndex<fib::Entry> m_faceIndex;
+
   /** \brief The empty FIB entry.
    *
    *  This entry has no nexthops.
@@ -40,11 +40,15 @@ Measurements::~Measurements()
 {
 }
 
-static inline bool
-predicate_NameTreeEntry_hasMeasurementsEntry(const name_tree::Entry& entry)
+/// selects NameTree entries that have a Measurements entry
+struct predicate_NameTreeEntry_hasMeasurementsEntry
 {
-  return static_cast<bool>(entry.getMeasurementsEntry());
-}
+  bool
+  operator()(const name_tree::Entry& entry) const
+  {
+    return static_cast<bool>(entry.getMeasurementsEntry());
+  }
+};
 
 shared_ptr<measurements::Entry>
 Measurements::get(shared_ptr<name_tree::Entry> nameTreeEntry)
@@ -113,9 +117,15 @@ Measurements::getParent(shared_ptr<measurements::Entry> child)
 
 shared_ptr<measurements::Entry>
 Measurements::findLongestPrefixMatch(const Name& name) const
+{
+  return findLongestPrefixMatch(name_tree::LookupContext(name));
+}
+
+shared_ptr<measurements::Entry>
+Measurements::findLongestPrefixMatch(const name_tree::LookupContext& context) const
 {
   shared_ptr<name_tree::Entry> nameTreeEntry =
-    m_nameTree.findLongestPrefixMatch(name, &predicate_NameTreeEntry_hasMeasurementsEntry);
+    m_nameTree.findLongestPrefixMatch(context, predicate_NameTreeEntry_hasMeasurementsEntry());
   if (static_cast<bool>(nameTreeEntry)) {
     return nameTreeEntry->getMeasurementsEntry();
   }
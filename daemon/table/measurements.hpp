@@ -74,6 +74,10 @@ public:
   shared_ptr<measurements::Entry>
   findLongestPrefixMatch(const Name& name) const;
 
+  /// perform a longest prefix match, using precomputed hash values
+  shared_ptr<measurements::Entry>
+  findLongestPrefixMatch(const name_tree::LookupContext& context) const;
+
   /// perform an exact match
   shared_ptr<measurements::Entry>
   findExactMatch(const Name& name) const;
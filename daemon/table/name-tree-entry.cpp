@@ -28,25 +28,11 @@
 namespace nfd {
 namespace name_tree {
 
-Node::Node()
-  : m_prev(0)
-  , m_next(0)
-{
-}
-
-Node::~Node()
-{
-  // erase the Name Tree Nodes that were created to
-  // resolve hash collisions
-  // So before erasing a single node, make sure its m_next == 0
-  // See eraseEntryIfEmpty in name-tree.cpp
-  if (m_next != 0)
-    delete m_next;
-}
-
 Entry::Entry(const Name& name)
   : m_hash(0)
   , m_prefix(name)
+  , m_table(0)
+  , m_slot(0)
 {
 }
 
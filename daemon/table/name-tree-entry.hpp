@@ -38,27 +38,6 @@ class NameTree;
 
 namespace name_tree {
 
-// Forward declarations
-class Node;
-class Entry;
-
-/**
- * \brief Name Tree Node Class
- */
-class Node
-{
-public:
-  Node();
-
-  ~Node();
-
-public:
-  // variables are in public as this is just a data structure
-  shared_ptr<Entry> m_entry; // Name Tree Entry (i.e., Name Prefix Entry)
-  Node* m_prev; // Previous Name Tree Node (to resolve hash collision)
-  Node* m_next; // Next Name Tree Node (to resolve hash collision)
-};
-
 /**
  * \brief Name Tree Entry Class
  */
@@ -138,8 +117,10 @@ private:
   shared_ptr<measurements::Entry> m_measurementsEntry;
   shared_ptr<strategy_choice::Entry> m_strategyChoiceEntry;
 
-  // get the Name Tree Node that is associated with this Name Tree Entry
-  Node* m_node;
+  // position of this Name Tree Entry in the Name Tree hash tables:
+  // which of the two tables holds it, and the bucket in that table
+  size_t m_table;
+  size_t m_slot;
 
   // Make private members accessible by Name Tree
   friend class nfd::NameTree;
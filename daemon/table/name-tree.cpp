@@ -28,6 +28,10 @@
 #include "core/logger.hpp"
 #include "core/city-hash.hpp"
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif // __SSE2__
+
 namespace nfd {
 
 NFD_LOG_INIT("NameTree");
@@ -38,9 +42,12 @@ class Hash32
 {
 public:
   static size_t
-  compute(const char* buffer, size_t length)
+  compute(const char* buffer, size_t length, size_t seed)
   {
-    return static_cast<size_t>(CityHash32(buffer, length));
+    size_t hashValue = static_cast<size_t>(CityHash32(buffer, length));
+    // CityHash32 has no seeded variant, so fold the seed in the same way
+    // as boost::hash_combine
+    return seed ^ (hashValue + 0x9e3779b9 + (seed << 6) + (seed >> 2));
   }
 };
 
@@ -48,14 +55,28 @@ class Hash64
 {
 public:
   static size_t
-  compute(const char* buffer, size_t length)
+  compute(const char* buffer, size_t length, size_t seed)
   {
-    return static_cast<size_t>(CityHash64(buffer, length));
+    return static_cast<size_t>(CityHash64WithSeed(buffer, length, seed));
   }
 };
 
 typedef boost::mpl::if_c<sizeof(size_t) >= 8, Hash64, Hash32>::type CityHash;
 
+/** \brief compute the hash value of a prefix from its parent's hash value
+ *         and its last component
+ *
+ *  Seeding the component hash with the parent's hash makes the prefix hash
+ *  order-sensitive: /a/b and /b/a, or /seg/1/seg/2 and /seg/2/seg/1,
+ *  do not collide unless the underlying CityHash does.
+ */
+static inline size_t
+computeNextHash(size_t parentHash, const name::Component& component)
+{
+  const char* wireFormat = reinterpret_cast<const char*>(component.wire());
+  return CityHash::compute(wireFormat, component.size(), parentHash);
+}
+
 // Interface of different hash functions
 size_t
 computeHash(const Name& prefix)
@@ -63,13 +84,26 @@ computeHash(const Name& prefix)
   prefix.wireEncode();  // guarantees prefix's wire buffer is not empty
 
   size_t hashValue = 0;
-  size_t hashUpdate = 0;
 
   for (Name::const_iterator it = prefix.begin(); it != prefix.end(); it++)
     {
-      const char* wireFormat = reinterpret_cast<const char*>( it->wire() );
-      hashUpdate = CityHash::compute(wireFormat, it->size());
-      hashValue ^= hashUpdate;
+      hashValue = computeNextHash(hashValue, *it);
+    }
+
+  return hashValue;
+}
+
+size_t
+computeHash(const Name& name, size_t prefixLength)
+{
+  name.wireEncode();  // guarantees name's wire buffer is not empty
+
+  size_t hashValue = 0;
+  size_t nComponents = std::min(prefixLength, name.size());
+
+  for (size_t i = 0; i < nComponents; ++i)
+    {
+      hashValue = computeNextHash(hashValue, name[i]);
     }
 
   return hashValue;
@@ -81,32 +115,157 @@ computeHashSet(const Name& prefix)
   prefix.wireEncode();  // guarantees prefix's wire buffer is not empty
 
   size_t hashValue = 0;
-  size_t hashUpdate = 0;
 
   std::vector<size_t> hashValueSet;
+  hashValueSet.reserve(prefix.size() + 1);
   hashValueSet.push_back(hashValue);
 
   for (Name::const_iterator it = prefix.begin(); it != prefix.end(); it++)
     {
-      const char* wireFormat = reinterpret_cast<const char*>( it->wire() );
-      hashUpdate = CityHash::compute(wireFormat, it->size());
-      hashValue ^= hashUpdate;
+      hashValue = computeNextHash(hashValue, *it);
       hashValueSet.push_back(hashValue);
     }
 
   return hashValueSet;
 }
 
+/** \brief the hash table is probed one group of buckets at a time
+ *
+ *  Each bucket has a control byte. The control bytes of a group fit in one
+ *  SSE2 register, so a group is searched for a hash fragment with a single
+ *  comparison, and Entries are only dereferenced on a fragment match.
+ *  Groups are aligned, and the number of buckets is a multiple of GROUP_SIZE.
+ */
+static const size_t GROUP_SIZE = 16;
+
+/// control byte of a bucket that has never been used
+static const int8_t CONTROL_EMPTY = -128;
+
+/// control byte of a bucket whose entry was erased
+static const int8_t CONTROL_DELETED = -2;
+
+/// \return hash bits that select the first group to probe
+static inline size_t
+getH1(size_t hashValue)
+{
+  return hashValue >> 7;
+}
+
+/// \return hash bits stored in the control byte of an occupied bucket
+static inline int8_t
+getH2(size_t hashValue)
+{
+  return static_cast<int8_t>(hashValue & 0x7F);
+}
+
+/// \return bitmask of the buckets in group whose control byte equals control
+static inline uint32_t
+matchControl(const int8_t* group, int8_t control)
+{
+#ifdef __SSE2__
+  __m128i controls = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+  return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(controls,
+                                                                _mm_set1_epi8(control))));
+#else
+  uint32_t mask = 0;
+  for (size_t i = 0; i < GROUP_SIZE; ++i)
+    {
+      if (group[i] == control)
+        mask |= 1 << i;
+    }
+  return mask;
+#endif // __SSE2__
+}
+
+/// \return bitmask of the buckets in group that are EMPTY or DELETED
+static inline uint32_t
+matchAvailable(const int8_t* group)
+{
+#ifdef __SSE2__
+  // only EMPTY and DELETED have the sign bit set
+  __m128i controls = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+  return static_cast<uint32_t>(_mm_movemask_epi8(controls));
+#else
+  uint32_t mask = 0;
+  for (size_t i = 0; i < GROUP_SIZE; ++i)
+    {
+      if (group[i] < 0)
+        mask |= 1 << i;
+    }
+  return mask;
+#endif // __SSE2__
+}
+
+/// \return index of the lowest set bit in a non-zero mask
+static inline size_t
+lowestBit(uint32_t mask)
+{
+  BOOST_ASSERT(mask != 0);
+#if defined(__GNUC__)
+  return static_cast<size_t>(__builtin_ctz(mask));
+#else
+  size_t i = 0;
+  while ((mask & 1) == 0)
+    {
+      mask >>= 1;
+      ++i;
+    }
+  return i;
+#endif // __GNUC__
+}
+
+/** \brief find an EMPTY or DELETED bucket for a new entry
+ *
+ *  Groups are visited in triangular order (+1, +2, +3, ...), which covers
+ *  every group when the number of groups is a power of two.
+ *  Lookups follow the same order, and stop at the first group with an EMPTY bucket.
+ */
+static size_t
+findAvailableSlot(const std::vector<int8_t>& controls, size_t hashValue)
+{
+  size_t groupMask = controls.size() / GROUP_SIZE - 1;
+  size_t group = getH1(hashValue) & groupMask;
+
+  for (size_t step = 1; ; ++step)
+    {
+      uint32_t mask = matchAvailable(&controls[group * GROUP_SIZE]);
+      if (mask != 0)
+        return group * GROUP_SIZE + lowestBit(mask);
+      group = (group + step) & groupMask;
+    }
+}
+
+/** \brief number of buckets of the former table migrated by each insertion or deletion
+ *
+ *  A growth from N to 2N buckets starts at N/2 entries, and the next growth is due at N
+ *  entries; a shrink from N to N/2 buckets starts below N/10 entries, and the next shrink
+ *  is due below N/20 entries. Migrating two groups per operation is enough to complete
+ *  a migration before the next resize is due.
+ */
+static const size_t MIGRATION_STEP = 2 * GROUP_SIZE;
+
+/// round the number of buckets up to a power of two, and at least one group
+static size_t
+roundNBuckets(size_t nBuckets)
+{
+  size_t roundedNBuckets = GROUP_SIZE;
+  while (roundedNBuckets < nBuckets)
+    roundedNBuckets <<= 1;
+  return roundedNBuckets;
+}
+
 } // namespace name_tree
 
 NameTree::NameTree(size_t nBuckets)
   : m_nItems(0)
-  , m_nBuckets(nBuckets)
-  , m_minNBuckets(nBuckets)
+  , m_nBuckets(name_tree::roundNBuckets(nBuckets))
+  , m_minNBuckets(m_nBuckets)
   , m_enlargeLoadFactor(0.5)       // more than 50% buckets loaded
   , m_enlargeFactor(2)       // double the hash table size
   , m_shrinkLoadFactor(0.1) // less than 10% buckets loaded
   , m_shrinkFactor(0.5)     // reduce the number of buckets by half
+  , m_currentTable(0)
+  , m_nMigrated(0)
   , m_endIterator(FULL_ENUMERATE_TYPE, *this, m_end)
 {
   m_enlargeThreshold = static_cast<size_t>(m_enlargeLoadFactor *
@@ -115,73 +274,170 @@ NameTree::NameTree(size_t nBuckets)
   m_shrinkThreshold = static_cast<size_t>(m_shrinkLoadFactor *
                                           static_cast<double>(m_nBuckets));
 
-  // array of node pointers
-  m_buckets = new name_tree::Node*[m_nBuckets];
-  // Initialize the pointer array
-  for (size_t i = 0; i < m_nBuckets; i++)
-    m_buckets[i] = 0;
+  allocateTable(m_tables[0], m_nBuckets);
+  allocateTable(m_tables[1], 0);
 }
 
 NameTree::~NameTree()
 {
-  for (size_t i = 0; i < m_nBuckets; i++)
-    {
-      if (m_buckets[i] != 0) {
-        delete m_buckets[i];
-      }
-    }
+  deallocateTable(m_tables[0]);
+  deallocateTable(m_tables[1]);
+}
 
-  delete [] m_buckets;
+void
+NameTree::allocateTable(Table& table, size_t nBuckets)
+{
+  table.controls.assign(nBuckets, name_tree::CONTROL_EMPTY);
+  // slots are left uninitialized, so that the pages of a large table are
+  // faulted in as buckets are filled, rather than when resize() starts
+  table.slots = nBuckets == 0 ? 0 : std::allocator<name_tree::Slot>().allocate(nBuckets);
+  table.nItems = 0;
+  table.nDeleted = 0;
 }
 
-// insert() is a private function, and called by only lookup()
-std::pair<shared_ptr<name_tree::Entry>, bool>
-NameTree::insert(const Name& prefix)
+void
+NameTree::deallocateTable(Table& table)
 {
-  NFD_LOG_TRACE("insert " << prefix);
+  std::allocator<name_tree::Slot> allocator;
+  for (size_t i = 0; i < table.controls.size() && table.nItems > 0; i++)
+    {
+      if (table.controls[i] >= 0)
+        {
+          allocator.destroy(&table.slots[i]);
+          table.nItems--;
+        }
+    }
 
-  size_t hashValue = name_tree::computeHash(prefix);
-  size_t loc = hashValue % m_nBuckets;
+  if (table.slots != 0)
+    allocator.deallocate(table.slots, table.controls.size());
 
-  NFD_LOG_TRACE("Name " << prefix << " hash value = " << hashValue << "  location = " << loc);
+  std::vector<int8_t>().swap(table.controls);
+  table.slots = 0;
+  table.nDeleted = 0;
+}
 
-  // Check if this Name has been stored
-  name_tree::Node* node = m_buckets[loc];
-  name_tree::Node* nodePrev = node;  // initialize nodePrev to node
+const name_tree::Slot*
+NameTree::findSlot(const Name& name, size_t prefixLength, size_t hashValue) const
+{
+  int8_t control = name_tree::getH2(hashValue);
 
-  for (node = m_buckets[loc]; node != 0; node = node->m_next)
+  // probe the current table, then the former table if a resize is in progress
+  for (size_t i = 0; i < 2; i++)
     {
-      if (static_cast<bool>(node->m_entry))
+      const Table& table = m_tables[i == 0 ? m_currentTable : 1 - m_currentTable];
+      if (table.nItems == 0)
+        continue;
+
+      size_t groupMask = table.controls.size() / name_tree::GROUP_SIZE - 1;
+      size_t group = name_tree::getH1(hashValue) & groupMask;
+
+      for (size_t step = 1; ; ++step)
         {
-          if (prefix == node->m_entry->m_prefix)
+          const int8_t* groupControls = &table.controls[group * name_tree::GROUP_SIZE];
+
+          for (uint32_t mask = name_tree::matchControl(groupControls, control);
+               mask != 0; mask &= mask - 1)
             {
-              return std::make_pair(node->m_entry, false); // false: old entry
+              const name_tree::Slot& slot =
+                table.slots[group * name_tree::GROUP_SIZE + name_tree::lowestBit(mask)];
+              if (slot.hash != hashValue)
+                continue;
+
+              // isPrefixOf() is used to avoid making a copy of the name
+              const Name& entryPrefix = slot.entry->m_prefix;
+              if (entryPrefix.size() == prefixLength && entryPrefix.isPrefixOf(name))
+                return &slot;
             }
+
+          // the prefix would have been placed in this group
+          if (name_tree::matchControl(groupControls, name_tree::CONTROL_EMPTY) != 0)
+            break;
+
+          group = (group + step) & groupMask;
         }
-      nodePrev = node;
     }
 
-  NFD_LOG_TRACE("Did not find " << prefix << ", need to insert it to the table");
+  return 0;
+}
 
-  // If no bucket is empty occupied, we need to create a new node, and it is
-  // linked from nodePrev
-  node = new name_tree::Node();
-  node->m_prev = nodePrev;
+void
+NameTree::insertSlot(size_t tableIndex, size_t hashValue,
+                     const shared_ptr<name_tree::Entry>& entry)
+{
+  Table& table = m_tables[tableIndex];
 
-  if (nodePrev == 0)
+  size_t slot = name_tree::findAvailableSlot(table.controls, hashValue);
+  if (table.controls[slot] == name_tree::CONTROL_DELETED)
     {
-      m_buckets[loc] = node;
+      table.nDeleted--;
+    }
+
+  name_tree::Slot value = { hashValue, entry };
+  std::allocator<name_tree::Slot>().construct(&table.slots[slot], value);
+  table.controls[slot] = name_tree::getH2(hashValue);
+  table.nItems++;
+
+  entry->m_table = tableIndex; // Used in eraseEntryIfEmpty.
+  entry->m_slot = slot;
+}
+
+void
+NameTree::eraseSlot(size_t tableIndex, size_t slot)
+{
+  Table& table = m_tables[tableIndex];
+
+  std::allocator<name_tree::Slot>().destroy(&table.slots[slot]);
+  table.nItems--;
+
+  // A lookup continues past a group only if the group has no EMPTY bucket.
+  // If this group has none, the bucket becomes DELETED so that such lookups
+  // still reach the groups that follow.
+  const int8_t* groupControls = &table.controls[slot & ~(name_tree::GROUP_SIZE - 1)];
+  if (name_tree::matchControl(groupControls, name_tree::CONTROL_EMPTY) != 0)
+    {
+      table.controls[slot] = name_tree::CONTROL_EMPTY;
     }
   else
     {
-      nodePrev->m_next = node;
+      table.controls[slot] = name_tree::CONTROL_DELETED;
+      table.nDeleted++;
+    }
+}
+
+// insert() is a private function, and called by only lookup()
+std::pair<shared_ptr<name_tree::Entry>, bool>
+NameTree::insert(const Name& name, size_t prefixLength, size_t hashValue)
+{
+  NFD_LOG_TRACE("insert " << name << " prefixLength = " << prefixLength);
+
+  // Check if this Name has been stored
+  const name_tree::Slot* slot = findSlot(name, prefixLength, hashValue);
+  if (slot != 0)
+    {
+      return std::make_pair(slot->entry, false); // false: old entry
+    }
+
+  NFD_LOG_TRACE("Did not find the prefix, need to insert it to the table");
+
+  // Lookups stop only at an EMPTY bucket. Purge DELETED buckets once they
+  // and the entries take up three quarters of the table; since entries take
+  // up at most half, each purge reclaims a quarter of the table.
+  const Table& table = m_tables[m_currentTable];
+  if (table.nItems + table.nDeleted >= m_nBuckets / 4 * 3)
+    {
+      resize(m_nBuckets);
     }
 
+  migrate(name_tree::MIGRATION_STEP);
+
   // Create a new Entry
-  shared_ptr<name_tree::Entry> entry(make_shared<name_tree::Entry>(prefix));
+  shared_ptr<name_tree::Entry> entry(make_shared<name_tree::Entry>(
+                                       name.getPrefix(prefixLength)));
   entry->setHash(hashValue);
-  node->m_entry = entry; // link the Entry to its Node
-  entry->m_node = node; // link the node to Entry. Used in eraseEntryIfEmpty.
+  insertSlot(m_currentTable, hashValue, entry);
+
+  NFD_LOG_TRACE("Name " << name << " hash value = " << hashValue <<
+                "  location = " << entry->m_slot);
 
   return std::make_pair(entry, true); // true: new entry
 }
@@ -190,6 +446,13 @@ NameTree::insert(const Name& prefix)
 shared_ptr<name_tree::Entry>
 NameTree::lookup(const Name& prefix)
 {
+  return lookup(name_tree::LookupContext(prefix));
+}
+
+shared_ptr<name_tree::Entry>
+NameTree::lookup(const name_tree::LookupContext& context)
+{
+  const Name& prefix = context.getName();
   NFD_LOG_TRACE("lookup " << prefix);
 
   shared_ptr<name_tree::Entry> entry;
@@ -197,10 +460,8 @@ NameTree::lookup(const Name& prefix)
 
   for (size_t i = 0; i <= prefix.size(); i++)
     {
-      Name temp = prefix.getPrefix(i);
-
       // insert() will create the entry if it does not exist.
-      std::pair<shared_ptr<name_tree::Entry>, bool> ret = insert(temp);
+      std::pair<shared_ptr<name_tree::Entry>, bool> ret = insert(prefix, i, context.getHash(i));
       entry = ret.first;
 
       if (ret.second == true)
@@ -224,88 +485,46 @@ NameTree::lookup(const Name& prefix)
   return entry;
 }
 
-// Exact Match
-shared_ptr<name_tree::Entry>
-NameTree::findExactMatch(const Name& prefix) const
+void
+NameTree::prefetch(const name_tree::LookupContext& context) const
 {
-  NFD_LOG_TRACE("findExactMatch " << prefix);
-
-  size_t hashValue = name_tree::computeHash(prefix);
-  size_t loc = hashValue % m_nBuckets;
-
-  NFD_LOG_TRACE("Name " << prefix << " hash value = " << hashValue <<
-                "  location = " << loc);
-
-  shared_ptr<name_tree::Entry> entry;
-  name_tree::Node* node = 0;
-
-  for (node = m_buckets[loc]; node != 0; node = node->m_next)
+#if defined(__GNUC__)
+  const std::vector<size_t>& hashSet = context.getHashSet();
+  for (std::vector<size_t>::const_iterator it = hashSet.begin(); it != hashSet.end(); ++it)
     {
-      entry = node->m_entry;
-      if (static_cast<bool>(entry))
+      for (size_t i = 0; i < 2; i++)
         {
-          if (hashValue == entry->getHash() && prefix == entry->getPrefix())
-            {
-              return entry;
-            }
-        } // if entry
-    } // for node
-
-  // if not found, the default value of entry (null pointer) will be returned
-  entry.reset();
-  return entry;
+          const Table& table = m_tables[i];
+          if (table.nItems == 0)
+            continue;
+
+          size_t groupMask = table.controls.size() / name_tree::GROUP_SIZE - 1;
+          size_t slot = (name_tree::getH1(*it) & groupMask) * name_tree::GROUP_SIZE;
+          __builtin_prefetch(&table.controls[slot]);
+          __builtin_prefetch(&table.slots[slot]);
+        }
+    }
+#endif // __GNUC__
 }
 
-// Longest Prefix Match
+// Exact Match
 shared_ptr<name_tree::Entry>
-NameTree::findLongestPrefixMatch(const Name& prefix, const name_tree::EntrySelector& entrySelector) const
+NameTree::findExactMatch(const Name& prefix) const
 {
-  NFD_LOG_TRACE("findLongestPrefixMatch " << prefix);
+  NFD_LOG_TRACE("findExactMatch " << prefix);
 
-  shared_ptr<name_tree::Entry> entry;
-  std::vector<size_t> hashValueSet = name_tree::computeHashSet(prefix);
+  size_t hashValue = name_tree::computeHash(prefix);
+  const name_tree::Slot* slot = findSlot(prefix, prefix.size(), hashValue);
 
-  size_t hashValue = 0;
-  size_t loc = 0;
+  NFD_LOG_TRACE("Name " << prefix << " hash value = " << hashValue);
 
-  for (int i = static_cast<int>(prefix.size()); i >= 0; i--)
+  if (slot == 0)
     {
-      hashValue = hashValueSet[i];
-      loc = hashValue % m_nBuckets;
-
-      name_tree::Node* node = 0;
-      for (node = m_buckets[loc]; node != 0; node = node->m_next)
-        {
-          entry = node->m_entry;
-          if (static_cast<bool>(entry))
-            {
-              // isPrefixOf() is used to avoid making a copy of the name
-              if (hashValue == entry->getHash() &&
-                  entry->getPrefix().isPrefixOf(prefix) &&
-                  entrySelector(*entry))
-                {
-                  return entry;
-                }
-            } // if entry
-        } // for node
+      // not found
+      return shared_ptr<name_tree::Entry>();
     }
 
-  // if not found, the default value of entry (null pointer) will be returned
-  entry.reset();
-  return entry;
-}
-
-shared_ptr<name_tree::Entry>
-NameTree::findLongestPrefixMatch(shared_ptr<name_tree::Entry> entry,
-                                 const name_tree::EntrySelector& entrySelector) const
-{
-  while (static_cast<bool>(entry))
-    {
-      if (entrySelector(*entry))
-        return entry;
-      entry = entry->getParent();
-    }
-  return shared_ptr<name_tree::Entry>();
+  return slot->entry;
 }
 
 // return {false: this entry is not empty, true: this entry is empty and erased}
@@ -343,32 +562,11 @@ NameTree::eraseEntryIfEmpty(shared_ptr<name_tree::Entry> entry)
           BOOST_ASSERT(isFound == true);
         }
 
-      // remove this Entry and its Name Tree Node
-      name_tree::Node* node = entry->m_node;
-      name_tree::Node* nodePrev = node->m_prev;
-
-      // configure the previous node
-      if (nodePrev != 0)
-        {
-          // link the previous node to the next node
-          nodePrev->m_next = node->m_next;
-        }
-      else
-        {
-          m_buckets[entry->getHash() % m_nBuckets] = node->m_next;
-        }
-
-      // link the previous node with the next node (skip the erased one)
-      if (node->m_next != 0)
-        {
-          node->m_next->m_prev = nodePrev;
-          node->m_next = 0;
-        }
-
-      BOOST_ASSERT(node->m_next == 0);
-
+      // remove this Entry from the hash table
+      eraseSlot(entry->m_table, entry->m_slot);
       m_nItems--;
-      delete node;
+
+      migrate(name_tree::MIGRATION_STEP);
 
       if (static_cast<bool>(parent))
         eraseEntryIfEmpty(parent);
@@ -393,14 +591,17 @@ NameTree::fullEnumerate(const name_tree::EntrySelector& entrySelector) const
 {
   NFD_LOG_TRACE("fullEnumerate");
 
-  // find the first eligible entry
-  for (size_t i = 0; i < m_nBuckets; i++)
+  // find the first eligible entry,
+  // in the former table if a resize is in progress, then in the current table
+  for (size_t i = 0; i < 2; i++)
     {
-      for (name_tree::Node* node = m_buckets[i]; node != 0; node = node->m_next)
+      const Table& table = m_tables[i == 0 ? 1 - m_currentTable : m_currentTable];
+      for (size_t slot = 0; slot < table.controls.size(); slot++)
         {
-          if (static_cast<bool>(node->m_entry) && entrySelector(*node->m_entry))
+          if (table.controls[slot] >= 0 && entrySelector(*table.slots[slot].entry))
             {
-              const_iterator it(FULL_ENUMERATE_TYPE, *this, node->m_entry, entrySelector);
+              const_iterator it(FULL_ENUMERATE_TYPE, *this, table.slots[slot].entry,
+                                entrySelector);
               return it;
             }
         }
@@ -447,7 +648,14 @@ NameTree::const_iterator
 NameTree::findAllMatches(const Name& prefix,
                          const name_tree::EntrySelector& entrySelector) const
 {
-  NFD_LOG_TRACE("NameTree::findAllMatches" << prefix);
+  return findAllMatches(name_tree::LookupContext(prefix), entrySelector);
+}
+
+NameTree::const_iterator
+NameTree::findAllMatches(const name_tree::LookupContext& context,
+                         const name_tree::EntrySelector& entrySelector) const
+{
+  NFD_LOG_TRACE("NameTree::findAllMatches" << context.getName());
 
   // As we are using Name Prefix Hash Table, and the current LPM() is
   // implemented as starting from full name, and reduce the number of
@@ -455,7 +663,7 @@ NameTree::findAllMatches(const Name& prefix,
   // For trie-like design, it could be more efficient by walking down the
   // trie from the root node.
 
-  shared_ptr<name_tree::Entry> entry = findLongestPrefixMatch(prefix, entrySelector);
+  shared_ptr<name_tree::Entry> entry = findLongestPrefixMatch(context, entrySelector);
 
   if (static_cast<bool>(entry))
     {
@@ -470,51 +678,18 @@ NameTree::findAllMatches(const Name& prefix,
 void
 NameTree::resize(size_t newNBuckets)
 {
-  NFD_LOG_TRACE("resize");
-
-  name_tree::Node** newBuckets = new name_tree::Node*[newNBuckets];
-  size_t count = 0;
-
-  // referenced ccnx hashtb.c hashtb_rehash()
-  name_tree::Node** pp = 0;
-  name_tree::Node* p = 0;
-  name_tree::Node* pre = 0;
-  name_tree::Node* q = 0; // record p->m_next
-  size_t i;
-  uint32_t h;
-  uint32_t b;
-
-  for (i = 0; i < newNBuckets; i++)
-    {
-      newBuckets[i] = 0;
-    }
+  NFD_LOG_TRACE("resize " << newNBuckets);
 
-  for (i = 0; i < m_nBuckets; i++)
-    {
-      for (p = m_buckets[i]; p != 0; p = q)
-        {
-          count++;
-          q = p->m_next;
-          BOOST_ASSERT(static_cast<bool>(p->m_entry));
-          h = p->m_entry->m_hash;
-          b = h % newNBuckets;
-          pre = 0;
-          for (pp = &newBuckets[b]; *pp != 0; pp = &((*pp)->m_next))
-            {
-              pre = *pp;
-              continue;
-            }
-          p->m_prev = pre;
-          p->m_next = *pp; // Actually *pp always == 0 in this case
-          *pp = p;
-        }
-    }
+  BOOST_ASSERT(newNBuckets >= name_tree::GROUP_SIZE &&
+               (newNBuckets & (newNBuckets - 1)) == 0);
 
-  BOOST_ASSERT(count == m_nItems);
+  // complete a resize that is still in progress
+  migrate(m_tables[1 - m_currentTable].controls.size());
+  BOOST_ASSERT(m_tables[1 - m_currentTable].controls.empty());
 
-  name_tree::Node** oldBuckets = m_buckets;
-  m_buckets = newBuckets;
-  delete [] oldBuckets;
+  m_currentTable = 1 - m_currentTable;
+  allocateTable(m_tables[m_currentTable], newNBuckets);
+  m_nMigrated = 0;
 
   m_nBuckets = newNBuckets;
 
@@ -522,6 +697,38 @@ NameTree::resize(size_t newNBuckets)
                                               static_cast<double>(m_nBuckets));
   m_shrinkThreshold = static_cast<size_t>(m_shrinkLoadFactor *
                                               static_cast<double>(m_nBuckets));
+
+  // release the former table right away if it holds no entry
+  migrate(0);
+}
+
+void
+NameTree::migrate(size_t nBuckets)
+{
+  size_t formerTable = 1 - m_currentTable;
+  Table& table = m_tables[formerTable];
+  if (table.controls.empty())
+    return;
+
+  size_t end = std::min(m_nMigrated + nBuckets, table.controls.size());
+  for (; m_nMigrated < end && table.nItems > 0; m_nMigrated++)
+    {
+      if (table.controls[m_nMigrated] < 0) // EMPTY or DELETED
+        continue;
+
+      name_tree::Slot& slot = table.slots[m_nMigrated];
+      shared_ptr<name_tree::Entry> entry = slot.entry;
+      size_t hashValue = slot.hash;
+      eraseSlot(formerTable, m_nMigrated);
+      insertSlot(m_currentTable, hashValue, entry);
+    }
+
+  if (table.nItems == 0)
+    {
+      NFD_LOG_TRACE("resize complete");
+      deallocateTable(table);
+      m_nMigrated = 0;
+    }
 }
 
 // For debugging
@@ -530,51 +737,57 @@ NameTree::dump(std::ostream& output) const
 {
   NFD_LOG_TRACE("dump()");
 
-  name_tree::Node* node = 0;
   shared_ptr<name_tree::Entry> entry;
 
   using std::endl;
 
   for (size_t i = 0; i < m_nBuckets; i++)
     {
-      for (node = m_buckets[i]; node != 0; node = node->m_next)
+      const Table& table = m_tables[m_currentTable];
+      entry.reset();
+      if (table.controls[i] >= 0)
+        entry = table.slots[i].entry;
+
+      // if the Entry exist, dump its information
+      if (static_cast<bool>(entry))
         {
-          entry = node->m_entry;
+          output << "Bucket" << i << "\t" << entry->m_prefix.toUri() << endl;
+          output << "\t\tHash " << entry->m_hash << endl;
 
-          // if the Entry exist, dump its information
-          if (static_cast<bool>(entry))
+          if (static_cast<bool>(entry->m_parent))
             {
-              output << "Bucket" << i << "\t" << entry->m_prefix.toUri() << endl;
-              output << "\t\tHash " << entry->m_hash << endl;
+              output << "\t\tparent->" << entry->m_parent->m_prefix.toUri();
+            }
+          else
+            {
+              output << "\t\tROOT";
+            }
+          output << endl;
 
-              if (static_cast<bool>(entry->m_parent))
-                {
-                  output << "\t\tparent->" << entry->m_parent->m_prefix.toUri();
-                }
-              else
-                {
-                  output << "\t\tROOT";
-                }
-              output << endl;
+          if (entry->m_children.size() != 0)
+            {
+              output << "\t\tchildren = " << entry->m_children.size() << endl;
 
-              if (entry->m_children.size() != 0)
+              for (size_t j = 0; j < entry->m_children.size(); j++)
                 {
-                  output << "\t\tchildren = " << entry->m_children.size() << endl;
-
-                  for (size_t j = 0; j < entry->m_children.size(); j++)
-                    {
-                      output << "\t\t\tChild " << j << " " <<
-                        entry->m_children[j]->getPrefix() << endl;
-                    }
+                  output << "\t\t\tChild " << j << " " <<
+                    entry->m_children[j]->getPrefix() << endl;
                 }
+            }
 
-            } // if (static_cast<bool>(entry))
-
-        } // for node
+        } // if (static_cast<bool>(entry))
     } // for int i
 
   output << "Bucket count = " << m_nBuckets << endl;
   output << "Stored item = " << m_nItems << endl;
+  output << "Deleted buckets = " << m_tables[m_currentTable].nDeleted << endl;
+
+  const Table& formerTable = m_tables[1 - m_currentTable];
+  if (!formerTable.controls.empty())
+    {
+      output << "Resizing from " << formerTable.controls.size() << " buckets, "
+             << formerTable.nItems << " items to migrate" << endl;
+    }
   output << "--------------------------\n";
 }
 
@@ -586,8 +799,8 @@ NameTree::const_iterator::const_iterator(NameTree::IteratorType type,
   : m_nameTree(nameTree)
   , m_entry(entry)
   , m_subTreeRoot(entry)
-  , m_entrySelector(make_shared<name_tree::EntrySelector>(entrySelector))
-  , m_entrySubTreeSelector(make_shared<name_tree::EntrySubTreeSelector>(entrySubTreeSelector))
+  , m_entrySelector(entrySelector)
+  , m_entrySubTreeSelector(entrySubTreeSelector)
   , m_type(type)
   , m_shouldVisitChildren(true)
 {
@@ -603,38 +816,32 @@ NameTree::const_iterator::operator++()
 
   if (m_type == FULL_ENUMERATE_TYPE) // fullEnumerate
     {
-      bool isFound = false;
-      // process the entries in the same bucket first
-      while (m_entry->m_node->m_next != 0)
+      // process the following buckets of this entry's table;
+      // the former table, if a resize is in progress, is followed by the current table
+      size_t tableIndex = m_entry->m_table;
+      size_t slot = m_entry->m_slot + 1;
+      while (true)
         {
-          m_entry = m_entry->m_node->m_next->m_entry;
-          if ((*m_entrySelector)(*m_entry))
+          const Table& table = m_nameTree.m_tables[tableIndex];
+          for (; slot < table.controls.size(); ++slot)
             {
-              isFound = true;
-              return *this;
-            }
-        }
-
-      // process other buckets
+              if (table.controls[slot] < 0) // EMPTY or DELETED
+                continue;
 
-      for (int newLocation = m_entry->m_hash % m_nameTree.m_nBuckets + 1;
-           newLocation < static_cast<int>(m_nameTree.m_nBuckets);
-           ++newLocation)
-        {
-          // process each bucket
-          name_tree::Node* node = m_nameTree.m_buckets[newLocation];
-          while (node != 0)
-            {
-              m_entry = node->m_entry;
-              if ((*m_entrySelector)(*m_entry))
+              m_entry = table.slots[slot].entry;
+              if (m_entrySelector(*m_entry))
                 {
-                  isFound = true;
                   return *this;
                 }
-              node = node->m_next;
             }
+
+          if (tableIndex == m_nameTree.m_currentTable)
+            break;
+
+          tableIndex = m_nameTree.m_currentTable;
+          slot = 0;
         }
-      BOOST_ASSERT(isFound == false);
+
       // Reach to the end()
       m_entry = m_nameTree.m_end;
       return *this;
@@ -654,7 +861,7 @@ NameTree::const_iterator::operator++()
           if (m_shouldVisitChildren)
             {
               m_entry = m_entry->getChildren()[0];
-              std::pair<bool, bool> result = ((*m_entrySubTreeSelector)(*m_entry));
+              std::pair<bool, bool> result = (m_entrySubTreeSelector(*m_entry));
               m_shouldVisitChildren = (result.second && m_entry->hasChildren());
               if(result.first)
                 {
@@ -682,7 +889,7 @@ NameTree::const_iterator::operator++()
             {
               // If this subtree should be visited
               m_entry = m_entry->getChildren()[0];
-              std::pair<bool, bool> result = ((*m_entrySubTreeSelector)(*m_entry));
+              std::pair<bool, bool> result = (m_entrySubTreeSelector(*m_entry));
               m_shouldVisitChildren = (result.second && m_entry->hasChildren());
               if (result.first) // if this node is acceptable
                 {
@@ -715,7 +922,7 @@ NameTree::const_iterator::operator++()
               if (i < parentChildrenList.size() - 1) // m_entry not the last child
                 {
                   m_entry = parentChildrenList[i + 1];
-                  std::pair<bool, bool> result = ((*m_entrySubTreeSelector)(*m_entry));
+                  std::pair<bool, bool> result = (m_entrySubTreeSelector(*m_entry));
                   m_shouldVisitChildren = (result.second && m_entry->hasChildren());
                   if (result.first) // if this node is acceptable
                     {
@@ -749,7 +956,7 @@ NameTree::const_iterator::operator++()
       while (static_cast<bool>(m_entry->getParent()))
         {
           m_entry = m_entry->getParent();
-          if ((*m_entrySelector)(*m_entry))
+          if (m_entrySelector(*m_entry))
             return *this;
         }
 
@@ -34,18 +34,92 @@ namespace name_tree {
 
 /**
  * \brief Compute the hash value of the given name prefix's WIRE FORMAT
+ * \details The hash of each prefix is seeded with the hash of its parent prefix,
+ * so the result depends on the order of name components.
+ * The hash value of the root prefix is 0.
  */
 size_t
 computeHash(const Name& prefix);
 
+/**
+ * \brief Compute the hash value of the prefix made of the first prefixLength components
+ * \details The result equals computeHash(name.getPrefix(prefixLength)),
+ * but the prefix is not copied. If name is shorter, the whole name is hashed.
+ */
+size_t
+computeHash(const Name& name, size_t prefixLength);
+
 /**
  * \brief Incrementally compute hash values
- * \return Return a vector of hash values, starting from the root prefix
+ * \return Return a vector of hash values, starting from the root prefix;
+ *         element i equals computeHash(prefix.getPrefix(i))
  */
 std::vector<size_t>
 computeHashSet(const Name& prefix);
 
-/// a predicate to accept or reject an Entry in find operations
+/** \brief prefix hash values of a name, computed once and reused by table lookups
+ *
+ *  A packet name is hashed once when it enters a forwarding pipeline;
+ *  PIT, FIB, Measurements and StrategyChoice lookups on that name take this
+ *  context instead of recomputing computeHashSet.
+ *  Contexts are copyable, so that a batch of packets can keep them in a vector.
+ *  \note The context refers to the name; the name must outlive the context.
+ */
+class LookupContext
+{
+public:
+  explicit
+  LookupContext(const Name& name);
+
+  const Name&
+  getName() const;
+
+  /** \return hash value of the prefix made of the first prefixLength components
+   */
+  size_t
+  getHash(size_t prefixLength) const;
+
+  /** \return hash values of all prefixes, as computed by computeHashSet
+   */
+  const std::vector<size_t>&
+  getHashSet() const;
+
+private:
+  const Name* m_name;
+  std::vector<size_t> m_hashSet;
+};
+
+inline
+LookupContext::LookupContext(const Name& name)
+  : m_name(&name)
+  , m_hashSet(computeHashSet(name))
+{
+}
+
+inline const Name&
+LookupContext::getName() const
+{
+  return *m_name;
+}
+
+inline size_t
+LookupContext::getHash(size_t prefixLength) const
+{
+  BOOST_ASSERT(prefixLength < m_hashSet.size());
+  return m_hashSet[prefixLength];
+}
+
+inline const std::vector<size_t>&
+LookupContext::getHashSet() const
+{
+  return m_hashSet;
+}
+
+/** \brief a predicate to accept or reject an Entry in find operations
+ *
+ *  Longest prefix match queries are templates that accept any predicate type;
+ *  a functor type can be inlined, while this type calls through a pointer.
+ */
 typedef function<bool (const Entry& entry)> EntrySelector;
 
 /**
@@ -57,7 +131,7 @@ typedef function<std::pair<bool,bool> (const Entry& entry)> EntrySubTreeSelector
 
 struct AnyEntry {
   bool
-  operator()(const Entry& entry)
+  operator()(const Entry& entry) const
   {
     return true;
   }
@@ -65,12 +139,23 @@ struct AnyEntry {
 
 struct AnyEntrySubTree {
   std::pair<bool, bool>
-  operator()(const Entry& entry)
+  operator()(const Entry& entry) const
   {
     return std::make_pair(true, true);
   }
 };
 
+/** \brief a slot in the Name Tree hash table
+ *
+ *  The hash value is kept next to the entry pointer, so that a probe compares
+ *  hash values without dereferencing the Entry.
+ */
+struct Slot
+{
+  size_t hash;
+  shared_ptr<Entry> entry;
+};
+
 } // namespace name_tree
 
 /**
@@ -95,8 +180,10 @@ public: // information
 
   /**
    * \brief Get the number of buckets in the Name Tree (NPHT)
-   * \details The number of buckets is the one that used to create the hash
-   * table, i.e., m_nBuckets.
+   * \details The Name Tree is an open-addressed hash table; each bucket holds
+   * at most one entry. The number of buckets is a power of two, and at least
+   * the number requested when the table was created, rounded up.
+   * While the table is being resized, this is the number of buckets of the new table.
    */
   size_t
   getNBuckets() const;
@@ -116,18 +203,35 @@ public: // mutation
    * \param prefix The querying name prefix.
    * \return The pointer to the Name Tree Entry that contains this full name
    * prefix.
-   * \note Existing iterators are unaffected.
+   * \note Existing iterators are unaffected, unless the hash table is being resized.
    */
   shared_ptr<name_tree::Entry>
   lookup(const Name& prefix);
 
+  /**
+   * \brief Look for the Name Tree Entry that contains context.getName(),
+   * using precomputed hash values.
+   * \sa lookup(const Name&)
+   */
+  shared_ptr<name_tree::Entry>
+  lookup(const name_tree::LookupContext& context);
+
+  /**
+   * \brief Prefetch the hash table control bytes of all prefixes of context.getName()
+   * \details A batch of packets issues prefetches for all names before any lookup,
+   * so that the memory accesses of different names overlap.
+   */
+  void
+  prefetch(const name_tree::LookupContext& context) const;
+
   /**
    * \brief Delete a Name Tree Entry if this entry is empty.
    * \param entry The entry to be deleted if empty.
    * \note This function must be called after a table entry is detached from Name Tree
    *       entry. The function deletes a Name Tree entry if nothing is attached to it and
    *       it has no children, then repeats the same process on its ancestors.
-   * \note Existing iterators, except those pointing to deleted entries, are unaffected.
+   * \note Existing iterators, except those pointing to deleted entries, are unaffected,
+   *       unless the hash table is being resized.
    */
   bool
   eraseEntryIfEmpty(shared_ptr<name_tree::Entry> entry);
@@ -164,14 +268,58 @@ public: // matching
    * by one each time, until an Entry is found.
    */
   shared_ptr<name_tree::Entry>
-  findLongestPrefixMatch(const Name& prefix,
-                         const name_tree::EntrySelector& entrySelector =
-                         name_tree::AnyEntry()) const;
+  findLongestPrefixMatch(const Name& prefix) const;
+
+  /**
+   * \brief Longest prefix matching for the given name, among entries that satisfy
+   * entrySelector
+   * \tparam EntrySelector a predicate taking const name_tree::Entry&;
+   * a functor type lets the predicate be inlined
+   */
+  template<typename EntrySelector>
+  shared_ptr<name_tree::Entry>
+  findLongestPrefixMatch(const Name& prefix, const EntrySelector& entrySelector) const;
 
+  /**
+   * \brief Longest prefix matching for context.getName(), using precomputed hash values
+   */
+  shared_ptr<name_tree::Entry>
+  findLongestPrefixMatch(const name_tree::LookupContext& context) const;
+
+  template<typename EntrySelector>
+  shared_ptr<name_tree::Entry>
+  findLongestPrefixMatch(const name_tree::LookupContext& context,
+                         const EntrySelector& entrySelector) const;
+
+  /**
+   * \brief Find the closest entry among entry and its ancestors
+   * that satisfies entrySelector
+   */
+  template<typename EntrySelector>
   shared_ptr<name_tree::Entry>
   findLongestPrefixMatch(shared_ptr<name_tree::Entry> entry,
-                         const name_tree::EntrySelector& entrySelector =
-                         name_tree::AnyEntry()) const;
+                         const EntrySelector& entrySelector) const;
+
+  /**
+   * \brief Longest prefix matching for context.getName(), by binary search over
+   * prefix lengths
+   * \details Every ancestor of a Name Tree entry is also in the Name Tree, so if the
+   * prefix of length k is stored, so are all shorter prefixes; ancestors serve as
+   * the markers of a binary search on prefix lengths (Waldvogel et al.).
+   * The longest stored prefix is found with O(log(depth)) hash probes; then it and
+   * its ancestors are visited through parent pointers until one satisfies
+   * entrySelector.
+   * \note This is faster than findLongestPrefixMatch(context) when the name is deeper
+   * than the stored prefixes, and slower when many stored prefixes of the name
+   * fail entrySelector.
+   */
+  template<typename EntrySelector>
+  shared_ptr<name_tree::Entry>
+  findLongestPrefixMatchByLength(const name_tree::LookupContext& context,
+                                 const EntrySelector& entrySelector) const;
+
+  shared_ptr<name_tree::Entry>
+  findLongestPrefixMatchByLength(const name_tree::LookupContext& context) const;
 
   /**
    * \brief Enumerate all the name prefixes that satisfy the prefix and entrySelector
@@ -180,6 +328,14 @@ public: // matching
   findAllMatches(const Name& prefix,
                  const name_tree::EntrySelector& entrySelector = name_tree::AnyEntry()) const;
 
+  /**
+   * \brief Enumerate all the name prefixes of context.getName() that satisfy entrySelector,
+   * using precomputed hash values
+   */
+  const_iterator
+  findAllMatches(const name_tree::LookupContext& context,
+                 const name_tree::EntrySelector& entrySelector = name_tree::AnyEntry()) const;
+
 public: // enumeration
   /**
    * \brief Enumerate all the name prefixes stored in the Name Tree.
@@ -242,23 +398,72 @@ public: // enumeration
     const NameTree&                             m_nameTree;
     shared_ptr<name_tree::Entry>                m_entry;
     shared_ptr<name_tree::Entry>                m_subTreeRoot;
-    shared_ptr<name_tree::EntrySelector>        m_entrySelector;
-    shared_ptr<name_tree::EntrySubTreeSelector> m_entrySubTreeSelector;
+    name_tree::EntrySelector                    m_entrySelector;
+    name_tree::EntrySubTreeSelector             m_entrySubTreeSelector;
     NameTree::IteratorType                      m_type;
     bool                                        m_shouldVisitChildren;
   };
 
 private:
+  /** \brief a hash table of Name Tree entries
+   *
+   *  Slots are constructed only in buckets whose control byte is neither EMPTY nor DELETED.
+   */
+  struct Table
+  {
+    // a control byte per bucket: EMPTY, DELETED, or the low 7 bits of the entry's hash
+    std::vector<int8_t> controls;
+    name_tree::Slot* slots;
+    size_t nItems;
+    size_t nDeleted;
+  };
+
   /**
-   * \brief Resize the hash table size when its load factor reaches a threshold.
-   * \details As we are currently using a hand-written hash table implementation
-   * for the Name Tree, the hash table resize() function should be kept in the
-   * name-tree.hpp file.
-   * \param newNBuckets The number of buckets for the new hash table.
+   * \brief Start resizing the hash table when its load factor reaches a threshold.
+   * \details A new table becomes the current table, and the entries of the former
+   * table are migrated a few buckets at a time by later insertions and deletions.
+   * Until the migration is complete, lookups probe both tables.
+   * Deleted buckets are not carried over, so resizing to the same size purges them.
+   * A resize that is still in progress is completed first.
+   * \param newNBuckets The number of buckets for the new hash table,
+   * a power of two.
    */
   void
   resize(size_t newNBuckets);
 
+  /**
+   * \brief Migrate entries in at most nBuckets buckets of the former table
+   * into the current table, and release the former table once it is empty.
+   */
+  void
+  migrate(size_t nBuckets);
+
+  /**
+   * \brief Find the slot of the entry for the prefix of name made of the
+   * first prefixLength components, in either table.
+   * \return The slot, or 0 if the prefix is not stored.
+   */
+  const name_tree::Slot*
+  findSlot(const Name& name, size_t prefixLength, size_t hashValue) const;
+
+  /**
+   * \brief Store an entry into a table
+   */
+  void
+  insertSlot(size_t tableIndex, size_t hashValue, const shared_ptr<name_tree::Entry>& entry);
+
+  /**
+   * \brief Remove the entry at a bucket from a table
+   */
+  void
+  eraseSlot(size_t tableIndex, size_t slot);
+
+  static void
+  allocateTable(Table& table, size_t nBuckets);
+
+  static void
+  deallocateTable(Table& table);
+
 private:
   size_t                        m_nItems;  // Number of items being stored
   size_t                        m_nBuckets; // Number of hash buckets
@@ -269,7 +474,9 @@ private:
   double                        m_shrinkLoadFactor;
   size_t                        m_shrinkThreshold;
   double                        m_shrinkFactor;
-  name_tree::Node**             m_buckets; // Name Tree Buckets in the NPHT
+  Table                         m_tables[2]; // Name Tree Buckets in the NPHT
+  size_t                        m_currentTable; // the table that receives new entries
+  size_t                        m_nMigrated; // buckets of the other table already migrated
   shared_ptr<name_tree::Entry>  m_end;
   const_iterator                m_endIterator;
 
@@ -277,12 +484,15 @@ private:
    * \brief Create a Name Tree Entry if it does not exist, or return the existing
    * Name Tree Entry address.
    * \details Called by lookup() only.
+   * \param name The name whose prefix is to be inserted.
+   * \param prefixLength The number of components of the prefix.
+   * \param hashValue The hash value of the prefix, as computed by computeHash()
    * \return The first item is the Name Tree Entry address, the second item is
    * a bool value indicates whether this is an old entry (false) or a new
    * entry (true).
    */
   std::pair<shared_ptr<name_tree::Entry>, bool>
-  insert(const Name& prefix);
+  insert(const Name& name, size_t prefixLength, size_t hashValue);
 };
 
 inline NameTree::const_iterator::~const_iterator()
@@ -325,6 +535,105 @@ NameTree::get(const strategy_choice::Entry& strategyChoiceEntry) const
   return strategyChoiceEntry.m_nameTreeEntry;
 }
 
+inline shared_ptr<name_tree::Entry>
+NameTree::findLongestPrefixMatch(const Name& prefix) const
+{
+  return findLongestPrefixMatch(name_tree::LookupContext(prefix), name_tree::AnyEntry());
+}
+
+template<typename EntrySelector>
+inline shared_ptr<name_tree::Entry>
+NameTree::findLongestPrefixMatch(const Name& prefix, const EntrySelector& entrySelector) const
+{
+  return findLongestPrefixMatch(name_tree::LookupContext(prefix), entrySelector);
+}
+
+inline shared_ptr<name_tree::Entry>
+NameTree::findLongestPrefixMatch(const name_tree::LookupContext& context) const
+{
+  return findLongestPrefixMatch(context, name_tree::AnyEntry());
+}
+
+template<typename EntrySelector>
+shared_ptr<name_tree::Entry>
+NameTree::findLongestPrefixMatch(const name_tree::LookupContext& context,
+                                 const EntrySelector& entrySelector) const
+{
+  const Name& prefix = context.getName();
+
+  for (int i = static_cast<int>(prefix.size()); i >= 0; i--)
+    {
+      const name_tree::Slot* slot = findSlot(prefix, i, context.getHash(i));
+      if (slot != 0 && entrySelector(*slot->entry))
+        {
+          return slot->entry;
+        }
+    }
+
+  // if not found, return a null pointer
+  return shared_ptr<name_tree::Entry>();
+}
+
+template<typename EntrySelector>
+shared_ptr<name_tree::Entry>
+NameTree::findLongestPrefixMatch(shared_ptr<name_tree::Entry> entry,
+                                 const EntrySelector& entrySelector) const
+{
+  while (static_cast<bool>(entry))
+    {
+      if (entrySelector(*entry))
+        return entry;
+      entry = entry->m_parent;
+    }
+  return shared_ptr<name_tree::Entry>();
+}
+
+template<typename EntrySelector>
+shared_ptr<name_tree::Entry>
+NameTree::findLongestPrefixMatchByLength(const name_tree::LookupContext& context,
+                                         const EntrySelector& entrySelector) const
+{
+  const Name& prefix = context.getName();
+
+  // the root prefix is stored unless the Name Tree is empty
+  if (m_nItems == 0)
+    return shared_ptr<name_tree::Entry>();
+
+  // invariant: the prefix of length low is stored, and no prefix longer than high is stored
+  size_t low = 0;
+  size_t high = prefix.size();
+  const name_tree::Slot* longest = 0;
+
+  while (low < high)
+    {
+      size_t middle = low + (high - low + 1) / 2;
+      const name_tree::Slot* slot = findSlot(prefix, middle, context.getHash(middle));
+      if (slot != 0)
+        {
+          longest = slot;
+          low = middle;
+        }
+      else
+        {
+          high = middle - 1;
+        }
+    }
+
+  if (longest == 0)
+    {
+      longest = findSlot(prefix, 0, context.getHash(0));
+      BOOST_ASSERT(longest != 0);
+    }
+
+  return findLongestPrefixMatch(longest->entry, entrySelector);
+}
+
+inline shared_ptr<name_tree::Entry>
+NameTree::findLongestPrefixMatchByLength(const name_tree::LookupContext& context) const
+{
+  return findLongestPrefixMatchByLength(context, name_tree::AnyEntry());
+}
+
 inline NameTree::const_iterator
 NameTree::begin() const
 {
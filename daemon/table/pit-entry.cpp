@@ -34,9 +34,16 @@ const Name Entry::LOCALHOP_NAME("ndn:/localhop");
 
 Entry::Entry(const Interest& interest)
   : m_interest(interest.shared_from_this())
+  , m_inRecordIndex(0)
+  , m_outRecordIndex(0)
 {
 }
 
+Entry::~Entry()
+{
+  this->detachFromFaceIndex();
+}
+
 const Name&
 Entry::getName() const
 {
@@ -138,8 +145,11 @@ Entry::insertOrUpdateInRecord(shared_ptr<Face> face, const Interest& interest)
   InRecordCollection::iterator it = std::find_if(m_inRecords.begin(),
     m_inRecords.end(), bind(&predicate_FaceRecord_Face, _1, face.get()));
   if (it == m_inRecords.end()) {
-    m_inRecords.push_front(InRecord(face));
-    it = m_inRecords.begin();
+    m_inRecords.push_back(InRecord(face));
+    it = m_inRecords.end() - 1;
+    if (m_inRecordIndex != 0) {
+      it->m_faceIndexPosition = m_inRecordIndex->add(*face, this);
+    }
   }
 
   it->update(interest);
@@ -153,9 +163,24 @@ Entry::getInRecord(shared_ptr<Face> face) const
                       bind(&predicate_FaceRecord_Face, _1, face.get()));
 }
 
+void
+Entry::deleteInRecord(shared_ptr<Face> face)
+{
+  InRecordCollection::iterator it = std::find_if(m_inRecords.begin(),
+    m_inRecords.end(), bind(&predicate_FaceRecord_Face, _1, face.get()));
+  if (it != m_inRecords.end()) {
+    removeFromFaceIndex(m_inRecordIndex, &Entry::m_inRecords, *it);
+    m_inRecords.erase(it);
+  }
+}
+
 void
 Entry::deleteInRecords()
 {
+  for (InRecordCollection::const_iterator it = m_inRecords.begin();
+       it != m_inRecords.end(); ++it) {
+    removeFromFaceIndex(m_inRecordIndex, &Entry::m_inRecords, *it);
+  }
   m_inRecords.clear();
 }
 
@@ -165,8 +190,11 @@ Entry::insertOrUpdateOutRecord(shared_ptr<Face> face, const Interest& interest)
   OutRecordCollection::iterator it = std::find_if(m_outRecords.begin(),
     m_outRecords.end(), bind(&predicate_FaceRecord_Face, _1, face.get()));
   if (it == m_outRecords.end()) {
-    m_outRecords.push_front(OutRecord(face));
-    it = m_outRecords.begin();
+    m_outRecords.push_back(OutRecord(face));
+    it = m_outRecords.end() - 1;
+    if (m_outRecordIndex != 0) {
+      it->m_faceIndexPosition = m_outRecordIndex->add(*face, this);
+    }
   }
 
   it->update(interest);
@@ -187,6 +215,7 @@ Entry::deleteOutRecord(shared_ptr<Face> face)
   OutRecordCollection::iterator it = std::find_if(m_outRecords.begin(),
     m_outRecords.end(), bind(&predicate_FaceRecord_Face, _1, face.get()));
   if (it != m_outRecords.end()) {
+    removeFromFaceIndex(m_outRecordIndex, &Entry::m_outRecords, *it);
     m_outRecords.erase(it);
   }
 }
@@ -205,5 +234,40 @@ Entry::hasUnexpiredOutRecords() const
   return it != m_outRecords.end();
 }
 
+template<typename Collection>
+void
+Entry::removeFromFaceIndex(FaceIndex<Entry>* index, Collection Entry::* collection,
+                           const FaceRecord& record)
+{
+  if (index == 0) {
+    return;
+  }
+
+  const Face* face = record.m_face.get();
+  Entry* moved = index->remove(*face, record.m_faceIndexPosition);
+  if (moved != 0) {
+    Collection& movedRecords = moved->*collection;
+    typename Collection::iterator it = std::find_if(movedRecords.begin(), movedRecords.end(),
+                                                    bind(&predicate_FaceRecord_Face, _1, face));
+    BOOST_ASSERT(it != movedRecords.end());
+    it->m_faceIndexPosition = record.m_faceIndexPosition;
+  }
+}
+
+void
+Entry::detachFromFaceIndex()
+{
+  for (InRecordCollection::const_iterator it = m_inRecords.begin();
+       it != m_inRecords.end(); ++it) {
+    removeFromFaceIndex(m_inRecordIndex, &Entry::m_inRecords, *it);
+  }
+  for (OutRecordCollection::const_iterator it = m_outRecords.begin();
+       it != m_outRecords.end(); ++it) {
+    removeFromFaceIndex(m_outRecordIndex, &Entry::m_outRecords, *it);
+  }
+  m_inRecordIndex = 0;
+  m_outRecordIndex = 0;
+}
+
 } // namespace pit
 } // namespace nfd
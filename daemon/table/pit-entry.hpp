@@ -29,11 +29,14 @@
 #include "pit-nonce-list.hpp"
 #include "pit-in-record.hpp"
 #include "pit-out-record.hpp"
-#include "core/scheduler.hpp"
+#include "face-index.hpp"
+#include "core/timer-wheel.hpp"
+#include "core/small-vector.hpp"
 
 namespace nfd {
 
 class NameTree;
+class Pit;
 
 namespace name_tree {
 class Entry;
@@ -42,12 +45,16 @@ class Entry;
 namespace pit {
 
 /** \brief represents an unordered collection of InRecords
+ *
+ *  Most PIT entries have one or two downstreams, whose InRecords are stored inline.
  */
-typedef std::list< InRecord>  InRecordCollection;
+typedef SmallVector<InRecord, 2> InRecordCollection;
 
 /** \brief represents an unordered collection of OutRecords
+ *
+ *  Most PIT entries have one or two upstreams, whose OutRecords are stored inline.
  */
-typedef std::list<OutRecord> OutRecordCollection;
+typedef SmallVector<OutRecord, 2> OutRecordCollection;
 
 /** \brief represents a PIT entry
  */
@@ -57,6 +64,8 @@ public:
   explicit
   Entry(const Interest& interest);
 
+  ~Entry();
+
   const Interest&
   getInterest() const;
 
@@ -110,6 +119,7 @@ public: // InRecord
    *  If InRecord for face exists, the existing one is updated.
    *  This method does not add the Nonce as a seen Nonce.
    *  \return an iterator to the InRecord
+   *  \note This invalidates iterators to other InRecords.
    */
   InRecordCollection::iterator
   insertOrUpdateInRecord(shared_ptr<Face> face, const Interest& interest);
@@ -120,6 +130,10 @@ public: // InRecord
   InRecordCollection::const_iterator
   getInRecord(shared_ptr<Face> face) const;
 
+  /// deletes one InRecord for face if exists
+  void
+  deleteInRecord(shared_ptr<Face> face);
+
   /// deletes all InRecords
   void
   deleteInRecords();
@@ -132,6 +146,7 @@ public: // OutRecord
    *
    *  If OutRecord for face exists, the existing one is updated.
    *  \return an iterator to the OutRecord
+   *  \note This invalidates iterators to other OutRecords.
    */
   OutRecordCollection::iterator
   insertOrUpdateOutRecord(shared_ptr<Face> face, const Interest& interest);
@@ -152,8 +167,21 @@ public: // OutRecord
   hasUnexpiredOutRecords() const;
 
 public:
-  EventId m_unsatisfyTimer;
-  EventId m_stragglerTimer;
+  Timer m_unsatisfyTimer;
+  Timer m_stragglerTimer;
+
+private:
+  /** \brief removes record from index, and updates the position recorded
+   *         in the entry that is moved into its place
+   */
+  template<typename Collection>
+  static void
+  removeFromFaceIndex(FaceIndex<Entry>* index, Collection Entry::* collection,
+                      const FaceRecord& record);
+
+  /// removes all records from the FaceIndexes, and stops indexing this entry
+  void
+  detachFromFaceIndex();
 
 private:
   pit::NonceList m_nonceList;
@@ -164,10 +192,15 @@ private:
   static const Name LOCALHOST_NAME;
   static const Name LOCALHOP_NAME;
 
+  /// the indexes of the Pit this entry belongs to, or 0 if this entry is not in a Pit
+  FaceIndex<Entry>* m_inRecordIndex;
+  FaceIndex<Entry>* m_outRecordIndex;
+
   shared_ptr<name_tree::Entry> m_nameTreeEntry;
 
   friend class nfd::NameTree;
   friend class nfd::name_tree::Entry;
+  friend class nfd::Pit;
 };
 
 inline const Interest&
@@ -32,6 +32,7 @@ FaceRecord::FaceRecord(shared_ptr<Face> face)
   , m_lastNonce(0)
   , m_lastRenewed(time::steady_clock::TimePoint::min())
   , m_expiry(time::steady_clock::TimePoint::min())
+  , m_faceIndexPosition(0)
 {
 }
 
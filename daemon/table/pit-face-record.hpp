@@ -67,6 +67,11 @@ private:
   uint32_t m_lastNonce;
   time::steady_clock::TimePoint m_lastRenewed;
   time::steady_clock::TimePoint m_expiry;
+
+  /// position of the PIT entry in the FaceIndex list of m_face
+  size_t m_faceIndexPosition;
+
+  friend class Entry;
 };
 
 inline shared_ptr<Face>
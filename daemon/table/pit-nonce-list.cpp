@@ -25,13 +25,15 @@
 
 #include "pit-nonce-list.hpp"
 
+#include <algorithm>
+
 namespace nfd {
 namespace pit {
 
 // The NonceList has limited capacity to avoid memory explosion
 // if PIT entry is constantly refreshed (NFD Bug #1770).
-// Current implementation keeps nonces in a set to detect duplicates,
-// and a queue to evict the oldest nonce when capacity limit is reached.
+// Current implementation keeps nonces in a ring buffer, which is scanned to detect duplicates;
+// when capacity limit is reached, the oldest nonce is overwritten.
 // A limitation is that a nonce first appeared at time 0 and duplicated at time 10
 // could be evicted before a nonce appeared only once at time 5;
 // this limitation should not affect normal operation.
@@ -39,26 +41,62 @@ namespace pit {
 const size_t NonceList::CAPACITY = 256;
 
 NonceList::NonceList()
+  : m_nonces(m_inline)
+  , m_size(0)
+  , m_capacity(INLINE_CAPACITY)
+  , m_oldest(0)
+{
+}
+
+NonceList::~NonceList()
 {
+  if (m_nonces != m_inline)
+    delete[] m_nonces;
+}
+
+bool
+NonceList::contains(uint32_t nonce) const
+{
+  // no early exit, so that the loop can be vectorized
+  bool isFound = false;
+  for (size_t i = 0; i < m_size; ++i)
+    isFound |= m_nonces[i] == nonce;
+  return isFound;
+}
+
+void
+NonceList::grow()
+{
+  BOOST_ASSERT(m_size == m_capacity);
+  size_t capacity = std::min<size_t>(m_capacity * 4, CAPACITY);
+  uint32_t* nonces = new uint32_t[capacity];
+  std::copy(m_nonces, m_nonces + m_size, nonces);
+
+  if (m_nonces != m_inline)
+    delete[] m_nonces;
+  m_nonces = nonces;
+  m_capacity = static_cast<uint16_t>(capacity);
 }
 
 bool
 NonceList::add(uint32_t nonce)
 {
-  bool isNew = m_nonceSet.insert(nonce).second;
-  if (!isNew)
+  if (this->contains(nonce))
     return false;
 
-  m_nonceQueue.push(nonce);
-  BOOST_ASSERT(m_nonceSet.size() == m_nonceQueue.size());
+  if (m_size == m_capacity && m_capacity < CAPACITY)
+    this->grow();
 
-  if (m_nonceSet.size() > CAPACITY) {
-    size_t nErased = m_nonceSet.erase(m_nonceQueue.front());
-    BOOST_ASSERT(nErased == 1);
-    m_nonceQueue.pop();
-    BOOST_ASSERT(m_nonceSet.size() == m_nonceQueue.size());
-    BOOST_ASSERT(m_nonceSet.size() <= CAPACITY);
+  if (m_size < m_capacity) {
+    // until the buffer is full, nonces are appended in arrival order
+    m_nonces[m_size++] = nonce;
+  }
+  else {
+    // overwrite the oldest nonce
+    m_nonces[m_oldest] = nonce;
+    m_oldest = static_cast<uint16_t>((m_oldest + 1) % CAPACITY);
   }
+  BOOST_ASSERT(m_size <= CAPACITY);
   return true;
 }
 
@@ -32,12 +32,19 @@ namespace nfd {
 namespace pit {
 
 /** \brief represents a Nonce list
+ *
+ *  Nonces are kept in a ring buffer in arrival order. The first INLINE_CAPACITY nonces
+ *  are stored within the NonceList; the buffer moves to the heap and grows as more
+ *  nonces arrive, up to CAPACITY. Duplicates are detected by scanning the buffer,
+ *  which is contiguous and short enough for a vectorized linear scan.
  */
 class NonceList : noncopyable
 {
 public:
   NonceList();
 
+  ~NonceList();
+
   /** \brief records a nonce
    *  \return true if nonce is new; false if nonce is seen before
    */
@@ -47,15 +54,27 @@ public:
   size_t
   size() const
   {
-    return m_nonceSet.size();
+    return m_size;
   }
 
 public:
   static const size_t CAPACITY;
 
 private:
-  std::set<uint32_t> m_nonceSet;
-  std::queue<uint32_t> m_nonceQueue;
+  bool
+  contains(uint32_t nonce) const;
+
+  void
+  grow();
+
+private:
+  static const size_t INLINE_CAPACITY = 4;
+
+  uint32_t* m_nonces;
+  uint16_t m_size;
+  uint16_t m_capacity;
+  uint16_t m_oldest; ///< position of the oldest nonce when the buffer is full
+  uint32_t m_inline[INLINE_CAPACITY];
 };
 
 } // namespace pit
@@ -25,22 +25,225 @@
 
 #include "pit.hpp"
 
+#include <boost/pool/pool.hpp>
+
+#include <limits>
+#include <new>
+
 namespace nfd {
 
+namespace pit {
+
+/** \brief allocates the entries of one Pit and their shared_ptr control blocks
+ *
+ *  After warm-up, creating and erasing a PIT entry does not call the global allocator.
+ *  The free lists are not locked: each Pit has its own, and a Pit is used
+ *  by one forwarding thread at a time.
+ */
+class EntryPool : noncopyable
+{
+public:
+  EntryPool()
+    : m_entries(sizeof(Entry))
+  {
+  }
+
+  Entry*
+  allocateEntry()
+  {
+    void* storage = m_entries.malloc();
+    if (storage == 0)
+      throw std::bad_alloc();
+    return static_cast<Entry*>(storage);
+  }
+
+  void
+  deallocateEntry(Entry* entry)
+  {
+    m_entries.free(entry);
+  }
+
+  /** \brief allocates a control block
+   *
+   *  The pool is sized by the first request; shared_ptr asks for one size only.
+   */
+  void*
+  allocateControlBlock(size_t size)
+  {
+    if (!static_cast<bool>(m_controlBlocks))
+      m_controlBlocks.reset(new boost::pool<>(size));
+
+    if (size != m_controlBlocks->get_requested_size())
+      return ::operator new(size);
+
+    void* storage = m_controlBlocks->malloc();
+    if (storage == 0)
+      throw std::bad_alloc();
+    return storage;
+  }
+
+  void
+  deallocateControlBlock(void* storage, size_t size)
+  {
+    if (size != m_controlBlocks->get_requested_size())
+      ::operator delete(storage);
+    else
+      m_controlBlocks->free(storage);
+  }
+
+private:
+  boost::pool<> m_entries;
+  scoped_ptr<boost::pool<> > m_controlBlocks;
+};
+
+/// allocates shared_ptr control blocks from an EntryPool
+template<typename T>
+class ControlBlockAllocator
+{
+public:
+  typedef T value_type;
+  typedef T* pointer;
+  typedef const T* const_pointer;
+  typedef T& reference;
+  typedef const T& const_reference;
+  typedef size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+
+  template<typename U>
+  struct rebind
+  {
+    typedef ControlBlockAllocator<U> other;
+  };
+
+  explicit
+  ControlBlockAllocator(const shared_ptr<EntryPool>& pool)
+    : m_pool(pool)
+  {
+  }
+
+  template<typename U>
+  ControlBlockAllocator(const ControlBlockAllocator<U>& other)
+    : m_pool(other.m_pool)
+  {
+  }
+
+  pointer
+  allocate(size_type n, const void* = 0)
+  {
+    return static_cast<pointer>(m_pool->allocateControlBlock(n * sizeof(T)));
+  }
+
+  void
+  deallocate(pointer p, size_type n)
+  {
+    m_pool->deallocateControlBlock(p, n * sizeof(T));
+  }
+
+  void
+  construct(pointer p, const T& value)
+  {
+    new (p) T(value);
+  }
+
+  void
+  destroy(pointer p)
+  {
+    p->~T();
+  }
+
+  size_type
+  max_size() const
+  {
+    return std::numeric_limits<size_type>::max() / sizeof(T);
+  }
+
+  bool
+  operator==(const ControlBlockAllocator& other) const
+  {
+    return m_pool == other.m_pool;
+  }
+
+  bool
+  operator!=(const ControlBlockAllocator& other) const
+  {
+    return m_pool != other.m_pool;
+  }
+
+private:
+  template<typename U>
+  friend class ControlBlockAllocator;
+
+  shared_ptr<EntryPool> m_pool;
+};
+
+/// destroys an entry and returns its storage to the EntryPool
+class EntryDeleter
+{
+public:
+  explicit
+  EntryDeleter(const shared_ptr<EntryPool>& pool)
+    : m_pool(pool)
+  {
+  }
+
+  void
+  operator()(Entry* entry) const
+  {
+    entry->~Entry();
+    m_pool->deallocateEntry(entry);
+  }
+
+private:
+  shared_ptr<EntryPool> m_pool;
+};
+
+} // namespace pit
+
 Pit::Pit(NameTree& nameTree)
   : m_nameTree(nameTree)
   , m_nItems(0)
+  , m_entryPool(make_shared<pit::EntryPool>())
 {
 }
 
-Pit::~Pit()
+static shared_ptr<pit::Entry>
+makePitEntry(const shared_ptr<pit::EntryPool>& pool, const Interest& interest)
 {
+  pit::Entry* storage = pool->allocateEntry();
+  pit::Entry* entry = 0;
+  try
+    {
+      entry = new (storage) pit::Entry(interest);
+    }
+  catch (...)
+    {
+      pool->deallocateEntry(storage);
+      throw;
+    }
+  return shared_ptr<pit::Entry>(entry, pit::EntryDeleter(pool),
+                                pit::ControlBlockAllocator<pit::Entry>(pool));
 }
 
-static inline bool
-predicate_NameTreeEntry_hasPitEntry(const name_tree::Entry& entry)
+/// selects NameTree entries that have a PIT entry
+struct predicate_NameTreeEntry_hasPitEntry
 {
-  return entry.hasPitEntries();
+  bool
+  operator()(const name_tree::Entry& entry) const
+  {
+    return entry.hasPitEntries();
+  }
+};
+
+Pit::~Pit()
+{
+  // entries may outlive the PIT
+  for (NameTree::const_iterator it = m_nameTree.fullEnumerate(
+       predicate_NameTreeEntry_hasPitEntry()); it != m_nameTree.end(); ++it) {
+    const std::vector<shared_ptr<pit::Entry> >& pitEntries = it->getPitEntries();
+    for (size_t i = 0; i < pitEntries.size(); ++i) {
+      pitEntries[i]->detachFromFaceIndex();
+    }
+  }
 }
 
 static inline bool
@@ -69,13 +272,21 @@ predicate_PitEntry_similar_Interest(const shared_ptr<pit::Entry>& entry,
 std::pair<shared_ptr<pit::Entry>, bool>
 Pit::insert(const Interest& interest)
 {
+  return insert(interest, name_tree::LookupContext(interest.getName()));
+}
+
+std::pair<shared_ptr<pit::Entry>, bool>
+Pit::insert(const Interest& interest, const name_tree::LookupContext& context)
+{
+  BOOST_ASSERT(context.getName() == interest.getName());
+
   // - first lookup() the Interest Name in the NameTree, which will creates all
   // the intermedia nodes, starting from the shortest prefix.
   // - if it is guaranteed that this Interest already has a NameTree Entry, we
   // could use findExactMatch() instead.
   // - Alternatively, we could try to do findExactMatch() first, if not found,
   // then do lookup().
-  shared_ptr<name_tree::Entry> nameTreeEntry = m_nameTree.lookup(interest.getName());
+  shared_ptr<name_tree::Entry> nameTreeEntry = m_nameTree.lookup(context);
   BOOST_ASSERT(static_cast<bool>(nameTreeEntry));
 
   const std::vector<shared_ptr<pit::Entry> >& pitEntries = nameTreeEntry->getPitEntries();
@@ -91,7 +302,9 @@ Pit::insert(const Interest& interest)
     }
   else
     {
-      shared_ptr<pit::Entry> entry = make_shared<pit::Entry>(interest);
+      shared_ptr<pit::Entry> entry = makePitEntry(m_entryPool, interest);
+      entry->m_inRecordIndex = &m_inRecordIndex;
+      entry->m_outRecordIndex = &m_outRecordIndex;
       nameTreeEntry->insertPitEntry(entry);
 
       // Increase m_nItmes only if we create a new PIT Entry
@@ -104,13 +317,24 @@ Pit::insert(const Interest& interest)
 shared_ptr<pit::DataMatchResult>
 Pit::findAllDataMatches(const Data& data) const
 {
+  return findAllDataMatches(data, name_tree::LookupContext(data.getName()));
+}
+
+shared_ptr<pit::DataMatchResult>
+Pit::findAllDataMatches(const Data& data, const name_tree::LookupContext& context) const
+{
+  BOOST_ASSERT(context.getName() == data.getName());
+
   shared_ptr<pit::DataMatchResult> result = make_shared<pit::DataMatchResult>();
 
-  for (NameTree::const_iterator it =
-       m_nameTree.findAllMatches(data.getName(), &predicate_NameTreeEntry_hasPitEntry);
-       it != m_nameTree.end(); it++)
+  // same as iterating over findAllMatches, with the predicate inlined
+  for (shared_ptr<name_tree::Entry> nameTreeEntry =
+         m_nameTree.findLongestPrefixMatch(context, predicate_NameTreeEntry_hasPitEntry());
+       static_cast<bool>(nameTreeEntry);
+       nameTreeEntry = m_nameTree.findLongestPrefixMatch(nameTreeEntry->getParent(),
+                                                         predicate_NameTreeEntry_hasPitEntry()))
     {
-      const std::vector<shared_ptr<pit::Entry> >& pitEntries = it->getPitEntries();
+      const std::vector<shared_ptr<pit::Entry> >& pitEntries = nameTreeEntry->getPitEntries();
       for (size_t i = 0; i < pitEntries.size(); i++)
         {
           if (pitEntries[i]->getInterest().matchesData(data))
@@ -127,10 +351,29 @@ Pit::erase(shared_ptr<pit::Entry> pitEntry)
   shared_ptr<name_tree::Entry> nameTreeEntry = m_nameTree.get(*pitEntry);
   BOOST_ASSERT(static_cast<bool>(nameTreeEntry));
 
+  pitEntry->detachFromFaceIndex();
   nameTreeEntry->erasePitEntry(pitEntry);
   m_nameTree.eraseEntryIfEmpty(nameTreeEntry);
 
   --m_nItems;
 }
 
+void
+Pit::deleteInOutRecords(shared_ptr<Face> face)
+{
+  // each list is taken out of its index, so that deleting records does not modify it
+  FaceIndex<pit::Entry>::EntryList entries;
+  m_inRecordIndex.take(*face, entries);
+  for (FaceIndex<pit::Entry>::EntryList::iterator it = entries.begin();
+       it != entries.end(); ++it) {
+    (*it)->deleteInRecord(face);
+  }
+
+  m_outRecordIndex.take(*face, entries);
+  for (FaceIndex<pit::Entry>::EntryList::iterator it = entries.begin();
+       it != entries.end(); ++it) {
+    (*it)->deleteOutRecord(face);
+  }
+}
+
 } // namespace nfd
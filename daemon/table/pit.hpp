@@ -39,6 +39,8 @@ namespace pit {
  */
 typedef std::vector<shared_ptr<pit::Entry> > DataMatchResult;
 
+class EntryPool;
+
 } // namespace pit
 
 /** \class Pit
@@ -65,21 +67,49 @@ public:
   std::pair<shared_ptr<pit::Entry>, bool>
   insert(const Interest& interest);
 
+  /** \brief inserts a PIT entry for prefix, using precomputed hash values
+   *  \param context lookup context of interest.getName()
+   */
+  std::pair<shared_ptr<pit::Entry>, bool>
+  insert(const Interest& interest, const name_tree::LookupContext& context);
+
   /** \brief performs a Data match
    *  \return{ an iterable of all PIT entries matching data }
    */
   shared_ptr<pit::DataMatchResult>
   findAllDataMatches(const Data& data) const;
 
+  /** \brief performs a Data match, using precomputed hash values
+   *  \param context lookup context of data.getName()
+   */
+  shared_ptr<pit::DataMatchResult>
+  findAllDataMatches(const Data& data, const name_tree::LookupContext& context) const;
+
   /**
    *  \brief Erase a PIT Entry
    */
   void
   erase(shared_ptr<pit::Entry> pitEntry);
 
+  /** \brief deletes the InRecord and OutRecord of face in all entries
+   *  This is usually invoked when face goes away.
+   *  Only the entries that have a record for face are visited.
+   *  Entries are not erased; they expire as usual.
+   */
+  void
+  deleteInOutRecords(shared_ptr<Face> face);
+
 private:
   NameTree& m_nameTree;
   size_t m_nItems;
+
+  /// free lists of this PIT's entries; entries keep it alive
+  shared_ptr<pit::EntryPool> m_entryPool;
+
+  /// PIT entries by downstream face
+  FaceIndex<pit::Entry> m_inRecordIndex;
+  /// PIT entries by upstream face
+  FaceIndex<pit::Entry> m_outRecordIndex;
 };
 
 inline size_t
@@ -140,17 +140,27 @@ StrategyChoice::get(const Name& prefix) const
   return entry->getStrategy().getName().shared_from_this();
 }
 
-static inline bool
-predicate_NameTreeEntry_hasStrategyChoiceEntry(const name_tree::Entry& entry)
+/// selects NameTree entries that have a StrategyChoice entry
+struct predicate_NameTreeEntry_hasStrategyChoiceEntry
 {
-  return static_cast<bool>(entry.getStrategyChoiceEntry());
-}
+  bool
+  operator()(const name_tree::Entry& entry) const
+  {
+    return static_cast<bool>(entry.getStrategyChoiceEntry());
+  }
+};
 
 Strategy&
 StrategyChoice::findEffectiveStrategy(const Name& prefix) const
+{
+  return findEffectiveStrategy(name_tree::LookupContext(prefix));
+}
+
+Strategy&
+StrategyChoice::findEffectiveStrategy(const name_tree::LookupContext& context) const
 {
   shared_ptr<name_tree::Entry> nameTreeEntry =
-    m_nameTree.findLongestPrefixMatch(prefix, &predicate_NameTreeEntry_hasStrategyChoiceEntry);
+    m_nameTree.findLongestPrefixMatch(context, predicate_NameTreeEntry_hasStrategyChoiceEntry());
   BOOST_ASSERT(static_cast<bool>(nameTreeEntry));
   return nameTreeEntry->getStrategyChoiceEntry()->getStrategy();
 }
@@ -162,7 +172,7 @@ StrategyChoice::findEffectiveStrategy(shared_ptr<name_tree::Entry> nameTreeEntry
   if (static_cast<bool>(entry))
     return entry->getStrategy();
   nameTreeEntry = m_nameTree.findLongestPrefixMatch(nameTreeEntry,
-                               &predicate_NameTreeEntry_hasStrategyChoiceEntry);
+                               predicate_NameTreeEntry_hasStrategyChoiceEntry());
   BOOST_ASSERT(static_cast<bool>(nameTreeEntry));
   return nameTreeEntry->getStrategyChoiceEntry()->getStrategy();
 }
@@ -276,7 +286,7 @@ StrategyChoice::changeStrategy(shared_ptr<strategy_choice::Entry> entry,
 StrategyChoice::const_iterator
 StrategyChoice::begin() const
 {
-  return const_iterator(m_nameTree.fullEnumerate(&predicate_NameTreeEntry_hasStrategyChoiceEntry));
+  return const_iterator(m_nameTree.fullEnumerate(predicate_NameTreeEntry_hasStrategyChoiceEntry()));
 }
 
 } // namespace nfd
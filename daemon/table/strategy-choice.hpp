@@ -74,6 +74,10 @@ public: // effective strategy
   fw::Strategy&
   findEffectiveStrategy(const Name& prefix) const;
 
+  /// get effective strategy for context.getName(), using precomputed hash values
+  fw::Strategy&
+  findEffectiveStrategy(const name_tree::LookupContext& context) const;
+
   /// get effective strategy for pitEntry
   fw::Strategy&
   findEffectiveStrategy(const pit::Entry& pitEntry) const;
@@ -0,0 +1,73 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "core/buffer-pool.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nfd {
+namespace tests {
+
+BOOST_FIXTURE_TEST_SUITE(CoreBufferPool, BaseFixture)
+
+BOOST_AUTO_TEST_CASE(Reuse)
+{
+  BufferPool pool(100, 1);
+  BOOST_CHECK_EQUAL(pool.getBufferSize(), 100);
+  BOOST_CHECK_EQUAL(pool.getNIdle(), 0);
+
+  shared_ptr<ndn::Buffer> b1 = pool.allocate();
+  shared_ptr<ndn::Buffer> b2 = pool.allocate();
+  BOOST_CHECK_EQUAL(b1->size(), 100);
+  BOOST_CHECK_EQUAL(b2->size(), 100);
+  BOOST_CHECK(b1 != b2);
+
+  ndn::Buffer* p1 = b1.get();
+  b1.reset();
+  BOOST_CHECK_EQUAL(pool.getNIdle(), 1);
+  b2.reset(); // exceeds maxIdle
+  BOOST_CHECK_EQUAL(pool.getNIdle(), 1);
+
+  shared_ptr<ndn::Buffer> b3 = pool.allocate();
+  BOOST_CHECK(b3.get() == p1);
+  BOOST_CHECK_EQUAL(pool.getNIdle(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(ReleaseAfterPool)
+{
+  shared_ptr<ndn::Buffer> b1;
+  {
+    BufferPool pool(100, 4);
+    b1 = pool.allocate();
+    shared_ptr<ndn::Buffer> b2 = pool.allocate();
+  }
+  BOOST_CHECK_EQUAL(b1->size(), 100);
+  b1.reset(); // deleted, not returned to the destroyed pool
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace nfd
@@ -23,9 +23,12 @@
  **/
 
 #include "core/scheduler.hpp"
+#include "core/global-io.hpp"
 
 #include "tests/test-common.hpp"
 
+#include <boost/thread/thread.hpp>
+
 namespace nfd {
 namespace tests {
 
@@ -111,6 +114,36 @@ BOOST_FIXTURE_TEST_CASE(SelfCancel, SelfCancelFixture)
   BOOST_REQUIRE_NO_THROW(g_io.run());
 }
 
+static void
+incrementCount(int* count)
+{
+  ++*count;
+}
+
+static void
+runThreadScheduler(boost::asio::io_service* ioService, bool* isThreadIoService, int* count)
+{
+  setThreadIoService(ioService);
+  *isThreadIoService = &getGlobalIoService() == ioService;
+  scheduler::schedule(time::milliseconds(10), bind(&incrementCount, count));
+  ioService->run();
+  setThreadIoService(0);
+}
+
+BOOST_AUTO_TEST_CASE(ThreadIoService)
+{
+  boost::asio::io_service threadIoService;
+  bool isThreadIoService = false;
+  int count = 0;
+
+  boost::thread thread(bind(&runThreadScheduler, &threadIoService, &isThreadIoService, &count));
+  thread.join();
+
+  BOOST_CHECK(isThreadIoService);
+  BOOST_CHECK_EQUAL(count, 1);
+  BOOST_CHECK(&getGlobalIoService() == &g_io);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
@@ -0,0 +1,94 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "core/small-vector.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nfd {
+namespace tests {
+
+BOOST_FIXTURE_TEST_SUITE(CoreSmallVector, BaseFixture)
+
+BOOST_AUTO_TEST_CASE(PushBackErase)
+{
+  SmallVector<std::string, 2> v;
+  BOOST_CHECK(v.empty());
+  BOOST_CHECK(v.begin() == v.end());
+
+  v.push_back("a");
+  v.push_back("b");
+  BOOST_CHECK_EQUAL(v.size(), 2);
+  BOOST_CHECK_EQUAL(v.isOnHeap(), false);
+
+  v.push_back(v.front()); // argument refers to an element that is moved to heap storage
+  BOOST_CHECK_EQUAL(v.isOnHeap(), true);
+  const char* expected1[] = { "a", "b", "a" };
+  BOOST_CHECK_EQUAL_COLLECTIONS(v.begin(), v.end(), expected1, expected1 + 3);
+
+  SmallVector<std::string, 2>::iterator it = v.erase(v.begin());
+  BOOST_CHECK_EQUAL(*it, "b");
+  const char* expected2[] = { "b", "a" };
+  BOOST_CHECK_EQUAL_COLLECTIONS(v.begin(), v.end(), expected2, expected2 + 2);
+
+  v.clear();
+  BOOST_CHECK(v.empty());
+}
+
+BOOST_AUTO_TEST_CASE(Copy)
+{
+  SmallVector<int, 2> v;
+  v.push_back(1);
+
+  SmallVector<int, 2> w(v);
+  BOOST_CHECK_EQUAL_COLLECTIONS(w.begin(), w.end(), v.begin(), v.end());
+
+  w.push_back(2);
+  w.push_back(3);
+  v = w;
+  BOOST_CHECK_EQUAL(v.isOnHeap(), true);
+  BOOST_CHECK_EQUAL_COLLECTIONS(v.begin(), v.end(), w.begin(), w.end());
+}
+
+BOOST_AUTO_TEST_CASE(Destruction)
+{
+  shared_ptr<int> counted = make_shared<int>(0);
+  {
+    SmallVector<shared_ptr<int>, 1> v;
+    v.push_back(counted);
+    v.push_back(counted);
+    v.push_back(counted);
+    BOOST_CHECK_EQUAL(counted.use_count(), 4);
+
+    v.erase(v.begin());
+    BOOST_CHECK_EQUAL(counted.use_count(), 3);
+  }
+  BOOST_CHECK_EQUAL(counted.use_count(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace nfd
@@ -0,0 +1,135 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "core/timer-wheel.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nfd {
+namespace tests {
+
+class TimerWheelFixture : protected BaseFixture
+{
+public:
+  void
+  record(int id)
+  {
+    fired.push_back(id);
+    firedAt.push_back(time::steady_clock::now());
+  }
+
+  std::vector<int> fired;
+  std::vector<time::steady_clock::TimePoint> firedAt;
+};
+
+BOOST_FIXTURE_TEST_SUITE(CoreTimerWheel, TimerWheelFixture)
+
+BOOST_AUTO_TEST_CASE(ScheduleCancel)
+{
+  TimerWheel wheel(time::milliseconds(1));
+  Timer timer1, timer2, timer3, timer4;
+
+  time::steady_clock::TimePoint start = time::steady_clock::now();
+  wheel.schedule(timer1, time::milliseconds(150), bind(&TimerWheelFixture::record, this, 1));
+  wheel.schedule(timer2, time::milliseconds(50), bind(&TimerWheelFixture::record, this, 2));
+  wheel.schedule(timer3, time::milliseconds(100), bind(&TimerWheelFixture::record, this, 3));
+  wheel.schedule(timer4, time::milliseconds(10), bind(&TimerWheelFixture::record, this, 4));
+  BOOST_CHECK_EQUAL(wheel.size(), 4);
+
+  timer3.cancel();
+  BOOST_CHECK_EQUAL(timer3.isScheduled(), false);
+  BOOST_CHECK_EQUAL(wheel.size(), 3);
+
+  // rescheduling replaces the previous expiry
+  wheel.schedule(timer4, time::milliseconds(200), bind(&TimerWheelFixture::record, this, 4));
+  BOOST_CHECK_EQUAL(wheel.size(), 3);
+
+  g_io.run();
+
+  BOOST_CHECK_EQUAL(wheel.size(), 0);
+  int expected[] = { 2, 1, 4 };
+  BOOST_CHECK_EQUAL_COLLECTIONS(fired.begin(), fired.end(), expected, expected + 3);
+  BOOST_REQUIRE_EQUAL(firedAt.size(), 3);
+  BOOST_CHECK_GE(firedAt[0] - start, time::milliseconds(50));
+  BOOST_CHECK_GE(firedAt[1] - start, time::milliseconds(150));
+  BOOST_CHECK_GE(firedAt[2] - start, time::milliseconds(200));
+}
+
+BOOST_AUTO_TEST_CASE(Cascade)
+{
+  // with 10us ticks, these timers are placed beyond the first level
+  TimerWheel wheel(time::microseconds(10));
+  Timer timer1, timer2;
+
+  time::steady_clock::TimePoint start = time::steady_clock::now();
+  wheel.schedule(timer1, time::milliseconds(120), bind(&TimerWheelFixture::record, this, 1));
+  wheel.schedule(timer2, time::milliseconds(30), bind(&TimerWheelFixture::record, this, 2));
+
+  g_io.run();
+
+  int expected[] = { 2, 1 };
+  BOOST_CHECK_EQUAL_COLLECTIONS(fired.begin(), fired.end(), expected, expected + 2);
+  BOOST_REQUIRE_EQUAL(firedAt.size(), 2);
+  BOOST_CHECK_GE(firedAt[0] - start, time::milliseconds(30));
+  BOOST_CHECK_GE(firedAt[1] - start, time::milliseconds(120));
+}
+
+BOOST_AUTO_TEST_CASE(DestructScheduledTimer)
+{
+  TimerWheel wheel;
+  {
+    Timer timer;
+    wheel.schedule(timer, time::milliseconds(10), bind(&TimerWheelFixture::record, this, 1));
+  }
+  BOOST_CHECK_EQUAL(wheel.size(), 0);
+
+  g_io.run();
+  BOOST_CHECK(fired.empty());
+}
+
+static void
+holdPointer(shared_ptr<int>)
+{
+}
+
+BOOST_AUTO_TEST_CASE(DestructWheel)
+{
+  shared_ptr<int> held = make_shared<int>(0);
+  Timer timer;
+  {
+    TimerWheel wheel;
+    wheel.schedule(timer, time::seconds(10), bind(&holdPointer, held));
+    BOOST_CHECK_EQUAL(held.use_count(), 2);
+  }
+  BOOST_CHECK_EQUAL(timer.isScheduled(), false);
+  BOOST_CHECK_EQUAL(held.use_count(), 1);
+
+  BOOST_CHECK_NO_THROW(g_io.run());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace nfd
@@ -78,6 +78,37 @@ public:
     this->onReceiveData(data);
   }
 
+  /// receive Interests as one batch, like packets decoded from one read
+  void
+  receiveInterestBatch(const InterestBatch& interests)
+  {
+    this->beginReceiveBatch();
+    for (InterestBatch::const_iterator it = interests.begin(); it != interests.end(); ++it)
+      this->onReceiveInterest(**it);
+    this->endReceiveBatch();
+  }
+
+  /// receive Data as one batch, like packets decoded from one read
+  void
+  receiveDataBatch(const DataBatch& datas)
+  {
+    this->beginReceiveBatch();
+    for (DataBatch::const_iterator it = datas.begin(); it != datas.end(); ++it)
+      this->onReceiveData(**it);
+    this->endReceiveBatch();
+  }
+
+  /// receive Interests in a batch, and fail before the batch ends, like a decoding error
+  void
+  receiveInterestBatchAndFail(const InterestBatch& interests)
+  {
+    this->beginReceiveBatch();
+    for (InterestBatch::const_iterator it = interests.begin(); it != interests.end(); ++it)
+      this->onReceiveInterest(**it);
+    this->fail("decoding error");
+    this->endReceiveBatch();
+  }
+
   EventEmitter<> afterSend;
 
 public:
@@ -136,6 +136,15 @@ BOOST_FIXTURE_TEST_CASE(SendPacket, InterfacesFixture)
   BOOST_CHECK_NO_THROW(face->sendData    (*data1    ));
   BOOST_CHECK_NO_THROW(face->sendInterest(*interest2));
   BOOST_CHECK_NO_THROW(face->sendData    (*data2    ));
+  BOOST_CHECK_EQUAL(face->getFragmentationCounters().getNOutFragments(), 0);
+
+  // packets larger than the MTU are sent in NDNLP fragments
+  shared_ptr<Data> data3 = makeData("ndn:/Lz8gGk3pUe");
+  std::vector<uint8_t> content(4000, 0xdd);
+  data3->setContent(&content.front(), content.size());
+  signData(data3);
+  BOOST_CHECK_NO_THROW(face->sendData    (*data3    ));
+  BOOST_CHECK_GT(face->getFragmentationCounters().getNOutFragments(), 2);
 
 //  m_ioRemaining = 4;
 //  m_ioService.run();
@@ -152,6 +161,47 @@ BOOST_FIXTURE_TEST_CASE(SendPacket, InterfacesFixture)
 //  BOOST_CHECK_EQUAL(m_face2_receivedDatas    [0].getName(), data1.getName());
 }
 
+BOOST_FIXTURE_TEST_CASE(SendPacketMmap, InterfacesFixture)
+{
+  if (!EthernetFace::isPacketMmapSupported())
+    {
+      BOOST_WARN_MESSAGE(false, "PACKET_MMAP is not available, cannot perform SendPacketMmap test");
+      return;
+    }
+
+  if (m_interfaces.empty())
+    {
+      BOOST_WARN_MESSAGE(false, "No interfaces available, cannot perform SendPacketMmap test");
+      return;
+    }
+
+  EthernetFactory factory;
+  shared_ptr<EthernetFace> pcapFace = factory.createMulticastFace(m_interfaces.front(),
+                                        ethernet::getDefaultMulticastAddress());
+  BOOST_CHECK_EQUAL(pcapFace->getBackend(), EthernetFace::BACKEND_PCAP);
+
+  factory.setBackend(EthernetFace::BACKEND_PACKET_MMAP);
+  shared_ptr<EthernetFace> face = factory.createMulticastFace(m_interfaces.front(),
+                                    ethernet::getDefaultMulticastAddress());
+  BOOST_REQUIRE(static_cast<bool>(face));
+  BOOST_CHECK_NE(face, pcapFace);
+  BOOST_CHECK_EQUAL(face->getBackend(), EthernetFace::BACKEND_PACKET_MMAP);
+  BOOST_CHECK_EQUAL(factory.getMulticastFaces().size(), 1);
+
+  shared_ptr<Interest> interest1 = makeInterest("ndn:/fnwE5bXk9");
+  shared_ptr<Data>     data1     = makeData("ndn:/vWxHq0tUz");
+
+  BOOST_CHECK_NO_THROW(face->sendInterest(*interest1));
+  BOOST_CHECK_NO_THROW(face->sendData    (*data1    ));
+
+  // frames are flushed from the transmit ring by a posted handler
+  g_io.poll();
+  g_io.reset();
+
+  BOOST_CHECK_EQUAL(face->getCounters().getNOutBytes(),
+                    interest1->wireEncode().size() + data1->wireEncode().size());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
@@ -96,6 +96,44 @@ BOOST_AUTO_TEST_CASE(FailTwice)
   BOOST_CHECK_EQUAL(face.failCount, 1);
 }
 
+class ParseReceivedElementTestFace : public DummyFace
+{
+public:
+  using DummyFace::parseReceivedElement;
+};
+
+BOOST_AUTO_TEST_CASE(ParseReceivedElement)
+{
+  shared_ptr<Interest> interest = makeInterest("ndn:/hFn9d1Wfx");
+  shared_ptr<Data> data = makeData("ndn:/hFn9d1Wfx");
+  const Block& interestWire = interest->wireEncode();
+  const Block& dataWire = data->wireEncode();
+
+  shared_ptr<ndn::Buffer> buffer = Face::getReceiveBufferPool().allocate();
+  std::copy(interestWire.begin(), interestWire.end(), buffer->begin());
+  std::copy(dataWire.begin(), dataWire.end(), buffer->begin() + interestWire.size());
+  size_t size = interestWire.size() + dataWire.size();
+
+  // Interest references the receive buffer
+  Block element;
+  BOOST_REQUIRE(ParseReceivedElementTestFace::parseReceivedElement(buffer, 0, size, element));
+  BOOST_CHECK_EQUAL(element.type(), tlv::Interest);
+  BOOST_CHECK_EQUAL(element.size(), interestWire.size());
+  BOOST_CHECK(element.wire() == &buffer->front());
+
+  // small Data is copied
+  BOOST_REQUIRE(ParseReceivedElementTestFace::parseReceivedElement(buffer, element.size(), size,
+                                                                    element));
+  BOOST_CHECK_EQUAL(element.type(), tlv::Data);
+  BOOST_CHECK_EQUAL_COLLECTIONS(element.begin(), element.end(), dataWire.begin(), dataWire.end());
+  BOOST_CHECK(element.wire() != &buffer->front() + interestWire.size());
+
+  // incomplete element
+  BOOST_CHECK(!ParseReceivedElementTestFace::parseReceivedElement(buffer, 0,
+                                                                  interestWire.size() - 1,
+                                                                  element));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
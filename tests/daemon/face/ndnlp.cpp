@@ -27,6 +27,7 @@
 #include "face/ndnlp-partial-message-store.hpp"
 
 #include "tests/test-common.hpp"
+#include "tests/limited-io.hpp"
 
 #include <boost/scoped_array.hpp>
 
@@ -162,6 +163,12 @@ protected:
            &m_received, _1);
   }
 
+  static void
+  increment(size_t* counter)
+  {
+    ++*counter;
+  }
+
   Block
   makeBlock(size_t valueLength)
   {
@@ -170,6 +177,16 @@ protected:
     return ndn::dataBlock(0x01, blockValue.get(), valueLength);
   }
 
+  /// concatenate header and payload of a fragment made by sliceInPlace
+  static Block
+  makeFragmentBlock(const ndnlp::Fragment& fragment)
+  {
+    ndn::BufferPtr buffer = make_shared<ndn::Buffer>(fragment.headerSize + fragment.payloadSize);
+    memcpy(buffer->get(), fragment.header, fragment.headerSize);
+    memcpy(buffer->get() + fragment.headerSize, fragment.payload, fragment.payloadSize);
+    return Block(buffer);
+  }
+
 protected:
   ndnlp::Slicer m_slicer;
   ndnlp::PartialMessageStore m_partialMessageStore;
@@ -226,6 +243,180 @@ BOOST_FIXTURE_TEST_CASE(Reassemble4and2, ReassembleFixture)
                                 block2.begin(),           block2.end());
 }
 
+// drop a partially received packet after idleDuration without fragments
+BOOST_FIXTURE_TEST_CASE(ReassemblyTimeout, ReassembleFixture)
+{
+  ndnlp::PartialMessageStore store(time::milliseconds(100));
+  store.onReceive +=
+    bind(static_cast<void (std::vector<Block>::*)(const Block&)>(&std::vector<Block>::push_back),
+         &m_received, _1);
+  size_t nTimeouts = 0;
+  store.onReassemblyTimeout += bind(&ReassembleFixture::increment, &nTimeouts);
+
+  Block block = makeBlock(5050);
+  ndnlp::PacketArray pa = m_slicer.slice(block);
+  BOOST_REQUIRE_EQUAL(pa->size(), 4);
+
+  store.receiveNdnlpData(pa->at(0));
+  store.receiveNdnlpData(pa->at(1));
+
+  LimitedIo limitedIo;
+  BOOST_CHECK_EQUAL(limitedIo.run(LimitedIo::UNLIMITED_OPS, time::milliseconds(300)),
+                    LimitedIo::EXCEED_TIME);
+  BOOST_CHECK_EQUAL(nTimeouts, 1);
+
+  // the remaining fragments alone cannot complete the packet
+  store.receiveNdnlpData(pa->at(2));
+  store.receiveNdnlpData(pa->at(3));
+  BOOST_CHECK_EQUAL(m_received.size(), 0);
+}
+
+// slice without copying payloads, and reassemble the result
+BOOST_FIXTURE_TEST_CASE(SliceInPlace, ReassembleFixture)
+{
+  Block block = makeBlock(5050);
+  ndnlp::PacketArray pa = m_slicer.slice(block);
+  std::vector<ndnlp::Fragment> fragments = m_slicer.sliceInPlace(block);
+  BOOST_REQUIRE_EQUAL(fragments.size(), pa->size());
+
+  for (size_t i = 0; i < fragments.size(); ++i) {
+    BOOST_CHECK(fragments[i].payload >= block.wire() &&
+                fragments[i].payload < block.wire() + block.size());
+    Block pkt = makeFragmentBlock(fragments[i]);
+    BOOST_CHECK_LE(pkt.size(), 1500);
+
+    // same encoding as slice, except for sequence numbers
+    ndnlp::NdnlpData expected;
+    expected.wireDecode(pa->at(i));
+    ndnlp::NdnlpData actual;
+    actual.wireDecode(pkt);
+    BOOST_CHECK_EQUAL(actual.m_fragIndex, expected.m_fragIndex);
+    BOOST_CHECK_EQUAL(actual.m_fragCount, expected.m_fragCount);
+    BOOST_CHECK_EQUAL_COLLECTIONS(actual.m_payload.begin(),   actual.m_payload.end(),
+                                  expected.m_payload.begin(), expected.m_payload.end());
+
+    ndnlp::NdnlpDataHeader header;
+    header.wireDecode(pkt);
+    BOOST_CHECK_EQUAL(header.m_seq, actual.m_seq);
+    BOOST_CHECK_EQUAL(header.m_fragIndex, actual.m_fragIndex);
+    BOOST_CHECK_EQUAL(header.m_payloadOffset, pkt.size() - fragments[i].payloadSize);
+    BOOST_CHECK_EQUAL(header.m_payloadSize, fragments[i].payloadSize);
+
+    m_partialMessageStore.receiveNdnlpData(pkt);
+  }
+
+  BOOST_REQUIRE_EQUAL(m_received.size(), 1);
+  BOOST_CHECK_EQUAL_COLLECTIONS(m_received.at(0).begin(), m_received.at(0).end(),
+                                block.begin(),            block.end());
+  BOOST_CHECK_EQUAL(m_partialMessageStore.size(), 0);
+
+  // a packet that fits in one fragment has no NdnlpFragIndex and NdnlpFragCount
+  Block small = makeBlock(60);
+  const std::vector<ndnlp::Fragment>& single = m_slicer.sliceInPlace(small);
+  BOOST_REQUIRE_EQUAL(single.size(), 1);
+  Block singlePkt = makeFragmentBlock(single[0]);
+  singlePkt.parse();
+  BOOST_CHECK_EQUAL(singlePkt.elements().size(), 2);
+  m_partialMessageStore.receiveNdnlpData(singlePkt);
+  BOOST_REQUIRE_EQUAL(m_received.size(), 2);
+  BOOST_CHECK_EQUAL_COLLECTIONS(m_received.at(1).begin(), m_received.at(1).end(),
+                                small.begin(),            small.end());
+}
+
+// drop the oldest partially received packet when all slots are in use
+BOOST_FIXTURE_TEST_CASE(SlotEviction, ReassembleFixture)
+{
+  ndnlp::PartialMessageStore store(time::seconds(10), 2);
+  store.onReceive +=
+    bind(static_cast<void (std::vector<Block>::*)(const Block&)>(&std::vector<Block>::push_back),
+         &m_received, _1);
+  size_t nTimeouts = 0;
+  store.onReassemblyTimeout += bind(&ReassembleFixture::increment, &nTimeouts);
+
+  std::vector<ndnlp::PacketArray> pas;
+  for (size_t i = 0; i < 3; ++i) {
+    pas.push_back(m_slicer.slice(makeBlock(2000)));
+    BOOST_REQUIRE_EQUAL(pas.back()->size(), 2);
+  }
+
+  store.receiveNdnlpData(pas[0]->at(0));
+  store.receiveNdnlpData(pas[1]->at(0));
+  BOOST_CHECK_EQUAL(store.size(), 2);
+  BOOST_CHECK_EQUAL(nTimeouts, 0);
+
+  store.receiveNdnlpData(pas[2]->at(0));
+  BOOST_CHECK_EQUAL(store.size(), 2);
+  BOOST_CHECK_EQUAL(nTimeouts, 1);
+
+  store.receiveNdnlpData(pas[1]->at(1));
+  store.receiveNdnlpData(pas[2]->at(1));
+  BOOST_CHECK_EQUAL(m_received.size(), 2);
+  BOOST_CHECK_EQUAL(store.size(), 0);
+
+  // the first fragment of the evicted packet is gone
+  store.receiveNdnlpData(pas[0]->at(1));
+  BOOST_CHECK_EQUAL(m_received.size(), 2);
+  BOOST_CHECK_EQUAL(store.size(), 1);
+}
+
+// reject packets with more fragments than a slot can hold
+BOOST_FIXTURE_TEST_CASE(TooManyFragments, ReassembleFixture)
+{
+  // Slicer never sends this, so the fragment is encoded by hand
+  uint8_t payload[100];
+  memset(payload, 0xcc, sizeof(payload));
+  uint64_t sequenceBE = htobe64(0xdddd);
+  Block pkt(tlv::NdnlpData);
+  pkt.push_back(ndn::dataBlock(tlv::NdnlpSequence,
+                               reinterpret_cast<uint8_t*>(&sequenceBE), sizeof(sequenceBE)));
+  pkt.push_back(ndn::nonNegativeIntegerBlock(tlv::NdnlpFragIndex, 0));
+  pkt.push_back(ndn::nonNegativeIntegerBlock(tlv::NdnlpFragCount,
+                                             ndnlp::PartialMessageStore::MAX_FRAGMENTS + 1));
+  pkt.push_back(ndn::dataBlock(tlv::NdnlpPayload, payload, sizeof(payload)));
+  pkt.encode();
+
+  BOOST_CHECK_THROW(m_partialMessageStore.receiveNdnlpData(pkt), ndnlp::ParseError);
+  BOOST_CHECK_EQUAL(m_partialMessageStore.size(), 0);
+}
+
+// the largest packet sliced with the smallest supported MTU can be reassembled
+BOOST_FIXTURE_TEST_CASE(MaxFragmentsAtMinMtu, ReassembleFixture)
+{
+  Block block = makeBlock(ndn::MAX_NDN_PACKET_SIZE - 4);
+  BOOST_REQUIRE_EQUAL(block.size(), ndn::MAX_NDN_PACKET_SIZE);
+
+  ndnlp::Slicer slicer(ndnlp::Slicer::MIN_MTU);
+  ndnlp::PacketArray pa = slicer.slice(block);
+  BOOST_REQUIRE_GT(pa->size(), 1);
+  BOOST_CHECK_LE(pa->size(), ndnlp::PartialMessageStore::MAX_FRAGMENTS);
+
+  for (std::vector<Block>::const_iterator i = pa->begin(); i != pa->end(); ++i) {
+    BOOST_CHECK_LE(i->size(), ndnlp::Slicer::MIN_MTU);
+    m_partialMessageStore.receiveNdnlpData(*i);
+  }
+
+  BOOST_REQUIRE_EQUAL(m_received.size(), 1);
+  BOOST_CHECK_EQUAL_COLLECTIONS(m_received.at(0).begin(), m_received.at(0).end(),
+                                block.begin(),            block.end());
+}
+
+// sender drops a packet that needs more fragments than a receiver can reassemble
+BOOST_AUTO_TEST_CASE(SliceTooManyFragments)
+{
+  uint8_t blockValue[5050];
+  memset(blockValue, 0xcc, sizeof(blockValue));
+  Block block = ndn::dataBlock(0x01, blockValue, sizeof(blockValue));
+
+  ndnlp::Slicer slicer(100);
+  BOOST_CHECK_EQUAL(slicer.slice(block)->size(), 0);
+  BOOST_CHECK_EQUAL(slicer.sliceInPlace(block).size(), 0);
+
+  // the Slicer remains usable for packets that fit
+  size_t nFragments = slicer.sliceInPlace(ndn::dataBlock(0x01, blockValue, 1000)).size();
+  BOOST_CHECK_GT(nFragments, 1);
+  BOOST_CHECK_LE(nFragments, ndnlp::Slicer::MAX_FRAGMENTS);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
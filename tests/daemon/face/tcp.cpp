@@ -24,6 +24,7 @@
  */
 
 #include "face/tcp-factory.hpp"
+#include "face/io-thread.hpp"
 #include "core/resolver.hpp"
 #include "core/network-interface.hpp"
 #include <ndn-cxx/security/key-chain.hpp>
@@ -411,6 +412,42 @@ BOOST_FIXTURE_TEST_CASE(MultipleAccepts, EndToEndFixture)
 }
 
 
+BOOST_FIXTURE_TEST_CASE(MultipleListenQueues, EndToEndFixture)
+{
+  if (!isReusePortSupported())
+    {
+      BOOST_TEST_MESSAGE("SO_REUSEPORT is not supported, skipping");
+      return;
+    }
+
+  TcpFactory factory;
+
+  shared_ptr<TcpChannel> channel1 = factory.createChannel("127.0.0.1", "20070");
+  channel1->setNListenQueues(4);
+  BOOST_CHECK_EQUAL(channel1->getNListenQueues(), 4);
+  channel1->listen(bind(&EndToEndFixture::channel_onFaceCreated,   this, _1),
+                   bind(&EndToEndFixture::channel_onConnectFailed, this, _1));
+  BOOST_CHECK(channel1->isListening());
+
+  std::vector<shared_ptr<TcpChannel> > clientChannels;
+  for (int i = 0; i < 3; ++i)
+    {
+      std::string port = boost::lexical_cast<std::string>(20071 + i);
+      shared_ptr<TcpChannel> channel = factory.createChannel("127.0.0.1", port);
+      channel->connect("127.0.0.1", "20070",
+                       bind(&EndToEndFixture::channel_onFaceCreated, this, _1),
+                       bind(&EndToEndFixture::channel_onConnectFailed, this, _1));
+      clientChannels.push_back(channel);
+    }
+
+  BOOST_CHECK_MESSAGE(limitedIo.run(6,// 3 connects and 3 accepts
+                      time::seconds(10)) == LimitedIo::EXCEED_OPS,
+                      "TcpChannel error: cannot connect or cannot accept multiple connections");
+
+  BOOST_CHECK_EQUAL(faces.size(), 6);
+  BOOST_CHECK_EQUAL(channel1->size(), 3);
+}
+
 BOOST_FIXTURE_TEST_CASE(FaceClosing, EndToEndFixture)
 {
   TcpFactory factory;
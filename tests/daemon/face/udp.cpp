@@ -24,6 +24,7 @@
  */
 
 #include "face/udp-factory.hpp"
+#include "face/io-thread.hpp"
 
 #include "tests/test-common.hpp"
 #include "tests/limited-io.hpp"
@@ -473,6 +474,201 @@ BOOST_FIXTURE_TEST_CASE(EndToEnd4, EndToEndFixture)
   BOOST_CHECK_EQUAL(counters2.getNOutBytes(), nBytesSent2);
 }
 
+BOOST_FIXTURE_TEST_CASE(BatchedIo, EndToEndFixture)
+{
+  UdpFactory factory;
+
+  shared_ptr<UdpChannel> channel2 = factory.createChannel("127.0.0.1", "20071");
+  channel2->setIoBatchSize(8);
+
+  factory.createFace(FaceUri("udp4://127.0.0.1:20070"),
+                     bind(&EndToEndFixture::channel2_onFaceCreated, this, _1),
+                     bind(&EndToEndFixture::channel2_onConnectFailed, this, _1));
+
+  BOOST_CHECK_MESSAGE(limitedIo.run(1, time::seconds(1)) == LimitedIo::EXCEED_OPS,
+                      "UdpChannel error: cannot connect or cannot accept connection");
+  BOOST_REQUIRE(static_cast<bool>(face2));
+  size_t expectedBatchSize = DatagramBatch::isSupported() ? 8 : 1;
+  BOOST_CHECK_EQUAL(static_pointer_cast<UdpFace>(face2)->getIoBatchSize(), expectedBatchSize);
+
+  shared_ptr<UdpChannel> channel1 = factory.createChannel("127.0.0.1", "20070");
+  channel1->setIoBatchSize(8);
+  channel1->listen(bind(&EndToEndFixture::channel1_onFaceCreated,   this, _1),
+                   bind(&EndToEndFixture::channel1_onConnectFailed, this, _1));
+
+  Interest interest1("ndn:/TpnzGvW9R");
+  Data     data1    ("ndn:/KfczhUqVix");
+  data1.setContent(0, 0);
+  Interest interest2("ndn:/QWiIMfj5sL");
+  Data     data2    ("ndn:/XNBV796f");
+  data2.setContent(0, 0);
+
+  ndn::SignatureSha256WithRsa fakeSignature;
+  fakeSignature.setValue(ndn::dataBlock(tlv::SignatureValue,
+                                        reinterpret_cast<const uint8_t*>(0),
+                                        0));
+  data1.setSignature(fakeSignature);
+  data2.setSignature(fakeSignature);
+
+  // sent together in one batch, and received by channel1 in one batch
+  face2->sendInterest(interest2);
+  face2->sendData    (data2    );
+  face2->sendData    (data2    );
+  face2->sendData    (data2    );
+  size_t nBytesSent2 = interest2.wireEncode().size() + data2.wireEncode().size() * 3;
+
+  BOOST_CHECK_MESSAGE(limitedIo.run(5,//4 send + 1 listen return
+                      time::seconds(4)) == LimitedIo::EXCEED_OPS,
+                      "UdpChannel error: cannot send or receive Interest/Data packets");
+
+  BOOST_REQUIRE(static_cast<bool>(face1));
+  BOOST_CHECK_EQUAL(face1->getRemoteUri().toString(), "udp4://127.0.0.1:20071");
+  BOOST_CHECK_EQUAL(static_pointer_cast<UdpFace>(face1)->getIoBatchSize(), expectedBatchSize);
+
+  face1->sendInterest(interest1);
+  face1->sendInterest(interest1);
+  face1->sendInterest(interest1);
+  face1->sendData    (data1    );
+
+  BOOST_CHECK_MESSAGE(limitedIo.run(4, time::seconds(4)) == LimitedIo::EXCEED_OPS,
+                      "UdpChannel error: cannot send or receive Interest/Data packets");
+
+  BOOST_REQUIRE_EQUAL(face1_receivedInterests.size(), 1);
+  BOOST_REQUIRE_EQUAL(face1_receivedDatas    .size(), 3);
+  BOOST_REQUIRE_EQUAL(face2_receivedInterests.size(), 3);
+  BOOST_REQUIRE_EQUAL(face2_receivedDatas    .size(), 1);
+
+  BOOST_CHECK_EQUAL(face1_receivedInterests[0].getName(), interest2.getName());
+  BOOST_CHECK_EQUAL(face1_receivedDatas    [0].getName(), data2.getName());
+  BOOST_CHECK_EQUAL(face2_receivedInterests[0].getName(), interest1.getName());
+  BOOST_CHECK_EQUAL(face2_receivedDatas    [0].getName(), data1.getName());
+
+  BOOST_CHECK_EQUAL(face1->getCounters().getNInBytes(), nBytesSent2);
+  BOOST_CHECK_EQUAL(face2->getCounters().getNOutBytes(), nBytesSent2);
+}
+
+BOOST_FIXTURE_TEST_CASE(SharedSocket, EndToEndFixture)
+{
+  UdpFactory factory;
+
+  shared_ptr<UdpChannel> channel1 = factory.createChannel("127.0.0.1", "20070");
+  channel1->setSharedSocket(true);
+  channel1->listen(bind(&EndToEndFixture::channel1_onFaceCreatedNoCheck, this, _1),
+                   bind(&EndToEndFixture::channel1_onConnectFailed, this, _1));
+
+  shared_ptr<UdpChannel> channel2 = factory.createChannel("127.0.0.1", "20071");
+  channel2->connect("127.0.0.1", "20070",
+                    bind(&EndToEndFixture::channel2_onFaceCreated, this, _1),
+                    bind(&EndToEndFixture::channel2_onConnectFailed, this, _1));
+  shared_ptr<UdpChannel> channel3 = factory.createChannel("127.0.0.1", "20072");
+  channel3->connect("127.0.0.1", "20070",
+                    bind(&EndToEndFixture::channel_onFaceCreated, this, _1),
+                    bind(&EndToEndFixture::channel_onConnectFailed, this, _1));
+
+  BOOST_CHECK_MESSAGE(limitedIo.run(2, time::seconds(4)) == LimitedIo::EXCEED_OPS,
+                      "UdpChannel error: cannot connect or cannot accept connection");
+  BOOST_REQUIRE(static_cast<bool>(face2));
+  BOOST_REQUIRE_EQUAL(faces.size(), 2);
+  shared_ptr<Face> face3 = faces.back() == face2 ? faces.front() : faces.back();
+
+  Interest interest1("ndn:/TpnzGvW9R");
+  Interest interest2("ndn:/QWiIMfj5sL");
+  Interest interest3("ndn:/QWiIhjgkj5sL");
+  Data     data1    ("ndn:/KfczhUqVix");
+  data1.setContent(0, 0);
+  ndn::SignatureSha256WithRsa fakeSignature;
+  fakeSignature.setValue(ndn::dataBlock(tlv::SignatureValue,
+                                        reinterpret_cast<const uint8_t*>(0),
+                                        0));
+  data1.setSignature(fakeSignature);
+
+  face2->sendInterest(interest1);
+  BOOST_CHECK_MESSAGE(limitedIo.run(2,//1 send + 1 listen return
+                      time::seconds(4)) == LimitedIo::EXCEED_OPS,
+                      "UdpChannel error: cannot send or receive Interest/Data packets");
+  BOOST_REQUIRE(static_cast<bool>(face1));
+  shared_ptr<Face> peerFace2 = face1;
+  BOOST_CHECK_EQUAL(peerFace2->getRemoteUri().toString(), "udp4://127.0.0.1:20071");
+  BOOST_CHECK_EQUAL(peerFace2->getLocalUri().toString(), "udp4://127.0.0.1:20070");
+
+  face3->sendInterest(interest2);
+  BOOST_CHECK_MESSAGE(limitedIo.run(2,//1 send + 1 listen return
+                      time::seconds(4)) == LimitedIo::EXCEED_OPS,
+                      "UdpChannel error: cannot send or receive Interest/Data packets");
+  BOOST_REQUIRE(static_cast<bool>(face1));
+  BOOST_CHECK_NE(face1, peerFace2);
+  BOOST_CHECK_EQUAL(face1->getRemoteUri().toString(), "udp4://127.0.0.1:20072");
+  BOOST_CHECK_EQUAL(channel1->size(), 2);
+
+  // both peer faces send through the channel socket
+  peerFace2->sendData(data1);
+  BOOST_CHECK_MESSAGE(limitedIo.run(1, time::seconds(4)) == LimitedIo::EXCEED_OPS,
+                      "UdpChannel error: cannot send or receive Interest/Data packets");
+  BOOST_REQUIRE_EQUAL(face2_receivedDatas.size(), 1);
+  BOOST_CHECK_EQUAL(face2_receivedDatas[0].getName(), data1.getName());
+
+  // closing one peer face leaves the channel socket open for the others
+  scheduler::schedule(time::milliseconds(100), bind(&Face::close, face1));
+  BOOST_CHECK_MESSAGE(limitedIo.run(1, time::seconds(4)) == LimitedIo::EXCEED_OPS,
+                      "FaceClosing error: cannot properly close faces");
+  BOOST_CHECK(!static_cast<bool>(face1));
+  BOOST_CHECK_EQUAL(channel1->size(), 1);
+
+  face2->sendInterest(interest3);
+  BOOST_CHECK_MESSAGE(limitedIo.run(1, time::seconds(4)) == LimitedIo::EXCEED_OPS,
+                      "UdpChannel error: cannot send or receive Interest/Data packets");
+  BOOST_REQUIRE_EQUAL(face1_receivedInterests.size(), 3);
+  BOOST_CHECK_EQUAL(face1_receivedInterests[0].getName(), interest1.getName());
+  BOOST_CHECK_EQUAL(face1_receivedInterests[1].getName(), interest2.getName());
+  BOOST_CHECK_EQUAL(face1_receivedInterests[2].getName(), interest3.getName());
+  BOOST_CHECK_EQUAL(peerFace2->getCounters().getNInInterests(), 2);
+}
+
+BOOST_FIXTURE_TEST_CASE(MultipleListenQueues, EndToEndFixture)
+{
+  if (!isReusePortSupported())
+    {
+      BOOST_TEST_MESSAGE("SO_REUSEPORT is not supported, skipping");
+      return;
+    }
+
+  UdpFactory factory;
+
+  shared_ptr<UdpChannel> channel1 = factory.createChannel("127.0.0.1", "20070");
+  channel1->setSharedSocket(true);
+  channel1->setNListenQueues(4);
+  BOOST_CHECK_EQUAL(channel1->getNListenQueues(), 4);
+  channel1->listen(bind(&EndToEndFixture::channel1_onFaceCreatedNoCheck, this, _1),
+                   bind(&EndToEndFixture::channel1_onConnectFailed, this, _1));
+
+  std::vector<shared_ptr<UdpChannel> > clientChannels;
+  for (int i = 0; i < 3; ++i)
+    {
+      std::string port = boost::lexical_cast<std::string>(20071 + i);
+      shared_ptr<UdpChannel> channel = factory.createChannel("127.0.0.1", port);
+      channel->connect("127.0.0.1", "20070",
+                       bind(&EndToEndFixture::channel_onFaceCreated, this, _1),
+                       bind(&EndToEndFixture::channel_onConnectFailed, this, _1));
+      clientChannels.push_back(channel);
+    }
+
+  BOOST_CHECK_MESSAGE(limitedIo.run(3, time::seconds(4)) == LimitedIo::EXCEED_OPS,
+                      "UdpChannel error: cannot connect or cannot accept connection");
+  BOOST_REQUIRE_EQUAL(faces.size(), 3);
+  std::vector<shared_ptr<Face> > clientFaces(faces.begin(), faces.end());
+
+  Interest interest("ndn:/TpnzGvW9R");
+  for (size_t i = 0; i < clientFaces.size(); ++i)
+    clientFaces[i]->sendInterest(interest);
+
+  // datagrams received by any queue reach their faces in this thread
+  BOOST_CHECK_MESSAGE(limitedIo.run(6,//3 send + 3 listen return
+                      time::seconds(4)) == LimitedIo::EXCEED_OPS,
+                      "UdpChannel error: cannot send or receive Interest/Data packets");
+  BOOST_CHECK_EQUAL(face1_receivedInterests.size(), 3);
+  BOOST_CHECK_EQUAL(channel1->size(), 3);
+}
+
 BOOST_FIXTURE_TEST_CASE(EndToEnd6, EndToEndFixture)
 {
   UdpFactory factory;
@@ -940,6 +1136,47 @@ BOOST_FIXTURE_TEST_CASE(ClosingIdleFace, EndToEndFixture)
   BOOST_CHECK_EQUAL(channel2->size(), 1);
 }
 
+BOOST_AUTO_TEST_CASE(MulticastFragmentation)
+{
+  UdpFactory factory;
+  shared_ptr<MulticastUdpFace> face = factory.createMulticastFace("0.0.0.0", "224.0.0.1", "20073");
+  BOOST_CHECK_EQUAL(face->getMtu(), 1472);
+  face->setMtu(1000);
+
+  std::vector<Data> received;
+  face->onReceiveData +=
+    bind(static_cast<void (std::vector<Data>::*)(const Data&)>(&std::vector<Data>::push_back),
+         &received, _1);
+
+  shared_ptr<Data> data = makeData("ndn:/fragmented/data");
+  std::vector<uint8_t> content(3000, 0xbb);
+  data->setContent(&content.front(), content.size());
+  signData(data);
+
+  // fragments are sent when the packet exceeds the MTU
+  face->sendData(*data);
+  ndnlp::Slicer slicer(1000);
+  ndnlp::PacketArray fragments = slicer.slice(data->wireEncode());
+  BOOST_CHECK_GT(fragments->size(), 1);
+  BOOST_CHECK_EQUAL(face->getFragmentationCounters().getNOutFragments(), fragments->size());
+
+  face->sendInterest(*makeInterest("ndn:/small"));
+  BOOST_CHECK_EQUAL(face->getFragmentationCounters().getNOutFragments(), fragments->size());
+
+  // fragments received from the group are reassembled, in any order
+  for (std::vector<Block>::const_reverse_iterator i = fragments->rbegin();
+       i != fragments->rend(); ++i)
+    {
+      ndn::ConstBufferPtr buffer = make_shared<ndn::Buffer>(i->wire(), i->size());
+      face->receiveDatagram(buffer, i->size(), boost::system::error_code());
+    }
+
+  BOOST_CHECK_EQUAL(face->getFragmentationCounters().getNInFragments(), fragments->size());
+  BOOST_REQUIRE_EQUAL(received.size(), 1);
+  BOOST_CHECK_EQUAL(received[0].getName(), data->getName());
+  BOOST_CHECK_EQUAL(received[0].getContent().value_size(), content.size());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
@@ -251,6 +251,66 @@ BOOST_FIXTURE_TEST_CASE(EndToEnd, EndToEndFixture)
   BOOST_CHECK_EQUAL(counters2.getNOutDatas()    , 3);
 }
 
+BOOST_FIXTURE_TEST_CASE(GatheredWrite, EndToEndFixture)
+{
+  std::vector<shared_ptr<Interest> > interests;
+  for (int i = 0; i < 5; ++i)
+    interests.push_back(makeInterest(Name("ndn:/jQ9cWp3r").appendNumber(i)));
+  shared_ptr<Data> data1 = makeData("ndn:/jQ9cWp3r/1");
+  shared_ptr<Data> data2 = makeData("ndn:/jQ9cWp3r/2");
+
+  UnixStreamFactory factory;
+
+  shared_ptr<UnixStreamChannel> channel1 = factory.createChannel(CHANNEL_PATH1);
+  // two Interests fit in one write
+  channel1->setMaxWriteSize(interests[0]->wireEncode().size() * 2 + 1);
+  channel1->listen(bind(&EndToEndFixture::channel1_onFaceCreated,   this, _1),
+                   bind(&EndToEndFixture::channel1_onConnectFailed, this, _1));
+
+  shared_ptr<stream_protocol::socket> client = make_shared<stream_protocol::socket>(ref(g_io));
+  client->async_connect(stream_protocol::endpoint(CHANNEL_PATH1),
+                        bind(&EndToEndFixture::client_onConnect, this, _1));
+
+  BOOST_CHECK_MESSAGE(limitedIo.run(2, time::seconds(1)) == LimitedIo::EXCEED_OPS,
+                      "UnixStreamChannel error: cannot connect or cannot accept connection");
+
+  BOOST_REQUIRE(static_cast<bool>(face1));
+  BOOST_CHECK_EQUAL(face1->getMaxWriteSize(), interests[0]->wireEncode().size() * 2 + 1);
+
+  face2 = make_shared<UnixStreamFace>(client);
+  face2->setMaxWriteSize(0); // one packet per write
+  face2->onReceiveInterest +=
+    bind(&EndToEndFixture::face2_onReceiveInterest, this, _1);
+  face2->onReceiveData +=
+    bind(&EndToEndFixture::face2_onReceiveData, this, _1);
+
+  size_t nBytesSent1 = 0;
+  for (int i = 0; i < 5; ++i)
+    {
+      face1->sendInterest(*interests[i]);
+      nBytesSent1 += interests[i]->wireEncode().size();
+    }
+  face2->sendData(*data1);
+  face2->sendData(*data2);
+  size_t nBytesSent2 = data1->wireEncode().size() + data2->wireEncode().size();
+
+  BOOST_CHECK_MESSAGE(limitedIo.run(7, time::seconds(1)) == LimitedIo::EXCEED_OPS,
+                      "UnixStreamChannel error: cannot send or receive Interest/Data packets");
+
+  BOOST_REQUIRE_EQUAL(face2_receivedInterests.size(), 5);
+  for (int i = 0; i < 5; ++i)
+    BOOST_CHECK_EQUAL(face2_receivedInterests[i].getName(), interests[i]->getName());
+  BOOST_REQUIRE_EQUAL(face1_receivedDatas.size(), 2);
+  BOOST_CHECK_EQUAL(face1_receivedDatas[0].getName(), data1->getName());
+  BOOST_CHECK_EQUAL(face1_receivedDatas[1].getName(), data2->getName());
+
+  // needed to ensure NOutBytes counters are accurate
+  limitedIo.run(LimitedIo::UNLIMITED_OPS, time::seconds(1));
+
+  BOOST_CHECK_EQUAL(face1->getCounters().getNOutBytes(), nBytesSent1);
+  BOOST_CHECK_EQUAL(face2->getCounters().getNOutBytes(), nBytesSent2);
+}
+
 BOOST_FIXTURE_TEST_CASE(MultipleAccepts, EndToEndFixture)
 {
   UnixStreamFactory factory;
@@ -79,6 +79,80 @@ BOOST_AUTO_TEST_CASE(SimpleExchange)
   BOOST_CHECK_EQUAL(forwarder.getCounters().getNOutDatas(), 1);
 }
 
+BOOST_AUTO_TEST_CASE(BatchExchange)
+{
+  Forwarder forwarder;
+
+  shared_ptr<DummyFace> face1 = make_shared<DummyFace>();
+  shared_ptr<DummyFace> face2 = make_shared<DummyFace>();
+  forwarder.addFace(face1);
+  forwarder.addFace(face2);
+
+  Fib& fib = forwarder.getFib();
+  shared_ptr<fib::Entry> fibEntry = fib.insert(Name("ndn:/A")).first;
+  fibEntry->addNextHop(face2, 0);
+
+  InterestBatch interests;
+  interests.push_back(makeInterest("ndn:/A/1"));
+  interests.push_back(makeInterest("ndn:/localhost/A"));
+  interests.push_back(makeInterest("ndn:/A/2"));
+  interests.push_back(makeInterest("ndn:/A/3"));
+  for (InterestBatch::iterator it = interests.begin(); it != interests.end(); ++it) {
+    (*it)->setInterestLifetime(time::seconds(4));
+  }
+
+  face1->receiveInterestBatch(interests);
+  BOOST_CHECK_EQUAL(forwarder.getCounters().getNInInterests(), 4);
+  // /localhost Interest from non-local face is dropped
+  BOOST_REQUIRE_EQUAL(face2->m_sentInterests.size(), 3);
+  BOOST_CHECK_EQUAL(face2->m_sentInterests[0].getName(), Name("ndn:/A/1"));
+  BOOST_CHECK_EQUAL(face2->m_sentInterests[1].getName(), Name("ndn:/A/2"));
+  BOOST_CHECK_EQUAL(face2->m_sentInterests[2].getName(), Name("ndn:/A/3"));
+  BOOST_CHECK_EQUAL(face2->m_sentInterests[2].getIncomingFaceId(), face1->getId());
+  BOOST_CHECK_EQUAL(forwarder.getPit().size(), 3);
+
+  DataBatch datas;
+  datas.push_back(makeData("ndn:/A/3"));
+  datas.push_back(makeData("ndn:/A/1"));
+  datas.push_back(makeData("ndn:/B"));
+  face2->receiveDataBatch(datas);
+  BOOST_CHECK_EQUAL(forwarder.getCounters().getNInDatas(), 3);
+  BOOST_REQUIRE_EQUAL(face1->m_sentDatas.size(), 2);
+  BOOST_CHECK_EQUAL(face1->m_sentDatas[0].getName(), Name("ndn:/A/3"));
+  BOOST_CHECK_EQUAL(face1->m_sentDatas[1].getName(), Name("ndn:/A/1"));
+  BOOST_CHECK_EQUAL(face1->m_sentDatas[1].getIncomingFaceId(), face2->getId());
+}
+
+BOOST_AUTO_TEST_CASE(BatchFaceFailed)
+{
+  Forwarder forwarder;
+
+  shared_ptr<DummyFace> face1 = make_shared<DummyFace>();
+  shared_ptr<DummyFace> face2 = make_shared<DummyFace>();
+  forwarder.addFace(face1);
+  forwarder.addFace(face2);
+
+  Fib& fib = forwarder.getFib();
+  shared_ptr<fib::Entry> fibEntry = fib.insert(Name("ndn:/A")).first;
+  fibEntry->addNextHop(face2, 0);
+
+  InterestBatch interests;
+  interests.push_back(makeInterest("ndn:/A/1"));
+  interests.push_back(makeInterest("ndn:/A/2"));
+  face1->receiveInterestBatchAndFail(interests);
+  BOOST_CHECK_EQUAL(face1->getId(), INVALID_FACEID);
+
+  // the next batch from another face does not flush Interests of the failed face
+  DataBatch datas;
+  datas.push_back(makeData("ndn:/A/1"));
+  face2->receiveDataBatch(datas);
+  BOOST_CHECK_EQUAL(forwarder.getCounters().getNInDatas(), 1);
+
+  BOOST_CHECK_EQUAL(forwarder.getCounters().getNInInterests(), 0);
+  BOOST_CHECK_EQUAL(face2->m_sentInterests.size(), 0);
+  BOOST_CHECK_EQUAL(forwarder.getPit().size(), 0);
+}
+
 BOOST_AUTO_TEST_CASE(CsMatched)
 {
   LimitedIo limitedIo;
@@ -0,0 +1,288 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/sharded-forwarder.hpp"
+#include "tests/daemon/face/dummy-face.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/limited-io.hpp"
+
+namespace nfd {
+namespace tests {
+
+class ShardedForwarderFixture : protected BaseFixture
+{
+public:
+  ShardedForwarderFixture()
+    : m_sharded(m_forwarder)
+    , m_face1(make_shared<DummyFace>())
+    , m_face2(make_shared<DummyFace>())
+  {
+    m_face1->afterSend += bind(&LimitedIo::afterOp, &m_limitedIo);
+    m_face2->afterSend += bind(&LimitedIo::afterOp, &m_limitedIo);
+    m_forwarder.addFace(m_face1);
+    m_forwarder.addFace(m_face2);
+  }
+
+  void
+  runConfig(const std::string& CONFIG, bool isDryRun)
+  {
+    ConfigFile config;
+    m_sharded.setConfigFile(config);
+    config.parse(CONFIG, isDryRun, "dummy-config");
+  }
+
+  /** \return a one-component prefix P, such that P and P/B are owned by different workers
+   */
+  Name
+  findSplitPrefix() const
+  {
+    for (int i = 0; ; ++i) {
+      Name prefix("ndn:/P");
+      prefix.appendNumber(i);
+      if (m_sharded.getShard(prefix, 1) != m_sharded.getShard(Name(prefix).append("B"), 2)) {
+        return prefix;
+      }
+    }
+  }
+
+protected:
+  LimitedIo m_limitedIo;
+  Forwarder m_forwarder;
+  ShardedForwarder m_sharded;
+  shared_ptr<DummyFace> m_face1;
+  shared_ptr<DummyFace> m_face2;
+};
+
+BOOST_FIXTURE_TEST_SUITE(FwShardedForwarder, ShardedForwarderFixture)
+
+BOOST_AUTO_TEST_CASE(GetShard)
+{
+  m_sharded.setNWorkers(4);
+  m_sharded.setNDispatchComponents(2);
+
+  size_t shardAB = m_sharded.getShard("ndn:/A/B", 2);
+  BOOST_CHECK_LT(shardAB, 4);
+  BOOST_CHECK_EQUAL(m_sharded.getShard("ndn:/A/B/C", 2), shardAB);
+  BOOST_CHECK_EQUAL(m_sharded.getShard("ndn:/A/B/D/E", 2), shardAB);
+  BOOST_CHECK_EQUAL(m_sharded.getShard("ndn:/A", 2), m_sharded.getShard("ndn:/A", 1));
+  BOOST_CHECK_EQUAL(m_sharded.getShard("ndn:/A/B", 0), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Config)
+{
+  BOOST_CHECK_EQUAL(m_sharded.getNWorkers(), 0);
+  BOOST_CHECK_EQUAL(m_sharded.getNDispatchComponents(), 2);
+
+  const std::string CONFIG =
+    "forwarder\n"
+    "{\n"
+    "  workers 3\n"
+    "  dispatch_components 1\n"
+    "}\n";
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, true));
+  BOOST_CHECK_EQUAL(m_sharded.getNWorkers(), 0);
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  BOOST_CHECK_EQUAL(m_sharded.getNWorkers(), 3);
+  BOOST_CHECK_EQUAL(m_sharded.getNDispatchComponents(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidConfig)
+{
+  const std::string CONFIG_WORKERS =
+    "forwarder\n"
+    "{\n"
+    "  workers many\n"
+    "}\n";
+  BOOST_CHECK_THROW(runConfig(CONFIG_WORKERS, true), ConfigFile::Error);
+
+  const std::string CONFIG_DISPATCH_COMPONENTS =
+    "forwarder\n"
+    "{\n"
+    "  dispatch_components 0\n"
+    "}\n";
+  BOOST_CHECK_THROW(runConfig(CONFIG_DISPATCH_COMPONENTS, true), ConfigFile::Error);
+}
+
+BOOST_AUTO_TEST_CASE(NoWorkers)
+{
+  m_sharded.start();
+  BOOST_CHECK(!m_sharded.isRunning());
+
+  m_forwarder.getFib().insert("ndn:/A").first->addNextHop(m_face2, 0);
+
+  m_face1->receiveInterest(*makeInterest("ndn:/A/B"));
+  BOOST_CHECK_EQUAL(m_forwarder.getCounters().getNInInterests(), 1);
+  BOOST_CHECK_EQUAL(m_face2->m_sentInterests.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(Exchange)
+{
+  m_forwarder.getFib().insert("ndn:/A").first->addNextHop(m_face2, 0);
+
+  m_sharded.setNWorkers(3);
+  m_sharded.start();
+  BOOST_REQUIRE(m_sharded.isRunning());
+
+  shared_ptr<Interest> interest = makeInterest("ndn:/A/B");
+  interest->setInterestLifetime(time::seconds(4));
+  m_face1->receiveInterest(*interest);
+  BOOST_CHECK_EQUAL(m_limitedIo.run(1, time::seconds(1)), LimitedIo::EXCEED_OPS);
+  BOOST_REQUIRE_EQUAL(m_face2->m_sentInterests.size(), 1);
+  BOOST_CHECK_EQUAL(m_face2->m_sentInterests[0].getName(), Name("ndn:/A/B"));
+  BOOST_CHECK_EQUAL(m_face2->m_sentInterests[0].getIncomingFaceId(), m_face1->getId());
+  // forwarded by a worker
+  BOOST_CHECK_EQUAL(m_forwarder.getCounters().getNInInterests(), 0);
+
+  m_face2->receiveData(*makeData("ndn:/A/B/C"));
+  BOOST_CHECK_EQUAL(m_limitedIo.run(1, time::seconds(1)), LimitedIo::EXCEED_OPS);
+  BOOST_REQUIRE_EQUAL(m_face1->m_sentDatas.size(), 1);
+  BOOST_CHECK_EQUAL(m_face1->m_sentDatas[0].getName(), Name("ndn:/A/B/C"));
+}
+
+BOOST_AUTO_TEST_CASE(ShortInterest)
+{
+  m_forwarder.getFib().insert("ndn:/").first->addNextHop(m_face2, 0);
+
+  m_sharded.setNWorkers(4);
+  m_sharded.setNDispatchComponents(3);
+  m_sharded.start();
+
+  // Interest is dispatched by one component, Data by three
+  shared_ptr<Interest> interest = makeInterest("ndn:/A");
+  interest->setInterestLifetime(time::seconds(4));
+  m_face1->receiveInterest(*interest);
+  BOOST_CHECK_EQUAL(m_limitedIo.run(1, time::seconds(1)), LimitedIo::EXCEED_OPS);
+  BOOST_REQUIRE_EQUAL(m_face2->m_sentInterests.size(), 1);
+
+  m_face2->receiveData(*makeData("ndn:/A/B/C/D"));
+  BOOST_CHECK_EQUAL(m_limitedIo.run(1, time::seconds(1)), LimitedIo::EXCEED_OPS);
+  BOOST_REQUIRE_EQUAL(m_face1->m_sentDatas.size(), 1);
+  BOOST_CHECK_EQUAL(m_face1->m_sentDatas[0].getName(), Name("ndn:/A/B/C/D"));
+}
+
+BOOST_AUTO_TEST_CASE(DataSatisfiesTwoWorkers)
+{
+  shared_ptr<DummyFace> face3 = make_shared<DummyFace>();
+  face3->afterSend += bind(&LimitedIo::afterOp, &m_limitedIo);
+  m_forwarder.addFace(face3);
+  m_forwarder.getFib().insert("ndn:/").first->addNextHop(face3, 0);
+
+  m_sharded.setNWorkers(4);
+  m_sharded.setNDispatchComponents(2);
+
+  Name prefix = findSplitPrefix();
+  Name nameB = Name(prefix).append("B");
+  m_sharded.start();
+
+  shared_ptr<Interest> interest1 = makeInterest(prefix);
+  interest1->setInterestLifetime(time::seconds(4));
+  m_face1->receiveInterest(*interest1);
+  shared_ptr<Interest> interest2 = makeInterest(nameB);
+  interest2->setInterestLifetime(time::seconds(4));
+  m_face2->receiveInterest(*interest2);
+  BOOST_CHECK_EQUAL(m_limitedIo.run(2, time::seconds(1)), LimitedIo::EXCEED_OPS);
+  BOOST_REQUIRE_EQUAL(face3->m_sentInterests.size(), 2);
+
+  // the Data is matched by the worker of nameB, and by the worker of prefix
+  face3->receiveData(*makeData(Name(nameB).append("C")));
+  BOOST_CHECK_EQUAL(m_limitedIo.run(2, time::seconds(1)), LimitedIo::EXCEED_OPS);
+  BOOST_CHECK_EQUAL(m_face1->m_sentDatas.size(), 1);
+  BOOST_CHECK_EQUAL(m_face2->m_sentDatas.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(ShortInterestFromCs)
+{
+  shared_ptr<DummyFace> face3 = make_shared<DummyFace>();
+  face3->afterSend += bind(&LimitedIo::afterOp, &m_limitedIo);
+  m_forwarder.addFace(face3);
+  m_forwarder.getFib().insert("ndn:/").first->addNextHop(face3, 0);
+
+  m_sharded.setNWorkers(4);
+  m_sharded.setNDispatchComponents(2);
+
+  Name prefix = findSplitPrefix();
+  Name nameB = Name(prefix).append("B");
+  m_sharded.start();
+
+  m_face2->receiveInterest(*makeInterest(nameB));
+  BOOST_CHECK_EQUAL(m_limitedIo.run(1, time::seconds(1)), LimitedIo::EXCEED_OPS);
+  face3->receiveData(*makeData(Name(nameB).append("C")));
+  BOOST_CHECK_EQUAL(m_limitedIo.run(1, time::seconds(1)), LimitedIo::EXCEED_OPS);
+  BOOST_REQUIRE_EQUAL(m_face2->m_sentDatas.size(), 1);
+  // let the worker of prefix process the Data passed on to it
+  m_limitedIo.run(LimitedIo::UNLIMITED_OPS, time::milliseconds(100));
+
+  // the worker of prefix cached the Data solicited in the worker of nameB
+  m_face1->receiveInterest(*makeInterest(prefix));
+  BOOST_CHECK_EQUAL(m_limitedIo.run(1, time::seconds(1)), LimitedIo::EXCEED_OPS);
+  BOOST_CHECK_EQUAL(m_face1->m_sentDatas.size(), 1);
+  BOOST_CHECK_EQUAL(face3->m_sentInterests.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(SyncFibEntry)
+{
+  m_sharded.setNWorkers(2);
+  m_sharded.start();
+
+  // FIB entry added after start is not known to workers until synchronized
+  m_forwarder.getFib().insert("ndn:/A").first->addNextHop(m_face2, 0);
+  m_sharded.syncFibEntry("ndn:/A");
+
+  shared_ptr<Interest> interest = makeInterest("ndn:/A/B");
+  m_face1->receiveInterest(*interest);
+  BOOST_CHECK_EQUAL(m_limitedIo.run(1, time::seconds(1)), LimitedIo::EXCEED_OPS);
+  BOOST_CHECK_EQUAL(m_face2->m_sentInterests.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(Localhost)
+{
+  m_sharded.setNWorkers(2);
+  m_sharded.start();
+
+  // /localhost is handled by the main Forwarder, which drops it from a non-local face
+  m_face1->receiveInterest(*makeInterest("ndn:/localhost/A"));
+  BOOST_CHECK_EQUAL(m_forwarder.getCounters().getNInInterests(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(StopStart)
+{
+  m_sharded.setNWorkers(2);
+  m_sharded.start();
+  BOOST_CHECK(m_sharded.isRunning());
+
+  m_sharded.stop();
+  BOOST_CHECK(!m_sharded.isRunning());
+
+  m_face1->receiveInterest(*makeInterest("ndn:/A"));
+  BOOST_CHECK_EQUAL(m_forwarder.getCounters().getNInInterests(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace nfd
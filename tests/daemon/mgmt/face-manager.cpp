@@ -343,6 +343,7 @@ BOOST_AUTO_TEST_CASE(TestProcessSectionUnix)
     "  {\n"
     "    listen yes\n"
     "    path /tmp/nfd.sock\n"
+    "    max_write_size 16384\n"
     "  }\n"
     "}\n";
   BOOST_TEST_CHECKPOINT("Calling parse");
@@ -379,6 +380,21 @@ BOOST_AUTO_TEST_CASE(TestProcessSectionUnixBadListen)
                              "Invalid value for option \"listen\" in \"unix\" section"));
 }
 
+BOOST_AUTO_TEST_CASE(TestProcessSectionUnixBadMaxWriteSize)
+{
+  const std::string CONFIG =
+    "face_system\n"
+    "{\n"
+    "  unix\n"
+    "  {\n"
+    "    max_write_size hello\n"
+    "  }\n"
+    "}\n";
+  BOOST_CHECK_EXCEPTION(parseConfig(CONFIG, false), ConfigFile::Error,
+                        bind(&isExpectedException, _1,
+                             "Invalid value for option \"max_write_size\" in \"unix\" section"));
+}
+
 BOOST_AUTO_TEST_CASE(TestProcessSectionUnixUnknownOption)
 {
   const std::string CONFIG =
@@ -408,6 +424,7 @@ BOOST_AUTO_TEST_CASE(TestProcessSectionTcp)
     "    port 6363\n"
     "    enable_v4 yes\n"
     "    enable_v6 yes\n"
+    "    max_write_size 16384\n"
     "  }\n"
     "}\n";
   try
@@ -455,6 +472,36 @@ BOOST_AUTO_TEST_CASE(TestProcessSectionTcpBadListen)
                              "Invalid value for option \"listen\" in \"tcp\" section"));
 }
 
+BOOST_AUTO_TEST_CASE(TestProcessSectionTcpBadMaxWriteSize)
+{
+  const std::string CONFIG =
+    "face_system\n"
+    "{\n"
+    "  tcp\n"
+    "  {\n"
+    "    max_write_size hello\n"
+    "  }\n"
+    "}\n";
+  BOOST_CHECK_EXCEPTION(parseConfig(CONFIG, false), ConfigFile::Error,
+                        bind(&isExpectedException, _1,
+                             "Invalid value for option \"max_write_size\" in \"tcp\" section"));
+}
+
+BOOST_AUTO_TEST_CASE(TestProcessSectionTcpBadListenQueues)
+{
+  const std::string CONFIG =
+    "face_system\n"
+    "{\n"
+    "  tcp\n"
+    "  {\n"
+    "    listen_queues 0\n"
+    "  }\n"
+    "}\n";
+  BOOST_CHECK_EXCEPTION(parseConfig(CONFIG, false), ConfigFile::Error,
+                        bind(&isExpectedException, _1,
+                             "Invalid value for option \"listen_queues\" in \"tcp\" section"));
+}
+
 BOOST_AUTO_TEST_CASE(TestProcessSectionTcpChannelsDisabled)
 {
   const std::string CONFIG =
@@ -501,6 +548,8 @@ BOOST_AUTO_TEST_CASE(TestProcessSectionUdp)
     "    enable_v6 yes\n"
     "    idle_timeout 30\n"
     "    keep_alive_interval 25\n"
+    "    io_batch_size 32\n"
+    "    shared_socket yes\n"
     "    mcast yes\n"
     "    mcast_port 56363\n"
     "    mcast_group 224.0.23.170\n"
@@ -543,6 +592,54 @@ BOOST_AUTO_TEST_CASE(TestProcessSectionUdpBadIdleTimeout)
                              "Invalid value for option \"idle_timeout\" in \"udp\" section"));
 }
 
+BOOST_AUTO_TEST_CASE(TestProcessSectionUdpBadIoBatchSize)
+{
+  const std::string CONFIG =
+    "face_system\n"
+    "{\n"
+    "  udp\n"
+    "  {\n"
+    "    io_batch_size hello\n"
+    "  }\n"
+    "}\n";
+
+  BOOST_CHECK_EXCEPTION(parseConfig(CONFIG, false), ConfigFile::Error,
+                        bind(&isExpectedException, _1,
+                             "Invalid value for option \"io_batch_size\" in \"udp\" section"));
+}
+
+BOOST_AUTO_TEST_CASE(TestProcessSectionUdpBadSharedSocket)
+{
+  const std::string CONFIG =
+    "face_system\n"
+    "{\n"
+    "  udp\n"
+    "  {\n"
+    "    shared_socket hello\n"
+    "  }\n"
+    "}\n";
+
+  BOOST_CHECK_EXCEPTION(parseConfig(CONFIG, false), ConfigFile::Error,
+                        bind(&isExpectedException, _1,
+                             "Invalid value for option \"shared_socket\" in \"udp\" section"));
+}
+
+BOOST_AUTO_TEST_CASE(TestProcessSectionUdpBadListenQueues)
+{
+  const std::string CONFIG =
+    "face_system\n"
+    "{\n"
+    "  udp\n"
+    "  {\n"
+    "    listen_queues hello\n"
+    "  }\n"
+    "}\n";
+
+  BOOST_CHECK_EXCEPTION(parseConfig(CONFIG, false), ConfigFile::Error,
+                        bind(&isExpectedException, _1,
+                             "Invalid value for option \"listen_queues\" in \"udp\" section"));
+}
+
 BOOST_AUTO_TEST_CASE(TestProcessSectionUdpBadMcast)
 {
   const std::string CONFIG =
@@ -759,6 +856,51 @@ BOOST_AUTO_TEST_CASE(TestProcessSectionEtherBadMcastGroup)
                              "Invalid value for option \"mcast_group\" in \"ether\" section"));
 }
 
+BOOST_AUTO_TEST_CASE(TestProcessSectionEtherBackend)
+{
+  const std::string CONFIG =
+    "face_system\n"
+    "{\n"
+    "  ether\n"
+    "  {\n"
+    "    mcast no\n"
+    "    backend packet_mmap\n"
+    "  }\n"
+    "}\n";
+
+  if (EthernetFace::isPacketMmapSupported())
+    {
+      BOOST_CHECK_NO_THROW(parseConfig(CONFIG, false));
+
+      shared_ptr<EthernetFactory> factory =
+        static_pointer_cast<EthernetFactory>(getManager().findFactory("ether"));
+      BOOST_REQUIRE(static_cast<bool>(factory));
+      BOOST_CHECK_EQUAL(factory->getBackend(), EthernetFace::BACKEND_PACKET_MMAP);
+    }
+  else
+    {
+      BOOST_CHECK_EXCEPTION(parseConfig(CONFIG, false), ConfigFile::Error,
+                            bind(&isExpectedException, _1,
+                                 "Invalid value for option \"backend\" in \"ether\" section"));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestProcessSectionEtherBadBackend)
+{
+  const std::string CONFIG =
+    "face_system\n"
+    "{\n"
+    "  ether\n"
+    "  {\n"
+    "    backend dpdk\n"
+    "  }\n"
+    "}\n";
+
+  BOOST_CHECK_EXCEPTION(parseConfig(CONFIG, false), ConfigFile::Error,
+                        bind(&isExpectedException, _1,
+                             "Invalid value for option \"backend\" in \"ether\" section"));
+}
+
 BOOST_AUTO_TEST_CASE(TestProcessSectionEtherUnknownOption)
 {
   const std::string CONFIG =
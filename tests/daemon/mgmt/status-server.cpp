@@ -27,6 +27,7 @@
 #include "fw/forwarder.hpp"
 #include "version.hpp"
 #include "mgmt/internal-face.hpp"
+#include "core/status-tlv.hpp"
 
 #include "tests/test-common.hpp"
 #include "tests/daemon/face/dummy-face.hpp"
@@ -64,6 +65,7 @@ BOOST_AUTO_TEST_CASE(Status)
   forwarder.getMeasurements().get("ndn:/measurements1");
   forwarder.getMeasurements().get("ndn:/measurements2");
   forwarder.getMeasurements().get("ndn:/measurements3");
+  forwarder.getCs().insert(*makeData("ndn:/cs1"));
   BOOST_CHECK_GE(forwarder.getFib().size(), 1);
   BOOST_CHECK_GE(forwarder.getPit().size(), 4);
   BOOST_CHECK_GE(forwarder.getMeasurements().size(), 3);
@@ -97,6 +99,16 @@ BOOST_AUTO_TEST_CASE(Status)
   BOOST_CHECK_EQUAL(status.getNPitEntries(), forwarder.getPit().size());
   BOOST_CHECK_EQUAL(status.getNMeasurementsEntries(), forwarder.getMeasurements().size());
   BOOST_CHECK_EQUAL(status.getNCsEntries(), forwarder.getCs().size());
+
+  // NFD-specific elements follow ForwarderStatus
+  Block content = g_response->getContent();
+  content.parse();
+  Block::element_const_iterator nCsBytes = content.find(status_tlv::NCsBytes);
+  BOOST_REQUIRE(nCsBytes != content.elements_end());
+  BOOST_CHECK_GT(forwarder.getCs().getNBytes(), 0);
+  BOOST_CHECK_EQUAL(readNonNegativeInteger(*nCsBytes), forwarder.getCs().getNBytes());
+  // byte limit is unlimited by default, so CsMaxBytes is omitted
+  BOOST_CHECK(content.find(status_tlv::CsMaxBytes) == content.elements_end());
 }
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -29,6 +29,8 @@
 
 #include "tests/test-common.hpp"
 
+#include <boost/filesystem.hpp>
+
 namespace nfd {
 namespace tests {
 
@@ -168,6 +170,239 @@ BOOST_AUTO_TEST_CASE(InvalidValueCsMaxPackets)
                              this, _1, expectedMsg));
 }
 
+BOOST_AUTO_TEST_CASE(ValidCsMaxBytes)
+{
+  const std::string CONFIG =
+    "tables\n"
+    "{\n"
+    "  cs_max_bytes 1048576\n"
+    "}\n";
+
+  BOOST_REQUIRE_EQUAL(m_cs.getByteLimit(), std::numeric_limits<size_t>::max());
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, true));
+  BOOST_CHECK_EQUAL(m_cs.getByteLimit(), std::numeric_limits<size_t>::max());
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  BOOST_CHECK_EQUAL(m_cs.getByteLimit(), 1048576);
+
+  const std::string CONFIG_DEFAULT =
+    "tables\n"
+    "{\n"
+    "}\n";
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG_DEFAULT, false));
+  BOOST_CHECK_EQUAL(m_cs.getByteLimit(), std::numeric_limits<size_t>::max());
+}
+
+BOOST_AUTO_TEST_CASE(InvalidValueCsMaxBytes)
+{
+  const std::string CONFIG =
+    "tables\n"
+    "{\n"
+    "  cs_max_bytes 0\n"
+    "}\n";
+
+  const std::string expectedMsg =
+    "Invalid value for option \"cs_max_bytes\" in \"tables\" section";
+
+  BOOST_CHECK_EXCEPTION(runConfig(CONFIG, true),
+                        ConfigFile::Error,
+                        bind(&TablesConfigSectionFixture::validateException,
+                             this, _1, expectedMsg));
+
+  BOOST_CHECK_EXCEPTION(runConfig(CONFIG, false),
+                        ConfigFile::Error,
+                        bind(&TablesConfigSectionFixture::validateException,
+                             this, _1, expectedMsg));
+}
+
+BOOST_AUTO_TEST_CASE(ValidCsIndex)
+{
+  const std::string CONFIG =
+    "tables\n"
+    "{\n"
+    "  cs_index btree\n"
+    "}\n";
+
+  BOOST_REQUIRE_EQUAL(m_cs.getIndexType(), Cs::INDEX_SKIP_LIST);
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, true));
+  BOOST_CHECK_EQUAL(m_cs.getIndexType(), Cs::INDEX_SKIP_LIST);
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  BOOST_CHECK_EQUAL(m_cs.getIndexType(), Cs::INDEX_BTREE);
+
+  const std::string CONFIG_DEFAULT =
+    "tables\n"
+    "{\n"
+    "}\n";
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG_DEFAULT, false));
+  BOOST_CHECK_EQUAL(m_cs.getIndexType(), Cs::INDEX_SKIP_LIST);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidValueCsIndex)
+{
+  const std::string CONFIG =
+    "tables\n"
+    "{\n"
+    "  cs_index invalid\n"
+    "}\n";
+
+  const std::string expectedMsg =
+    "Invalid value for option \"cs_index\" in \"tables\" section";
+
+  BOOST_CHECK_EXCEPTION(runConfig(CONFIG, true),
+                        ConfigFile::Error,
+                        bind(&TablesConfigSectionFixture::validateException,
+                             this, _1, expectedMsg));
+
+  BOOST_CHECK_EXCEPTION(runConfig(CONFIG, false),
+                        ConfigFile::Error,
+                        bind(&TablesConfigSectionFixture::validateException,
+                             this, _1, expectedMsg));
+}
+
+BOOST_AUTO_TEST_CASE(ValidCsPolicy)
+{
+  const std::string CONFIG =
+    "tables\n"
+    "{\n"
+    "  cs_policy lru\n"
+    "}\n";
+
+  BOOST_REQUIRE_EQUAL(m_cs.getPolicy().getName(), "fifo");
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, true));
+  BOOST_CHECK_EQUAL(m_cs.getPolicy().getName(), "fifo");
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  BOOST_CHECK_EQUAL(m_cs.getPolicy().getName(), "lru");
+
+  const std::string CONFIG_DEFAULT =
+    "tables\n"
+    "{\n"
+    "}\n";
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG_DEFAULT, false));
+  BOOST_CHECK_EQUAL(m_cs.getPolicy().getName(), "fifo");
+}
+
+BOOST_AUTO_TEST_CASE(InvalidValueCsPolicy)
+{
+  const std::string CONFIG =
+    "tables\n"
+    "{\n"
+    "  cs_policy invalid\n"
+    "}\n";
+
+  const std::string expectedMsg =
+    "Invalid value for option \"cs_policy\" in \"tables\" section";
+
+  BOOST_CHECK_EXCEPTION(runConfig(CONFIG, true),
+                        ConfigFile::Error,
+                        bind(&TablesConfigSectionFixture::validateException,
+                             this, _1, expectedMsg));
+
+  BOOST_CHECK_EXCEPTION(runConfig(CONFIG, false),
+                        ConfigFile::Error,
+                        bind(&TablesConfigSectionFixture::validateException,
+                             this, _1, expectedMsg));
+}
+
+BOOST_AUTO_TEST_CASE(ValidCsDiskTier)
+{
+  const std::string path =
+    (boost::filesystem::current_path() / "unit-test-tables-config-cs-disk").string();
+  boost::filesystem::remove(path);
+
+  const std::string CONFIG =
+    "tables\n"
+    "{\n"
+    "  cs_disk_path " + path + "\n"
+    "  cs_disk_max_bytes 65536\n"
+    "}\n";
+
+  BOOST_REQUIRE(m_cs.getDiskTier() == 0);
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, true));
+  BOOST_CHECK(m_cs.getDiskTier() == 0);
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  BOOST_REQUIRE(m_cs.getDiskTier() != 0);
+  BOOST_CHECK_EQUAL(m_cs.getDiskTier()->getPath(), path);
+  BOOST_CHECK_EQUAL(m_cs.getDiskTier()->getCapacity(), 65536);
+
+  const std::string CONFIG_DEFAULT =
+    "tables\n"
+    "{\n"
+    "}\n";
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG_DEFAULT, false));
+  BOOST_CHECK(m_cs.getDiskTier() == 0);
+
+  boost::filesystem::remove(path);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidValueCsDiskMaxBytes)
+{
+  const std::string CONFIG =
+    "tables\n"
+    "{\n"
+    "  cs_disk_max_bytes 0\n"
+    "}\n";
+
+  const std::string expectedMsg =
+    "Invalid value for option \"cs_disk_max_bytes\" in \"tables\" section";
+
+  BOOST_CHECK_EXCEPTION(runConfig(CONFIG, true),
+                        ConfigFile::Error,
+                        bind(&TablesConfigSectionFixture::validateException,
+                             this, _1, expectedMsg));
+
+  BOOST_CHECK_EXCEPTION(runConfig(CONFIG, false),
+                        ConfigFile::Error,
+                        bind(&TablesConfigSectionFixture::validateException,
+                             this, _1, expectedMsg));
+}
+
+BOOST_AUTO_TEST_CASE(InvalidCsDiskPath)
+{
+  const std::string path =
+    (boost::filesystem::current_path() / "unit-test-tables-config-no-such-dir" / "cs-disk").string();
+
+  const std::string CONFIG =
+    "tables\n"
+    "{\n"
+    "  cs_disk_path " + path + "\n"
+    "}\n";
+
+  // the directory is checked in dry-run too, but the file is never created
+  BOOST_CHECK_THROW(runConfig(CONFIG, true), ConfigFile::Error);
+  BOOST_CHECK(m_cs.getDiskTier() == 0);
+
+  BOOST_CHECK_THROW(runConfig(CONFIG, false), ConfigFile::Error);
+  BOOST_CHECK(m_cs.getDiskTier() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(TooSmallCsDiskMaxBytes)
+{
+  const std::string path =
+    (boost::filesystem::current_path() / "unit-test-tables-config-cs-disk").string();
+  boost::filesystem::remove(path);
+
+  const std::string CONFIG =
+    "tables\n"
+    "{\n"
+    "  cs_disk_path " + path + "\n"
+    "  cs_disk_max_bytes 1\n"
+    "}\n";
+
+  BOOST_CHECK_THROW(runConfig(CONFIG, true), ConfigFile::Error);
+  BOOST_CHECK(!boost::filesystem::exists(path));
+}
+
 class IgnoreNotTablesSection
 {
 public:
@@ -0,0 +1,228 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "table/cs-disk-tier.hpp"
+#include "table/cs.hpp"
+
+#include "tests/test-common.hpp"
+
+#include <boost/filesystem.hpp>
+
+namespace nfd {
+namespace tests {
+
+class CsDiskTierFixture : public BaseFixture
+{
+protected:
+  CsDiskTierFixture()
+    : m_path((boost::filesystem::current_path() / "unit-test-cs-disk-tier").string())
+  {
+    boost::filesystem::remove(m_path);
+  }
+
+  ~CsDiskTierFixture()
+  {
+    boost::filesystem::remove(m_path);
+  }
+
+  static shared_ptr<Data>
+  makeDataWithPayload(const Name& name, size_t payloadSize)
+  {
+    shared_ptr<Data> data = make_shared<Data>(name);
+    std::vector<uint8_t> payload(payloadSize, 0xBB);
+    data->setContent(&payload.front(), payload.size());
+    data->setFreshnessPeriod(time::seconds(3600));
+    return signData(data);
+  }
+
+protected:
+  std::string m_path;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TableCsDiskTier, CsDiskTierFixture)
+
+BOOST_AUTO_TEST_CASE(InsertFindErase)
+{
+  cs::DiskTier diskTier(m_path, 65536);
+  time::system_clock::TimePoint fresh = time::system_clock::now() + time::seconds(3600);
+  time::system_clock::TimePoint stale = time::system_clock::now() - time::seconds(1);
+
+  shared_ptr<Data> dataA = makeDataWithPayload("/A", 100);
+  shared_ptr<Data> dataB = makeDataWithPayload("/B", 100);
+  BOOST_CHECK_EQUAL(diskTier.insert(*dataA, fresh), true);
+  BOOST_CHECK_EQUAL(diskTier.insert(*dataA, fresh), false);
+  BOOST_CHECK_EQUAL(diskTier.insert(*dataB, stale), true);
+  BOOST_CHECK_EQUAL(diskTier.size(), 2);
+
+  time::system_clock::TimePoint staleAt;
+  shared_ptr<Data> found = diskTier.find("/A", false, staleAt);
+  BOOST_REQUIRE(static_cast<bool>(found));
+  BOOST_CHECK_EQUAL(found->getFullName(), dataA->getFullName());
+  BOOST_CHECK_EQUAL(time::toUnixTimestamp(staleAt).count(), time::toUnixTimestamp(fresh).count());
+
+  found = diskTier.find(dataA->getFullName(), true, staleAt);
+  BOOST_REQUIRE(static_cast<bool>(found));
+  BOOST_CHECK_EQUAL(found->getFullName(), dataA->getFullName());
+
+  BOOST_CHECK(static_cast<bool>(diskTier.find("/B", false, staleAt)));
+  BOOST_CHECK(!static_cast<bool>(diskTier.find("/B", true, staleAt)));
+  BOOST_CHECK(!static_cast<bool>(diskTier.find("/C", false, staleAt)));
+
+  diskTier.erase(dataA->getFullName());
+  BOOST_CHECK_EQUAL(diskTier.size(), 1);
+  BOOST_CHECK(!static_cast<bool>(diskTier.find("/A", false, staleAt)));
+}
+
+BOOST_AUTO_TEST_CASE(Wraparound)
+{
+  static const uint64_t CAPACITY = 16384;
+  cs::DiskTier diskTier(m_path, CAPACITY);
+  time::system_clock::TimePoint fresh = time::system_clock::now() + time::seconds(3600);
+
+  std::vector<shared_ptr<Data> > dataset;
+  for (int i = 0; i < 100; ++i) {
+    dataset.push_back(makeDataWithPayload(Name("/W").appendNumber(i), 700));
+    BOOST_CHECK_EQUAL(diskTier.insert(*dataset.back(), fresh), true);
+    BOOST_CHECK_LE(diskTier.getNBytes(), CAPACITY);
+  }
+
+  // the oldest records are overwritten, the newest are kept
+  time::system_clock::TimePoint staleAt;
+  BOOST_CHECK(!static_cast<bool>(diskTier.find(dataset.front()->getName(), false, staleAt)));
+  BOOST_CHECK(static_cast<bool>(diskTier.find(dataset.back()->getName(), false, staleAt)));
+  BOOST_CHECK_GT(diskTier.size(), 0);
+  BOOST_CHECK_LT(diskTier.size(), dataset.size());
+
+  // a Data larger than the file is rejected
+  BOOST_CHECK_EQUAL(diskTier.insert(*makeDataWithPayload("/big", CAPACITY), fresh), false);
+}
+
+BOOST_AUTO_TEST_CASE(Reopen)
+{
+  time::system_clock::TimePoint fresh = time::system_clock::now() + time::seconds(3600);
+  shared_ptr<Data> dataA = makeDataWithPayload("/A", 100);
+  shared_ptr<Data> dataB = makeDataWithPayload("/B", 100);
+  shared_ptr<Data> dataC = makeDataWithPayload("/C", 100);
+
+  {
+    cs::DiskTier diskTier(m_path, 65536);
+    diskTier.insert(*dataA, fresh);
+    diskTier.insert(*dataB, fresh);
+    diskTier.insert(*dataC, fresh);
+    diskTier.erase(dataB->getFullName());
+  }
+
+  time::system_clock::TimePoint staleAt;
+  {
+    cs::DiskTier diskTier(m_path, 65536);
+    BOOST_CHECK_EQUAL(diskTier.size(), 2);
+    BOOST_CHECK(static_cast<bool>(diskTier.find("/A", false, staleAt)));
+    BOOST_CHECK(!static_cast<bool>(diskTier.find("/B", false, staleAt)));
+    BOOST_CHECK(static_cast<bool>(diskTier.find("/C", false, staleAt)));
+  }
+
+  // another capacity reinitializes the file
+  {
+    cs::DiskTier diskTier(m_path, 32768);
+    BOOST_CHECK_EQUAL(diskTier.size(), 0);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(DemoteAndPromote)
+{
+  shared_ptr<Data> dataA = makeDataWithPayload("/A", 100);
+  shared_ptr<Data> dataB = makeDataWithPayload("/B", 100);
+  shared_ptr<Data> dataC = makeDataWithPayload("/C", 100);
+  shared_ptr<Data> dataU = makeDataWithPayload("/U", 100);
+
+  Cs cs(2);
+  cs.enableDiskTier(m_path, 65536);
+  BOOST_REQUIRE(cs.getDiskTier() != 0);
+
+  cs.insert(*dataU, true);
+  cs.insert(*dataA);
+  cs.insert(*dataB); // evicts unsolicited /U, which is not written to disk
+  cs.insert(*dataC); // evicts /A to disk
+  BOOST_CHECK_EQUAL(cs.size(), 2);
+
+  // the write is deferred to a scheduler event
+  BOOST_CHECK_EQUAL(cs.getDiskTier()->size(), 0);
+  g_io.poll();
+  g_io.reset();
+  BOOST_CHECK_EQUAL(cs.getDiskTier()->size(), 1);
+
+  // /A is promoted, evicting /B to disk
+  const Data* found = cs.find(Interest("/A"));
+  BOOST_REQUIRE(found != 0);
+  BOOST_CHECK_EQUAL(found->getFullName(), dataA->getFullName());
+  BOOST_CHECK_EQUAL(cs.size(), 2);
+  BOOST_CHECK_EQUAL(cs.getDiskTier()->size(), 1);
+
+  BOOST_CHECK(cs.find(Interest("/U")) == 0);
+
+  // Interests with selectors are not answered from disk
+  Interest interestB("/B");
+  interestB.setChildSelector(1);
+  BOOST_CHECK(cs.find(interestB) == 0);
+
+  // /B is found before it is written, and its promotion evicts /C
+  found = cs.find(Interest("/B"));
+  BOOST_REQUIRE(found != 0);
+  BOOST_CHECK_EQUAL(found->getFullName(), dataB->getFullName());
+
+  g_io.poll();
+  g_io.reset();
+  BOOST_CHECK_EQUAL(cs.getDiskTier()->size(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(WarmRestart)
+{
+  shared_ptr<Data> dataA = makeDataWithPayload("/A", 100);
+  shared_ptr<Data> dataB = makeDataWithPayload("/B", 100);
+
+  {
+    Cs cs(10);
+    cs.enableDiskTier(m_path, 65536);
+    cs.insert(*dataA);
+    cs.insert(*dataB);
+  }
+
+  Cs cs(10);
+  cs.enableDiskTier(m_path, 65536);
+  BOOST_CHECK_EQUAL(cs.size(), 0);
+  BOOST_CHECK_EQUAL(cs.getDiskTier()->size(), 2);
+
+  Interest interest(dataB->getFullName());
+  interest.setMustBeFresh(true);
+  const Data* found = cs.find(interest);
+  BOOST_REQUIRE(found != 0);
+  BOOST_CHECK_EQUAL(found->getFullName(), dataB->getFullName());
+  BOOST_CHECK_EQUAL(cs.size(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace nfd
@@ -0,0 +1,255 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "table/cs.hpp"
+#include "table/cs-policy-priority-fifo.hpp"
+#include "table/cs-policy-lru.hpp"
+#include "table/cs-policy-lfu.hpp"
+#include "table/cs-policy-arc.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nfd {
+namespace tests {
+
+BOOST_FIXTURE_TEST_SUITE(TableCsPolicy, BaseFixture)
+
+static bool
+isCached(Cs& cs, const Name& name)
+{
+  return cs.find(Interest(name)) != 0;
+}
+
+BOOST_AUTO_TEST_CASE(MakePolicy)
+{
+  BOOST_CHECK_EQUAL(cs::makePolicy("fifo")->getName(), "fifo");
+  BOOST_CHECK_EQUAL(cs::makePolicy("lru")->getName(), "lru");
+  BOOST_CHECK_EQUAL(cs::makePolicy("lfu")->getName(), "lfu");
+  BOOST_CHECK_EQUAL(cs::makePolicy("arc")->getName(), "arc");
+  BOOST_CHECK(!static_cast<bool>(cs::makePolicy("unknown")));
+
+  Cs cs;
+  BOOST_CHECK_EQUAL(cs.getPolicy().getName(), "fifo");
+}
+
+BOOST_AUTO_TEST_CASE(PriorityFifo)
+{
+  Cs cs(3);
+  cs.insert(*makeData("/a"));
+  cs.insert(*makeData("/b"));
+  cs.insert(*makeData("/c"));
+
+  // cache hit does not protect /a
+  BOOST_CHECK(isCached(cs, "/a"));
+  cs.insert(*makeData("/d"));
+
+  BOOST_CHECK(!isCached(cs, "/a"));
+  BOOST_CHECK(isCached(cs, "/b"));
+  BOOST_CHECK(isCached(cs, "/c"));
+  BOOST_CHECK(isCached(cs, "/d"));
+}
+
+BOOST_AUTO_TEST_CASE(PriorityFifoUnsolicited)
+{
+  Cs cs(3);
+  cs.insert(*makeData("/a"));
+  cs.insert(*makeData("/b"), true);
+  cs.insert(*makeData("/c"));
+  cs.insert(*makeData("/d"));
+
+  BOOST_CHECK(isCached(cs, "/a"));
+  BOOST_CHECK(!isCached(cs, "/b"));
+}
+
+BOOST_AUTO_TEST_CASE(Lru)
+{
+  Cs cs(3);
+  cs.setPolicy(make_shared<cs::LruPolicy>());
+  cs.insert(*makeData("/a"));
+  cs.insert(*makeData("/b"));
+  cs.insert(*makeData("/c"));
+
+  BOOST_CHECK(isCached(cs, "/a"));
+  cs.insert(*makeData("/d"));
+
+  BOOST_CHECK(isCached(cs, "/a"));
+  BOOST_CHECK(!isCached(cs, "/b"));
+  BOOST_CHECK(isCached(cs, "/c"));
+  BOOST_CHECK(isCached(cs, "/d"));
+}
+
+BOOST_AUTO_TEST_CASE(Lfu)
+{
+  Cs cs(3);
+  cs.setPolicy(make_shared<cs::LfuPolicy>());
+  cs.insert(*makeData("/a"));
+  cs.insert(*makeData("/b"));
+  cs.insert(*makeData("/c"));
+
+  BOOST_CHECK(isCached(cs, "/a"));
+  BOOST_CHECK(isCached(cs, "/a"));
+  BOOST_CHECK(isCached(cs, "/c"));
+
+  // /b has the smallest count
+  cs.insert(*makeData("/d"));
+  BOOST_CHECK(!isCached(cs, "/b"));
+
+  // /d has the smallest count, although it is the most recent
+  cs.insert(*makeData("/e"));
+  BOOST_CHECK(!isCached(cs, "/d"));
+  BOOST_CHECK(isCached(cs, "/a"));
+  BOOST_CHECK(isCached(cs, "/c"));
+  BOOST_CHECK(isCached(cs, "/e"));
+}
+
+BOOST_AUTO_TEST_CASE(Arc)
+{
+  Cs cs(3);
+  cs.setPolicy(make_shared<cs::ArcPolicy>());
+  const cs::ArcPolicy& policy = static_cast<const cs::ArcPolicy&>(cs.getPolicy());
+
+  shared_ptr<Data> dataA = makeData("/a");
+  shared_ptr<Data> dataB = makeData("/b");
+  shared_ptr<Data> dataC = makeData("/c");
+  shared_ptr<Data> dataD = makeData("/d");
+  cs.insert(*dataA);
+  cs.insert(*dataB);
+  cs.insert(*dataC);
+
+  // /a moves to T2
+  BOOST_CHECK(isCached(cs, "/a"));
+
+  // evicts /b from T1
+  cs.insert(*dataD);
+  BOOST_CHECK(!isCached(cs, "/b"));
+  BOOST_CHECK_EQUAL(policy.getTarget(), 0);
+
+  // evicts /c from T1; /b is found in B1, which grows the target size of T1
+  cs.insert(*dataB);
+  BOOST_CHECK_EQUAL(policy.getTarget(), 1);
+  BOOST_CHECK(!isCached(cs, "/c"));
+  BOOST_CHECK(isCached(cs, "/a"));
+  BOOST_CHECK(isCached(cs, "/b"));
+  BOOST_CHECK(isCached(cs, "/d"));
+}
+
+BOOST_AUTO_TEST_CASE(EraseByNameThenEvict)
+{
+  const char* POLICIES[] = { "fifo", "lru", "lfu", "arc" };
+  for (size_t i = 0; i < sizeof(POLICIES) / sizeof(POLICIES[0]); ++i)
+    {
+      Cs cs(2);
+      cs.setPolicy(cs::makePolicy(POLICIES[i]));
+
+      shared_ptr<Data> dataA = makeData("/a");
+      cs.insert(*dataA);
+      cs.insert(*makeData("/b"));
+      cs.erase(dataA->getFullName());
+      BOOST_CHECK_EQUAL(cs.size(), 1);
+
+      // the erased entry must not be chosen as a victim
+      cs.insert(*makeData("/c"));
+      cs.insert(*makeData("/d"));
+      cs.insert(*makeData("/e"));
+      BOOST_CHECK_EQUAL(cs.size(), 2);
+      BOOST_CHECK(isCached(cs, "/d"));
+      BOOST_CHECK(isCached(cs, "/e"));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(SetPolicyKeepsEntries)
+{
+  Cs cs(3);
+  cs.insert(*makeData("/a"));
+  cs.insert(*makeData("/b"));
+
+  cs.setPolicy(make_shared<cs::LruPolicy>());
+  BOOST_CHECK_EQUAL(cs.getPolicy().getName(), "lru");
+  BOOST_CHECK_EQUAL(cs.size(), 2);
+
+  BOOST_CHECK(isCached(cs, "/a"));
+  cs.insert(*makeData("/c"));
+  cs.insert(*makeData("/d"));
+  BOOST_CHECK(isCached(cs, "/a"));
+  BOOST_CHECK(!isCached(cs, "/b"));
+}
+
+BOOST_AUTO_TEST_CASE(SetIndexTypeKeepsArcState)
+{
+  Cs cs(3, Cs::INDEX_SKIP_LIST);
+  cs.setPolicy(make_shared<cs::ArcPolicy>());
+  const cs::ArcPolicy& policy = static_cast<const cs::ArcPolicy&>(cs.getPolicy());
+
+  cs.insert(*makeData("/a"));
+  cs.insert(*makeData("/b"));
+  cs.insert(*makeData("/c"));
+
+  // /a moves to T2
+  BOOST_CHECK(isCached(cs, "/a"));
+
+  // entries stay in their lists, and nothing goes to B1 or B2
+  cs.setIndexType(Cs::INDEX_BTREE);
+  cs.setIndexType(Cs::INDEX_SKIP_LIST);
+  BOOST_CHECK_EQUAL(cs.size(), 3);
+  BOOST_CHECK_EQUAL(policy.getTarget(), 0);
+
+  // evicts /b from T1
+  cs.insert(*makeData("/d"));
+  BOOST_CHECK_EQUAL(policy.getTarget(), 0);
+  BOOST_CHECK(!isCached(cs, "/b"));
+  BOOST_CHECK(isCached(cs, "/a"));
+  BOOST_CHECK(isCached(cs, "/c"));
+  BOOST_CHECK(isCached(cs, "/d"));
+}
+
+BOOST_AUTO_TEST_CASE(SetIndexTypeKeepsLfuCounts)
+{
+  Cs cs(3, Cs::INDEX_BTREE);
+  cs.setPolicy(make_shared<cs::LfuPolicy>());
+
+  cs.insert(*makeData("/a"));
+  cs.insert(*makeData("/b"));
+  cs.insert(*makeData("/c"));
+
+  BOOST_CHECK(isCached(cs, "/a"));
+  BOOST_CHECK(isCached(cs, "/a"));
+  BOOST_CHECK(isCached(cs, "/c"));
+
+  cs.setIndexType(Cs::INDEX_SKIP_LIST);
+  cs.setIndexType(Cs::INDEX_BTREE);
+  BOOST_CHECK_EQUAL(cs.size(), 3);
+
+  // /b still has the smallest count
+  cs.insert(*makeData("/d"));
+  BOOST_CHECK(!isCached(cs, "/b"));
+  BOOST_CHECK(isCached(cs, "/a"));
+  BOOST_CHECK(isCached(cs, "/c"));
+  BOOST_CHECK(isCached(cs, "/d"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace nfd
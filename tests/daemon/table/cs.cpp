@@ -62,6 +62,74 @@ BOOST_AUTO_TEST_CASE(SetLimit)
   BOOST_CHECK_EQUAL(cs.size(), 2);
 }
 
+static shared_ptr<Data>
+makeDataWithPayload(const Name& name, size_t payloadSize)
+{
+  shared_ptr<Data> data = make_shared<Data>(name);
+  std::vector<uint8_t> payload(payloadSize, 0xBB);
+  data->setContent(&payload.front(), payload.size());
+  return signData(data);
+}
+
+BOOST_AUTO_TEST_CASE(SetByteLimit)
+{
+  Cs cs(100);
+  BOOST_CHECK_EQUAL(cs.getByteLimit(), std::numeric_limits<size_t>::max());
+  BOOST_CHECK_EQUAL(cs.getNBytes(), 0);
+
+  shared_ptr<Data> data1 = makeDataWithPayload("/1", 1000);
+  shared_ptr<Data> data2 = makeDataWithPayload("/2", 1000);
+  shared_ptr<Data> data3 = makeDataWithPayload("/3", 1000);
+  size_t entrySize = Cs::getEntrySize(*data1);
+  BOOST_CHECK_GT(entrySize, data1->wireEncode().size());
+
+  BOOST_CHECK_EQUAL(cs.insert(*data1), true);
+  BOOST_CHECK_EQUAL(cs.insert(*data2), true);
+  BOOST_CHECK_EQUAL(cs.getNBytes(), Cs::getEntrySize(*data1) + Cs::getEntrySize(*data2));
+
+  // duplicate does not change byte count
+  BOOST_CHECK_EQUAL(cs.insert(*data2), false);
+  BOOST_CHECK_EQUAL(cs.getNBytes(), Cs::getEntrySize(*data1) + Cs::getEntrySize(*data2));
+
+  // shrinking the byte limit evicts
+  cs.setByteLimit(entrySize + entrySize / 2);
+  BOOST_CHECK_EQUAL(cs.size(), 1);
+  BOOST_CHECK_LE(cs.getNBytes(), cs.getByteLimit());
+
+  // insertion evicts until the new Data fits
+  BOOST_CHECK_EQUAL(cs.insert(*data3), true);
+  BOOST_CHECK_EQUAL(cs.size(), 1);
+  BOOST_CHECK_EQUAL(cs.getNBytes(), Cs::getEntrySize(*data3));
+
+  // Data larger than the byte limit is not stored
+  shared_ptr<Data> big = makeDataWithPayload("/big", 4000);
+  BOOST_CHECK_EQUAL(cs.insert(*big), false);
+  BOOST_CHECK_EQUAL(cs.size(), 1);
+
+  cs.erase(data3->getFullName());
+  BOOST_CHECK_EQUAL(cs.size(), 0);
+  BOOST_CHECK_EQUAL(cs.getNBytes(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(ByteCountBTreeIndex)
+{
+  Cs cs(100, Cs::INDEX_BTREE);
+
+  shared_ptr<Data> data1 = makeDataWithPayload("/1", 500);
+  shared_ptr<Data> data2 = makeDataWithPayload("/2", 1500);
+  BOOST_CHECK_EQUAL(cs.insert(*data1), true);
+  BOOST_CHECK_EQUAL(cs.insert(*data2), true);
+  BOOST_CHECK_EQUAL(cs.insert(*data2), false);
+  BOOST_CHECK_EQUAL(cs.getNBytes(), Cs::getEntrySize(*data1) + Cs::getEntrySize(*data2));
+
+  cs.setIndexType(Cs::INDEX_SKIP_LIST);
+  BOOST_CHECK_EQUAL(cs.getNBytes(), Cs::getEntrySize(*data1) + Cs::getEntrySize(*data2));
+
+  cs.setByteLimit(Cs::getEntrySize(*data2));
+  BOOST_CHECK_EQUAL(cs.size(), 1);
+  BOOST_CHECK_EQUAL(cs.getNBytes(), Cs::getEntrySize(*data2));
+}
+
 BOOST_AUTO_TEST_CASE(Insertion)
 {
   Cs cs;
@@ -596,6 +664,142 @@ BOOST_AUTO_TEST_CASE(ExcludeSelector)
   BOOST_CHECK_EQUAL(found3->getName(), "/c/a");
 }
 
+BOOST_AUTO_TEST_CASE(BTreeIndexInsertFindErase)
+{
+  Cs cs(1000, Cs::INDEX_BTREE);
+  BOOST_CHECK_EQUAL(cs.getIndexType(), Cs::INDEX_BTREE);
+
+  // enough entries to split and merge leaf nodes
+  std::vector<shared_ptr<Data> > dataset;
+  for (int i = 0; i < 600; ++i) {
+    Name name("/btree");
+    name.appendNumber((i * 7919) % 600);
+    dataset.push_back(makeData(name));
+    BOOST_CHECK_EQUAL(cs.insert(*dataset.back()), true);
+  }
+  BOOST_CHECK_EQUAL(cs.size(), 600);
+  BOOST_CHECK_EQUAL(cs.insert(*dataset[0]), false);
+  BOOST_CHECK_EQUAL(cs.size(), 600);
+
+  for (int i = 0; i < 600; ++i) {
+    Interest interest(dataset[i]->getName());
+    BOOST_CHECK_EQUAL(cs.find(interest), dataset[i].get());
+  }
+
+  for (int i = 0; i < 600; i += 2) {
+    cs.erase(dataset[i]->getFullName());
+  }
+  BOOST_CHECK_EQUAL(cs.size(), 300);
+
+  for (int i = 0; i < 600; ++i) {
+    Interest interest(dataset[i]->getName());
+    BOOST_CHECK_EQUAL(cs.find(interest), i % 2 == 0 ? 0 : dataset[i].get());
+  }
+
+  cs.setIndexType(Cs::INDEX_SKIP_LIST);
+  BOOST_CHECK_EQUAL(cs.size(), 300);
+  Interest interest(dataset[1]->getName());
+  BOOST_CHECK_EQUAL(cs.find(interest), dataset[1].get());
+}
+
+BOOST_AUTO_TEST_CASE(BTreeIndexMatchesSkipList)
+{
+  Cs skipListCs(1000, Cs::INDEX_SKIP_LIST);
+  Cs bTreeCs(1000, Cs::INDEX_BTREE);
+
+  static const char* COMPONENTS[] = {"A", "B", "CC"};
+  std::vector<Name> names(1, Name());
+  for (size_t i = 0; i < names.size() && names.size() < 40; ++i) {
+    for (size_t j = 0; j < 3; ++j) {
+      names.push_back(Name(names[i]).append(COMPONENTS[j]));
+    }
+  }
+
+  std::vector<shared_ptr<Data> > dataset;
+  for (size_t i = 1; i < names.size(); i += 2) {
+    dataset.push_back(makeData(names[i]));
+    skipListCs.insert(*dataset.back());
+    bTreeCs.insert(*dataset.back());
+  }
+  BOOST_CHECK_EQUAL(skipListCs.size(), bTreeCs.size());
+
+  std::vector<Name> interestNames = names;
+  for (size_t i = 0; i < dataset.size(); ++i) {
+    interestNames.push_back(dataset[i]->getFullName());
+  }
+
+  for (size_t i = 0; i < interestNames.size(); ++i) {
+    for (int childSelector = 0; childSelector <= 1; ++childSelector) {
+      for (int minSuffix = -1; minSuffix <= 2; ++minSuffix) {
+        for (int maxSuffix = -1; maxSuffix <= 2; ++maxSuffix) {
+          Interest interest(interestNames[i]);
+          interest.setChildSelector(childSelector);
+          interest.setMinSuffixComponents(minSuffix);
+          interest.setMaxSuffixComponents(maxSuffix);
+          BOOST_CHECK_MESSAGE(skipListCs.find(interest) == bTreeCs.find(interest),
+                              "find() differs for " << interest);
+        }
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ExactMatchAgreesWithOrderedLookup)
+{
+  static const Cs::IndexType INDEX_TYPES[] = {Cs::INDEX_SKIP_LIST, Cs::INDEX_BTREE};
+  for (size_t t = 0; t < 2; ++t) {
+    Cs cs(1000, INDEX_TYPES[t]);
+
+    static const char* COMPONENTS[] = {"A", "B", "CCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCC"};
+    std::vector<Name> names(1, Name());
+    for (size_t i = 0; i < names.size() && names.size() < 40; ++i) {
+      for (size_t j = 0; j < 3; ++j) {
+        names.push_back(Name(names[i]).append(COMPONENTS[j]));
+      }
+    }
+
+    // two Data with the same Name but different digests, half of them fresh
+    std::vector<shared_ptr<Data> > dataset;
+    for (size_t i = 1; i < names.size(); i += 2) {
+      for (uint8_t version = 0; version < 2; ++version) {
+        shared_ptr<Data> data = make_shared<Data>(names[i]);
+        data->setContent(&version, 1);
+        if ((i + version) % 2 == 0) {
+          data->setFreshnessPeriod(time::seconds(3600));
+        }
+        dataset.push_back(signData(data));
+        cs.insert(*data);
+      }
+    }
+
+    std::vector<Name> interestNames = names;
+    for (size_t i = 0; i < dataset.size(); ++i) {
+      interestNames.push_back(dataset[i]->getFullName());
+    }
+
+    for (size_t i = 0; i < interestNames.size(); ++i) {
+      for (int mustBeFresh = 0; mustBeFresh <= 1; ++mustBeFresh) {
+        Interest exactInterest(interestNames[i]);
+        exactInterest.setMustBeFresh(mustBeFresh);
+
+        // MaxSuffixComponents admits every Data, but forces the ordered lookup
+        Interest orderedInterest(interestNames[i]);
+        orderedInterest.setMustBeFresh(mustBeFresh);
+        orderedInterest.setMaxSuffixComponents(100);
+
+        BOOST_CHECK_MESSAGE(cs.find(exactInterest) == cs.find(orderedInterest),
+                            "find() differs for " << exactInterest);
+      }
+    }
+
+    // erased entries are removed from the exact name index
+    for (size_t i = 0; i < dataset.size(); ++i) {
+      cs.erase(dataset[i]->getFullName());
+      BOOST_CHECK(cs.find(Interest(dataset[i]->getFullName())) == 0);
+    }
+  }
+}
+
 //
 
 class FindFixture : protected BaseFixture
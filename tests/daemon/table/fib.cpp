@@ -264,6 +264,43 @@ BOOST_AUTO_TEST_CASE(RemoveNextHopFromAllEntries)
   BOOST_CHECK_EQUAL(entry->getPrefix(), nameEmpty);
 }
 
+// the face index stays consistent when nexthops and entries are removed individually
+BOOST_AUTO_TEST_CASE(RemoveNextHopFromAllEntriesAfterChurn)
+{
+  shared_ptr<Face> face1 = make_shared<DummyFace>();
+  shared_ptr<Face> face2 = make_shared<DummyFace>();
+
+  NameTree nameTree;
+  Fib fib(nameTree);
+
+  std::vector<shared_ptr<fib::Entry> > entries;
+  for (int i = 0; i < 10; ++i) {
+    shared_ptr<fib::Entry> entry = fib.insert(Name("/F").appendNumber(i)).first;
+    entry->addNextHop(face1, 0);
+    entry->addNextHop(face2, 1);
+    entries.push_back(entry);
+  }
+  BOOST_CHECK_EQUAL(fib.size(), 10);
+
+  entries[0]->removeNextHop(face1);
+  entries[4]->removeNextHop(face1);
+  entries[4]->addNextHop(face1, 2);
+  fib.erase(*entries[7]);
+  BOOST_CHECK_EQUAL(fib.size(), 9);
+
+  // an erased entry is not visited even if it is still referenced
+  fib.removeNextHopFromAllEntries(face1);
+  BOOST_CHECK_EQUAL(fib.size(), 9);
+  BOOST_CHECK(entries[7]->hasNextHop(face1));
+  for (int i = 0; i < 10; ++i) {
+    BOOST_CHECK(!entries[i]->hasNextHop(face1) || i == 7);
+    BOOST_CHECK(entries[i]->hasNextHop(face2));
+  }
+
+  fib.removeNextHopFromAllEntries(face2);
+  BOOST_CHECK_EQUAL(fib.size(), 0);
+}
+
 void
 validateFindExactMatch(const Fib& fib, const Name& target)
 {
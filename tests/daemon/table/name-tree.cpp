@@ -44,6 +44,19 @@ BOOST_AUTO_TEST_CASE(Hash)
   prefix.wireEncode();
   std::vector<size_t> hashSet = name_tree::computeHashSet(prefix);
   BOOST_CHECK_EQUAL(hashSet.size(), prefix.size() + 1);
+  for (size_t i = 0; i <= prefix.size(); ++i) {
+    BOOST_CHECK_EQUAL(hashSet[i], name_tree::computeHash(prefix.getPrefix(i)));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(HashOrderSensitive)
+{
+  BOOST_CHECK_NE(name_tree::computeHash("/a/b"), name_tree::computeHash("/b/a"));
+  BOOST_CHECK_NE(name_tree::computeHash("/a/a"), name_tree::computeHash("/"));
+  BOOST_CHECK_NE(name_tree::computeHash("/seg/1/seg/2"),
+                 name_tree::computeHash("/seg/2/seg/1"));
+  BOOST_CHECK_NE(name_tree::computeHash("/seg/1/seg/1"),
+                 name_tree::computeHash("/seg/2/seg/2"));
 }
 
 BOOST_AUTO_TEST_CASE(Entry)
@@ -784,6 +797,80 @@ BOOST_AUTO_TEST_CASE(IteratorFindAllMatches)
   BOOST_CHECK_EQUAL(counter, 7);
 }
 
+BOOST_AUTO_TEST_CASE(LookupContext)
+{
+  NameTree nt(16);
+
+  Name nameABC("/a/b/c");
+  name_tree::LookupContext contextABC(nameABC);
+  BOOST_CHECK_EQUAL(contextABC.getName(), nameABC);
+  BOOST_CHECK(contextABC.getHashSet() == name_tree::computeHashSet(nameABC));
+  BOOST_CHECK_EQUAL(contextABC.getHash(2), name_tree::computeHash("/a/b"));
+
+  shared_ptr<name_tree::Entry> entryABC = nt.lookup(contextABC);
+  BOOST_CHECK_EQUAL(entryABC->getPrefix(), nameABC);
+  BOOST_CHECK_EQUAL(nt.size(), 4);
+  BOOST_CHECK_EQUAL(nt.lookup(nameABC), entryABC);
+  BOOST_CHECK_EQUAL(nt.findExactMatch("/a/b")->getHash(), contextABC.getHash(2));
+
+  Name nameABCD("/a/b/c/d");
+  name_tree::LookupContext contextABCD(nameABCD);
+  BOOST_CHECK_EQUAL(nt.findLongestPrefixMatch(contextABCD), entryABC);
+  BOOST_CHECK_EQUAL(nt.findLongestPrefixMatch(contextABCD),
+                    nt.findLongestPrefixMatch(nameABCD));
+
+  int counter = 0;
+  for (NameTree::const_iterator it = nt.findAllMatches(contextABCD); it != nt.end(); ++it) {
+    ++counter;
+  }
+  BOOST_CHECK_EQUAL(counter, 4);
+}
+
+static bool
+predicate_hasTwoOrSixComponents(const name_tree::Entry& entry)
+{
+  return entry.getPrefix().size() == 2 ||
+         entry.getPrefix().size() == 6;
+}
+
+BOOST_AUTO_TEST_CASE(LongestPrefixMatchByLength)
+{
+  NameTree nameTree(16);
+  BOOST_CHECK(!static_cast<bool>(nameTree.findLongestPrefixMatchByLength(
+                                   name_tree::LookupContext("/a"))));
+
+  nameTree.lookup("/a/b/c/d/e/f/g/h/i/j/k/l/m/n/o/p");
+  nameTree.lookup("/a/b/x");
+  nameTree.lookup("/q");
+
+  const char* names[] = {
+    "/",
+    "/a",
+    "/a/b/c/d/e/f/g/h/i/j/k/l/m/n/o/p",
+    "/a/b/c/d/e/f/g/h/i/j/k/l/m/n/o/p/q/r",
+    "/a/b/c/d/e/f/x/y/z",
+    "/a/b/x/y",
+    "/a/y/z",
+    "/q/r/s/t/u/v/w",
+    "/z/a/b",
+  };
+  for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); ++i) {
+    Name name(names[i]);
+    name_tree::LookupContext context(name);
+
+    BOOST_CHECK_EQUAL(nameTree.findLongestPrefixMatchByLength(context),
+                      nameTree.findLongestPrefixMatch(context));
+    BOOST_CHECK_EQUAL(nameTree.findLongestPrefixMatchByLength(context,
+                                                              &predicate_hasTwoOrSixComponents),
+                      nameTree.findLongestPrefixMatch(context,
+                                                      &predicate_hasTwoOrSixComponents));
+  }
+
+  BOOST_CHECK_EQUAL(nameTree.findLongestPrefixMatchByLength(
+                      name_tree::LookupContext("/a/b/c/d/e/f/x/y/z"))->getPrefix(),
+                    Name("/a/b/c/d/e/f"));
+}
+
 BOOST_AUTO_TEST_CASE(HashTableResizeShrink)
 {
   size_t nBuckets = 16;
@@ -800,6 +887,87 @@ BOOST_AUTO_TEST_CASE(HashTableResizeShrink)
   BOOST_CHECK_EQUAL(nameTree.getNBuckets(), 16);
 }
 
+// entries stay reachable and enumerable while the hash table is resized
+BOOST_AUTO_TEST_CASE(HashTableIncrementalResize)
+{
+  NameTree nameTree(16);
+
+  std::vector<shared_ptr<name_tree::Entry> > entries;
+  for (int i = 0; i < 200; ++i) {
+    Name name("/resize");
+    name.appendNumber(i);
+    entries.push_back(nameTree.lookup(name));
+
+    size_t nFound = 0;
+    for (size_t j = 0; j < entries.size(); ++j) {
+      nFound += nameTree.findExactMatch(entries[j]->getPrefix()) == entries[j];
+    }
+    BOOST_CHECK_EQUAL(nFound, entries.size());
+
+    std::set<Name> seenNames;
+    for (NameTree::const_iterator it = nameTree.begin(); it != nameTree.end(); ++it) {
+      BOOST_CHECK(seenNames.insert(it->getPrefix()).second);
+    }
+    BOOST_CHECK_EQUAL(seenNames.size(), nameTree.size());
+  }
+  BOOST_CHECK_EQUAL(nameTree.size(), 202);
+  BOOST_CHECK_EQUAL(nameTree.getNBuckets(), 512);
+
+  while (!entries.empty()) {
+    BOOST_CHECK(nameTree.eraseEntryIfEmpty(entries.back()));
+    entries.pop_back();
+
+    size_t nFound = 0;
+    for (size_t j = 0; j < entries.size(); ++j) {
+      nFound += nameTree.findExactMatch(entries[j]->getPrefix()) == entries[j];
+    }
+    BOOST_CHECK_EQUAL(nFound, entries.size());
+  }
+  BOOST_CHECK_EQUAL(nameTree.size(), 0);
+  BOOST_CHECK_EQUAL(nameTree.getNBuckets(), 16);
+}
+
+// entries stay reachable after repeated inserts and erases
+BOOST_AUTO_TEST_CASE(HashTableChurn)
+{
+  NameTree nameTree(16);
+  nameTree.lookup("/");
+
+  std::vector<shared_ptr<name_tree::Entry> > entries;
+  for (int round = 0; round < 50; ++round) {
+    for (int i = 0; i < 5; ++i) {
+      Name name("/churn");
+      name.appendNumber(round).appendNumber(i);
+      entries.push_back(nameTree.lookup(name));
+    }
+
+    // erase three of the five names inserted in this round
+    for (int i = 0; i < 3; ++i) {
+      BOOST_CHECK(nameTree.eraseEntryIfEmpty(entries.back()));
+      entries.pop_back();
+    }
+  }
+
+  BOOST_CHECK_EQUAL(nameTree.size(), 1 + 1 + 50 * 3); // "/", "/churn", 50 * (round + 2 names)
+
+  for (std::vector<shared_ptr<name_tree::Entry> >::iterator it = entries.begin();
+       it != entries.end(); ++it) {
+    BOOST_CHECK_EQUAL(nameTree.findExactMatch((*it)->getPrefix()), *it);
+  }
+
+  Name erased("/churn");
+  erased.appendNumber(49).appendNumber(4);
+  BOOST_CHECK(!static_cast<bool>(nameTree.findExactMatch(erased)));
+  BOOST_CHECK_EQUAL(nameTree.findLongestPrefixMatch(erased)->getPrefix(),
+                    erased.getPrefix(-1));
+
+  size_t nEnumerated = 0;
+  for (NameTree::const_iterator it = nameTree.begin(); it != nameTree.end(); ++it) {
+    ++nEnumerated;
+  }
+  BOOST_CHECK_EQUAL(nEnumerated, nameTree.size());
+}
+
 // .lookup should not invalidate iterator
 BOOST_AUTO_TEST_CASE(SurvivedIteratorAfterLookup)
 {
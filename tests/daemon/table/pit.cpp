@@ -54,6 +54,30 @@ BOOST_AUTO_TEST_CASE(NonceList)
   BOOST_CHECK_EQUAL(nl.size(), pit::NonceList::CAPACITY);
 }
 
+BOOST_AUTO_TEST_CASE(NonceListEviction)
+{
+  const uint32_t capacity = static_cast<uint32_t>(pit::NonceList::CAPACITY);
+
+  pit::NonceList nl;
+  for (uint32_t nonce = 0; nonce < capacity * 3; ++nonce) {
+    BOOST_CHECK_EQUAL(nl.add(nonce), true);
+    BOOST_CHECK_EQUAL(nl.add(nonce), false);
+  }
+  BOOST_CHECK_EQUAL(nl.size(), pit::NonceList::CAPACITY);
+
+  // the most recent nonces are kept
+  for (uint32_t nonce = capacity * 2 + 1; nonce < capacity * 3; ++nonce) {
+    BOOST_CHECK_EQUAL(nl.add(nonce), false);
+  }
+
+  // the oldest nonces are evicted first
+  BOOST_CHECK_EQUAL(nl.add(0), true); // evicts capacity*2
+  BOOST_CHECK_EQUAL(nl.add(capacity * 2 + 1), false);
+  BOOST_CHECK_EQUAL(nl.add(capacity * 2), true); // evicts capacity*2+1
+  BOOST_CHECK_EQUAL(nl.add(capacity * 2 + 1), true);
+  BOOST_CHECK_EQUAL(nl.size(), pit::NonceList::CAPACITY);
+}
+
 BOOST_AUTO_TEST_CASE(EntryInOutRecords)
 {
   shared_ptr<Face> face1 = make_shared<DummyFace>();
@@ -169,6 +193,41 @@ BOOST_AUTO_TEST_CASE(EntryInOutRecords)
   BOOST_CHECK(entry.getOutRecord(face2) == entry.getOutRecords().end());
 }
 
+BOOST_AUTO_TEST_CASE(EntryManyInOutRecords)
+{
+  // more faces than the inline capacity of record collections
+  static const size_t N_FACES = 5;
+  std::vector<shared_ptr<Face> > faces;
+  for (size_t i = 0; i < N_FACES; ++i)
+    faces.push_back(make_shared<DummyFace>());
+
+  shared_ptr<Interest> interest = makeInterest("ndn:/Yp9sJlRe");
+  pit::Entry entry(*interest);
+  for (size_t i = 0; i < N_FACES; ++i)
+    {
+      entry.insertOrUpdateInRecord(faces[i], *interest);
+      entry.insertOrUpdateOutRecord(faces[i], *interest);
+    }
+  BOOST_CHECK_EQUAL(entry.getInRecords().size(), N_FACES);
+  BOOST_CHECK_EQUAL(entry.getOutRecords().size(), N_FACES);
+
+  for (size_t i = 0; i < N_FACES; ++i)
+    {
+      pit::InRecordCollection::const_iterator inIt = entry.getInRecord(faces[i]);
+      BOOST_REQUIRE(inIt != entry.getInRecords().end());
+      BOOST_CHECK_EQUAL(inIt->getFace(), faces[i]);
+    }
+
+  entry.deleteOutRecord(faces[1]);
+  BOOST_CHECK_EQUAL(entry.getOutRecords().size(), N_FACES - 1);
+  BOOST_CHECK(entry.getOutRecord(faces[1]) == entry.getOutRecords().end());
+  for (size_t i = 2; i < N_FACES; ++i)
+    BOOST_CHECK(entry.getOutRecord(faces[i]) != entry.getOutRecords().end());
+
+  entry.deleteInRecords();
+  BOOST_CHECK_EQUAL(faces[0].use_count(), 2); // faces, and the remaining OutRecord
+}
+
 BOOST_AUTO_TEST_CASE(EntryNonce)
 {
   shared_ptr<Interest> interest = makeInterest("ndn:/qtCQ7I1c");
@@ -364,6 +423,50 @@ BOOST_AUTO_TEST_CASE(EraseNameTreeEntry)
   BOOST_CHECK_EQUAL(nameTree.size(), nNameTreeEntriesBefore);
 }
 
+BOOST_AUTO_TEST_CASE(DeleteInOutRecords)
+{
+  shared_ptr<Face> face1 = make_shared<DummyFace>();
+  shared_ptr<Face> face2 = make_shared<DummyFace>();
+
+  NameTree nameTree;
+  Pit pit(nameTree);
+
+  std::vector<shared_ptr<pit::Entry> > entries;
+  for (int i = 0; i < 10; ++i) {
+    shared_ptr<Interest> interest = makeInterest(Name("/P").appendNumber(i));
+    shared_ptr<pit::Entry> entry = pit.insert(*interest).first;
+    entry->insertOrUpdateInRecord(face1, *interest);
+    entry->insertOrUpdateInRecord(face2, *interest);
+    entry->insertOrUpdateOutRecord(face1, *interest);
+    entries.push_back(entry);
+  }
+
+  entries[0]->deleteInRecords();
+  entries[3]->deleteOutRecord(face1);
+  entries[5]->deleteInRecord(face1);
+  pit.erase(entries[8]);
+
+  pit.deleteInOutRecords(face1);
+  for (int i = 0; i < 10; ++i) {
+    const pit::Entry& entry = *entries[i];
+    if (i == 8) {
+      // an erased entry is not visited even if it is still referenced
+      BOOST_CHECK(entry.getInRecord(face1) != entry.getInRecords().end());
+      BOOST_CHECK(entry.getOutRecord(face1) != entry.getOutRecords().end());
+      continue;
+    }
+    BOOST_CHECK(entry.getInRecord(face1) == entry.getInRecords().end());
+    BOOST_CHECK(entry.getOutRecord(face1) == entry.getOutRecords().end());
+    BOOST_CHECK_EQUAL(entry.getInRecord(face2) != entry.getInRecords().end(), i != 0);
+  }
+  BOOST_CHECK_EQUAL(pit.size(), 9);
+
+  pit.deleteInOutRecords(face2);
+  for (int i = 0; i < 10; ++i) {
+    BOOST_CHECK_EQUAL(entries[i]->getInRecords().size(), i == 8 ? 2 : 0);
+  }
+}
+
 BOOST_AUTO_TEST_CASE(FindAllDataMatches)
 {
   Name nameA   ("ndn:/A");
@@ -0,0 +1,136 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Measures how long it takes for the Content Store disk tier to become usable
+// after a restart, i.e. to rebuild its index from record headers.
+//
+// usage: cs-disk-tier-benchmark file [n-objects]
+//
+// The file is filled with n-objects small Data packets (default 10000000),
+// closed, and reopened; then a sample of the Data is looked up.
+
+#include "table/cs-disk-tier.hpp"
+
+#include <ndn-cxx/security/signature-sha256-with-rsa.hpp>
+
+#include <boost/lexical_cast.hpp>
+
+namespace nfd {
+
+static const size_t DEFAULT_N_OBJECTS = 10000000;
+/// bytes reserved per object, including RecordHeader and padding
+static const uint64_t BYTES_PER_OBJECT = 256;
+static const size_t N_LOOKUPS = 100000;
+
+static ndn::SignatureSha256WithRsa
+makeFakeSignature()
+{
+  ndn::SignatureSha256WithRsa fakeSignature;
+  fakeSignature.setValue(ndn::dataBlock(tlv::SignatureValue,
+                                        reinterpret_cast<const uint8_t*>(0), 0));
+  return fakeSignature;
+}
+
+static Name
+makeObjectName(size_t i)
+{
+  Name name("/benchmark/disk");
+  name.appendNumber(i);
+  return name;
+}
+
+static time::duration<double, boost::milli>
+elapsedSince(const time::steady_clock::TimePoint& startTime)
+{
+  return time::duration_cast<time::duration<double, boost::milli> >(
+           time::steady_clock::now() - startTime);
+}
+
+static void
+fill(const std::string& path, size_t nObjects)
+{
+  static const uint8_t CONTENT[64] = {};
+  const ndn::SignatureSha256WithRsa fakeSignature = makeFakeSignature();
+  time::system_clock::TimePoint staleAt = time::system_clock::now() + time::seconds(3600);
+
+  time::steady_clock::TimePoint startTime = time::steady_clock::now();
+  cs::DiskTier diskTier(path, nObjects * BYTES_PER_OBJECT);
+  for (size_t i = 0; i < nObjects; ++i)
+    {
+      Data data(makeObjectName(i));
+      data.setContent(CONTENT, sizeof(CONTENT));
+      data.setSignature(fakeSignature);
+      diskTier.insert(data, staleAt);
+    }
+  diskTier.sync();
+
+  std::cout << "fill: " << diskTier.size() << " objects, "
+            << diskTier.getNBytes() << " bytes, "
+            << elapsedSince(startTime) << std::endl;
+}
+
+static void
+reopen(const std::string& path, size_t nObjects)
+{
+  time::steady_clock::TimePoint startTime = time::steady_clock::now();
+  cs::DiskTier diskTier(path, nObjects * BYTES_PER_OBJECT);
+  std::cout << "reopen: " << diskTier.size() << " objects indexed in "
+            << elapsedSince(startTime) << std::endl;
+
+  size_t nLookups = std::min(N_LOOKUPS, nObjects);
+  size_t nHits = 0;
+  time::system_clock::TimePoint staleAt;
+  startTime = time::steady_clock::now();
+  for (size_t i = 0; i < nLookups; ++i)
+    {
+      if (static_cast<bool>(diskTier.find(makeObjectName(i * (nObjects / nLookups)),
+                                          true, staleAt)))
+        ++nHits;
+    }
+  std::cout << "lookup: " << nHits << "/" << nLookups << " hits in "
+            << elapsedSince(startTime) << std::endl;
+}
+
+} // namespace nfd
+
+int
+main(int argc, char** argv)
+{
+  if (argc < 2)
+    {
+      std::cerr << "usage: " << argv[0] << " file [n-objects]" << std::endl;
+      return 2;
+    }
+
+  std::string path = argv[1];
+  size_t nObjects = nfd::DEFAULT_N_OBJECTS;
+  if (argc > 2)
+    nObjects = boost::lexical_cast<size_t>(argv[2]);
+
+  nfd::fill(path, nObjects);
+  nfd::reopen(path, nObjects);
+
+  return 0;
+}
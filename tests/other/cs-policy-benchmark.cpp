@@ -0,0 +1,206 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Replays a request trace through Content Store under each replacement policy,
+// and reports hit ratio and per-request latency.
+//
+// usage: cs-policy-benchmark [trace-file]
+//
+// The trace file contains one Name per line. Without a trace file, a synthetic
+// trace with Zipf-distributed popularity and periodic one-off scans is generated.
+
+#include "table/cs.hpp"
+#include "core/random.hpp"
+
+#include <ndn-cxx/security/signature-sha256-with-rsa.hpp>
+
+#include <boost/random/uniform_real_distribution.hpp>
+
+#include <cmath>
+#include <fstream>
+
+namespace nfd {
+
+static const size_t N_CATALOG = 100000;
+static const size_t N_REQUESTS = 1000000;
+static const double ZIPF_ALPHA = 0.8;
+/// every SCAN_PERIOD requests, SCAN_LENGTH names that are never requested again
+static const size_t SCAN_PERIOD = 50000;
+static const size_t SCAN_LENGTH = 2000;
+
+/** \brief trace of requests; each request is an index into the Data catalog
+ */
+struct Trace
+{
+  std::vector<shared_ptr<Data> > catalog;
+  std::vector<shared_ptr<Interest> > interests;
+  std::vector<size_t> requests;
+};
+
+static ndn::SignatureSha256WithRsa
+makeFakeSignature()
+{
+  ndn::SignatureSha256WithRsa fakeSignature;
+  fakeSignature.setValue(ndn::dataBlock(tlv::SignatureValue,
+                                        reinterpret_cast<const uint8_t*>(0), 0));
+  return fakeSignature;
+}
+
+static shared_ptr<Data>
+makeCatalogData(const Name& name)
+{
+  static const ndn::SignatureSha256WithRsa fakeSignature = makeFakeSignature();
+
+  shared_ptr<Data> data = make_shared<Data>(name);
+  data->setFreshnessPeriod(time::seconds(3600));
+  data->setSignature(fakeSignature);
+  data->getFullName();
+  return data;
+}
+
+static size_t
+addToCatalog(Trace& trace, const Name& name)
+{
+  trace.catalog.push_back(makeCatalogData(name));
+  trace.interests.push_back(make_shared<Interest>(name));
+  return trace.catalog.size() - 1;
+}
+
+static void
+generateTrace(Trace& trace)
+{
+  // cumulative Zipf distribution over the catalog
+  std::vector<double> cdf(N_CATALOG);
+  double sum = 0;
+  for (size_t i = 0; i < N_CATALOG; ++i)
+    {
+      sum += 1.0 / std::pow(static_cast<double>(i + 1), ZIPF_ALPHA);
+      cdf[i] = sum;
+    }
+
+  for (size_t i = 0; i < N_CATALOG; ++i)
+    {
+      Name name("/benchmark/popular");
+      name.appendNumber(i);
+      addToCatalog(trace, name);
+    }
+
+  boost::random::uniform_real_distribution<double> dist(0, sum);
+  size_t nScanned = 0;
+  trace.requests.reserve(N_REQUESTS);
+  for (size_t i = 0; i < N_REQUESTS; ++i)
+    {
+      if (i % SCAN_PERIOD == 0 && i > 0)
+        {
+          for (size_t j = 0; j < SCAN_LENGTH; ++j)
+            {
+              Name name("/benchmark/scan");
+              name.appendNumber(nScanned++);
+              trace.requests.push_back(addToCatalog(trace, name));
+            }
+        }
+
+      double x = dist(getGlobalRng());
+      trace.requests.push_back(std::lower_bound(cdf.begin(), cdf.end(), x) - cdf.begin());
+    }
+}
+
+static void
+loadTrace(Trace& trace, const std::string& filename)
+{
+  std::ifstream file(filename.c_str());
+  std::map<Name, size_t> indexByName;
+  std::string line;
+  while (std::getline(file, line))
+    {
+      if (line.empty())
+        continue;
+
+      Name name(line);
+      std::map<Name, size_t>::iterator it = indexByName.find(name);
+      if (it == indexByName.end())
+        it = indexByName.insert(std::make_pair(name, addToCatalog(trace, name))).first;
+      trace.requests.push_back(it->second);
+    }
+}
+
+static void
+replay(const Trace& trace, const std::string& policyName, size_t nMaxPackets)
+{
+  Cs cs(nMaxPackets);
+  cs.setPolicy(cs::makePolicy(policyName));
+
+  size_t nHits = 0;
+  time::steady_clock::TimePoint startTime = time::steady_clock::now();
+  for (size_t i = 0; i < trace.requests.size(); ++i)
+    {
+      size_t index = trace.requests[i];
+      if (cs.find(*trace.interests[index]) != 0)
+        ++nHits;
+      else
+        cs.insert(*trace.catalog[index]);
+    }
+  time::steady_clock::Duration duration = time::steady_clock::now() - startTime;
+
+  time::duration<double, boost::nano> perRequest =
+    time::duration<double, boost::nano>(duration) / trace.requests.size();
+  std::cout << "  " << policyName
+            << ": hit ratio = " << static_cast<double>(nHits) / trace.requests.size()
+            << ", per-request time = "
+            << time::duration_cast<time::duration<double, boost::micro> >(perRequest)
+            << std::endl;
+}
+
+static void
+runPolicyBenchmark(const Trace& trace)
+{
+  static const char* POLICIES[] = { "fifo", "lru", "lfu", "arc" };
+
+  std::cout << "catalog = " << trace.catalog.size()
+            << ", requests = " << trace.requests.size() << std::endl;
+
+  for (size_t nMaxPackets = 1000; nMaxPackets <= 16000; nMaxPackets *= 4)
+    {
+      std::cout << "nMaxPackets = " << nMaxPackets << std::endl;
+      for (size_t i = 0; i < sizeof(POLICIES) / sizeof(POLICIES[0]); ++i)
+        replay(trace, POLICIES[i], nMaxPackets);
+    }
+}
+
+} // namespace nfd
+
+int
+main(int argc, char** argv)
+{
+  nfd::Trace trace;
+  if (argc > 1)
+    nfd::loadTrace(trace, argv[1]);
+  else
+    nfd::generateTrace(trace);
+
+  nfd::runPolicyBenchmark(trace);
+
+  return 0;
+}
@@ -99,12 +99,151 @@ runStressTest()
     }
 }
 
+static time::duration<double, boost::micro>
+perOperation(const time::steady_clock::Duration& duration, size_t nOperations)
+{
+  return time::duration_cast<time::duration<double, boost::micro> >(
+    time::duration<double, boost::nano>(duration) / nOperations);
+}
+
+/** \brief compares skip list and B+-tree CS index with 64K to 1M stored entries
+ */
+static void
+runIndexComparison()
+{
+  ndn::SignatureSha256WithRsa fakeSignature;
+  fakeSignature.setValue(ndn::dataBlock(tlv::SignatureValue,
+                                        reinterpret_cast<const uint8_t*>(0), 0));
+
+  for (size_t nEntries = 65536; nEntries <= 1048576; nEntries *= 2)
+    {
+      std::vector<shared_ptr<Data> > dataWorkload;
+      std::vector<shared_ptr<Interest> > interestWorkload;
+      dataWorkload.reserve(nEntries);
+      interestWorkload.reserve(nEntries);
+
+      for (size_t i = 0; i < nEntries; i++)
+        {
+          Name name("/stress/test");
+          name.appendNumber(i % 256);
+          name.appendNumber(i);
+
+          Data data(name);
+          data.setSignature(fakeSignature);
+          // decode from a right-sized copy, so that the workload does not keep
+          // the encoder's oversized buffer around
+          const Block& wire = data.wireEncode();
+          dataWorkload.push_back(make_shared<Data>(Block(wire.wire(), wire.size())));
+          dataWorkload.back()->getFullName();
+
+          interestWorkload.push_back(make_shared<Interest>(name));
+        }
+
+      // find Interests in a different order than Data were inserted
+      std::vector<size_t> order(nEntries);
+      for (size_t i = 0; i < nEntries; i++)
+        order[i] = (i * 7919) % nEntries;
+
+      std::cout << "nEntries = " << nEntries << std::endl;
+
+      static const Cs::IndexType INDEX_TYPES[] = {Cs::INDEX_SKIP_LIST, Cs::INDEX_BTREE};
+      static const char* INDEX_NAMES[] = {"skiplist", "btree   "};
+      for (size_t t = 0; t < 2; t++)
+        {
+          Cs cs(nEntries, INDEX_TYPES[t]);
+
+          time::steady_clock::TimePoint startTime = time::steady_clock::now();
+          for (size_t i = 0; i < nEntries; i++)
+            cs.insert(*dataWorkload[order[i]]);
+          time::steady_clock::Duration insertDuration = time::steady_clock::now() - startTime;
+
+          size_t nHits = 0;
+          startTime = time::steady_clock::now();
+          for (size_t i = 0; i < nEntries; i++)
+            nHits += (cs.find(*interestWorkload[i]) != 0);
+          time::steady_clock::Duration findDuration = time::steady_clock::now() - startTime;
+
+          std::cout << "  " << INDEX_NAMES[t]
+                    << ": insert = " << perOperation(insertDuration, nEntries)
+                    << ", find = " << perOperation(findDuration, nEntries)
+                    << ", hits = " << nHits << std::endl;
+        }
+
+      std::cout << "\n=================================\n" << std::endl;
+    }
+}
+
+/** \brief compares the hit-path latency of the exact name fast path
+ *         with the ordered lookup for Interests that carry the exact Data Name
+ */
+static void
+runExactMatchComparison()
+{
+  ndn::SignatureSha256WithRsa fakeSignature;
+  fakeSignature.setValue(ndn::dataBlock(tlv::SignatureValue,
+                                        reinterpret_cast<const uint8_t*>(0), 0));
+
+  static const size_t N_ENTRIES = 65536;
+  static const Cs::IndexType INDEX_TYPES[] = {Cs::INDEX_SKIP_LIST, Cs::INDEX_BTREE};
+  static const char* INDEX_NAMES[] = {"skiplist", "btree   "};
+
+  std::vector<shared_ptr<Data> > dataWorkload;
+  std::vector<shared_ptr<Interest> > exactInterests;
+  std::vector<shared_ptr<Interest> > orderedInterests;
+  for (size_t i = 0; i < N_ENTRIES; i++)
+    {
+      Name name("/stress/test");
+      name.appendNumber(i % 256);
+      name.appendSegment(i);
+
+      shared_ptr<Data> data = make_shared<Data>(name);
+      data->setSignature(fakeSignature);
+      data->getFullName();
+      dataWorkload.push_back(data);
+
+      exactInterests.push_back(make_shared<Interest>(name));
+
+      // a selector that every Data satisfies, which disables the fast path
+      orderedInterests.push_back(make_shared<Interest>(name));
+      orderedInterests.back()->setMaxSuffixComponents(1);
+    }
+
+  std::cout << "exact Name hit path, nEntries = " << N_ENTRIES << std::endl;
+
+  for (size_t t = 0; t < 2; t++)
+    {
+      Cs cs(N_ENTRIES, INDEX_TYPES[t]);
+      for (size_t i = 0; i < N_ENTRIES; i++)
+        cs.insert(*dataWorkload[i]);
+
+      size_t nHits = 0;
+      time::steady_clock::TimePoint startTime = time::steady_clock::now();
+      for (size_t i = 0; i < N_ENTRIES; i++)
+        nHits += (cs.find(*exactInterests[i]) != 0);
+      time::steady_clock::Duration exactDuration = time::steady_clock::now() - startTime;
+
+      startTime = time::steady_clock::now();
+      for (size_t i = 0; i < N_ENTRIES; i++)
+        nHits += (cs.find(*orderedInterests[i]) != 0);
+      time::steady_clock::Duration orderedDuration = time::steady_clock::now() - startTime;
+
+      std::cout << "  " << INDEX_NAMES[t]
+                << ": exact = " << perOperation(exactDuration, N_ENTRIES)
+                << ", ordered = " << perOperation(orderedDuration, N_ENTRIES)
+                << ", hits = " << nHits << std::endl;
+    }
+
+  std::cout << "\n=================================\n" << std::endl;
+}
+
 } // namespace nfd
 
 int
 main(int argc, char** argv)
 {
   nfd::runStressTest();
+  nfd::runIndexComparison();
+  nfd::runExactMatchComparison();
 
   return 0;
 }
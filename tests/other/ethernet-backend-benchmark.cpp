@@ -0,0 +1,209 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Measures frames/s and CPU time per frame of the pcap and PACKET_MMAP Ethernet face backends.
+// For each backend, a face on one end of a veth pair sends Interests in bursts of BURST_SIZE
+// to a face on the other end; both faces run in this process, so CPU time per frame
+// covers both sending and receiving.
+// Create the veth pair beforehand and run as root (or with CAP_NET_RAW):
+//
+//   ip link add nfdbench0 type veth peer name nfdbench1
+//   ip link set nfdbench0 up && ip link set nfdbench1 up
+//
+// usage: ethernet-backend-benchmark <interface> <peer interface> [number of frames]
+
+#include "config.hpp"
+
+#ifdef HAVE_LIBPCAP
+
+#include "face/ethernet-factory.hpp"
+#include "core/global-io.hpp"
+#include "core/network-interface.hpp"
+#include "core/scheduler.hpp"
+
+#include <sys/resource.h>
+
+namespace nfd {
+
+static const size_t BURST_SIZE = 64;
+static const time::seconds DRAIN_TIMEOUT(2);
+
+class EthernetBackendBenchmark
+{
+public:
+  EthernetBackendBenchmark(const std::string& interfaceName,
+                           const std::string& peerInterfaceName,
+                           size_t nFrames)
+    : m_interface(findInterface(interfaceName))
+    , m_peerInterface(findInterface(peerInterfaceName))
+    , m_nFrames(nFrames)
+    , m_nSent(0)
+    , m_nReceived(0)
+    , m_isDrainTimedOut(false)
+    , m_interest("/benchmark/site/video")
+  {
+    m_interest.setNonce(1);
+    m_interest.wireEncode();
+  }
+
+  void
+  run(EthernetFace::Backend backend, const std::string& backendName)
+  {
+    boost::asio::io_service& io = getGlobalIoService();
+
+    EthernetFactory factory;
+    factory.setBackend(backend);
+    m_sender = factory.createMulticastFace(m_interface, ethernet::getDefaultMulticastAddress());
+    shared_ptr<EthernetFace> receiver =
+      factory.createMulticastFace(m_peerInterface, ethernet::getDefaultMulticastAddress());
+    receiver->onReceiveInterest += bind(&EthernetBackendBenchmark::onReceiveInterest, this);
+
+    m_nSent = 0;
+    m_nReceived = 0;
+    m_isDrainTimedOut = false;
+
+    double cpuStart = getCpuSeconds();
+    time::steady_clock::TimePoint startTime = time::steady_clock::now();
+
+    io.post(bind(&EthernetBackendBenchmark::sendBurst, this));
+    while (m_nReceived < m_nFrames && !m_isDrainTimedOut)
+      io.run_one();
+
+    double seconds = time::duration_cast<time::duration<double> >(
+                       time::steady_clock::now() - startTime).count();
+    double cpuSeconds = getCpuSeconds() - cpuStart;
+
+    std::cout << backendName << ": "
+              << "frames/s = " << m_nReceived / seconds
+              << ", CPU us/frame = " << cpuSeconds * 1e6 / std::max<size_t>(m_nReceived, 1)
+              << ", lost = " << m_nFrames - m_nReceived << std::endl;
+
+    scheduler::cancel(m_drainTimeout);
+    m_sender->close();
+    receiver->close();
+    m_sender.reset();
+    io.poll();
+    io.reset();
+  }
+
+private:
+  static shared_ptr<NetworkInterfaceInfo>
+  findInterface(const std::string& name)
+  {
+    std::list<shared_ptr<NetworkInterfaceInfo> > nics = listNetworkInterfaces();
+    for (std::list<shared_ptr<NetworkInterfaceInfo> >::const_iterator i = nics.begin();
+         i != nics.end(); ++i)
+      {
+        if ((*i)->name == name)
+          return *i;
+      }
+    throw std::runtime_error("interface " + name + " not found");
+  }
+
+  static double
+  getCpuSeconds()
+  {
+    rusage usage;
+    ::getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec +
+           (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+  }
+
+  /** \brief send one burst, then let the io_service process received frames
+   */
+  void
+  sendBurst()
+  {
+    for (size_t i = 0; i < BURST_SIZE && m_nSent < m_nFrames; ++i, ++m_nSent)
+      m_sender->sendInterest(m_interest);
+
+    if (m_nSent < m_nFrames)
+      getGlobalIoService().post(bind(&EthernetBackendBenchmark::sendBurst, this));
+    else
+      // frames still missing after DRAIN_TIMEOUT are lost
+      m_drainTimeout = scheduler::schedule(DRAIN_TIMEOUT,
+                                           bind(&EthernetBackendBenchmark::onDrainTimeout, this));
+  }
+
+  void
+  onDrainTimeout()
+  {
+    m_isDrainTimedOut = true;
+  }
+
+  void
+  onReceiveInterest()
+  {
+    ++m_nReceived;
+  }
+
+private:
+  shared_ptr<NetworkInterfaceInfo> m_interface;
+  shared_ptr<NetworkInterfaceInfo> m_peerInterface;
+  size_t m_nFrames;
+  size_t m_nSent;
+  size_t m_nReceived;
+  bool m_isDrainTimedOut;
+  scheduler::EventId m_drainTimeout;
+  Interest m_interest;
+  shared_ptr<EthernetFace> m_sender;
+};
+
+} // namespace nfd
+
+int
+main(int argc, char** argv)
+{
+  if (argc < 3)
+    {
+      std::cerr << "usage: " << argv[0]
+                << " <interface> <peer interface> [number of frames]" << std::endl;
+      return 2;
+    }
+
+  size_t nFrames = argc > 3 ? boost::lexical_cast<size_t>(argv[3]) : 1000000;
+  nfd::EthernetBackendBenchmark benchmark(argv[1], argv[2], nFrames);
+
+  benchmark.run(nfd::EthernetFace::BACKEND_PCAP, "pcap");
+  if (nfd::EthernetFace::isPacketMmapSupported())
+    benchmark.run(nfd::EthernetFace::BACKEND_PACKET_MMAP, "packet_mmap");
+  else
+    std::cout << "packet_mmap: not available on this platform" << std::endl;
+
+  return 0;
+}
+
+#else // HAVE_LIBPCAP
+
+#include <iostream>
+
+int
+main()
+{
+  std::cout << "Ethernet faces are not available without libpcap" << std::endl;
+  return 0;
+}
+
+#endif // HAVE_LIBPCAP
@@ -0,0 +1,216 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Measures throughput of Data larger than the MTU between Ethernet faces, which send them
+// in NDNLP fragments and reassemble them at the receiver.
+// For each content size, a face on one end of a veth pair sends Data in bursts of BURST_SIZE
+// to a face on the other end, and the benchmark reports Data/s, goodput,
+// fragments/s and reassembly timeouts.
+// Create the veth pair beforehand and run as root (or with CAP_NET_RAW):
+//
+//   ip link add nfdbench0 type veth peer name nfdbench1
+//   ip link set nfdbench0 up && ip link set nfdbench1 up
+//
+// usage: ethernet-fragmentation-benchmark <interface> <peer interface> [pcap|packet_mmap]
+
+#include "config.hpp"
+
+#ifdef HAVE_LIBPCAP
+
+#include "face/ethernet-factory.hpp"
+#include "core/global-io.hpp"
+#include "core/network-interface.hpp"
+#include "core/scheduler.hpp"
+
+#include <ndn-cxx/security/signature-sha256-with-rsa.hpp>
+
+namespace nfd {
+
+static const size_t N_DATA = 100000;
+static const size_t BURST_SIZE = 16;
+static const time::seconds DRAIN_TIMEOUT(2);
+
+class EthernetFragmentationBenchmark
+{
+public:
+  EthernetFragmentationBenchmark(const std::string& interfaceName,
+                                 const std::string& peerInterfaceName,
+                                 EthernetFace::Backend backend)
+    : m_interface(findInterface(interfaceName))
+    , m_peerInterface(findInterface(peerInterfaceName))
+    , m_backend(backend)
+    , m_nSent(0)
+    , m_nReceived(0)
+    , m_isDrainTimedOut(false)
+  {
+  }
+
+  void
+  run(size_t contentSize)
+  {
+    boost::asio::io_service& io = getGlobalIoService();
+
+    EthernetFactory factory;
+    factory.setBackend(m_backend);
+    m_sender = factory.createMulticastFace(m_interface, ethernet::getDefaultMulticastAddress());
+    shared_ptr<EthernetFace> receiver =
+      factory.createMulticastFace(m_peerInterface, ethernet::getDefaultMulticastAddress());
+    receiver->onReceiveData += bind(&EthernetFragmentationBenchmark::onReceiveData, this);
+
+    m_data = make_shared<Data>("/benchmark/site/video/segment");
+    std::vector<uint8_t> content(contentSize, 0xaa);
+    m_data->setContent(&content.front(), content.size());
+    ndn::SignatureSha256WithRsa signature;
+    signature.setValue(ndn::dataBlock(tlv::SignatureValue,
+                                      reinterpret_cast<const uint8_t*>(0), 0));
+    m_data->setSignature(signature);
+    m_data->wireEncode();
+
+    m_nSent = 0;
+    m_nReceived = 0;
+    m_isDrainTimedOut = false;
+
+    time::steady_clock::TimePoint startTime = time::steady_clock::now();
+    io.post(bind(&EthernetFragmentationBenchmark::sendBurst, this));
+    while (m_nReceived < N_DATA && !m_isDrainTimedOut)
+      io.run_one();
+    double seconds = time::duration_cast<time::duration<double> >(
+                       time::steady_clock::now() - startTime).count();
+
+    const FragmentationCounters& counters = receiver->getFragmentationCounters();
+    std::cout << "content " << contentSize << " octets, "
+              << m_data->wireEncode().size() << " octets on the wire: "
+              << "Data/s = " << m_nReceived / seconds
+              << ", goodput Mbit/s = " << m_nReceived * contentSize * 8 / seconds / 1e6
+              << ", fragments/s = " << counters.getNInFragments() / seconds
+              << ", reassembly timeouts = " << counters.getNReassemblyTimeouts()
+              << ", lost = " << N_DATA - m_nReceived << std::endl;
+
+    scheduler::cancel(m_drainTimeout);
+    m_sender->close();
+    receiver->close();
+    m_sender.reset();
+    io.poll();
+    io.reset();
+  }
+
+private:
+  static shared_ptr<NetworkInterfaceInfo>
+  findInterface(const std::string& name)
+  {
+    std::list<shared_ptr<NetworkInterfaceInfo> > nics = listNetworkInterfaces();
+    for (std::list<shared_ptr<NetworkInterfaceInfo> >::const_iterator i = nics.begin();
+         i != nics.end(); ++i)
+      {
+        if ((*i)->name == name)
+          return *i;
+      }
+    throw std::runtime_error("interface " + name + " not found");
+  }
+
+  /** \brief send one burst, then let the io_service process received frames
+   */
+  void
+  sendBurst()
+  {
+    for (size_t i = 0; i < BURST_SIZE && m_nSent < N_DATA; ++i, ++m_nSent)
+      m_sender->sendData(*m_data);
+
+    if (m_nSent < N_DATA)
+      getGlobalIoService().post(bind(&EthernetFragmentationBenchmark::sendBurst, this));
+    else
+      // Data still missing after DRAIN_TIMEOUT are lost
+      m_drainTimeout = scheduler::schedule(DRAIN_TIMEOUT,
+                         bind(&EthernetFragmentationBenchmark::onDrainTimeout, this));
+  }
+
+  void
+  onDrainTimeout()
+  {
+    m_isDrainTimedOut = true;
+  }
+
+  void
+  onReceiveData()
+  {
+    ++m_nReceived;
+  }
+
+private:
+  shared_ptr<NetworkInterfaceInfo> m_interface;
+  shared_ptr<NetworkInterfaceInfo> m_peerInterface;
+  EthernetFace::Backend m_backend;
+  size_t m_nSent;
+  size_t m_nReceived;
+  bool m_isDrainTimedOut;
+  scheduler::EventId m_drainTimeout;
+  shared_ptr<Data> m_data;
+  shared_ptr<EthernetFace> m_sender;
+};
+
+} // namespace nfd
+
+int
+main(int argc, char** argv)
+{
+  if (argc < 3)
+    {
+      std::cerr << "usage: " << argv[0]
+                << " <interface> <peer interface> [pcap|packet_mmap]" << std::endl;
+      return 2;
+    }
+
+  nfd::EthernetFace::Backend backend = nfd::EthernetFace::BACKEND_PCAP;
+  if (argc > 3 && std::string(argv[3]) == "packet_mmap")
+    {
+      if (!nfd::EthernetFace::isPacketMmapSupported())
+        {
+          std::cerr << "packet_mmap is not available on this platform" << std::endl;
+          return 1;
+        }
+      backend = nfd::EthernetFace::BACKEND_PACKET_MMAP;
+    }
+
+  nfd::EthernetFragmentationBenchmark benchmark(argv[1], argv[2], backend);
+
+  size_t contentSizes[] = { 1000, 4000, 8000 };
+  for (size_t i = 0; i < sizeof(contentSizes) / sizeof(contentSizes[0]); ++i)
+    benchmark.run(contentSizes[i]);
+
+  return 0;
+}
+
+#else // HAVE_LIBPCAP
+
+#include <iostream>
+
+int
+main()
+{
+  std::cout << "Ethernet faces are not available without libpcap" << std::endl;
+  return 0;
+}
+
+#endif // HAVE_LIBPCAP
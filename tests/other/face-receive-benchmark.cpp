@@ -0,0 +1,231 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Measures heap octets allocated per received packet, which include every copy of
+// the packet made between the socket and the face's receive events, and receive
+// throughput of TcpFace and UnixStreamFace over the loopback.
+//
+// usage: face-receive-benchmark
+//
+// Build this program on an earlier revision to compare against receiving with
+// a copy per packet.
+
+#include "face/tcp-factory.hpp"
+#include "face/unix-stream-factory.hpp"
+#include "core/global-io.hpp"
+
+#include <ndn-cxx/security/signature-sha256-with-rsa.hpp>
+
+#include <cstdlib>
+#include <new>
+
+static size_t g_nAllocatedOctets = 0;
+
+void*
+operator new(std::size_t size)
+{
+  g_nAllocatedOctets += size;
+  void* p = std::malloc(size == 0 ? 1 : size);
+  if (p == 0)
+    throw std::bad_alloc();
+  return p;
+}
+
+void
+operator delete(void* p) throw()
+{
+  std::free(p);
+}
+
+namespace nfd {
+
+static const size_t N_PACKETS = 20000;
+static const char UNIX_SOCKET_PATH[] = "face-receive-benchmark.sock";
+
+class FaceReceiveBenchmark
+{
+public:
+  FaceReceiveBenchmark()
+    : m_nReceived(0)
+    , m_isWritten(false)
+  {
+  }
+
+  void
+  onFaceCreated(const shared_ptr<Face>& face)
+  {
+    m_face = face;
+    m_face->onReceiveInterest += bind(&FaceReceiveBenchmark::onReceive, this);
+    m_face->onReceiveData += bind(&FaceReceiveBenchmark::onReceive, this);
+  }
+
+  static void
+  onConnectFailed(const std::string& reason)
+  {
+    std::cerr << "cannot create face: " << reason << std::endl;
+    std::exit(1);
+  }
+
+  /** \brief connect to the listening channel, write packets,
+   *         and measure their reception on the accepted face
+   */
+  template<class Socket>
+  void
+  run(const std::string& label, const typename Socket::endpoint_type& endpoint,
+      const std::vector<Block>& packets)
+  {
+    boost::asio::io_service& io = getGlobalIoService();
+    Socket client(io);
+    client.connect(endpoint);
+    while (!m_face)
+      io.run_one();
+
+    std::vector<uint8_t> stream;
+    for (std::vector<Block>::const_iterator it = packets.begin(); it != packets.end(); ++it)
+      stream.insert(stream.end(), it->begin(), it->end());
+
+    m_nReceived = 0;
+    m_isWritten = false;
+    size_t nAllocatedOctetsBefore = g_nAllocatedOctets;
+    time::steady_clock::TimePoint startTime = time::steady_clock::now();
+
+    boost::asio::async_write(client, boost::asio::buffer(stream),
+                             bind(&FaceReceiveBenchmark::onWritten, this, _1));
+    while (m_nReceived < packets.size() || !m_isWritten)
+      io.run_one();
+
+    time::steady_clock::Duration duration = time::steady_clock::now() - startTime;
+    size_t nAllocatedOctets = g_nAllocatedOctets - nAllocatedOctetsBefore;
+
+    double seconds = time::duration_cast<time::duration<double> >(duration).count();
+    std::cout << label << ": "
+              << "heap octets per packet = " << nAllocatedOctets / packets.size()
+              << " (packet size " << packets.front().size() << ")"
+              << ", packets/s = " << packets.size() / seconds
+              << ", MB/s = " << stream.size() / seconds / 1e6 << std::endl;
+
+    m_face->close();
+    m_face.reset();
+    io.poll();
+  }
+
+private:
+  void
+  onReceive()
+  {
+    ++m_nReceived;
+  }
+
+  void
+  onWritten(const boost::system::error_code& error)
+  {
+    if (error) {
+      std::cerr << "write failed: " << error.message() << std::endl;
+      std::exit(1);
+    }
+    m_isWritten = true;
+  }
+
+private:
+  shared_ptr<Face> m_face;
+  size_t m_nReceived;
+  bool m_isWritten;
+};
+
+static std::vector<Block>
+makeInterests()
+{
+  std::vector<Block> packets;
+  for (size_t i = 0; i < N_PACKETS; ++i)
+    {
+      Name name("/benchmark/site");
+      name.appendNumber(i % 100).append("video").appendNumber(i);
+      Interest interest(name);
+      interest.setNonce(i);
+      packets.push_back(interest.wireEncode());
+    }
+  return packets;
+}
+
+static std::vector<Block>
+makeDatas(size_t payloadSize)
+{
+  ndn::SignatureSha256WithRsa fakeSignature;
+  fakeSignature.setValue(ndn::dataBlock(tlv::SignatureValue,
+                                        reinterpret_cast<const uint8_t*>(0), 0));
+  std::vector<uint8_t> payload(payloadSize, 0xBB);
+
+  std::vector<Block> packets;
+  for (size_t i = 0; i < N_PACKETS; ++i)
+    {
+      Name name("/benchmark/site");
+      name.appendNumber(i % 100).append("video").appendNumber(i);
+      Data data(name);
+      data.setContent(&payload.front(), payload.size());
+      data.setSignature(fakeSignature);
+      packets.push_back(data.wireEncode());
+    }
+  return packets;
+}
+
+static void
+runFaceReceiveBenchmarks()
+{
+  std::vector<Block> interests = makeInterests();
+  std::vector<Block> smallDatas = makeDatas(1000);
+  std::vector<Block> largeDatas = makeDatas(4000);
+
+  TcpFactory tcpFactory("6363");
+  boost::asio::ip::tcp::endpoint tcpEndpoint(boost::asio::ip::address_v4::loopback(), 20070);
+  FaceReceiveBenchmark tcpBenchmark;
+  tcpFactory.createChannel(tcpEndpoint)->listen(
+    bind(&FaceReceiveBenchmark::onFaceCreated, &tcpBenchmark, _1),
+    &FaceReceiveBenchmark::onConnectFailed);
+  typedef boost::asio::ip::tcp::socket TcpSocket;
+  tcpBenchmark.run<TcpSocket>("TCP Interest", tcpEndpoint, interests);
+  tcpBenchmark.run<TcpSocket>("TCP Data 1000", tcpEndpoint, smallDatas);
+  tcpBenchmark.run<TcpSocket>("TCP Data 4000", tcpEndpoint, largeDatas);
+
+  UnixStreamFactory unixFactory;
+  boost::asio::local::stream_protocol::endpoint unixEndpoint(UNIX_SOCKET_PATH);
+  FaceReceiveBenchmark unixBenchmark;
+  unixFactory.createChannel(UNIX_SOCKET_PATH)->listen(
+    bind(&FaceReceiveBenchmark::onFaceCreated, &unixBenchmark, _1),
+    &FaceReceiveBenchmark::onConnectFailed);
+  typedef boost::asio::local::stream_protocol::socket UnixSocket;
+  unixBenchmark.run<UnixSocket>("Unix Interest", unixEndpoint, interests);
+  unixBenchmark.run<UnixSocket>("Unix Data 1000", unixEndpoint, smallDatas);
+  unixBenchmark.run<UnixSocket>("Unix Data 4000", unixEndpoint, largeDatas);
+}
+
+} // namespace nfd
+
+int
+main(int argc, char** argv)
+{
+  nfd::runFaceReceiveBenchmarks();
+
+  return 0;
+}
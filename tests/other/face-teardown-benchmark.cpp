@@ -0,0 +1,119 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+
+// Measures the latency of removing a face from the FIB and PIT against FIB size,
+// when the face is a nexthop of N_AFFECTED FIB entries and has records in N_AFFECTED
+// PIT entries, as an on-demand face usually does.
+// For comparison, it also reports the time to enumerate all FIB entries,
+// which is what face removal took before FIB and PIT entries were indexed by face.
+//
+// usage: face-teardown-benchmark
+
+#include "table/fib.hpp"
+#include "table/pit.hpp"
+#include "tests/daemon/face/dummy-face.hpp"
+
+namespace nfd {
+
+static const size_t N_PIT_ENTRIES = 10000;
+static const size_t N_AFFECTED = 10;
+static const size_t N_TEARDOWNS = 100;
+
+static void
+runFaceTeardownBenchmark(size_t nFibEntries)
+{
+  NameTree nameTree;
+  Fib fib(nameTree);
+  Pit pit(nameTree);
+  shared_ptr<Face> upstream = make_shared<tests::DummyFace>();
+
+  std::vector<shared_ptr<fib::Entry> > fibEntries;
+  for (size_t i = 0; i < nFibEntries; ++i)
+    {
+      Name prefix("/benchmark");
+      prefix.appendNumber(i / 1000).appendNumber(i);
+      shared_ptr<fib::Entry> entry = fib.insert(prefix).first;
+      entry->addNextHop(upstream, 0);
+      fibEntries.push_back(entry);
+    }
+
+  std::vector<shared_ptr<Interest> > interests;
+  std::vector<shared_ptr<pit::Entry> > pitEntries;
+  for (size_t i = 0; i < N_PIT_ENTRIES; ++i)
+    {
+      Name name("/benchmark");
+      name.appendNumber(i / 1000).appendNumber(i).append("data");
+      interests.push_back(make_shared<Interest>(name));
+      shared_ptr<pit::Entry> entry = pit.insert(*interests.back()).first;
+      entry->insertOrUpdateOutRecord(upstream, *interests.back());
+      pitEntries.push_back(entry);
+    }
+
+  time::steady_clock::Duration teardownDuration = time::steady_clock::Duration::zero();
+  for (size_t round = 0; round < N_TEARDOWNS; ++round)
+    {
+      shared_ptr<Face> face = make_shared<tests::DummyFace>();
+      for (size_t j = 0; j < N_AFFECTED; ++j)
+        {
+          size_t i = (round * 7919 + j * 104729) % nFibEntries;
+          fibEntries[i]->addNextHop(face, 1);
+          size_t k = (round * 7919 + j * 104729) % N_PIT_ENTRIES;
+          pitEntries[k]->insertOrUpdateInRecord(face, *interests[k]);
+        }
+
+      time::steady_clock::TimePoint startTime = time::steady_clock::now();
+      fib.removeNextHopFromAllEntries(face);
+      pit.deleteInOutRecords(face);
+      teardownDuration += time::steady_clock::now() - startTime;
+    }
+
+  // cost of visiting every FIB entry once
+  size_t nVisited = 0;
+  time::steady_clock::TimePoint startTime = time::steady_clock::now();
+  for (Fib::const_iterator it = fib.begin(); it != fib.end(); ++it)
+    {
+      nVisited += it->hasNextHop(upstream);
+    }
+  time::steady_clock::Duration enumerateDuration = time::steady_clock::now() - startTime;
+
+  typedef time::duration<double, boost::micro> Micros;
+  std::cout << "FIB entries = " << nFibEntries
+            << ": per-teardown time = "
+            << time::duration_cast<Micros>(teardownDuration) / N_TEARDOWNS
+            << ", full FIB enumeration = "
+            << time::duration_cast<Micros>(enumerateDuration)
+            << " (" << nVisited << ")" << std::endl;
+}
+
+} // namespace nfd
+
+int
+main(int argc, char** argv)
+{
+  nfd::runFaceTeardownBenchmark(10000);
+  nfd::runFaceTeardownBenchmark(100000);
+  nfd::runFaceTeardownBenchmark(1000000);
+
+  return 0;
+}
@@ -0,0 +1,129 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+
+// Measures FIB longest prefix match on 10 to 20 component names under
+// 2 or 3 component FIB prefixes, comparing NameTree::findLongestPrefixMatch,
+// which probes prefix lengths from the longest down, against
+// Fib::findLongestPrefixMatch, which binary searches prefix lengths.
+// Hash values are precomputed, so that only table probing is measured.
+// The second round stores the query names in the NameTree, as PIT entries would.
+//
+// usage: fib-lpm-benchmark
+
+#include "table/fib.hpp"
+
+namespace nfd {
+
+static const size_t N_FIB_ENTRIES = 100000;
+static const size_t N_QUERIES = 100000;
+static const int N_ROUNDS = 10;
+
+static bool
+predicate_NameTreeEntry_hasFibEntry(const name_tree::Entry& entry)
+{
+  return static_cast<bool>(entry.getFibEntry());
+}
+
+static void
+measure(const std::string& label, NameTree& nameTree, Fib& fib,
+        const std::vector<name_tree::LookupContext>& contexts)
+{
+  size_t nFound = 0;
+  time::steady_clock::TimePoint startTime = time::steady_clock::now();
+  for (int round = 0; round < N_ROUNDS; ++round)
+    {
+      for (std::vector<name_tree::LookupContext>::const_iterator it = contexts.begin();
+           it != contexts.end(); ++it)
+        nFound += static_cast<bool>(nameTree.findLongestPrefixMatch(
+                                      *it, &predicate_NameTreeEntry_hasFibEntry));
+    }
+  time::duration<double, boost::nano> linearTime = time::steady_clock::now() - startTime;
+
+  startTime = time::steady_clock::now();
+  for (int round = 0; round < N_ROUNDS; ++round)
+    {
+      for (std::vector<name_tree::LookupContext>::const_iterator it = contexts.begin();
+           it != contexts.end(); ++it)
+        nFound += fib.findLongestPrefixMatch(*it)->getPrefix().size() > 0;
+    }
+  time::duration<double, boost::nano> binarySearchTime = time::steady_clock::now() - startTime;
+
+  std::cout << label << ": NameTree entries = " << nameTree.size() << std::endl
+            << "  probing from the longest prefix, per-operation time = "
+            << time::duration_cast<time::duration<double, boost::micro> >(
+                 linearTime / (N_ROUNDS * contexts.size()))
+            << std::endl
+            << "  binary search on prefix lengths, per-operation time = "
+            << time::duration_cast<time::duration<double, boost::micro> >(
+                 binarySearchTime / (N_ROUNDS * contexts.size()))
+            << " (" << nFound << " found)" << std::endl;
+}
+
+static void
+runFibLpmBenchmark()
+{
+  NameTree nameTree;
+  Fib fib(nameTree);
+
+  for (size_t i = 0; i < N_FIB_ENTRIES; ++i)
+    {
+      Name prefix("/fib");
+      prefix.appendNumber(i);
+      if (i % 2 == 0)
+        prefix.append("sub");
+      fib.insert(prefix);
+    }
+
+  // 10 to 20 components
+  std::vector<Name> names;
+  names.reserve(N_QUERIES);
+  for (size_t i = 0; i < N_QUERIES; ++i)
+    {
+      Name name("/fib");
+      name.appendNumber(i * 7919 % N_FIB_ENTRIES).append("sub");
+      size_t depth = 10 + i % 11;
+      while (name.size() < depth)
+        name.appendNumber(i);
+      names.push_back(name);
+    }
+  std::vector<name_tree::LookupContext> contexts(names.begin(), names.end());
+
+  measure("FIB prefixes only", nameTree, fib, contexts);
+
+  for (std::vector<name_tree::LookupContext>::const_iterator it = contexts.begin();
+       it != contexts.end(); ++it)
+    nameTree.lookup(*it);
+
+  measure("FIB prefixes and query names", nameTree, fib, contexts);
+}
+
+} // namespace nfd
+
+int
+main(int argc, char** argv)
+{
+  nfd::runFibLpmBenchmark();
+
+  return 0;
+}
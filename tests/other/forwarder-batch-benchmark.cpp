@@ -0,0 +1,140 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Measures forwarding throughput of Interests and Data received one by one,
+// and received in batches of 8, 32 and 64 packets as from one stream read.
+//
+// usage: forwarder-batch-benchmark
+
+#include "fw/forwarder.hpp"
+#include "tests/daemon/face/dummy-face.hpp"
+
+#include <ndn-cxx/security/signature-sha256-with-rsa.hpp>
+
+namespace nfd {
+
+static const size_t N_PACKETS = 100000;
+
+/** \brief a face that counts sent packets without storing them
+ */
+class CountingFace : public tests::DummyFace
+{
+public:
+  CountingFace()
+    : nSent(0)
+  {
+  }
+
+  virtual void
+  sendInterest(const Interest& interest)
+  {
+    ++nSent;
+  }
+
+  virtual void
+  sendData(const Data& data)
+  {
+    ++nSent;
+  }
+
+public:
+  size_t nSent;
+};
+
+static void
+runForwarderBatchBenchmark(size_t batchSize)
+{
+  Forwarder forwarder;
+  shared_ptr<CountingFace> consumer = make_shared<CountingFace>();
+  shared_ptr<CountingFace> producer = make_shared<CountingFace>();
+  forwarder.addFace(consumer);
+  forwarder.addFace(producer);
+  forwarder.getFib().insert("/benchmark").first->addNextHop(producer, 0);
+
+  ndn::SignatureSha256WithRsa fakeSignature;
+  fakeSignature.setValue(ndn::dataBlock(tlv::SignatureValue,
+                                        reinterpret_cast<const uint8_t*>(0), 0));
+
+  InterestBatch interests;
+  DataBatch datas;
+  for (size_t i = 0; i < N_PACKETS; ++i)
+    {
+      Name name("/benchmark/site");
+      name.appendNumber(i % 100).append("video").appendNumber(i);
+      interests.push_back(make_shared<Interest>(name));
+      interests.back()->setNonce(i);
+      interests.back()->setInterestLifetime(time::seconds(10));
+      datas.push_back(make_shared<Data>(name));
+      datas.back()->setSignature(fakeSignature);
+      datas.back()->wireEncode();
+    }
+
+  time::steady_clock::TimePoint startTime = time::steady_clock::now();
+  if (batchSize == 1)
+    {
+      for (size_t i = 0; i < N_PACKETS; ++i)
+        consumer->receiveInterest(*interests[i]);
+      for (size_t i = 0; i < N_PACKETS; ++i)
+        producer->receiveData(*datas[i]);
+    }
+  else
+    {
+      for (size_t i = 0; i < N_PACKETS; i += batchSize)
+        {
+          size_t end = std::min(i + batchSize, N_PACKETS);
+          consumer->receiveInterestBatch(InterestBatch(interests.begin() + i,
+                                                       interests.begin() + end));
+        }
+      for (size_t i = 0; i < N_PACKETS; i += batchSize)
+        {
+          size_t end = std::min(i + batchSize, N_PACKETS);
+          producer->receiveDataBatch(DataBatch(datas.begin() + i, datas.begin() + end));
+        }
+    }
+  time::steady_clock::Duration duration = time::steady_clock::now() - startTime;
+
+  size_t nPackets = 2 * N_PACKETS;
+  time::duration<double, boost::nano> perPacket =
+    time::duration<double, boost::nano>(duration) / nPackets;
+  std::cout << "batch size = " << batchSize
+            << ": per-packet time = "
+            << time::duration_cast<time::duration<double, boost::micro> >(perPacket)
+            << ", packets/s = " << 1e9 / perPacket.count()
+            << " (" << producer->nSent << " Interests, "
+            << consumer->nSent << " Data forwarded)" << std::endl;
+}
+
+} // namespace nfd
+
+int
+main(int argc, char** argv)
+{
+  nfd::runForwarderBatchBenchmark(1);
+  nfd::runForwarderBatchBenchmark(8);
+  nfd::runForwarderBatchBenchmark(32);
+  nfd::runForwarderBatchBenchmark(64);
+
+  return 0;
+}
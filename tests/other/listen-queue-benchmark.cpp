@@ -0,0 +1,226 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Measures how UDP receive and TCP accept throughput of a channel scale with the number
+// of SO_REUSEPORT listen queues, each serviced by its own I/O thread.
+// Load generator threads, each with its own sockets, run for a fixed duration:
+// - UDP: every generator sends Interests from 8 source ports to a shared-socket channel;
+//   the benchmark reports Interests/s received by faces.
+// - TCP: every generator connects and resets the connection in a loop;
+//   the benchmark reports faces created/s.
+// Faces and forwarding remain in the main thread, which bounds the scaling.
+//
+// usage: listen-queue-benchmark [number of load generator threads]
+
+#include "face/udp-factory.hpp"
+#include "face/tcp-factory.hpp"
+#include "face/io-thread.hpp"
+#include "core/global-io.hpp"
+
+#include <boost/thread/thread.hpp>
+
+namespace nfd {
+
+static const time::seconds DURATION(3);
+static const size_t N_SOURCES_PER_GENERATOR = 8;
+static const uint16_t UDP_PORT = 20076;
+static const uint16_t TCP_PORT = 20077;
+
+class ListenQueueBenchmark
+{
+public:
+  ListenQueueBenchmark()
+    : m_nReceived(0)
+    , m_nFacesCreated(0)
+  {
+  }
+
+  void
+  runUdp(size_t nQueues, size_t nGenerators)
+  {
+    boost::asio::ip::udp::endpoint endpoint(boost::asio::ip::address_v4::loopback(), UDP_PORT);
+
+    UdpFactory factory;
+    shared_ptr<UdpChannel> channel = factory.createChannel(endpoint, time::seconds(600));
+    channel->setSharedSocket(true);
+    channel->setNListenQueues(nQueues);
+    channel->listen(bind(&ListenQueueBenchmark::onUdpFaceCreated, this, _1),
+                    &ListenQueueBenchmark::onFailed);
+
+    m_nReceived = 0;
+    double seconds = this->runGenerators(bind(&ListenQueueBenchmark::generateUdp,
+                                              endpoint, _1),
+                                         nGenerators);
+    std::cout << "UDP, " << nQueues << " listen queues: "
+              << "Interests/s = " << m_nReceived / seconds
+              << ", faces = " << m_udpFaces.size() << std::endl;
+
+    for (std::list<shared_ptr<Face> >::iterator it = m_udpFaces.begin();
+         it != m_udpFaces.end(); ++it)
+      (*it)->close();
+    m_udpFaces.clear();
+    getGlobalIoService().poll();
+  }
+
+  void
+  runTcp(size_t nQueues, size_t nGenerators)
+  {
+    boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::address_v4::loopback(), TCP_PORT);
+
+    TcpFactory factory("6363");
+    shared_ptr<TcpChannel> channel = factory.createChannel(endpoint);
+    channel->setNListenQueues(nQueues);
+    channel->listen(bind(&ListenQueueBenchmark::onTcpFaceCreated, this, _1),
+                    &ListenQueueBenchmark::onFailed);
+
+    m_nFacesCreated = 0;
+    double seconds = this->runGenerators(bind(&ListenQueueBenchmark::generateTcp,
+                                              endpoint, _1),
+                                         nGenerators);
+    std::cout << "TCP, " << nQueues << " listen queues: "
+              << "faces created/s = " << m_nFacesCreated / seconds << std::endl;
+    getGlobalIoService().poll();
+  }
+
+  static void
+  onFailed(const std::string& reason)
+  {
+    std::cerr << "channel failed: " << reason << std::endl;
+  }
+
+private:
+  /** \brief run generator threads for DURATION while the main thread runs the io_service
+   *  \return elapsed seconds
+   */
+  double
+  runGenerators(const function<void(time::steady_clock::TimePoint)>& generator,
+                size_t nGenerators)
+  {
+    boost::asio::io_service& io = getGlobalIoService();
+
+    time::steady_clock::TimePoint startTime = time::steady_clock::now();
+    time::steady_clock::TimePoint endTime = startTime + DURATION;
+    boost::thread_group generators;
+    for (size_t i = 0; i < nGenerators; ++i)
+      generators.create_thread(bind(generator, endTime));
+
+    while (time::steady_clock::now() < endTime)
+      io.poll();
+    double seconds = time::duration_cast<time::duration<double> >(
+                       time::steady_clock::now() - startTime).count();
+
+    generators.join_all();
+    return seconds;
+  }
+
+  /** \brief send Interests from N_SOURCES_PER_GENERATOR source ports; runs in a generator thread
+   */
+  static void
+  generateUdp(const boost::asio::ip::udp::endpoint& endpoint,
+              const time::steady_clock::TimePoint& endTime)
+  {
+    boost::asio::io_service io;
+    std::vector<shared_ptr<boost::asio::ip::udp::socket> > sources;
+    for (size_t i = 0; i < N_SOURCES_PER_GENERATOR; ++i)
+      sources.push_back(make_shared<boost::asio::ip::udp::socket>(ref(io),
+                          boost::asio::ip::udp::endpoint(boost::asio::ip::address_v4::loopback(),
+                                                         0)));
+
+    Interest interest("/benchmark/site/video");
+    interest.setNonce(1);
+    const Block& wire = interest.wireEncode();
+    boost::system::error_code error;
+    for (size_t i = 0; time::steady_clock::now() < endTime; ++i)
+      sources[i % sources.size()]->send_to(boost::asio::buffer(wire.wire(), wire.size()),
+                                           endpoint, 0, error);
+  }
+
+  /** \brief connect and disconnect in a loop; runs in a generator thread
+   */
+  static void
+  generateTcp(const boost::asio::ip::tcp::endpoint& endpoint,
+              const time::steady_clock::TimePoint& endTime)
+  {
+    boost::asio::io_service io;
+    while (time::steady_clock::now() < endTime)
+      {
+        boost::asio::ip::tcp::socket socket(io);
+        boost::system::error_code error;
+        socket.connect(endpoint, error);
+        socket.set_option(boost::asio::socket_base::linger(true, 0), error);
+        socket.close(error);
+      }
+  }
+
+  void
+  onUdpFaceCreated(const shared_ptr<Face>& face)
+  {
+    m_udpFaces.push_back(face);
+    face->onReceiveInterest += bind(&ListenQueueBenchmark::onReceiveInterest, this);
+  }
+
+  void
+  onReceiveInterest()
+  {
+    ++m_nReceived;
+  }
+
+  void
+  onTcpFaceCreated(const shared_ptr<Face>& face)
+  {
+    ++m_nFacesCreated;
+    face->close();
+  }
+
+private:
+  size_t m_nReceived;
+  size_t m_nFacesCreated;
+  std::list<shared_ptr<Face> > m_udpFaces;
+};
+
+} // namespace nfd
+
+int
+main(int argc, char** argv)
+{
+  if (!nfd::isReusePortSupported())
+    {
+      std::cerr << "SO_REUSEPORT is not supported" << std::endl;
+      return 1;
+    }
+
+  size_t nGenerators = 4;
+  if (argc > 1)
+    nGenerators = boost::lexical_cast<size_t>(argv[1]);
+
+  size_t nQueues[] = { 1, 2, 4 };
+  nfd::ListenQueueBenchmark benchmark;
+  for (size_t i = 0; i < sizeof(nQueues) / sizeof(nQueues[0]); ++i)
+    benchmark.runUdp(nQueues[i], nGenerators);
+  for (size_t i = 0; i < sizeof(nQueues) / sizeof(nQueues[0]); ++i)
+    benchmark.runTcp(nQueues[i], nGenerators);
+
+  return 0;
+}
@@ -0,0 +1,115 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014  Regents of the University of California,
+ *                     Arizona Board of Regents,
+ *                     Colorado State University,
+ *                     University Pierre & Marie Curie, Sorbonne University,
+ *                     Washington University in St. Louis,
+ *                     Beijing Institute of Technology
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// Per-Interest table lookup cost, with each table hashing the Name on its own
+// versus sharing one name_tree::LookupContext.
+
+#include "fw/forwarder.hpp"
+
+namespace nfd {
+
+static const size_t N_INTERESTS = 100000;
+static const int N_ROUNDS = 10;
+
+static void
+printResult(const std::string& label, const time::steady_clock::Duration& duration)
+{
+  time::duration<double, boost::nano> perOperationTime =
+    time::duration<double, boost::nano>(duration) / (N_ROUNDS * N_INTERESTS);
+  std::cout << label << " per-Interest time = "
+            << time::duration_cast<time::duration<double, boost::micro> >(perOperationTime)
+            << std::endl;
+}
+
+static void
+runNameLookupContextBenchmark()
+{
+  Forwarder forwarder;
+  Pit& pit = forwarder.getPit();
+  Fib& fib = forwarder.getFib();
+  Measurements& measurements = forwarder.getMeasurements();
+  StrategyChoice& strategyChoice = forwarder.getStrategyChoice();
+
+  std::vector<shared_ptr<Interest> > interests;
+  for (size_t i = 0; i < N_INTERESTS; ++i) {
+    Name name("/benchmark/site");
+    name.appendNumber(i % 100).append("video").appendNumber(i % 10).appendNumber(i);
+    interests.push_back(make_shared<Interest>(name));
+
+    if (i < 100) {
+      fib.insert(name.getPrefix(3));
+    }
+  }
+
+  // populate PIT, so that the measured insertions find existing entries
+  for (size_t i = 0; i < N_INTERESTS; ++i) {
+    pit.insert(*interests[i]);
+  }
+
+  size_t nMatches = 0;
+  time::steady_clock::TimePoint startTime = time::steady_clock::now();
+  for (int round = 0; round < N_ROUNDS; ++round) {
+    for (size_t i = 0; i < N_INTERESTS; ++i) {
+      nMatches += name_tree::computeHashSet(interests[i]->getName()).size();
+    }
+  }
+  printResult("computeHashSet only     ", time::steady_clock::now() - startTime);
+
+  startTime = time::steady_clock::now();
+  for (int round = 0; round < N_ROUNDS; ++round) {
+    for (size_t i = 0; i < N_INTERESTS; ++i) {
+      const Interest& interest = *interests[i];
+      pit.insert(interest);
+      nMatches += fib.findLongestPrefixMatch(interest.getName())->hasNextHops();
+      strategyChoice.findEffectiveStrategy(interest.getName());
+      nMatches += static_cast<bool>(measurements.findLongestPrefixMatch(interest.getName()));
+    }
+  }
+  printResult("hash per table (before) ", time::steady_clock::now() - startTime);
+
+  startTime = time::steady_clock::now();
+  for (int round = 0; round < N_ROUNDS; ++round) {
+    for (size_t i = 0; i < N_INTERESTS; ++i) {
+      const Interest& interest = *interests[i];
+      name_tree::LookupContext context(interest.getName());
+      pit.insert(interest, context);
+      nMatches += fib.findLongestPrefixMatch(context)->hasNextHops();
+      strategyChoice.findEffectiveStrategy(context);
+      nMatches += static_cast<bool>(measurements.findLongestPrefixMatch(context));
+    }
+  }
+  printResult("LookupContext (after)   ", time::steady_clock::now() - startTime);
+
+  std::cout << "(" << nMatches << ")" << std::endl;
+}
+
+} // namespace nfd
+
+int
+main(int argc, char** argv)
+{
+  nfd::runNameLookupContextBenchmark();
+
+  return 0;
+}
@@ -0,0 +1,132 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+
+// Measures NameTree insertion and longest prefix match against table size.
+// Names are /bench/<a>/<b>/<c>; insertion time is per name, and includes the creation
+// of missing ancestor entries. Queries are names of Data under random inserted names,
+// two components longer, so each LPM probes three prefix lengths before it finds a match.
+// With 10 million names, the NameTree takes several gigabytes of memory.
+//
+// usage: name-tree-benchmark [number of names]
+
+#include "table/name-tree.hpp"
+
+#include <boost/lexical_cast.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+
+namespace nfd {
+
+static const size_t BATCH_SIZE = 100000;
+static const size_t N_QUERIES = 100000;
+static const int N_ROUNDS = 10;
+
+static Name
+makeName(size_t i)
+{
+  Name name("/bench");
+  name.appendNumber(i / 1000000).appendNumber(i / 1000 % 1000).appendNumber(i % 1000);
+  return name;
+}
+
+static void
+runNameTreeBenchmark(size_t nNames)
+{
+  NameTree nameTree;
+
+  // insert in batches, so that name construction is not timed
+  // and not all names are held in memory at once
+  time::duration<double, boost::nano> insertTime(0);
+  std::vector<Name> batch;
+  batch.reserve(BATCH_SIZE);
+  for (size_t i = 0; i < nNames; i += BATCH_SIZE)
+    {
+      batch.clear();
+      for (size_t j = i; j < std::min(i + BATCH_SIZE, nNames); ++j)
+        batch.push_back(makeName(j));
+
+      time::steady_clock::TimePoint startTime = time::steady_clock::now();
+      for (std::vector<Name>::const_iterator it = batch.begin(); it != batch.end(); ++it)
+        nameTree.lookup(*it);
+      insertTime += time::steady_clock::now() - startTime;
+    }
+
+  boost::random::mt19937 generator;
+  boost::random::uniform_int_distribution<size_t> distribution(0, nNames - 1);
+  std::vector<Name> queries;
+  queries.reserve(N_QUERIES);
+  for (size_t i = 0; i < N_QUERIES; ++i)
+    queries.push_back(makeName(distribution(generator)).append("data").appendSegment(i));
+
+  size_t nFound = 0;
+  time::steady_clock::TimePoint startTime = time::steady_clock::now();
+  for (int round = 0; round < N_ROUNDS; ++round)
+    {
+      for (std::vector<Name>::const_iterator it = queries.begin(); it != queries.end(); ++it)
+        nFound += static_cast<bool>(nameTree.findLongestPrefixMatch(*it));
+    }
+  time::duration<double, boost::nano> lpmTime = time::steady_clock::now() - startTime;
+
+  // the same queries with precomputed hash values isolate the cost of probing the table
+  std::vector<name_tree::LookupContext> contexts(queries.begin(), queries.end());
+  startTime = time::steady_clock::now();
+  for (int round = 0; round < N_ROUNDS; ++round)
+    {
+      for (std::vector<name_tree::LookupContext>::const_iterator it = contexts.begin();
+           it != contexts.end(); ++it)
+        nFound += static_cast<bool>(nameTree.findLongestPrefixMatch(*it));
+    }
+  time::duration<double, boost::nano> probeTime = time::steady_clock::now() - startTime;
+
+  std::cout << nNames << " names: entries = " << nameTree.size()
+            << ", buckets = " << nameTree.getNBuckets() << std::endl
+            << "  insert per-name time = "
+            << time::duration_cast<time::duration<double, boost::micro> >(insertTime / nNames)
+            << std::endl
+            << "  LPM per-operation time = "
+            << time::duration_cast<time::duration<double, boost::micro> >(
+                 lpmTime / (N_ROUNDS * N_QUERIES))
+            << std::endl
+            << "  LPM per-operation time, hash precomputed = "
+            << time::duration_cast<time::duration<double, boost::micro> >(
+                 probeTime / (N_ROUNDS * N_QUERIES))
+            << " (" << nFound << " found)" << std::endl;
+}
+
+} // namespace nfd
+
+int
+main(int argc, char** argv)
+{
+  if (argc > 1)
+    {
+      nfd::runNameTreeBenchmark(boost::lexical_cast<size_t>(argv[1]));
+      return 0;
+    }
+
+  nfd::runNameTreeBenchmark(1000000);
+  nfd::runNameTreeBenchmark(10000000);
+
+  return 0;
+}
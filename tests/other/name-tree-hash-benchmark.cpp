@@ -0,0 +1,194 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014  Regents of the University of California,
+ *                     Arizona Board of Regents,
+ *                     Colorado State University,
+ *                     University Pierre & Marie Curie, Sorbonne University,
+ *                     Washington University in St. Louis,
+ *                     Beijing Institute of Technology
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// NameTree hash quality benchmark:
+// compares bucket chain lengths of the order-insensitive XOR hash that NameTree used
+// to have against name_tree::computeHash, and measures NameTree LPM time.
+
+#include "table/name-tree.hpp"
+#include "core/city-hash.hpp"
+
+#include <boost/unordered_map.hpp>
+
+namespace nfd {
+
+/// the former NameTree hash: XOR of component hashes
+static size_t
+computeXorHash(const Name& prefix)
+{
+  size_t hashValue = 0;
+  for (Name::const_iterator it = prefix.begin(); it != prefix.end(); ++it) {
+    hashValue ^= static_cast<size_t>(CityHash64(reinterpret_cast<const char*>(it->wire()),
+                                                it->size()));
+  }
+  return hashValue;
+}
+
+/// all prefixes of all names, without duplicates
+static std::vector<Name>
+collectPrefixes(const std::vector<Name>& names)
+{
+  std::set<Name> prefixes;
+  for (std::vector<Name>::const_iterator it = names.begin(); it != names.end(); ++it) {
+    for (size_t i = 0; i <= it->size(); ++i) {
+      prefixes.insert(it->getPrefix(i));
+    }
+  }
+  return std::vector<Name>(prefixes.begin(), prefixes.end());
+}
+
+static void
+reportChains(const std::string& label, const std::vector<Name>& prefixes,
+             size_t (*hashFunction)(const Name&))
+{
+  // same sizing policy as NameTree: load factor stays below 0.5
+  size_t nBuckets = 1024;
+  while (prefixes.size() > nBuckets / 2) {
+    nBuckets *= 2;
+  }
+
+  std::vector<size_t> chainLength(nBuckets, 0);
+  boost::unordered_map<size_t, size_t> hashCount;
+  for (std::vector<Name>::const_iterator it = prefixes.begin(); it != prefixes.end(); ++it) {
+    size_t hashValue = hashFunction(*it);
+    ++chainLength[hashValue % nBuckets];
+    ++hashCount[hashValue];
+  }
+
+  size_t maxChain = 0;
+  size_t sumOfSquares = 0; // sum over entries of the chain length they live in
+  for (size_t i = 0; i < nBuckets; ++i) {
+    maxChain = std::max(maxChain, chainLength[i]);
+    sumOfSquares += chainLength[i] * chainLength[i];
+  }
+
+  std::cout << "  " << label
+            << ": distinct hashes = " << hashCount.size()
+            << ", full-hash collisions = " << (prefixes.size() - hashCount.size())
+            << ", max chain = " << maxChain
+            << ", avg chain seen by an entry = "
+            << (static_cast<double>(sumOfSquares) / prefixes.size())
+            << std::endl;
+}
+
+static void
+measureLookup(const std::vector<Name>& names)
+{
+  NameTree nameTree;
+  for (std::vector<Name>::const_iterator it = names.begin(); it != names.end(); ++it) {
+    nameTree.lookup(*it);
+  }
+
+  time::steady_clock::TimePoint startTime = time::steady_clock::now();
+
+  static const int N_ROUNDS = 10;
+  size_t nFound = 0;
+  for (int round = 0; round < N_ROUNDS; ++round) {
+    for (std::vector<Name>::const_iterator it = names.begin(); it != names.end(); ++it) {
+      nFound += static_cast<bool>(nameTree.findLongestPrefixMatch(*it));
+    }
+  }
+
+  time::steady_clock::TimePoint endTime = time::steady_clock::now();
+  time::duration<double, boost::nano> perOperationTime =
+    time::duration<double, boost::nano>(endTime - startTime) / (N_ROUNDS * names.size());
+
+  std::cout << "  NameTree: entries = " << nameTree.size()
+            << ", buckets = " << nameTree.getNBuckets()
+            << ", LPM per-operation time = "
+            << time::duration_cast<time::duration<double, boost::micro> >(perOperationTime)
+            << " (" << nFound << " found)" << std::endl;
+}
+
+static void
+runBenchmark(const std::string& title, const std::vector<Name>& names)
+{
+  std::vector<Name> prefixes = collectPrefixes(names);
+
+  std::cout << title << ": " << names.size() << " names, "
+            << prefixes.size() << " prefixes" << std::endl;
+  reportChains("XOR hash    ", prefixes, &computeXorHash);
+  reportChains("computeHash ", prefixes, &name_tree::computeHash);
+  measureLookup(names);
+  std::cout << "\n=================================\n" << std::endl;
+}
+
+static void
+runNameTreeHashBenchmark()
+{
+  std::vector<Name> names;
+
+  // /seg/i/seg/j: every permutation of (i, j) collides under XOR
+  names.clear();
+  for (int i = 0; i < 300; ++i) {
+    for (int j = 0; j < 300; ++j) {
+      Name name("/seg");
+      name.appendNumber(i).append("seg").appendNumber(j);
+      names.push_back(name);
+    }
+  }
+  runBenchmark("Repeated components /seg/<i>/seg/<j>", names);
+
+  // a/b/c drawn from a small alphabet: permutations and repeated pairs
+  names.clear();
+  for (int a = 0; a < 40; ++a) {
+    for (int b = 0; b < 40; ++b) {
+      for (int c = 0; c < 40; ++c) {
+        Name name("/video");
+        name.appendNumber(a).appendNumber(b).appendNumber(c);
+        names.push_back(name);
+      }
+    }
+  }
+  runBenchmark("Permuted components /video/<a>/<b>/<c>", names);
+
+  // realistic hierarchical names: site, user, application, version, segment
+  names.clear();
+  for (int site = 0; site < 10; ++site) {
+    for (int user = 0; user < 20; ++user) {
+      for (int version = 0; version < 5; ++version) {
+        for (int segment = 0; segment < 100; ++segment) {
+          Name name("/ndn/edu");
+          name.append("site" + boost::lexical_cast<std::string>(site))
+              .append("user" + boost::lexical_cast<std::string>(user))
+              .append("app")
+              .appendNumber(version)
+              .appendNumber(segment);
+          names.push_back(name);
+        }
+      }
+    }
+  }
+  runBenchmark("Hierarchical /ndn/edu/<site>/<user>/app/<version>/<segment>", names);
+}
+
+} // namespace nfd
+
+int
+main(int argc, char** argv)
+{
+  nfd::runNameTreeHashBenchmark();
+
+  return 0;
+}
@@ -0,0 +1,97 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+
+// Measures the tail latency of NameTree lookups that insert names while the table grows.
+// Each lookup inserts one new name; the benchmark reports latency percentiles,
+// and the worst latency of lookups that started a resize.
+//
+// usage: name-tree-resize-benchmark [number of names]
+
+#include "table/name-tree.hpp"
+
+#include <boost/lexical_cast.hpp>
+
+namespace nfd {
+
+typedef time::duration<double, boost::micro> Microseconds;
+
+static void
+runNameTreeResizeBenchmark(size_t nNames)
+{
+  NameTree nameTree;
+  nameTree.lookup("/bench");
+
+  std::vector<Microseconds> latencies;
+  latencies.reserve(nNames);
+  Microseconds maxResizeLatency(0);
+  size_t nResizes = 0;
+
+  for (size_t i = 0; i < nNames; ++i)
+    {
+      Name name("/bench");
+      name.appendNumber(i);
+      size_t nBuckets = nameTree.getNBuckets();
+
+      time::steady_clock::TimePoint startTime = time::steady_clock::now();
+      nameTree.lookup(name);
+      Microseconds latency = time::steady_clock::now() - startTime;
+
+      latencies.push_back(latency);
+      if (nameTree.getNBuckets() != nBuckets)
+        {
+          ++nResizes;
+          maxResizeLatency = std::max(maxResizeLatency, latency);
+        }
+    }
+
+  std::sort(latencies.begin(), latencies.end());
+
+  std::cout << nNames << " insertions, " << nResizes << " resizes, "
+            << nameTree.getNBuckets() << " buckets" << std::endl;
+
+  static const double PERCENTILES[] = {50, 99, 99.9, 99.99};
+  for (size_t i = 0; i < sizeof(PERCENTILES) / sizeof(PERCENTILES[0]); ++i)
+    {
+      size_t index = static_cast<size_t>(PERCENTILES[i] / 100 * (latencies.size() - 1));
+      std::cout << "  p" << PERCENTILES[i] << " lookup latency = " << latencies[index]
+                << std::endl;
+    }
+  std::cout << "  max lookup latency = " << latencies.back() << std::endl
+            << "  max latency of a lookup that started a resize = " << maxResizeLatency
+            << std::endl;
+}
+
+} // namespace nfd
+
+int
+main(int argc, char** argv)
+{
+  size_t nNames = 4000000;
+  if (argc > 1)
+    nNames = boost::lexical_cast<size_t>(argv[1]);
+
+  nfd::runNameTreeResizeBenchmark(nNames);
+
+  return 0;
+}
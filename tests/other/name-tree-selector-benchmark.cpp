@@ -0,0 +1,167 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+
+// Measures the cost of passing NameTree entry selectors as name_tree::EntrySelector,
+// which calls through a function object, against passing a functor type, which
+// the templated NameTree queries inline.
+// PIT: iterating over NameTree::findAllMatches, as Pit::findAllDataMatches used to,
+// against Pit::findAllDataMatches.
+// FIB: NameTree::findLongestPrefixMatch with either kind of selector.
+// Hash values are precomputed, so that hashing is not measured.
+//
+// usage: name-tree-selector-benchmark
+
+#include "table/fib.hpp"
+#include "table/pit.hpp"
+
+namespace nfd {
+
+static const size_t N_NAMES = 100000;
+static const int N_ROUNDS = 10;
+
+static bool
+hasPitEntry(const name_tree::Entry& entry)
+{
+  return entry.hasPitEntries();
+}
+
+static bool
+hasFibEntry(const name_tree::Entry& entry)
+{
+  return static_cast<bool>(entry.getFibEntry());
+}
+
+struct HasFibEntry
+{
+  bool
+  operator()(const name_tree::Entry& entry) const
+  {
+    return static_cast<bool>(entry.getFibEntry());
+  }
+};
+
+static void
+report(const std::string& label, const time::steady_clock::TimePoint& startTime, size_t nFound)
+{
+  time::duration<double, boost::nano> perOperationTime =
+    time::duration<double, boost::nano>(time::steady_clock::now() - startTime) /
+    (N_ROUNDS * N_NAMES);
+  std::cout << "  " << label << ": per-operation time = "
+            << time::duration_cast<time::duration<double, boost::micro> >(perOperationTime)
+            << " (" << nFound << " found)" << std::endl;
+}
+
+static void
+runNameTreeSelectorBenchmark()
+{
+  NameTree nameTree;
+  Fib fib(nameTree);
+  Pit pit(nameTree);
+
+  std::vector<shared_ptr<Data> > datas;
+  for (size_t i = 0; i < N_NAMES; ++i)
+    {
+      Name prefix("/benchmark/site");
+      prefix.appendNumber(i % 1000);
+      fib.insert(prefix);
+
+      Name name(prefix);
+      name.append("video").appendNumber(i).appendSegment(0);
+      pit.insert(*make_shared<Interest>(name));
+      // a shorter Interest matches the Data of several names
+      if (i % 10 == 0)
+        pit.insert(*make_shared<Interest>(name.getPrefix(-2)));
+
+      datas.push_back(make_shared<Data>(name));
+    }
+
+  std::vector<name_tree::LookupContext> contexts;
+  contexts.reserve(N_NAMES);
+  for (size_t i = 0; i < N_NAMES; ++i)
+    contexts.push_back(name_tree::LookupContext(datas[i]->getName()));
+
+  std::cout << "PIT Data match" << std::endl;
+
+  size_t nFound = 0;
+  time::steady_clock::TimePoint startTime = time::steady_clock::now();
+  for (int round = 0; round < N_ROUNDS; ++round)
+    {
+      for (size_t i = 0; i < N_NAMES; ++i)
+        {
+          shared_ptr<pit::DataMatchResult> result = make_shared<pit::DataMatchResult>();
+          for (NameTree::const_iterator it = nameTree.findAllMatches(contexts[i], &hasPitEntry);
+               it != nameTree.end(); it++)
+            {
+              const std::vector<shared_ptr<pit::Entry> >& pitEntries = it->getPitEntries();
+              for (size_t j = 0; j < pitEntries.size(); j++)
+                {
+                  if (pitEntries[j]->getInterest().matchesData(*datas[i]))
+                    result->push_back(pitEntries[j]);
+                }
+            }
+          nFound += result->size();
+        }
+    }
+  report("findAllMatches iterator, EntrySelector", startTime, nFound);
+
+  nFound = 0;
+  startTime = time::steady_clock::now();
+  for (int round = 0; round < N_ROUNDS; ++round)
+    {
+      for (size_t i = 0; i < N_NAMES; ++i)
+        nFound += pit.findAllDataMatches(*datas[i], contexts[i])->size();
+    }
+  report("Pit::findAllDataMatches, functor", startTime, nFound);
+
+  std::cout << "FIB longest prefix match" << std::endl;
+
+  name_tree::EntrySelector entrySelector(&hasFibEntry);
+  nFound = 0;
+  startTime = time::steady_clock::now();
+  for (int round = 0; round < N_ROUNDS; ++round)
+    {
+      for (size_t i = 0; i < N_NAMES; ++i)
+        nFound += static_cast<bool>(nameTree.findLongestPrefixMatch(contexts[i], entrySelector));
+    }
+  report("EntrySelector", startTime, nFound);
+
+  nFound = 0;
+  startTime = time::steady_clock::now();
+  for (int round = 0; round < N_ROUNDS; ++round)
+    {
+      for (size_t i = 0; i < N_NAMES; ++i)
+        nFound += static_cast<bool>(nameTree.findLongestPrefixMatch(contexts[i], HasFibEntry()));
+    }
+  report("functor", startTime, nFound);
+}
+
+} // namespace nfd
+
+int
+main(int argc, char** argv)
+{
+  nfd::runNameTreeSelectorBenchmark();
+
+  return 0;
+}
@@ -0,0 +1,171 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+
+// Measures NDNLP fragmentation and reassembly throughput and heap allocations per packet.
+// Slicer::slice, which encodes each fragment into a new Block, is compared against
+// Slicer::sliceInPlace, which encodes only headers; PartialMessageStore reassembles
+// N_INTERLEAVED packets whose fragments arrive interleaved.
+//
+// usage: ndnlp-benchmark
+
+#include "face/ndnlp-slicer.hpp"
+#include "face/ndnlp-partial-message-store.hpp"
+
+#include <cstdlib>
+#include <new>
+
+static size_t g_nAllocations = 0;
+
+void*
+operator new(std::size_t size)
+{
+  ++g_nAllocations;
+  void* p = std::malloc(size == 0 ? 1 : size);
+  if (p == 0)
+    throw std::bad_alloc();
+  return p;
+}
+
+void
+operator delete(void* p) throw()
+{
+  std::free(p);
+}
+
+namespace nfd {
+
+static const size_t MTU = 1500;
+static const size_t N_PACKETS = 200000;
+static const size_t N_INTERLEAVED = 8;
+
+static Block
+makePacket(size_t size)
+{
+  std::vector<uint8_t> value(size - 4, 0xcc);
+  return ndn::dataBlock(tlv::Content, &value.front(), value.size());
+}
+
+static void
+report(const std::string& label, const time::steady_clock::Duration& duration,
+       size_t nFragments, size_t nAllocations)
+{
+  double seconds = time::duration<double>(duration).count();
+  std::cout << "  " << label
+            << ": fragments/s = " << static_cast<size_t>(nFragments / seconds)
+            << ", allocations per packet = "
+            << static_cast<double>(nAllocations) / N_PACKETS << std::endl;
+}
+
+static void
+measureSlice(const Block& packet)
+{
+  ndnlp::Slicer slicer(MTU);
+  size_t nFragments = 0;
+  size_t nAllocationsBefore = g_nAllocations;
+  time::steady_clock::TimePoint startTime = time::steady_clock::now();
+  for (size_t i = 0; i < N_PACKETS; ++i)
+    {
+      ndnlp::PacketArray pa = slicer.slice(packet);
+      nFragments += pa->size();
+    }
+  report("slice         ", time::steady_clock::now() - startTime,
+         nFragments, g_nAllocations - nAllocationsBefore);
+}
+
+static void
+measureSliceInPlace(const Block& packet)
+{
+  ndnlp::Slicer slicer(MTU);
+  slicer.sliceInPlace(packet); // warm up header storage
+
+  size_t nFragments = 0;
+  size_t nAllocationsBefore = g_nAllocations;
+  time::steady_clock::TimePoint startTime = time::steady_clock::now();
+  for (size_t i = 0; i < N_PACKETS; ++i)
+    {
+      nFragments += slicer.sliceInPlace(packet).size();
+    }
+  report("sliceInPlace  ", time::steady_clock::now() - startTime,
+         nFragments, g_nAllocations - nAllocationsBefore);
+}
+
+static void
+countPacket(size_t* nReceived)
+{
+  ++*nReceived;
+}
+
+static void
+measureReassembly(const Block& packet)
+{
+  ndnlp::Slicer slicer(MTU);
+  std::vector<ndnlp::PacketArray> messages;
+  for (size_t i = 0; i < N_INTERLEAVED; ++i)
+    messages.push_back(slicer.slice(packet));
+  size_t fragCount = messages.front()->size();
+
+  ndnlp::PartialMessageStore store(time::seconds(10));
+  size_t nReceived = 0;
+  store.onReceive += bind(&countPacket, &nReceived);
+
+  size_t nFragments = 0;
+  size_t nAllocationsBefore = g_nAllocations;
+  time::steady_clock::TimePoint startTime = time::steady_clock::now();
+  for (size_t i = 0; i < N_PACKETS; i += N_INTERLEAVED)
+    {
+      for (size_t fragIndex = 0; fragIndex < fragCount; ++fragIndex)
+        {
+          for (size_t j = 0; j < N_INTERLEAVED; ++j)
+            store.receiveNdnlpData(messages[j]->at(fragIndex));
+        }
+      nFragments += fragCount * N_INTERLEAVED;
+    }
+  report("reassemble    ", time::steady_clock::now() - startTime,
+         nFragments, g_nAllocations - nAllocationsBefore);
+  BOOST_ASSERT(nReceived == N_PACKETS);
+}
+
+static void
+runNdnlpBenchmark()
+{
+  static const size_t PACKET_SIZES[] = { 4000, 8800 };
+  for (size_t i = 0; i < sizeof(PACKET_SIZES) / sizeof(PACKET_SIZES[0]); ++i)
+    {
+      Block packet = makePacket(PACKET_SIZES[i]);
+      std::cout << "packet size = " << packet.size() << ", MTU = " << MTU << std::endl;
+      measureSlice(packet);
+      measureSliceInPlace(packet);
+      measureReassembly(packet);
+    }
+}
+
+} // namespace nfd
+
+int
+main(int argc, char** argv)
+{
+  nfd::runNdnlpBenchmark();
+
+  return 0;
+}
@@ -0,0 +1,144 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Compares pit::NonceList against the set+queue structure it replaced,
+// for heap memory per PIT entry and loop-detection (duplicate Nonce) latency.
+//
+// usage: nonce-list-benchmark
+
+#include "table/pit-nonce-list.hpp"
+
+#include <cstdlib>
+#include <new>
+
+static size_t g_nAllocatedBytes = 0;
+
+void*
+operator new(std::size_t size)
+{
+  g_nAllocatedBytes += size;
+  void* p = std::malloc(size == 0 ? 1 : size);
+  if (p == 0)
+    throw std::bad_alloc();
+  return p;
+}
+
+void
+operator delete(void* p) throw()
+{
+  std::free(p);
+}
+
+namespace nfd {
+
+/** \brief the NonceList implementation before the ring buffer
+ */
+class SetQueueNonceList : noncopyable
+{
+public:
+  bool
+  add(uint32_t nonce)
+  {
+    bool isNew = m_nonceSet.insert(nonce).second;
+    if (!isNew)
+      return false;
+
+    m_nonceQueue.push(nonce);
+    if (m_nonceSet.size() > pit::NonceList::CAPACITY) {
+      m_nonceSet.erase(m_nonceQueue.front());
+      m_nonceQueue.pop();
+    }
+    return true;
+  }
+
+private:
+  std::set<uint32_t> m_nonceSet;
+  std::queue<uint32_t> m_nonceQueue;
+};
+
+static const size_t N_ENTRIES = 10000;
+static const size_t N_LOOKUPS = 10000000;
+
+template<typename NonceListType>
+static void
+measure(const std::string& label, size_t nNonces)
+{
+  std::vector<NonceListType*> lists(N_ENTRIES);
+
+  // memory per PIT entry
+  size_t nAllocatedBytesBefore = g_nAllocatedBytes;
+  for (size_t i = 0; i < N_ENTRIES; ++i)
+    {
+      lists[i] = new NonceListType;
+      for (size_t j = 0; j < nNonces; ++j)
+        lists[i]->add(static_cast<uint32_t>(i * 7919 + j * 104729));
+    }
+  double bytesPerEntry = static_cast<double>(g_nAllocatedBytes - nAllocatedBytesBefore) /
+                         N_ENTRIES;
+
+  // loop detection: every lookup finds a duplicate, so that the lists are not modified
+  size_t nDuplicates = 0;
+  time::steady_clock::TimePoint startTime = time::steady_clock::now();
+  for (size_t i = 0; i < N_LOOKUPS; ++i)
+    {
+      size_t entry = i % N_ENTRIES;
+      size_t j = (i / N_ENTRIES) % nNonces;
+      uint32_t nonce = static_cast<uint32_t>(entry * 7919 + j * 104729);
+      nDuplicates += !lists[entry]->add(nonce);
+    }
+  time::steady_clock::Duration duration = time::steady_clock::now() - startTime;
+
+  time::duration<double, boost::nano> perLookup =
+    time::duration<double, boost::nano>(duration) / N_LOOKUPS;
+  std::cout << "  " << label
+            << ": bytes per entry = " << bytesPerEntry
+            << ", per-lookup time = " << perLookup
+            << " (" << nDuplicates << ")" << std::endl;
+
+  for (size_t i = 0; i < N_ENTRIES; ++i)
+    delete lists[i];
+}
+
+static void
+runNonceListBenchmark()
+{
+  static const size_t N_NONCES[] = { 1, 2, 8, 64, 256 };
+  for (size_t i = 0; i < sizeof(N_NONCES) / sizeof(N_NONCES[0]); ++i)
+    {
+      std::cout << "nonces = " << N_NONCES[i] << std::endl;
+      measure<SetQueueNonceList>("set+queue  ", N_NONCES[i]);
+      measure<pit::NonceList>   ("ring buffer", N_NONCES[i]);
+    }
+}
+
+} // namespace nfd
+
+int
+main(int argc, char** argv)
+{
+  nfd::runNonceListBenchmark();
+
+  return 0;
+}
@@ -0,0 +1,144 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Measures heap allocations and time per Interest for the PIT part of forwarding:
+// insert a PIT entry, add an InRecord and an OutRecord, match Data, and erase the entry.
+//
+// usage: pit-benchmark
+//
+// Build this program on an earlier revision to compare against the previous
+// PIT entry and record allocation scheme.
+
+#include "table/pit.hpp"
+#include "tests/daemon/face/dummy-face.hpp"
+
+#include <cstdlib>
+#include <new>
+
+static size_t g_nAllocations = 0;
+
+void*
+operator new(std::size_t size)
+{
+  ++g_nAllocations;
+  void* p = std::malloc(size == 0 ? 1 : size);
+  if (p == 0)
+    throw std::bad_alloc();
+  return p;
+}
+
+void
+operator delete(void* p) throw()
+{
+  std::free(p);
+}
+
+namespace nfd {
+
+static const size_t N_INTERESTS = 100000;
+static const int N_ROUNDS = 10;
+
+static void
+runPitBenchmark(size_t nDownstreams)
+{
+  NameTree nameTree;
+  Pit pit(nameTree);
+
+  std::vector<shared_ptr<Face> > faces;
+  for (size_t i = 0; i <= nDownstreams; ++i)
+    faces.push_back(make_shared<tests::DummyFace>());
+
+  std::vector<shared_ptr<Interest> > interests;
+  std::vector<shared_ptr<Data> > datas;
+  for (size_t i = 0; i < N_INTERESTS; ++i)
+    {
+      Name name("/benchmark/site");
+      name.appendNumber(i % 100).append("video").appendNumber(i);
+      interests.push_back(make_shared<Interest>(name));
+      interests.back()->setNonce(i);
+      datas.push_back(make_shared<Data>(name));
+    }
+
+  // keep prefixes in NameTree, and warm up allocator pools
+  std::vector<shared_ptr<name_tree::Entry> > prefixes;
+  for (size_t i = 0; i < 100; ++i)
+    prefixes.push_back(nameTree.lookup(interests[i]->getName().getPrefix(-2)));
+  for (size_t i = 0; i < N_INTERESTS; ++i)
+    pit.insert(*interests[i]);
+  for (size_t i = 0; i < N_INTERESTS; ++i)
+    pit.erase(pit.insert(*interests[i]).first);
+
+  size_t nAllocationsBefore = g_nAllocations;
+  size_t nMatches = 0;
+  time::steady_clock::TimePoint startTime = time::steady_clock::now();
+  for (int round = 0; round < N_ROUNDS; ++round)
+    {
+      for (size_t i = 0; i < N_INTERESTS; ++i)
+        {
+          const Interest& interest = *interests[i];
+          shared_ptr<pit::Entry> entry = pit.insert(interest).first;
+          for (size_t j = 1; j <= nDownstreams; ++j)
+            entry->insertOrUpdateInRecord(faces[j], interest);
+          entry->insertOrUpdateOutRecord(faces[0], interest);
+        }
+
+      for (size_t i = 0; i < N_INTERESTS; ++i)
+        {
+          shared_ptr<pit::DataMatchResult> matches = pit.findAllDataMatches(*datas[i]);
+          for (pit::DataMatchResult::iterator it = matches->begin(); it != matches->end(); ++it)
+            {
+              (*it)->deleteInRecords();
+              (*it)->deleteOutRecord(faces[0]);
+              pit.erase(*it);
+              ++nMatches;
+            }
+        }
+    }
+  time::steady_clock::Duration duration = time::steady_clock::now() - startTime;
+  size_t nAllocations = g_nAllocations - nAllocationsBefore;
+
+  size_t nOperations = N_ROUNDS * N_INTERESTS;
+  time::duration<double, boost::nano> perInterest =
+    time::duration<double, boost::nano>(duration) / nOperations;
+  std::cout << "downstreams = " << nDownstreams
+            << ": allocations per Interest = "
+            << static_cast<double>(nAllocations) / nOperations
+            << ", per-Interest time = "
+            << time::duration_cast<time::duration<double, boost::micro> >(perInterest)
+            << ", Interests/s = " << 1e9 / perInterest.count()
+            << " (" << nMatches << ")" << std::endl;
+}
+
+} // namespace nfd
+
+int
+main(int argc, char** argv)
+{
+  nfd::runPitBenchmark(1);
+  nfd::runPitBenchmark(2);
+  nfd::runPitBenchmark(4);
+
+  return 0;
+}
@@ -0,0 +1,165 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Measures forwarding throughput of a full Interest-Data exchange with many
+// consumer faces and one producer face, for different numbers of forwarding workers.
+// Faces are processed in the main thread in every case.
+//
+// usage: sharded-forwarder-benchmark [max-workers]
+
+#include "fw/sharded-forwarder.hpp"
+#include "core/global-io.hpp"
+#include "tests/daemon/face/dummy-face.hpp"
+
+#include <ndn-cxx/security/signature-sha256-with-rsa.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/thread/thread.hpp>
+
+namespace nfd {
+
+static const size_t N_CONSUMERS = 64;
+static const size_t N_INTERESTS = 200000;
+
+/** \brief a face that answers every Interest with a Data
+ */
+class ProducerFace : public tests::DummyFace
+{
+public:
+  virtual void
+  sendInterest(const Interest& interest)
+  {
+    shared_ptr<Data> data = make_shared<Data>(interest.getName());
+    ndn::SignatureSha256WithRsa fakeSignature;
+    fakeSignature.setValue(ndn::dataBlock(tlv::SignatureValue,
+                                          reinterpret_cast<const uint8_t*>(0), 0));
+    data->setSignature(fakeSignature);
+    data->wireEncode();
+
+    // answer asynchronously, as a real face would
+    getGlobalIoService().post(bind(&ProducerFace::reply, this, data));
+  }
+
+private:
+  void
+  reply(shared_ptr<Data> data)
+  {
+    this->receiveData(*data);
+  }
+};
+
+/** \brief a face that counts Data, and stops the io_service when all are received
+ */
+class ConsumerFace : public tests::DummyFace
+{
+public:
+  explicit
+  ConsumerFace(size_t& nReceived)
+    : m_nReceived(nReceived)
+  {
+  }
+
+  virtual void
+  sendData(const Data& data)
+  {
+    if (++m_nReceived == N_INTERESTS)
+      getGlobalIoService().stop();
+  }
+
+private:
+  size_t& m_nReceived;
+};
+
+static void
+runShardedForwarderBenchmark(size_t nWorkers)
+{
+  boost::asio::io_service& ioService = getGlobalIoService();
+
+  Forwarder forwarder;
+  ShardedForwarder sharded(forwarder);
+
+  size_t nReceived = 0;
+  std::vector<shared_ptr<ConsumerFace> > consumers;
+  for (size_t i = 0; i < N_CONSUMERS; ++i)
+    {
+      consumers.push_back(make_shared<ConsumerFace>(ref(nReceived)));
+      forwarder.addFace(consumers.back());
+    }
+  shared_ptr<ProducerFace> producer = make_shared<ProducerFace>();
+  forwarder.addFace(producer);
+  forwarder.getFib().insert("/benchmark").first->addNextHop(producer, 0);
+
+  std::vector<shared_ptr<Interest> > interests;
+  for (size_t i = 0; i < N_INTERESTS; ++i)
+    {
+      Name name("/benchmark");
+      name.appendNumber(i % 1000).append("video").appendNumber(i);
+      interests.push_back(make_shared<Interest>(name));
+      interests.back()->setNonce(i);
+      interests.back()->setInterestLifetime(time::seconds(10));
+      interests.back()->wireEncode();
+    }
+
+  sharded.setNWorkers(nWorkers);
+  sharded.start();
+
+  time::steady_clock::TimePoint startTime = time::steady_clock::now();
+  for (size_t i = 0; i < N_INTERESTS; ++i)
+    {
+      consumers[i % N_CONSUMERS]->receiveInterest(*interests[i]);
+    }
+  {
+    // keep the main thread waiting while workers are busy
+    boost::asio::io_service::work work(ioService);
+    ioService.run();
+  }
+  time::steady_clock::Duration duration = time::steady_clock::now() - startTime;
+  ioService.reset();
+
+  sharded.stop();
+
+  time::duration<double, boost::nano> perExchange =
+    time::duration<double, boost::nano>(duration) / N_INTERESTS;
+  std::cout << "workers = " << nWorkers
+            << ": per-exchange time = "
+            << time::duration_cast<time::duration<double, boost::micro> >(perExchange)
+            << ", exchanges/s = " << 1e9 / perExchange.count()
+            << " (" << nReceived << ")" << std::endl;
+}
+
+} // namespace nfd
+
+int
+main(int argc, char** argv)
+{
+  size_t maxWorkers = std::max<size_t>(boost::thread::hardware_concurrency(), 1);
+  if (argc > 1)
+    maxWorkers = boost::lexical_cast<size_t>(argv[1]);
+
+  nfd::runShardedForwarderBenchmark(0);
+  for (size_t nWorkers = 1; nWorkers <= maxWorkers; nWorkers *= 2)
+    nfd::runShardedForwarderBenchmark(nWorkers);
+
+  return 0;
+}
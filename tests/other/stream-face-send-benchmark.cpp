@@ -0,0 +1,244 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Measures write syscalls per packet and send throughput of TcpFace and UnixStreamFace
+// over the loopback, when a pipelined consumer keeps a window of Interests outstanding
+// so that Data are sent in bursts. Each run is repeated with max write size 0, which
+// writes packets one by one as before gathered writes.
+//
+// usage: stream-face-send-benchmark
+//
+// Write syscalls are read from /proc/self/io, and are reported only on Linux.
+
+#include "face/tcp-factory.hpp"
+#include "face/unix-stream-factory.hpp"
+#include "core/global-io.hpp"
+
+#include <ndn-cxx/security/signature-sha256-with-rsa.hpp>
+
+#include <fstream>
+
+namespace nfd {
+
+static const size_t N_PACKETS = 50000;
+static const size_t WINDOW = 32;
+static const char UNIX_SOCKET_PATH[] = "stream-face-send-benchmark.sock";
+
+/** \return number of write syscalls made by this process, or 0 if unknown
+ */
+static size_t
+getNWriteSyscalls()
+{
+  std::ifstream io("/proc/self/io");
+  std::string key;
+  size_t value = 0;
+  while (io >> key >> value)
+    {
+      if (key == "syscw:")
+        return value;
+    }
+  return 0;
+}
+
+class StreamFaceSendBenchmark
+{
+public:
+  StreamFaceSendBenchmark()
+    : m_nOctetsExpected(0)
+    , m_nOctetsReceived(0)
+    , m_readBuffer(65536)
+  {
+  }
+
+  void
+  onFaceCreated(const shared_ptr<Face>& face)
+  {
+    m_face = face;
+  }
+
+  static void
+  onConnectFailed(const std::string& reason)
+  {
+    std::cerr << "cannot create face: " << reason << std::endl;
+    std::exit(1);
+  }
+
+  /** \brief connect to the listening channel, and send Data from the accepted face
+   */
+  template<class Socket>
+  void
+  run(const std::string& label, const typename Socket::endpoint_type& endpoint,
+      const std::vector<shared_ptr<Data> >& datas)
+  {
+    boost::asio::io_service& io = getGlobalIoService();
+    Socket client(io);
+    client.connect(endpoint);
+    while (!m_face)
+      io.run_one();
+
+    m_nOctetsExpected = 0;
+    for (std::vector<shared_ptr<Data> >::const_iterator it = datas.begin();
+         it != datas.end(); ++it)
+      m_nOctetsExpected += (*it)->wireEncode().size();
+    m_nOctetsReceived = 0;
+    this->startRead(client);
+
+    size_t nWriteSyscallsBefore = getNWriteSyscalls();
+    time::steady_clock::TimePoint startTime = time::steady_clock::now();
+
+    for (size_t i = 0; i < datas.size(); i += WINDOW)
+      {
+        size_t end = std::min(i + WINDOW, datas.size());
+        for (size_t j = i; j < end; ++j)
+          m_face->sendData(*datas[j]);
+        io.poll();
+      }
+    while (m_nOctetsReceived < m_nOctetsExpected)
+      io.run_one();
+
+    time::steady_clock::Duration duration = time::steady_clock::now() - startTime;
+    size_t nWriteSyscalls = getNWriteSyscalls() - nWriteSyscallsBefore;
+
+    double seconds = time::duration_cast<time::duration<double> >(duration).count();
+    std::cout << label << ": "
+              << "write syscalls per packet = "
+              << static_cast<double>(nWriteSyscalls) / datas.size()
+              << ", packets/s = " << datas.size() / seconds
+              << ", MB/s = " << m_nOctetsExpected / seconds / 1e6 << std::endl;
+
+    client.close();
+    m_face->close();
+    m_face.reset();
+    io.poll();
+  }
+
+private:
+  template<class Socket>
+  void
+  startRead(Socket& client)
+  {
+    client.async_read_some(boost::asio::buffer(m_readBuffer),
+                           bind(&StreamFaceSendBenchmark::handleRead<Socket>, this,
+                                ref(client), _1, _2));
+  }
+
+  template<class Socket>
+  void
+  handleRead(Socket& client, const boost::system::error_code& error, size_t nOctets)
+  {
+    if (error) {
+      if (error != boost::asio::error::operation_aborted) {
+        std::cerr << "read failed: " << error.message() << std::endl;
+        std::exit(1);
+      }
+      return;
+    }
+
+    m_nOctetsReceived += nOctets;
+    if (m_nOctetsReceived < m_nOctetsExpected)
+      this->startRead(client);
+  }
+
+private:
+  size_t m_nOctetsExpected;
+  shared_ptr<Face> m_face;
+  size_t m_nOctetsReceived;
+  std::vector<uint8_t> m_readBuffer;
+};
+
+static std::vector<shared_ptr<Data> >
+makeDatas(size_t payloadSize)
+{
+  ndn::SignatureSha256WithRsa fakeSignature;
+  fakeSignature.setValue(ndn::dataBlock(tlv::SignatureValue,
+                                        reinterpret_cast<const uint8_t*>(0), 0));
+  std::vector<uint8_t> payload(payloadSize, 0xBB);
+
+  std::vector<shared_ptr<Data> > datas;
+  for (size_t i = 0; i < N_PACKETS; ++i)
+    {
+      Name name("/benchmark/site");
+      name.appendNumber(i % 100).append("video").appendNumber(i);
+      shared_ptr<Data> data = make_shared<Data>(name);
+      data->setContent(&payload.front(), payload.size());
+      data->setSignature(fakeSignature);
+      data->wireEncode();
+      datas.push_back(data);
+    }
+  return datas;
+}
+
+static void
+runStreamFaceSendBenchmarks()
+{
+  size_t payloadSizes[] = { 100, 1000 };
+  std::vector<shared_ptr<Data> > datas[2];
+  std::string labels[2];
+  for (int i = 0; i < 2; ++i)
+    {
+      datas[i] = makeDatas(payloadSizes[i]);
+      labels[i] = " Data " + boost::lexical_cast<std::string>(payloadSizes[i]);
+    }
+
+  TcpFactory tcpFactory("6363");
+  boost::asio::ip::tcp::endpoint tcpEndpoint(boost::asio::ip::address_v4::loopback(), 20070);
+  shared_ptr<TcpChannel> tcpChannel = tcpFactory.createChannel(tcpEndpoint);
+  StreamFaceSendBenchmark tcpBenchmark;
+  tcpChannel->listen(bind(&StreamFaceSendBenchmark::onFaceCreated, &tcpBenchmark, _1),
+                     &StreamFaceSendBenchmark::onConnectFailed);
+  typedef boost::asio::ip::tcp::socket TcpSocket;
+  for (int i = 0; i < 2; ++i)
+    {
+      tcpChannel->setMaxWriteSize(0);
+      tcpBenchmark.run<TcpSocket>("TCP" + labels[i] + ", one by one", tcpEndpoint, datas[i]);
+      tcpChannel->setMaxWriteSize(DEFAULT_STREAM_MAX_WRITE_SIZE);
+      tcpBenchmark.run<TcpSocket>("TCP" + labels[i] + ", gathered", tcpEndpoint, datas[i]);
+    }
+
+  UnixStreamFactory unixFactory;
+  boost::asio::local::stream_protocol::endpoint unixEndpoint(UNIX_SOCKET_PATH);
+  shared_ptr<UnixStreamChannel> unixChannel = unixFactory.createChannel(UNIX_SOCKET_PATH);
+  StreamFaceSendBenchmark unixBenchmark;
+  unixChannel->listen(bind(&StreamFaceSendBenchmark::onFaceCreated, &unixBenchmark, _1),
+                      &StreamFaceSendBenchmark::onConnectFailed);
+  typedef boost::asio::local::stream_protocol::socket UnixSocket;
+  for (int i = 0; i < 2; ++i)
+    {
+      unixChannel->setMaxWriteSize(0);
+      unixBenchmark.run<UnixSocket>("Unix" + labels[i] + ", one by one", unixEndpoint, datas[i]);
+      unixChannel->setMaxWriteSize(DEFAULT_STREAM_MAX_WRITE_SIZE);
+      unixBenchmark.run<UnixSocket>("Unix" + labels[i] + ", gathered", unixEndpoint, datas[i]);
+    }
+}
+
+} // namespace nfd
+
+int
+main(int argc, char** argv)
+{
+  nfd::runStreamFaceSendBenchmarks();
+
+  return 0;
+}
@@ -0,0 +1,109 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Measures schedule and cancel throughput with 1M outstanding timers,
+// for the global scheduler (one ordered event per timer) and for TimerWheel.
+//
+// usage: timer-wheel-benchmark
+
+#include "core/timer-wheel.hpp"
+
+#include <boost/scoped_array.hpp>
+
+namespace nfd {
+
+static const size_t N_OUTSTANDING = 1000000;
+static const size_t N_OPERATIONS = 1000000;
+
+static void
+doNothing()
+{
+}
+
+static void
+printResult(const std::string& label, const time::steady_clock::Duration& duration)
+{
+  time::duration<double, boost::nano> perOperation =
+    time::duration<double, boost::nano>(duration) / N_OPERATIONS;
+  std::cout << label << " schedule+cancel time = " << perOperation
+            << ", operations/s = " << 1e9 / perOperation.count() << std::endl;
+}
+
+/** \return a delay between 1s and 5s, like an InterestLifetime
+ */
+static time::nanoseconds
+makeDelay(size_t i)
+{
+  return time::milliseconds(1000 + (i * 7919) % 4000);
+}
+
+static void
+runSchedulerBenchmark()
+{
+  std::vector<EventId> events(N_OUTSTANDING);
+  for (size_t i = 0; i < N_OUTSTANDING; ++i)
+    events[i] = scheduler::schedule(makeDelay(i), &doNothing);
+
+  time::steady_clock::TimePoint startTime = time::steady_clock::now();
+  for (size_t i = 0; i < N_OPERATIONS; ++i)
+    {
+      EventId& event = events[i % N_OUTSTANDING];
+      scheduler::cancel(event);
+      event = scheduler::schedule(makeDelay(i + 1), &doNothing);
+    }
+  printResult("scheduler  ", time::steady_clock::now() - startTime);
+
+  for (size_t i = 0; i < N_OUTSTANDING; ++i)
+    scheduler::cancel(events[i]);
+}
+
+static void
+runTimerWheelBenchmark()
+{
+  TimerWheel wheel;
+  boost::scoped_array<Timer> timers(new Timer[N_OUTSTANDING]); // Timer is noncopyable
+  for (size_t i = 0; i < N_OUTSTANDING; ++i)
+    wheel.schedule(timers[i], makeDelay(i), &doNothing);
+
+  time::steady_clock::TimePoint startTime = time::steady_clock::now();
+  for (size_t i = 0; i < N_OPERATIONS; ++i)
+    {
+      Timer& timer = timers[i % N_OUTSTANDING];
+      timer.cancel();
+      wheel.schedule(timer, makeDelay(i + 1), &doNothing);
+    }
+  printResult("TimerWheel ", time::steady_clock::now() - startTime);
+}
+
+} // namespace nfd
+
+int
+main(int argc, char** argv)
+{
+  nfd::runSchedulerBenchmark();
+  nfd::runTimerWheelBenchmark();
+
+  return 0;
+}
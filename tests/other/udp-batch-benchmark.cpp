@@ -0,0 +1,182 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Measures datagrams per second per core received and sent by a UdpFace over the loopback,
+// with one datagram per syscall and with recvmmsg/sendmmsg batches.
+// A peer socket sends bursts of Interests to the face, and the face sends bursts of Data
+// to the peer. Both run in this thread, so CPU time includes the peer's syscalls.
+//
+// usage: udp-batch-benchmark
+
+#include "face/udp-factory.hpp"
+#include "core/global-io.hpp"
+
+#include <ndn-cxx/security/signature-sha256-with-rsa.hpp>
+
+#include <ctime>
+
+namespace nfd {
+
+static const size_t N_PACKETS = 200000;
+static const size_t BURST = 32;
+static const uint16_t FACE_PORT = 20073;
+static const uint16_t PEER_PORT = 20074;
+
+class UdpBatchBenchmark
+{
+public:
+  UdpBatchBenchmark()
+    : m_nReceived(0)
+  {
+  }
+
+  void
+  onFaceCreated(const shared_ptr<Face>& face)
+  {
+    m_face = face;
+    m_face->onReceiveInterest += bind(&UdpBatchBenchmark::onReceiveInterest, this);
+  }
+
+  static void
+  onConnectFailed(const std::string& reason)
+  {
+    std::cerr << "cannot create face: " << reason << std::endl;
+    std::exit(1);
+  }
+
+  void
+  run(size_t batchSize)
+  {
+    boost::asio::io_service& io = getGlobalIoService();
+    boost::asio::ip::address loopback = boost::asio::ip::address_v4::loopback();
+    boost::asio::ip::udp::endpoint faceEndpoint(loopback, FACE_PORT);
+    boost::asio::ip::udp::endpoint peerEndpoint(loopback, PEER_PORT);
+
+    UdpFactory factory;
+    shared_ptr<UdpChannel> channel = factory.createChannel(faceEndpoint, time::seconds(600));
+    channel->setIoBatchSize(batchSize);
+
+    boost::asio::ip::udp::socket peer(io, peerEndpoint);
+    channel->connect(peerEndpoint,
+                     bind(&UdpBatchBenchmark::onFaceCreated, this, _1),
+                     &UdpBatchBenchmark::onConnectFailed);
+    while (!m_face)
+      io.run_one();
+
+    std::string label = batchSize > 1 ?
+      "batch " + boost::lexical_cast<std::string>(batchSize) : "one by one";
+    if (batchSize > 1 && !DatagramBatch::isSupported())
+      label += " (recvmmsg/sendmmsg unavailable)";
+
+    // receive: the peer sends a burst, then the face receives it
+    Interest interest("/benchmark/site/video");
+    interest.setNonce(1);
+    const Block& interestWire = interest.wireEncode();
+    m_nReceived = 0;
+    std::clock_t cpuStart = std::clock();
+    time::steady_clock::TimePoint startTime = time::steady_clock::now();
+    for (size_t i = 0; i < N_PACKETS; i += BURST)
+      {
+        for (size_t j = 0; j < BURST; ++j)
+          peer.send_to(boost::asio::buffer(interestWire.wire(), interestWire.size()),
+                       faceEndpoint);
+        while (m_nReceived < i + BURST)
+          io.run_one();
+      }
+    this->report(label + ", receive", startTime, cpuStart);
+
+    // send: the face sends a burst, then the peer receives it
+    shared_ptr<Data> data = makeData();
+    std::vector<uint8_t> readBuffer(MAX_NDN_PACKET_SIZE);
+    cpuStart = std::clock();
+    startTime = time::steady_clock::now();
+    for (size_t i = 0; i < N_PACKETS; i += BURST)
+      {
+        for (size_t j = 0; j < BURST; ++j)
+          m_face->sendData(*data);
+        io.poll();
+        for (size_t j = 0; j < BURST; ++j)
+          peer.receive(boost::asio::buffer(readBuffer));
+      }
+    this->report(label + ", send", startTime, cpuStart);
+
+    m_face->close();
+    m_face.reset();
+    io.poll();
+  }
+
+private:
+  void
+  onReceiveInterest()
+  {
+    ++m_nReceived;
+  }
+
+  static shared_ptr<Data>
+  makeData()
+  {
+    ndn::SignatureSha256WithRsa fakeSignature;
+    fakeSignature.setValue(ndn::dataBlock(tlv::SignatureValue,
+                                          reinterpret_cast<const uint8_t*>(0), 0));
+    std::vector<uint8_t> payload(1000, 0xBB);
+
+    shared_ptr<Data> data = make_shared<Data>("/benchmark/site/video/1");
+    data->setContent(&payload.front(), payload.size());
+    data->setSignature(fakeSignature);
+    data->wireEncode();
+    return data;
+  }
+
+  static void
+  report(const std::string& label, const time::steady_clock::TimePoint& startTime,
+         std::clock_t cpuStart)
+  {
+    time::steady_clock::Duration duration = time::steady_clock::now() - startTime;
+    double seconds = time::duration_cast<time::duration<double> >(duration).count();
+    double cpuSeconds = static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+    std::cout << label << ": "
+              << "datagrams/s = " << N_PACKETS / seconds
+              << ", datagrams/s per core = " << N_PACKETS / cpuSeconds << std::endl;
+  }
+
+private:
+  shared_ptr<Face> m_face;
+  size_t m_nReceived;
+};
+
+} // namespace nfd
+
+int
+main(int argc, char** argv)
+{
+  size_t batchSizes[] = { 1, 8, 32, 64 };
+  for (size_t i = 0; i < sizeof(batchSizes) / sizeof(batchSizes[0]); ++i)
+    {
+      nfd::UdpBatchBenchmark benchmark;
+      benchmark.run(batchSizes[i]);
+    }
+
+  return 0;
+}
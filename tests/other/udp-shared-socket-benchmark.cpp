@@ -0,0 +1,215 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014,  Regents of the University of California,
+ *                      Arizona Board of Regents,
+ *                      Colorado State University,
+ *                      University Pierre & Marie Curie, Sorbonne University,
+ *                      Washington University in St. Louis,
+ *                      Beijing Institute of Technology,
+ *                      The University of Memphis
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Measures UdpChannel with many on-demand peers over the loopback, with one connected
+// socket per peer and with one shared channel socket.
+// Each peer first sends one Interest, which creates its face, and then keeps sending
+// Interests in round-robin order. The benchmark reports faces created per second,
+// Interests received per second, and file descriptors held by the process.
+//
+// usage: udp-shared-socket-benchmark [number of peers]
+//
+// Peer sockets need one file descriptor each; the open files limit is raised if possible.
+
+#include "face/udp-factory.hpp"
+#include "core/global-io.hpp"
+
+#include <sys/resource.h>
+#include <dirent.h>
+
+namespace nfd {
+
+static const size_t DEFAULT_N_PEERS = 10000;
+static const size_t N_ROUNDS = 20;
+static const size_t BURST = 32;
+static const uint16_t CHANNEL_PORT = 20075;
+
+/** \return number of open file descriptors, or 0 if unknown
+ */
+static size_t
+getNOpenFds()
+{
+  DIR* dir = ::opendir("/proc/self/fd");
+  if (dir == 0)
+    return 0;
+
+  size_t nFds = 0;
+  while (::readdir(dir) != 0)
+    ++nFds;
+  ::closedir(dir);
+  return nFds > 3 ? nFds - 3 : 0; // ".", ".." and the directory itself
+}
+
+/** \brief raise the open files limit to at least nFds
+ *  \return whether the limit is sufficient
+ */
+static bool
+raiseFdLimit(size_t nFds)
+{
+  rlimit limit;
+  if (::getrlimit(RLIMIT_NOFILE, &limit) != 0)
+    return false;
+  if (limit.rlim_cur >= nFds)
+    return true;
+
+  limit.rlim_cur = std::min<rlim_t>(nFds, limit.rlim_max);
+  return ::setrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur >= nFds;
+}
+
+class UdpSharedSocketBenchmark
+{
+public:
+  UdpSharedSocketBenchmark()
+    : m_nFacesCreated(0)
+    , m_nReceived(0)
+  {
+  }
+
+  void
+  run(const std::string& label, bool isSocketShared, size_t nPeers)
+  {
+    boost::asio::io_service& io = getGlobalIoService();
+    boost::asio::ip::udp::endpoint channelEndpoint(boost::asio::ip::address_v4::loopback(),
+                                                   CHANNEL_PORT);
+
+    UdpFactory factory;
+    shared_ptr<UdpChannel> channel = factory.createChannel(channelEndpoint, time::seconds(600));
+    channel->setSharedSocket(isSocketShared);
+    channel->listen(bind(&UdpSharedSocketBenchmark::onFaceCreated, this, _1),
+                    &UdpSharedSocketBenchmark::onListenFailed);
+
+    std::vector<shared_ptr<boost::asio::ip::udp::socket> > peers;
+    for (size_t i = 0; i < nPeers; ++i)
+      {
+        shared_ptr<boost::asio::ip::udp::socket> peer =
+          make_shared<boost::asio::ip::udp::socket>(ref(io));
+        peer->open(boost::asio::ip::udp::v4());
+        peer->bind(boost::asio::ip::udp::endpoint(boost::asio::ip::address_v4::loopback(), 0));
+        peers.push_back(peer);
+      }
+
+    Interest interest("/benchmark/site/video");
+    interest.setNonce(1);
+    const Block& wire = interest.wireEncode();
+
+    m_nFacesCreated = 0;
+    m_nReceived = 0;
+    time::steady_clock::TimePoint startTime = time::steady_clock::now();
+    this->sendRound(peers, wire, channelEndpoint);
+    double createSeconds = secondsSince(startTime);
+
+    startTime = time::steady_clock::now();
+    for (size_t round = 0; round < N_ROUNDS; ++round)
+      this->sendRound(peers, wire, channelEndpoint);
+    double receiveSeconds = secondsSince(startTime);
+
+    std::cout << label << ", " << nPeers << " peers: "
+              << "faces created/s = " << nPeers / createSeconds
+              << ", Interests/s = " << nPeers * N_ROUNDS / receiveSeconds
+              << ", open fds = " << getNOpenFds()
+              << " (" << nPeers << " held by peers)" << std::endl;
+
+    for (std::list<shared_ptr<Face> >::iterator it = m_faces.begin(); it != m_faces.end(); ++it)
+      (*it)->close();
+    m_faces.clear();
+    io.poll();
+  }
+
+  static void
+  onListenFailed(const std::string& reason)
+  {
+    std::cerr << "channel failed: " << reason << std::endl;
+    std::exit(1);
+  }
+
+private:
+  void
+  onFaceCreated(const shared_ptr<Face>& face)
+  {
+    ++m_nFacesCreated;
+    m_faces.push_back(face);
+    face->onReceiveInterest += bind(&UdpSharedSocketBenchmark::onReceiveInterest, this);
+  }
+
+  void
+  onReceiveInterest()
+  {
+    ++m_nReceived;
+  }
+
+  /** \brief send one Interest from every peer, in bursts
+   */
+  void
+  sendRound(const std::vector<shared_ptr<boost::asio::ip::udp::socket> >& peers,
+            const Block& wire, const boost::asio::ip::udp::endpoint& channelEndpoint)
+  {
+    boost::asio::io_service& io = getGlobalIoService();
+    for (size_t i = 0; i < peers.size(); i += BURST)
+      {
+        size_t end = std::min(i + BURST, peers.size());
+        for (size_t j = i; j < end; ++j)
+          peers[j]->send_to(boost::asio::buffer(wire.wire(), wire.size()), channelEndpoint);
+
+        size_t expected = m_nReceived + (end - i);
+        while (m_nReceived < expected)
+          io.run_one();
+      }
+  }
+
+  static double
+  secondsSince(const time::steady_clock::TimePoint& startTime)
+  {
+    time::steady_clock::Duration duration = time::steady_clock::now() - startTime;
+    return time::duration_cast<time::duration<double> >(duration).count();
+  }
+
+private:
+  size_t m_nFacesCreated;
+  size_t m_nReceived;
+  std::list<shared_ptr<Face> > m_faces;
+};
+
+} // namespace nfd
+
+int
+main(int argc, char** argv)
+{
+  size_t nPeers = nfd::DEFAULT_N_PEERS;
+  if (argc > 1)
+    nPeers = boost::lexical_cast<size_t>(argv[1]);
+
+  // peers, plus one connected socket per peer in the per-peer socket mode
+  if (!nfd::raiseFdLimit(2 * nPeers + 64))
+    {
+      std::cerr << "open files limit is too low for " << nPeers << " peers" << std::endl;
+      return 1;
+    }
+
+  nfd::UdpSharedSocketBenchmark benchmark;
+  benchmark.run("shared socket", true, nPeers);
+  benchmark.run("socket per peer", false, nPeers);
+
+  return 0;
+}
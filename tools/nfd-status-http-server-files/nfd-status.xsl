@@ -91,6 +91,7 @@ xmlns:nfd="ndn:/localhost/nfd/status/1">
         <th>PIT entries</th>
         <th>Measurements entries</th>
         <th>CS entries</th>
+        <th>CS bytes</th>
         <th>In Interests</th>
         <th>Out Interests</th>
         <th>In Data</th>
@@ -109,6 +110,10 @@ xmlns:nfd="ndn:/localhost/nfd/status/1">
         <td><xsl:value-of select="nfd:nPitEntries"/></td>
         <td><xsl:value-of select="nfd:nMeasurementsEntries"/></td>
         <td><xsl:value-of select="nfd:nCsEntries"/></td>
+        <td>
+          <xsl:value-of select="nfd:nCsBytes"/>
+          <xsl:if test="nfd:csMaxBytes"> / <xsl:value-of select="nfd:csMaxBytes"/></xsl:if>
+        </td>
         <td><xsl:value-of select="nfd:packetCounters/nfd:incomingPackets/nfd:nInterests"/></td>
         <td><xsl:value-of select="nfd:packetCounters/nfd:outgoingPackets/nfd:nInterests"/></td>
         <td><xsl:value-of select="nfd:packetCounters/nfd:incomingPackets/nfd:nDatas"/></td>
@@ -26,6 +26,7 @@
  */
 
 #include "version.hpp"
+#include "core/status-tlv.hpp"
 
 #include <ndn-cxx/face.hpp>
 #include <ndn-cxx/name.hpp>
@@ -184,6 +185,13 @@ public:
   afterFetchedVersionInformation(const Data& data)
   {
     nfd::ForwarderStatus status(data.getContent());
+
+    // NFD-specific elements appended after ForwarderStatus; absent with older forwarders
+    Block content = data.getContent();
+    content.parse();
+    Block::element_const_iterator nCsBytes = content.find(::nfd::status_tlv::NCsBytes);
+    Block::element_const_iterator csMaxBytes = content.find(::nfd::status_tlv::CsMaxBytes);
+
     std::string nfdId;
     if (data.getSignature().hasKeyLocator())
       {
@@ -220,6 +228,12 @@ public:
                   << "</nMeasurementsEntries>";
         std::cout << "<nCsEntries>"           << status.getNCsEntries()
                   << "</nCsEntries>";
+        if (nCsBytes != content.elements_end())
+          std::cout << "<nCsBytes>"           << readNonNegativeInteger(*nCsBytes)
+                    << "</nCsBytes>";
+        if (csMaxBytes != content.elements_end())
+          std::cout << "<csMaxBytes>"         << readNonNegativeInteger(*csMaxBytes)
+                    << "</csMaxBytes>";
         std::cout << "<packetCounters>";
         std::cout << "<incomingPackets>";
         std::cout << "<nInterests>"           << status.getNInInterests()
@@ -256,6 +270,11 @@ public:
         std::cout << "           nPitEntries=" << status.getNPitEntries()          << std::endl;
         std::cout << "  nMeasurementsEntries=" << status.getNMeasurementsEntries() << std::endl;
         std::cout << "            nCsEntries=" << status.getNCsEntries()           << std::endl;
+        if (nCsBytes != content.elements_end())
+          std::cout << "              nCsBytes=" << readNonNegativeInteger(*nCsBytes) << std::endl;
+        if (csMaxBytes != content.elements_end())
+          std::cout << "            csMaxBytes=" << readNonNegativeInteger(*csMaxBytes)
+                    << std::endl;
         std::cout << "          nInInterests=" << status.getNInInterests()         << std::endl;
         std::cout << "         nOutInterests=" << status.getNOutInterests()        << std::endl;
         std::cout << "              nInDatas=" << status.getNInDatas()             << std::endl;